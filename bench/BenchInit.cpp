@@ -0,0 +1,58 @@
+#include "BenchInit.hpp"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include "Systems/BenchSystem.hpp"
+
+#include <GraphicsCore/Systems/DeltaTimeSystem.hpp>
+#include <GraphicsCore/Systems/FrameBeginSystem.hpp>
+#include <GraphicsCore/GraphicsContexts.hpp>
+#include <GraphicsCore/Components/BufferManagerComponent.hpp>
+#include <GraphicsCore/Components/TextureManagerComponent.hpp>
+#include <GraphicsCore/Components/ModelManagerComponent.hpp>
+#include <GraphicsCore/Components/DescriptorManagerComponent.hpp>
+#include <GraphicsCore/Components/DeltaTimeComponent.hpp>
+#include <GraphicsCore/Components/NameComponent.hpp>
+#include <GraphicsCore/Components/RelationshipComponent.hpp>
+#include <GraphicsCore/Resources/Components/BindlessTextureDSetComponent.hpp>
+#include <GraphicsCore/Components/VulkanDeviceComponent.hpp>
+#include <GraphicsCore/Components/MaterialManagerComponent.hpp>
+#include <GraphicsCore/Components/VMAllocatorComponent.hpp>
+#include <GraphicsCore/Resources/Factories/ModelFactory.hpp>
+#include <SmithCore/Renderables.hpp>
+
+void BenchInit::Run(GeneralManager& gm)
+{
+	gm.registerSystem<BenchSystem>()
+	    .after<DeltaTimeSystem>()
+	    .before<FrameBeginSystem>()
+	    .reads<DrawInfoComponent>()
+	    .writes<BenchComponent, GlobalTransformComponent>();
+	gm.addComponent<BenchComponent>(gm.getContext<MainCameraContext>(), config);
+	gm.getContextComponent<DeltaTimeContext, DeltaTimeComponent>()->fixedDeltaTime = fixedDeltaTime;
+
+	// Managers the model loader needs.
+	BufferManager* bufferManager = gm.getContextComponent<BufferManagerContext, BufferManagerComponent>()->bufferManager;
+	TextureManager* textureManager =
+	    gm.getContextComponent<TextureManagerContext, TextureManagerComponent>()->textureManager;
+	ModelManager* modelManager = gm.getContextComponent<ModelManagerContext, ModelManagerComponent>()->modelManager;
+	DescriptorManager* descriptorManager =
+	    gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>()->descriptorManager;
+	BindlessTextureDSetComponent* dSetComponent =
+	    gm.getContextComponent<MainDSetsContext, BindlessTextureDSetComponent>();
+	VulkanDevice& vulkanDevice =
+	    *gm.getContextComponent<MainVulkanDeviceContext, VulkanDeviceComponent>()->vulkanDeviceInstance;
+	VmaAllocator allocator = gm.getContextComponent<VMAllocatorContext, VMAllocatorComponent>()->allocator;
+	MaterialManager* materialManager =
+	    gm.getContextComponent<MaterialManagerContext, MaterialManagerComponent>()->materialManager;
+
+	Orhescyon::Entity scene = gm.createEntity();
+	gm.addComponent<NameComponent>(scene, "Bench Scene");
+	Smith::Renderables::forgeTransform(gm, scene, glm::vec3(0.0f), glm::quat{1.0f, 0.0f, 0.0f, 0.0f});
+
+	Orhescyon::Entity mesh =
+	    ModelFactory::loadModel(config.scenePath.c_str(), 0, *bufferManager, *dSetComponent, *descriptorManager, gm,
+	                            *textureManager, *modelManager, *materialManager, vulkanDevice, allocator);
+	gm.getComponent<RelationshipComponent>(scene)->addChild(scene, mesh, gm);
+}
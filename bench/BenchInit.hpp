@@ -0,0 +1,22 @@
+#pragma once
+
+#include <Halcyon.hpp>
+
+#include "Components/BenchComponent.hpp"
+
+using Orhescyon::GeneralManager;
+
+// Loads the benchmark scene and hands `config` to BenchSystem on the main camera. Every frame advances by exactly
+// `fixedDeltaTime`, so camera placement and animation are identical between runs.
+class BenchInit : public IStartUp
+{
+public:
+	BenchInit(BenchComponent config, float fixedDeltaTime) : config(std::move(config)), fixedDeltaTime(fixedDeltaTime)
+	{
+	}
+	void Run(GeneralManager& gm);
+
+private:
+	BenchComponent config;
+	float fixedDeltaTime;
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstdint>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+struct BenchWaypoint
+{
+	glm::vec3 position;
+	glm::vec3 target;
+};
+
+// Scripted run attached to the main camera: BenchSystem flies the camera along `path` during the measured frames
+// and writes the report to `reportPath` once they are done.
+struct BenchComponent
+{
+	uint32_t warmupFrames = 60;
+	uint32_t measuredFrames = 600;
+	std::vector<BenchWaypoint> path;
+	std::string scenePath;
+	std::string reportPath;
+
+	// Run state
+	uint32_t frame = 0;
+	uint64_t drawCountSum = 0;
+	uint64_t objectCountSum = 0;
+	uint32_t maxDrawCount = 0;
+	std::chrono::steady_clock::time_point measureStart;
+};
@@ -0,0 +1,157 @@
+#include <PhysicsCore/PhysRecording.hpp>
+#include <TaskScheduler.hpp>
+
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/Factory.h>
+#include <Jolt/RegisterTypes.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+void printUsage()
+{
+	std::cout << "Usage: halcyon_phys_replay <recording> [options]\n"
+	             "  --runs <n>            Replays of the recording; timings come from the fastest (default 3)\n"
+	             "  --workers <n>         Task workers for physics jobs (default: hardware threads minus one)\n"
+	             "  --out <file.json>     Report path (default halcyon_phys_replay.json)\n";
+}
+
+std::string jsonEscape(const std::string& text)
+{
+	std::string escaped;
+	escaped.reserve(text.size());
+	for (char c : text)
+	{
+		if (c == '"' || c == '\\') escaped += '\\';
+		escaped += c;
+	}
+	return escaped;
+}
+
+double percentile(const std::vector<double>& sorted, double p)
+{
+	if (sorted.empty()) return 0.0;
+	const size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+} // namespace
+
+// Re-simulates a session recorded with PhysSettingsComponent::recordPath, headless and without pacing, and reports
+// the step time of every tick. Doubles as a determinism check: each tick's state is compared with the recording.
+int main(int argc, char** argv)
+{
+	std::string recordingPath;
+	std::string reportPath = "halcyon_phys_replay.json";
+	uint32_t runs = 3;
+	TaskSchedulerDesc schedulerDesc;
+	schedulerDesc.reservedThreads = 1; // Only the replaying thread
+
+	try
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string_view arg = argv[i];
+			if (arg == "--help" || arg == "-h")
+			{
+				printUsage();
+				return EXIT_SUCCESS;
+			}
+			if (!arg.starts_with("--"))
+			{
+				recordingPath = arg;
+				continue;
+			}
+			if (i + 1 >= argc) throw std::runtime_error("missing value for " + std::string(arg));
+			const std::string value = argv[++i];
+
+			if (arg == "--runs")
+				runs = static_cast<uint32_t>(std::stoul(value));
+			else if (arg == "--workers")
+				schedulerDesc.workerCount = static_cast<uint32_t>(std::stoul(value));
+			else if (arg == "--out")
+				reportPath = value;
+			else
+				throw std::runtime_error("unknown option " + std::string(arg));
+		}
+		if (recordingPath.empty()) throw std::runtime_error("no recording given");
+		if (runs == 0) throw std::runtime_error("runs must be positive");
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "halcyon_phys_replay: " << e.what() << std::endl;
+		printUsage();
+		return EXIT_FAILURE;
+	}
+
+	JPH::RegisterDefaultAllocator();
+	JPH::Factory::sInstance = new JPH::Factory();
+	JPH::RegisterTypes();
+
+	int exitCode = EXIT_SUCCESS;
+	try
+	{
+		TaskScheduler scheduler(schedulerDesc);
+
+		PhysReplayResult best;
+		double bestTotalMs = 0.0;
+		for (uint32_t run = 0; run < runs; ++run)
+		{
+			PhysReplayResult result = replayPhysRecording(recordingPath, scheduler);
+			const double totalMs = std::accumulate(result.stepMilliseconds.begin(), result.stepMilliseconds.end(), 0.0);
+			std::cout << "Run " << run + 1 << ": " << result.stepMilliseconds.size() << " ticks, " << totalMs
+			          << " ms stepping, " << result.wallSeconds << " s total" << std::endl;
+			if (run == 0 || totalMs < bestTotalMs)
+			{
+				best = std::move(result);
+				bestTotalMs = totalMs;
+			}
+		}
+
+		std::vector<double> sorted = best.stepMilliseconds;
+		std::sort(sorted.begin(), sorted.end());
+		const double ticks = static_cast<double>(std::max<size_t>(sorted.size(), 1));
+
+		std::ofstream file(reportPath);
+		if (!file) throw std::runtime_error("could not write " + reportPath);
+		file << "{\n  \"recording\": \"" << jsonEscape(recordingPath) << "\",\n  \"workers\": "
+		     << scheduler.workerCount() << ",\n  \"runs\": " << runs << ",\n  \"ticks\": " << sorted.size()
+		     << ",\n  \"peakBodies\": " << best.peakBodies << ",\n  \"truncated\": "
+		     << (best.truncated ? "true" : "false") << ",\n  \"firstDivergentTick\": " << best.firstDivergentTick
+		     << ",\n  \"step\": {\"avgMs\": " << bestTotalMs / ticks << ", \"minMs\": " << percentile(sorted, 0.0)
+		     << ", \"maxMs\": " << percentile(sorted, 1.0) << ", \"p50Ms\": " << percentile(sorted, 0.5)
+		     << ", \"p95Ms\": " << percentile(sorted, 0.95) << ", \"p99Ms\": " << percentile(sorted, 0.99)
+		     << "},\n  \"stepMs\": [";
+		for (size_t i = 0; i < best.stepMilliseconds.size(); ++i)
+			file << (i == 0 ? "" : ", ") << best.stepMilliseconds[i];
+		file << "]\n}\n";
+		std::cout << "halcyon_phys_replay: report written to " << reportPath << std::endl;
+
+		if (best.truncated)
+			std::cout << "Warning: the recording has no end marker, the session was cut short" << std::endl;
+		if (best.firstDivergentTick >= 0)
+		{
+			std::cerr << "halcyon_phys_replay: diverged from the recording at tick " << best.firstDivergentTick
+			          << std::endl;
+			exitCode = EXIT_FAILURE;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "halcyon_phys_replay: " << e.what() << std::endl;
+		exitCode = EXIT_FAILURE;
+	}
+
+	JPH::UnregisterTypes();
+	delete JPH::Factory::sInstance;
+	JPH::Factory::sInstance = nullptr;
+	return exitCode;
+}
@@ -0,0 +1,185 @@
+#include "BenchSystem.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include <glm/gtc/quaternion.hpp>
+#include <vk_mem_alloc.h>
+
+#include <FrameProfiler.hpp>
+#include <FrameProfilerComponent.hpp>
+#include <FrameProfilerContext.hpp>
+#include <GraphicsCore/GraphicsContexts.hpp>
+#include <GraphicsCore/SwapChain.hpp>
+#include <GraphicsCore/VulkanDevice.hpp>
+#include <GraphicsCore/Components/DrawInfoComponent.hpp>
+#include <GraphicsCore/Components/SwapChainComponent.hpp>
+#include <GraphicsCore/Components/VulkanDeviceComponent.hpp>
+#include <GraphicsCore/Components/VMAllocatorComponent.hpp>
+#include <GraphicsCore/Components/TextureManagerComponent.hpp>
+#include <GraphicsCore/Components/MaterialManagerComponent.hpp>
+#include <GraphicsCore/Components/ModelManagerComponent.hpp>
+#include <GraphicsCore/Resources/Managers/TextureManager.hpp>
+#include <GraphicsCore/Resources/Managers/MaterialManager.hpp>
+#include <GraphicsCore/Resources/Managers/ModelManager.hpp>
+#include <PlatformCore/PlatformContexts.hpp>
+#include <PlatformCore/Components/WindowComponent.hpp>
+
+namespace
+{
+std::string jsonEscape(const std::string& text)
+{
+	std::string escaped;
+	escaped.reserve(text.size());
+	for (char c : text)
+	{
+		if (c == '"' || c == '\\') escaped += '\\';
+		escaped += c;
+	}
+	return escaped;
+}
+
+glm::vec3 catmullRom(const glm::vec3& p0, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, float t)
+{
+	const float t2 = t * t;
+	const float t3 = t2 * t;
+	return 0.5f * (2.0f * p1 + (p2 - p0) * t + (2.0f * p0 - 5.0f * p1 + 4.0f * p2 - p3) * t2 +
+	               (3.0f * p1 - p0 - 3.0f * p2 + p3) * t3);
+}
+
+void writeStats(std::ofstream& file, const std::vector<FrameProfiler::Stats>& stats, FrameProfiler::Domain domain)
+{
+	bool first = true;
+	for (const FrameProfiler::Stats& s : stats)
+	{
+		if (s.domain != domain) continue;
+		file << (first ? "\n" : ",\n") << "    {\"name\": \"" << jsonEscape(s.name) << "\", \"samples\": "
+		     << s.sampleCount << ", \"avgMs\": " << s.avgMs << ", \"minMs\": " << s.minMs << ", \"maxMs\": "
+		     << s.maxMs << ", \"p50Ms\": " << s.p50Ms << ", \"p95Ms\": " << s.p95Ms << ", \"p99Ms\": " << s.p99Ms
+		     << "}";
+		first = false;
+	}
+	file << "\n  ]";
+}
+} // namespace
+
+void BenchSystem::update(GeneralManager& gm)
+{
+	BenchComponent* bench = gm.getContextComponent<MainCameraContext, BenchComponent>();
+	GlobalTransformComponent* cameraTransform = gm.getContextComponent<MainCameraContext, GlobalTransformComponent>();
+	DrawInfoComponent* drawInfo = gm.getContextComponent<MainFrameDataContext, DrawInfoComponent>();
+	FrameProfilerComponent* profilerComponent = gm.getContextComponent<FrameProfilerContext, FrameProfilerComponent>();
+	WindowComponent* window = gm.getContextComponent<MainWindowContext, WindowComponent>();
+
+	const uint32_t totalFrames = bench->warmupFrames + bench->measuredFrames;
+	if (bench->frame > totalFrames) return; // Report written, waiting for the loop to see the close request
+
+	const uint32_t measuredFrame = bench->frame > bench->warmupFrames ? bench->frame - bench->warmupFrames : 0;
+	const float t =
+	    bench->measuredFrames > 1 ? static_cast<float>(measuredFrame) / static_cast<float>(bench->measuredFrames) : 0.0f;
+	placeCamera(*cameraTransform, bench->path, std::min(t, 1.0f));
+
+	if (bench->frame == bench->warmupFrames)
+	{
+		// Keep every measured frame, and none of the warm-up with its pipeline and streaming hitches
+		if (profilerComponent && profilerComponent->profiler)
+			profilerComponent->profiler->setHistoryLength(bench->measuredFrames);
+		bench->measureStart = std::chrono::steady_clock::now();
+	}
+	else if (bench->frame > bench->warmupFrames)
+	{
+		// Counts of the frame recorded by the previous update
+		bench->drawCountSum += drawInfo->totalDrawCount;
+		bench->objectCountSum += drawInfo->totalObjectCount;
+		bench->maxDrawCount = std::max(bench->maxDrawCount, drawInfo->totalDrawCount);
+	}
+
+	if (bench->frame == totalFrames)
+	{
+		std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - bench->measureStart;
+		writeReport(gm, *bench, elapsed.count());
+		window->windowInstance->setShouldClose(true);
+	}
+	++bench->frame;
+}
+
+void BenchSystem::placeCamera(GlobalTransformComponent& transform, const std::vector<BenchWaypoint>& path, float t)
+{
+	if (path.empty()) return;
+
+	// Uniform Catmull-Rom through the waypoints, with the end points repeated as outer controls
+	const size_t last = path.size() - 1;
+	const float segmentPos = t * static_cast<float>(last);
+	const size_t segment = std::min(static_cast<size_t>(segmentPos), last == 0 ? size_t{0} : last - 1);
+	const float local = segmentPos - static_cast<float>(segment);
+	auto at = [&](size_t i) -> const BenchWaypoint& { return path[std::min(i, last)]; };
+	const BenchWaypoint& p0 = at(segment == 0 ? 0 : segment - 1);
+	const BenchWaypoint& p1 = at(segment);
+	const BenchWaypoint& p2 = at(segment + 1);
+	const BenchWaypoint& p3 = at(segment + 2);
+
+	const glm::vec3 position = catmullRom(p0.position, p1.position, p2.position, p3.position, local);
+	const glm::vec3 target = catmullRom(p0.target, p1.target, p2.target, p3.target, local);
+	transform.setGlobalPosition(position);
+
+	const glm::vec3 forward = target - position;
+	if (glm::dot(forward, forward) > 1e-8f)
+		transform.setGlobalRotation(glm::quatLookAt(glm::normalize(forward), glm::vec3(0.0f, 1.0f, 0.0f)));
+}
+
+void BenchSystem::writeReport(GeneralManager& gm, const BenchComponent& bench, double seconds)
+{
+	VulkanDevice& vulkanDevice =
+	    *gm.getContextComponent<MainVulkanDeviceContext, VulkanDeviceComponent>()->vulkanDeviceInstance;
+	SwapChain& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
+	VmaAllocator allocator = gm.getContextComponent<VMAllocatorContext, VMAllocatorComponent>()->allocator;
+	TextureManager& textureManager =
+	    *gm.getContextComponent<TextureManagerContext, TextureManagerComponent>()->textureManager;
+	MaterialManager& materialManager =
+	    *gm.getContextComponent<MaterialManagerContext, MaterialManagerComponent>()->materialManager;
+	ModelManager& modelManager = *gm.getContextComponent<ModelManagerContext, ModelManagerComponent>()->modelManager;
+	FrameProfilerComponent* profilerComponent = gm.getContextComponent<FrameProfilerContext, FrameProfilerComponent>();
+
+	std::ofstream file(bench.reportPath);
+	if (!file) throw std::runtime_error("BenchSystem: could not write " + bench.reportPath);
+
+	const double frames = static_cast<double>(std::max(bench.measuredFrames, 1u));
+	file << "{\n  \"scene\": \"" << jsonEscape(bench.scenePath) << "\",\n  \"device\": \""
+	     << jsonEscape(vulkanDevice.physicalDevice.getProperties().deviceName.data()) << "\",\n  \"width\": "
+	     << swapChain.swapChainExtent.width << ",\n  \"height\": " << swapChain.swapChainExtent.height
+	     << ",\n  \"warmupFrames\": " << bench.warmupFrames << ",\n  \"frames\": " << bench.measuredFrames
+	     << ",\n  \"wallSeconds\": " << seconds << ",\n  \"avgFrameMs\": " << seconds * 1000.0 / frames
+	     << ",\n  \"draws\": {\"avgDrawCommands\": " << static_cast<double>(bench.drawCountSum) / frames
+	     << ", \"maxDrawCommands\": " << bench.maxDrawCount
+	     << ", \"avgInstances\": " << static_cast<double>(bench.objectCountSum) / frames << "}";
+
+	// Heap usage as the driver reports it, plus the engine's own resource pools
+	const VkPhysicalDeviceMemoryProperties* memoryProperties = nullptr;
+	vmaGetMemoryProperties(allocator, &memoryProperties);
+	VmaBudget budgets[VK_MAX_MEMORY_HEAPS];
+	vmaGetHeapBudgets(allocator, budgets);
+	file << ",\n  \"memory\": {\n    \"heaps\": [";
+	for (uint32_t i = 0; i < memoryProperties->memoryHeapCount; ++i)
+	{
+		const bool deviceLocal = (memoryProperties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+		file << (i == 0 ? "" : ", ") << "{\"heap\": " << i << ", \"deviceLocal\": " << (deviceLocal ? "true" : "false")
+		     << ", \"usageBytes\": " << budgets[i].usage << ", \"budgetBytes\": " << budgets[i].budget
+		     << ", \"allocationBytes\": " << budgets[i].statistics.allocationBytes << "}";
+	}
+	file << "],\n    \"textures\": " << textureManager.textureCount()
+	     << ", \"materials\": " << materialManager.materialCount() << ", \"meshes\": " << modelManager.meshCount()
+	     << ", \"models\": " << modelManager.modelCount() << "\n  }";
+
+	std::vector<FrameProfiler::Stats> stats;
+	if (profilerComponent && profilerComponent->profiler) stats = profilerComponent->profiler->collectStats();
+	file << ",\n  \"gpuPasses\": [";
+	writeStats(file, stats, FrameProfiler::Domain::Gpu);
+	file << ",\n  \"cpuScopes\": [";
+	writeStats(file, stats, FrameProfiler::Domain::Cpu);
+	file << "\n}\n";
+
+	if (!file) throw std::runtime_error("BenchSystem: could not write " + bench.reportPath);
+	std::cout << "BenchSystem: report written to " << bench.reportPath << std::endl;
+}
@@ -0,0 +1,31 @@
+#pragma once
+#include <Orhescyon/GeneralManager.hpp>
+#include <Orhescyon/Systems/SystemCore.hpp>
+
+#include "../Components/BenchComponent.hpp"
+
+#include <GraphicsCore/Components/GlobalTransformComponent.hpp>
+
+#include <iostream>
+
+using Orhescyon::GeneralManager;
+
+// Drives a headless benchmark run: holds the camera on the first waypoint for the warm-up frames, then flies it
+// along the path while the profiler records, and finally writes the report and closes the window.
+class BenchSystem : public Orhescyon::SystemCore<BenchSystem>
+{
+public:
+	void update(GeneralManager& gm) override;
+	void onRegistered(GeneralManager& gm) override
+	{
+		std::cout << "BenchSystem registered!" << std::endl;
+	};
+	void onShutdown(GeneralManager& gm) override
+	{
+		std::cout << "BenchSystem shutdown!" << std::endl;
+	};
+
+private:
+	static void placeCamera(GlobalTransformComponent& transform, const std::vector<BenchWaypoint>& path, float t);
+	static void writeReport(GeneralManager& gm, const BenchComponent& bench, double seconds);
+};
@@ -0,0 +1,120 @@
+#include <Halcyon.hpp>
+
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "BenchInit.hpp"
+
+namespace
+{
+void printUsage()
+{
+	std::cout << "Usage: halcyon_bench [options]\n"
+	             "  --scene <file.gltf>   Scene to load (default assets/models/cube.gltf)\n"
+	             "  --frames <n>          Measured frames (default 600)\n"
+	             "  --warmup <n>          Frames rendered before measuring (default 60)\n"
+	             "  --width <px>          Output width (default 1920)\n"
+	             "  --height <px>         Output height (default 1080)\n"
+	             "  --dt <seconds>        Fixed delta time per frame (default 1/60)\n"
+	             "  --path <file>         Camera waypoints, one 'px py pz tx ty tz' per line (default: orbit)\n"
+	             "  --out <file.json>     Report path (default halcyon_bench.json)\n";
+}
+
+// Orbit around the origin, rising and falling once, closed so the last frame matches the first
+std::vector<BenchWaypoint> defaultPath()
+{
+	std::vector<BenchWaypoint> path;
+	constexpr int kSteps = 8;
+	for (int i = 0; i <= kSteps; ++i)
+	{
+		const float angle = 6.2831853f * static_cast<float>(i) / kSteps;
+		const float height = 1.5f + std::sin(angle) * 1.0f;
+		path.push_back({glm::vec3(std::cos(angle) * 6.0f, height, std::sin(angle) * 6.0f), glm::vec3(0.0f)});
+	}
+	return path;
+}
+
+std::vector<BenchWaypoint> loadPath(const std::string& file)
+{
+	std::ifstream in(file);
+	if (!in) throw std::runtime_error("could not open path file " + file);
+
+	std::vector<BenchWaypoint> path;
+	std::string line;
+	while (std::getline(in, line))
+	{
+		if (line.empty() || line[0] == '#') continue;
+		std::istringstream fields(line);
+		BenchWaypoint waypoint;
+		if (!(fields >> waypoint.position.x >> waypoint.position.y >> waypoint.position.z >> waypoint.target.x >>
+		      waypoint.target.y >> waypoint.target.z))
+			throw std::runtime_error("malformed waypoint in " + file + ": " + line);
+		path.push_back(waypoint);
+	}
+	if (path.empty()) throw std::runtime_error("no waypoints in " + file);
+	return path;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	BenchComponent config;
+	config.scenePath = "assets/models/cube.gltf";
+	config.reportPath = "halcyon_bench.json";
+	uint32_t width = 1920;
+	uint32_t height = 1080;
+	float fixedDeltaTime = 1.0f / 60.0f;
+
+	try
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string_view arg = argv[i];
+			if (arg == "--help" || arg == "-h")
+			{
+				printUsage();
+				return EXIT_SUCCESS;
+			}
+			if (i + 1 >= argc) throw std::runtime_error("missing value for " + std::string(arg));
+			const std::string value = argv[++i];
+
+			if (arg == "--scene")
+				config.scenePath = value;
+			else if (arg == "--frames")
+				config.measuredFrames = static_cast<uint32_t>(std::stoul(value));
+			else if (arg == "--warmup")
+				config.warmupFrames = static_cast<uint32_t>(std::stoul(value));
+			else if (arg == "--width")
+				width = static_cast<uint32_t>(std::stoul(value));
+			else if (arg == "--height")
+				height = static_cast<uint32_t>(std::stoul(value));
+			else if (arg == "--dt")
+				fixedDeltaTime = std::stof(value);
+			else if (arg == "--path")
+				config.path = loadPath(value);
+			else if (arg == "--out")
+				config.reportPath = value;
+			else
+				throw std::runtime_error("unknown option " + std::string(arg));
+		}
+		if (config.measuredFrames == 0 || width == 0 || height == 0 || fixedDeltaTime <= 0.0f)
+			throw std::runtime_error("frames, width, height and dt must be positive");
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "halcyon_bench: " << e.what() << std::endl;
+		printUsage();
+		return EXIT_FAILURE;
+	}
+	if (config.path.empty()) config.path = defaultPath();
+
+	BenchInit bench(std::move(config), fixedDeltaTime);
+	return App::createHeadless(width, height).addStartUp(bench).run();
+}
@@ -6,6 +6,7 @@
 
 #include <PlatformCore/PlatformContexts.hpp>
 #include <GraphicsCore/GraphicsContexts.hpp>
+#include <GraphicsCore/Components/CameraLatchComponent.hpp>
 
 
 
@@ -26,11 +27,56 @@ void ControlSystem::cursorDisableToggle(Window* window)
 	}
 }
 
+void ControlSystem::applyMouseLook(GeneralManager& gm)
+{
+	if (!cursorDisable) return;
+
+	CursorPositionComponent* cursorPositionState = gm.getContextComponent<InputDataContext, CursorPositionComponent>();
+	WindowComponent* windowInstance = gm.getContextComponent<MainWindowContext, WindowComponent>();
+	GlobalTransformComponent* mainCameraTransform =
+	    gm.getContextComponent<MainCameraContext, GlobalTransformComponent>();
+	ControlComponent* mainCameraControl = gm.getContextComponent<MainCameraContext, ControlComponent>();
+
+	constexpr float sensitivity = 0.1f;
+	float xoffset = static_cast<float>((cursorPositionState->mousePositionX - lastMousePositionX) * sensitivity);
+	float yoffset = static_cast<float>((cursorPositionState->mousePositionY - lastMousePositionY) * sensitivity);
+
+	// Prevent huge jumps the first frame or when toggling
+	if (xoffset > 50.0f || xoffset < -50.0f || yoffset > 50.0f || yoffset < -50.0f)
+	{
+		xoffset = 0.0f;
+		yoffset = 0.0f;
+	}
+
+	xoffset *= mainCameraControl->mouseSensitivity;
+	yoffset *= mainCameraControl->mouseSensitivity;
+	mainCameraTransform->rotateGlobal(glm::radians(-xoffset), glm::vec3(0.0f, 1.0f, 0.0f));
+	mainCameraTransform->rotateLocal(glm::radians(-yoffset), glm::vec3(1.0f, 0.0f, 0.0f));
+
+	int width, height;
+	windowInstance->windowInstance->getWindowSize(&width, &height);
+	double centerX = width / 2.0;
+	double centerY = height / 2.0;
+
+	windowInstance->windowInstance->setCursorPos(centerX, centerY);
+	lastMousePositionX = centerX;
+	lastMousePositionY = centerY;
+	cursorPositionState->mousePositionX = centerX;
+	cursorPositionState->mousePositionY = centerY;
+}
+
+void ControlSystem::onRegistered(GeneralManager& gm)
+{
+	std::cout << "ControlSystem registered!" << std::endl;
+	// With late latching on, mouse look is re-applied just before submit from the freshest cursor position
+	gm.getContextComponent<MainCameraContext, CameraLatchComponent>()->resample = [this](GeneralManager& gm)
+	{ applyMouseLook(gm); };
+}
+
 void ControlSystem::update(GeneralManager& gm)
 {
 	float deltaTime = gm.getContextComponent<DeltaTimeContext, DeltaTimeComponent>()->deltaTime;
 	KeyboardStateComponent* keyboardState = gm.getContextComponent<InputDataContext, KeyboardStateComponent>();
-	CursorPositionComponent* cursorPositionState = gm.getContextComponent<InputDataContext, CursorPositionComponent>();
 	WindowComponent* windowInstance = gm.getContextComponent<MainWindowContext, WindowComponent>();
 	CameraComponent* mainCamera = gm.getContextComponent<MainCameraContext, CameraComponent>();
 	GlobalTransformComponent* mainCameraTransform =
@@ -55,33 +101,7 @@ void ControlSystem::update(GeneralManager& gm)
 	}
 	if (cursorDisable)
 	{
-		//=== Mouse ===
-		constexpr float sensitivity = 0.1f;
-		float xoffset = static_cast<float>((cursorPositionState->mousePositionX - lastMousePositionX) * sensitivity);
-		float yoffset = static_cast<float>((cursorPositionState->mousePositionY - lastMousePositionY) * sensitivity);
-
-		// Prevent huge jumps the first frame or when toggling
-		if (xoffset > 50.0f || xoffset < -50.0f || yoffset > 50.0f || yoffset < -50.0f)
-		{
-			xoffset = 0.0f;
-			yoffset = 0.0f;
-		}
-
-		xoffset *= mainCameraControl->mouseSensitivity;
-		yoffset *= mainCameraControl->mouseSensitivity;
-		mainCameraTransform->rotateGlobal(glm::radians(-xoffset), glm::vec3(0.0f, 1.0f, 0.0f));
-		mainCameraTransform->rotateLocal(glm::radians(-yoffset), glm::vec3(1.0f, 0.0f, 0.0f));
-
-		int width, height;
-		windowInstance->windowInstance->getWindowSize(&width, &height);
-		double centerX = width / 2.0;
-		double centerY = height / 2.0;
-
-		windowInstance->windowInstance->setCursorPos(centerX, centerY);
-		lastMousePositionX = centerX;
-		lastMousePositionY = centerY;
-		cursorPositionState->mousePositionX = centerX;
-		cursorPositionState->mousePositionY = centerY;
+		applyMouseLook(gm);
 
 		//=== Keyboard ===
 		float velocity = mainCameraControl->movementSpeed * deltaTime;
@@ -22,13 +22,12 @@ private:
 	double lastMousePositionY = 0.0;
 
 	void cursorDisableToggle(Window* window);
+	// Turns the cursor's offset from the window center into camera rotation, then recenters the cursor
+	void applyMouseLook(GeneralManager& gm);
 
 public:
 	void update(GeneralManager& gm) override;
-	void onRegistered(GeneralManager& gm) override
-	{
-		std::cout << "ControlSystem registered!" << std::endl;
-	};
+	void onRegistered(GeneralManager& gm) override;
 	void onShutdown(GeneralManager& gm) override
 	{
 		std::cout << "ControlSystem shutdown!" << std::endl;
@@ -3,13 +3,21 @@
 #include "HalcyonExport.hpp"
 #include <Orhescyon/GeneralManager.hpp>
 
+#include <memory>
+
 #include "DeletionQueue.hpp"
+#include "FrameProfiler.hpp"
 #include "IStartUp.hpp"
+#include "TaskScheduler.hpp"
+#include "PlatformCore/WindowDesc.hpp"
+#include "PhysicsCore/Components/PhysSettingsComponent.hpp"
 
 class HALCYON_API App
 {
 public:
 	App();
+	explicit App(const WindowDesc& windowDesc, const PhysSettingsComponent& physSettings = {},
+	             const TaskSchedulerDesc& schedulerDesc = {});
 	~App();
 
 	App(App&&) = default;
@@ -20,10 +28,15 @@ public:
 
 	int run();
 	static App create();
+	// No window or swap chain; the frame loop runs until something calls Window::setShouldClose
+	static App createHeadless(uint32_t width, uint32_t height);
 	App& addStartUp(IStartUp& startUp);
 
 
 private:
 	Orhescyon::GeneralManager gm;
+	// Before deletionQueue, so the workers outlive everything the queue destroys
+	std::unique_ptr<TaskScheduler> scheduler;
 	DeletionQueue deletionQueue;
+	std::unique_ptr<FrameProfiler> profiler;
 };
\ No newline at end of file
@@ -4,3 +4,7 @@
 struct HALCYON_API AudioManagerContext
 {
 };
+
+struct HALCYON_API AudioListenerContext
+{
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include <cstdint>
+
+enum class SoundLoadMode : uint8_t
+{
+	Preload, // Decoded to PCM once at load and shared by every voice: short clips played often
+	Stream   // Decoded from disk while playing, one decoder per voice: music and ambience
+};
+
+struct HALCYON_API SoundHandle
+{
+	int id = -1;
+};
+
+// One play of a sound. Goes stale once its voice is reused for another play, after which calls on it do nothing.
+struct HALCYON_API VoiceHandle
+{
+	int sound = -1;
+	uint32_t voice = 0;
+	uint32_t generation = 0;
+};
+
+struct HALCYON_API AudioMetrics
+{
+	uint32_t sounds = 0;
+	uint32_t streamedSounds = 0;
+	uint32_t voices = 0; // Allocated across every sound's pool
+	uint32_t playingVoices = 0;
+	uint64_t voiceSteals = 0; // Plays that cut off the oldest voice of a full pool
+	uint64_t failedPlays = 0;
+	uint64_t decodedBytes = 0; // PCM held for preloaded sounds
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include <cstdint>
+
+// Settings of the listener, which sits on the main camera
+struct HALCYON_API AudioListenerComponent
+{
+	float volume = 1.0f;
+	// Sources mixed at once; the rest are virtualized, so mixing cost stays flat however many there are
+	uint32_t maxRealVoices = 32;
+	// Sources quieter than this are virtualized even when voices are free
+	float minAudibleGain = 0.001f;
+	float speedOfSound = 343.3f; // Units per second
+	float dopplerFactor = 1.0f;  // 0 turns doppler off
+
+	// Written by AudioSpatialSystem every frame
+	uint32_t realSources = 0;
+	uint32_t virtualSources = 0;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "AudioCore/AudioHandles.hpp"
+#include <glm/ext/vector_float3.hpp>
+
+// A sound emitted from its entity's GlobalTransformComponent, heard by the main camera. Only the most audible
+// sources hold a real voice; the rest are virtual, their place in the sound kept by time alone, and pick up from
+// there once they are audible enough again.
+struct HALCYON_API AudioSourceComponent
+{
+	SoundHandle sound; // Loaded through AudioManager
+	float volume = 1.0f;
+	bool loop = true;
+	bool playing = true; // Cleared by AudioSpatialSystem once a one-shot has played through
+	// Inverse distance rolloff: full volume within minDistance, no quieter past maxDistance
+	float minDistance = 1.0f;
+	float maxDistance = 100.0f;
+	float rolloff = 1.0f;
+	float dopplerFactor = 1.0f;
+	float priority = 1.0f; // Scales audibility when ranking sources for the real voices
+
+	// === AudioSpatialSystem state ===
+	VoiceHandle voice;   // Valid while real
+	float cursor = 0.0f; // Seconds into the sound
+	float audibility = 0.0f;
+	glm::vec3 lastPosition{0.0f};
+	bool hasLastPosition = false;
+};
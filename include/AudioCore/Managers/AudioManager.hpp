@@ -2,16 +2,49 @@
 
 #include <string>
 #include "HalcyonExport.hpp"
+#include "AudioCore/AudioHandles.hpp"
 
+// Sound bank over miniaudio. Sounds are loaded once and played through a pool of voices each, so a play costs no file
+// I/O, decoding or allocation once the pool has grown. Main thread only. Without an audio device everything still
+// succeeds but nothing plays.
 class HALCYON_API AudioManager
 {
 public:
 	AudioManager();
 	~AudioManager();
 
-	void play(const std::string& filepath);
+	AudioManager(const AudioManager&) = delete;
+	AudioManager& operator=(const AudioManager&) = delete;
+
+	// Loading the same path again returns the same handle. `maxVoices` caps how many plays of it overlap; past that
+	// the oldest is cut off. Throws std::runtime_error when the file cannot be opened or decoded.
+	SoundHandle load(const std::string& filepath, SoundLoadMode mode = SoundLoadMode::Preload, uint32_t maxVoices = 8);
+	// Stops its voices and frees its PCM; the handle must not be used afterwards
+	void unload(SoundHandle sound);
+
+	// False for an invalid handle or an unloaded sound, which the queries below throw for
+	bool isLoaded(SoundHandle sound) const;
+	uint32_t maxVoices(SoundHandle sound) const;
+	// Seconds; 0 when the length is not known up front, as for some streamed formats
+	float length(SoundHandle sound) const;
+
+	// Invalid handle (sound -1) when no voice could be started. Starts `startSeconds` into the sound, centred and at
+	// its own pitch.
+	VoiceHandle play(SoundHandle sound, float volume = 1.0f, bool loop = false, float startSeconds = 0.0f);
+	// Loads `filepath` preloaded on first use
+	VoiceHandle play(const std::string& filepath);
+
+	void stop(VoiceHandle voice);
+	void setVolume(VoiceHandle voice, float volume);
+	// Pan from -1 (left) to 1 (right); pitch as a playback rate multiplier
+	void setSpatial(VoiceHandle voice, float volume, float pan, float pitch);
+	bool isPlaying(VoiceHandle voice) const;
+	// Seconds into the sound; 0 for a stale handle
+	float cursor(VoiceHandle voice) const;
+
+	AudioMetrics metrics() const;
 
 private:
 	struct Impl;
 	Impl* pImpl;
-};
\ No newline at end of file
+};
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+#include <Orhescyon/GeneralManager.hpp>
+#include <Orhescyon/Systems/SystemCore.hpp>
+#include <glm/ext/vector_float3.hpp>
+
+#include "AudioCore/Components/AudioSourceComponent.hpp"
+#include "GraphicsCore/Components/GlobalTransformComponent.hpp"
+
+// Spatializes every AudioSourceComponent against the main camera once a frame: attenuation, panning and doppler are
+// worked out here for all sources and applied to their voices as volume, pan and pitch. Only the most audible
+// AudioListenerComponent::maxRealVoices sources hold a voice; the rest are virtual and cost a cursor update.
+using Orhescyon::GeneralManager;
+class HALCYON_API AudioSpatialSystem
+    : public Orhescyon::SystemCore<AudioSpatialSystem, GlobalTransformComponent, AudioSourceComponent>
+{
+public:
+	struct HALCYON_API Emitter
+	{
+		AudioSourceComponent* source;
+		float gain;
+		float pan;
+		float pitch;
+		bool real; // Picked for a voice this frame
+	};
+
+	void update(GeneralManager& gm) override;
+	void onRegistered(GeneralManager& gm) override;
+	void onShutdown(GeneralManager& gm) override;
+	void onEntityUnsubscribed(Orhescyon::Entity entity, GeneralManager& gm) override;
+	std::string_view getSystemManagerName() const override
+	{
+		return "audio";
+	}
+
+private:
+	// Rebuilt every frame; kept to reuse their capacity
+	std::vector<Emitter> _emitters;
+	std::vector<uint32_t> _ranked;
+	std::unordered_map<int, uint32_t> _voicesPerSound;
+
+	glm::vec3 _lastListenerPosition{0.0f};
+	bool _hasListenerPosition = false;
+};
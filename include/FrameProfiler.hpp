@@ -0,0 +1,100 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Orhescyon/GeneralManager.hpp>
+
+// Timing that does not depend on Tracy: CPU scopes and GPU render graph passes are recorded into a ring buffer per
+// name, summarized on demand and dumpable to CSV/JSON from any build. Recording is thread-safe.
+class HALCYON_API FrameProfiler
+{
+public:
+	static constexpr size_t kDefaultHistoryLength = 256;
+
+	enum class Domain
+	{
+		Cpu,
+		Gpu,
+	};
+
+	struct Stats
+	{
+		std::string name;
+		Domain domain = Domain::Cpu;
+		uint32_t sampleCount = 0;
+		float lastMs = 0.0f;
+		float avgMs = 0.0f;
+		float minMs = 0.0f;
+		float maxMs = 0.0f;
+		float p50Ms = 0.0f;
+		float p95Ms = 0.0f;
+		float p99Ms = 0.0f;
+	};
+
+	void record(Domain domain, std::string_view name, float ms);
+	// One entry per series over its retained history: CPU first, then GPU, each in name order.
+	std::vector<Stats> collectStats() const;
+	// Retained samples of one series, oldest first.
+	std::vector<float> history(Domain domain, std::string_view name) const;
+	void clear();
+	// Samples retained per series. Clears all series; a benchmark sets it to its frame count so the statistics
+	// cover the whole run.
+	void setHistoryLength(size_t length);
+	size_t getHistoryLength() const;
+	// Bumped by clear() and setHistoryLength(). GPU timings arrive frames after they were measured, so their
+	// recorder tags them with the window current at submit and drops those from an earlier one.
+	uint64_t getWindow() const { return window.load(std::memory_order_relaxed); }
+
+	bool dumpCsv(const std::filesystem::path& path) const;
+	bool dumpJson(const std::filesystem::path& path) const;
+	// JSON when the extension is .json, CSV otherwise.
+	bool dump(const std::filesystem::path& path) const;
+
+	void setEnabled(bool value) { enabled.store(value, std::memory_order_relaxed); }
+	bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+private:
+	struct Series
+	{
+		std::vector<float> samples; // Ring of historyLength entries
+		size_t next = 0;
+		size_t count = 0;
+	};
+	using SeriesMap = std::map<std::string, Series, std::less<>>;
+
+	static Stats summarize(const std::string& name, Domain domain, const Series& series);
+	static std::vector<float> ordered(const Series& series);
+
+	mutable std::mutex mutex;
+	SeriesMap cpuSeries;
+	SeriesMap gpuSeries;
+	size_t historyLength = kDefaultHistoryLength;
+	std::atomic<uint64_t> window{0};
+	std::atomic<bool> enabled{true};
+};
+
+// Records the wall time of the enclosing scope under `name` in the profiler registered on the GeneralManager.
+// Does nothing when none is registered or it is disabled.
+class HALCYON_API CpuProfileScope
+{
+public:
+	CpuProfileScope(Orhescyon::GeneralManager& gm, const char* name);
+	~CpuProfileScope();
+
+	CpuProfileScope(const CpuProfileScope&) = delete;
+	CpuProfileScope& operator=(const CpuProfileScope&) = delete;
+
+private:
+	FrameProfiler* profiler = nullptr;
+	const char* name;
+	std::chrono::steady_clock::time_point start;
+};
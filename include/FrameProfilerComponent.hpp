@@ -0,0 +1,12 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "FrameProfiler.hpp"
+
+struct HALCYON_API FrameProfilerComponent
+{
+	FrameProfiler* profiler = nullptr;
+
+	FrameProfilerComponent() = default;
+	FrameProfilerComponent(FrameProfiler* p) : profiler(p) {}
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include <Orhescyon/GeneralManager.hpp>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <functional>
+
+// Main camera state shared between CameraMatrixSystem and the late latch in FrameEndSystem.
+struct HALCYON_API CameraLatchComponent
+{
+	// Run by the late latch after input has been re-read and before the camera block is rebuilt. The application
+	// re-applies whatever input should move the camera (mouse look, head tracking); unset, only the transform as
+	// it stands at submit is re-latched.
+	std::function<void(Orhescyon::GeneralManager&)> resample;
+
+	// Unjittered view-projections for motion vectors: the one the current block was built against and the one it
+	// renders with. The late latch replaces the latter, so the next frame's motion vectors start from it.
+	glm::mat4 prevViewProj{1.0f};
+	glm::mat4 viewProj{1.0f};
+	uint32_t frameNumber = 0;
+	bool valid = false;
+};
@@ -6,4 +6,5 @@ struct HALCYON_API DeltaTimeComponent
 	float deltaTime = 0.0f;
 	float totalTime = 0.0f;
 	float lastFrameTime = 0.0f;
+	float fixedDeltaTime = 0.0f; // When > 0 every frame advances by exactly this, regardless of wall time
 };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "HalcyonExport.hpp"
+#include "GraphicsCore/VulkanConst.hpp"
 #include <vulkan/vulkan_raii.hpp>
 #include <Orhescyon/Entitys/EntityManager.hpp>
 
@@ -16,6 +17,18 @@ struct HALCYON_API GraphicsSettingsComponent
 	bool enableFxaa = true;
 	bool enableBloom = true;
 	bool enableVignette = true;
+	// Single compute pass for god rays, bloom composite, exposure, tone mapping and vignette, plus tiled FXAA
+	bool enableFusedPostProcess = false;
+	// Temporal AA; with renderScale < 1 the scene renders at that fraction of the output and TAA upscales it
+	bool enableTaa = false;
+	float renderScale = 1.0f;
+	float taaBlendFactor = 0.1f; // Weight of the current frame in the history blend
+	// Dynamic resolution: render-scaled streams stay allocated at the output size and the scene renders into a
+	// corner of them, scaled each frame so the measured GPU frame time tracks the target. Overrides renderScale.
+	bool enableDynamicResolution = false;
+	float dynamicResolutionTargetMs = 16.6f;
+	float dynamicResolutionMinScale = 0.5f;
+	float dynamicResolutionScale = 1.0f; // Controller output, used from the next frame on
 	float bloomThreshold = 1.0f;
 	float bloomKnee = 0.3f;
 	float bloomIntensity = 0.08f;
@@ -27,6 +40,16 @@ struct HALCYON_API GraphicsSettingsComponent
 	float saturation = 1.0f;
 	float temperature = 0.0f;
 	float tint = 0.0f;
+	// Frame pacing. presentMode falls back to FIFO where the surface lacks it. framesInFlight (1 to
+	// MAX_FRAMES_IN_FLIGHT) bounds how many frames the CPU may queue ahead of the GPU; fewer means less latency.
+	vk::PresentModeKHR presentMode = vk::PresentModeKHR::eMailbox;
+	uint32_t framesInFlight = MAX_FRAMES_IN_FLIGHT;
+	float frameRateLimit = 0.0f; // Frames per second, 0 = unlimited
+	// Re-read input and rewrite the main camera block just before submit, see CameraLatchComponent
+	bool enableLateLatch = false;
+	// Texture streaming: applies to models loaded after it is enabled
+	bool enableTextureStreaming = false;
+	uint32_t textureStreamingBudgetMB = 1024;
 	//bool enableToneMapping = true;
 	//bool enableGammaCorrection = true;
 	vk::SampleCountFlagBits msaaSamples = vk::SampleCountFlagBits::e4;
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "GraphicsCore/Resources/Factories/MipGenerator.hpp"
+#include "GraphicsCore/Resources/Factories/TextureUploadBatch.hpp"
+
+struct HALCYON_API MipGeneratorComponent
+{
+	MipGenerator* mipGenerator;
+	TextureUploadBatch* uploadBatch; // Shared by every model load, retired by FrameBeginSystem
+
+	MipGeneratorComponent(MipGenerator* generator, TextureUploadBatch* batch)
+	    : mipGenerator(generator), uploadBatch(batch)
+	{
+	}
+};
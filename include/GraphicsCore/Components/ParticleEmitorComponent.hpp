@@ -2,10 +2,12 @@
 
 #include "HalcyonExport.hpp"
 #include <glm/glm.hpp>
+#include <cstdint>
 
 struct HALCYON_API ParticleEmitorComponent
 {
 	bool active = true;
+	bool sortByDepth = false; // Draw back to front; costs a GPU sort of all alive particles while any emiter uses it
 	uint32_t spawnCount = 10;
 	float emissionAccumulator;
 	glm::vec3 directionalVector = {0.0f, 1.0f, 0.0f};
@@ -15,4 +17,18 @@ struct HALCYON_API ParticleEmitorComponent
 	glm::vec2 scale = {1.0f, 1.0f};       // 1-min, 2-max
 	glm::vec4 colorStart = {1.0f, 1.0f, 1.0f, 1.0f};
 	glm::vec4 colorEnd = {1.0f, 1.0f, 1.0f, 1.0f};
+
+	// Screen-space collision against the depth prepass; only surfaces visible on screen are hit
+	bool depthCollision = false;
+	float restitution = 0.5f; // Fraction of the normal speed kept on bounce
+	float friction = 0.1f;    // Fraction of the tangential speed lost on contact
+
+	// Bounding sphere around the emitter for frustum culling; 0 derives it from spawn radius, speed, lifetime, scale
+	float boundsRadius = 0.0f;
+	// While the bounds are off screen the emitter spawns and simulates only once per this many seconds, with the
+	// accumulated time. 0 never throttles.
+	float offscreenTickInterval = 0.25f;
+	float pendingDeltaTime = 0.0f;
+
+	uint32_t gpuSlot = UINT32_MAX; // Slot in the GPU emiter table, assigned by GPUParticlesSystem
 };
\ No newline at end of file
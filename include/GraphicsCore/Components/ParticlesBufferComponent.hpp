@@ -9,6 +9,9 @@ struct HALCYON_API ParticlesBufferComponent
 	BufferHandle indirectBuffer;
 	BufferHandle aliveIndicesBufferA;
 	BufferHandle aliveIndicesBufferB;
-	BufferHandle dispatchBuffer;
-	BufferHandle emitersData;
+	BufferHandle dispatchBuffer; // Per frame in flight, SpawnDispatchCommand
+	BufferHandle emitersData;    // Per frame in flight, MAX_NUMBER_EMITERS slots
+	BufferHandle sortBuffer;
+	BufferHandle spawnRanges; // Per frame in flight, EmiterSpawnRange list
+	bool depthSortRequested = false; // Set by GPUParticlesSystem when an active emiter sorts by depth
 };
\ No newline at end of file
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "GraphicsCore/Resources/Managers/TextureStreamer.hpp"
+
+struct HALCYON_API TextureStreamerComponent
+{
+	TextureStreamer* textureStreamer;
+
+	TextureStreamerComponent(TextureStreamer* streamer) : textureStreamer(streamer) {}
+};
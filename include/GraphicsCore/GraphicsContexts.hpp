@@ -43,6 +43,9 @@ class HALCYON_API FrameImageContext
 class HALCYON_API TextureManagerContext
 {
 };
+class HALCYON_API TextureStreamerContext
+{
+};
 class HALCYON_API VMAllocatorContext
 {
 };
@@ -84,4 +87,7 @@ class HALCYON_API ExposureBufferContext
 };
 class HALCYON_API ParticlesBufferContext
 {
+};
+class HALCYON_API MipGeneratorContext
+{
 };
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "GraphicsCore/Components/GraphicsSettingsComponent.hpp"
+
+// Stream the scene passes render HDR color into. With TAA or dynamic resolution it is the render-scaled "SceneColor"
+// that the TAA resolve or the upscale pass writes into the full-resolution "MainColor"; otherwise the scene goes
+// straight to "MainColor".
+inline const char* sceneColorStream(const GraphicsSettingsComponent& settings)
+{
+	return settings.enableTaa || settings.enableDynamicResolution ? "SceneColor" : "MainColor";
+}
+
+// Fraction of the output extent the scene passes render at this frame.
+inline float activeRenderScale(const GraphicsSettingsComponent& settings)
+{
+	if (settings.enableDynamicResolution) return settings.dynamicResolutionScale;
+	return settings.enableTaa ? settings.renderScale : 1.0f;
+}
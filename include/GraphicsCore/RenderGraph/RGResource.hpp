@@ -23,6 +23,7 @@ enum class RGResourceUsage
 	ShaderRead,
 	StorageReadWrite,
 	Present,
+	TransferSrc, // Terminal use of an offscreen output: left ready to be copied out instead of presented
 };
 
 // A single read or write declaration for a resource in a pass
@@ -56,6 +57,7 @@ struct HALCYON_API RGImageDesc
 	uint32_t mipLevels = 1;
 	vk::ImageUsageFlags extraUsage = {}; // e.g. eStorage for compute UAV writes
 	std::optional<SamplerDesc> samplerOverride;
+	bool renderScaled = false; // Sized from the render extent (see RenderGraph::setRenderScale) instead of the output
 };
 
 // Unified resource entry — covers both imported and transient resources
@@ -58,6 +58,22 @@ public:
 	                             vk::ImageAspectFlags aspect,
 	                             vk::ImageLayout currentLayout = vk::ImageLayout::eUndefined);
 	void handleResize(uint32_t newWidth, uint32_t newHeight);
+	// Fraction of the output extent that renderScaled streams are allocated at (temporal upscaling input).
+	// Reallocates those streams when it changes.
+	void setRenderScale(float scale);
+	float getRenderScale() const { return renderScale; }
+	vk::Extent2D getRenderExtent() const;
+	static vk::Extent2D scaleExtent(vk::Extent2D extent, float scale);
+	// Dynamic resolution: renderScaled streams stay allocated at the output extent and passes render into the
+	// getRenderExtent() corner of them, so setRenderScale changes no allocation. Toggling it reallocates once.
+	void setDynamicResolution(bool enabled);
+	bool isDynamicResolution() const { return dynamicResolution; }
+	// Size renderScaled streams are allocated at: the output under dynamic resolution, else the render extent.
+	vk::Extent2D getRenderAllocationExtent() const;
+	// GPU time between the first and last command of the most recently completed execute(), read back from
+	// timestamps without waiting. 0 until a result is available or when the graphics queue has no timestamps.
+	// Per-pass times go to the FrameProfiler registered on the GeneralManager, under the pass names.
+	float getGpuFrameTimeMs() const { return gpuFrameTimeMs; }
 
 	void declareLogicalStream(const std::string& name, const RGImageDesc& desc);
 	void setTerminalOutput(const std::string& logicalName, const std::string& physicalName);
@@ -75,7 +91,8 @@ public:
 	// executeFn - lambda with draw/dispatch commands. Receives primary cmd buffer.
 	//             Do NOT call beginRendering/endRendering inside — RG handles that.
 	// updateDescriptorsFn - optional lambda to update descriptor sets before execution. Receives the entire graph and
-	// the pass.
+	// the pass. Runs once per frame-in-flight slot after a change and must only write copy getUpdateFrame() of
+	// per-frame sets; writes are batched and flushed together.
 	void addPass(const std::string& name, const RGPassDesc& desc, std::vector<RGResourceAccess> reads,
 	             std::vector<RGResourceAccess> writes, std::function<void(vk::raii::CommandBuffer& cmd)> executeFn,
 	             std::function<void(const RenderGraph& rg, const RGPass& pass)> updateDescriptorsFn = nullptr);
@@ -99,12 +116,21 @@ public:
 	const RGImageDesc& getDesc(RGResourceHandle handle) const;
 	uint32_t getMipLevels(RGResourceHandle handle) const;
 	vk::Extent2D getMipExtent(RGResourceHandle handle, uint32_t mip) const;
+	// Part of the mip that holds this frame's content; smaller than getMipExtent for renderScaled streams under
+	// dynamic resolution.
+	vk::Extent2D getActiveExtent(RGResourceHandle handle, uint32_t mip) const;
 	RGResourceHandle getHandle(const std::string& name) const;
+	// Frame-in-flight slot whose descriptor copies are being refreshed; valid inside updateDescriptorsFn.
+	uint32_t getUpdateFrame() const { return updateFrame; }
 
 private:
 	void allocateTransientImage(RGResourceEntry& res);
 	void destroyTransientImage(RGResourceEntry& res);
 	void createSampler(RGResourceEntry& res);
+	vk::Extent2D targetExtent(const RGImageDesc& desc) const;
+	static vk::Extent2D sizedExtent(const RGImageDesc& desc, vk::Extent2D base);
+	void createTimestampPool();
+	void readFrameTimestamps(uint32_t frame);
 
 	static vk::ImageLayout usageToLayout(RGResourceUsage usage);
 	static vk::AccessFlags2 usageToAccessMask(RGResourceUsage usage);
@@ -114,9 +140,23 @@ private:
 	VulkanDevice& vulkanDevice;
 	VmaAllocator allocator;
 	Orhescyon::GeneralManager* gm;
-	bool needsDescriptorUpdate = false;
+	static constexpr uint32_t kAllFramesStale = ~0u;
+	uint32_t staleDescriptorFrames = 0; // Bit per frame-in-flight slot whose descriptor copies are out of date
+	uint32_t updateFrame = 0;
 	uint32_t currentWidth = 0;
 	uint32_t currentHeight = 0;
+	float renderScale = 1.0f;
+	bool dynamicResolution = false;
+
+	// Per frame-in-flight slot: one timestamp before the first pass, one after each timed pass and a final one.
+	// Passes past the query budget are left out of the per-pass times but still count towards the frame.
+	static constexpr uint32_t kTimestampsPerFrame = 256;
+	vk::raii::QueryPool timestampPool = nullptr;
+	float timestampPeriodNs = 0.0f;
+	uint32_t pendingTimestampFrames = 0; // Bit per slot whose queries were written and not read back yet
+	std::vector<std::vector<std::string>> timedPassNames; // Per slot, in query order
+	std::vector<uint64_t> timestampWindows; // Per slot, FrameProfiler::getWindow() when its queries were written
+	float gpuFrameTimeMs = 0.0f;
 
 	std::unordered_map<std::string, RGImageDesc> logicalStreams;
 	std::unordered_map<std::string, std::string> terminalOutputs;
@@ -3,8 +3,12 @@
 #include "HalcyonExport.hpp"
 #include "GraphicsCore/VulkanConst.hpp"
 #include "GraphicsCore/Resources/Managers/ResourceHandles.hpp"
+#include <glm/glm.hpp>
 
 struct HALCYON_API MeshInfoComponent
 {
 	MeshHandle mesh;
-};
\ No newline at end of file
+	// Model matrix uploaded last frame, so motion vectors survive the per-frame repacking of the transform buffer
+	glm::mat4 previousModel{1.0f};
+	bool hasPreviousModel = false;
+};
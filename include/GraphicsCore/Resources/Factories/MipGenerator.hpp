@@ -0,0 +1,54 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "GraphicsCore/ImageDesc.hpp"
+#include "GraphicsCore/Resources/Managers/ResourceHandles.hpp"
+#include "GraphicsCore/VulkanDevice.hpp"
+#include <vulkan/vulkan_raii.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+class DescriptorManager;
+class PipelineManager;
+
+// Compute mip-chain generation for RGBA8 textures (shaders/mip_downsample.slang). Unlike blits it filters
+// sRGB in linear space and renormalizes normal maps, and a whole batch of textures shares each dispatch pass.
+class HALCYON_API MipGenerator
+{
+public:
+	// Textures per record() call; each one holds a descriptor set of the group until its command buffer completes.
+	static constexpr uint32_t maxBatchSize = 32;
+
+	struct Request
+	{
+		vk::Image image;
+		vk::Format format;
+		uint32_t width;
+		uint32_t height;
+		uint32_t mipLevels;
+		bool isNormalMap = false;
+	};
+
+	MipGenerator(VulkanDevice& vulkanDevice, DescriptorManager& descriptorManager, PipelineManager& pipelineManager);
+
+	static bool supports(vk::Format format, uint32_t mipLevels);
+	// Adds the storage usage and the create flags that let an sRGB image take a UNORM storage view.
+	static void prepareImageDesc(ImageDesc& desc);
+
+	// Expects mip 0 of every image in TransferDstOptimal with the write already recorded; leaves all levels
+	// in ShaderReadOnlyOptimal. The returned views and `sets` must outlive the command buffer's execution.
+	std::vector<vk::raii::ImageView> record(vk::raii::CommandBuffer& cmd, std::span<const Request> requests,
+	                                        DSetHandle sets);
+
+	// A group of maxBatchSize sets for one record(), reused once released. Groups are allocated on demand and
+	// never returned to the pool, so callers bound how many they hold at once.
+	DSetHandle acquireSets();
+	void releaseSets(DSetHandle sets);
+
+private:
+	VulkanDevice& vulkanDevice;
+	DescriptorManager& descriptorManager;
+	PipelineManager& pipelineManager;
+	std::vector<DSetHandle> _freeSets; // Groups of maxBatchSize "mipGenSet" copies, rewritten on every record()
+};
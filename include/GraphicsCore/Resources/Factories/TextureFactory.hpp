@@ -13,6 +13,8 @@ class TextureManager;
 class DescriptorManager;
 struct BindlessTextureDSetComponent;
 struct VulkanDevice;
+struct ktxTexture2;
+class TextureUploadBatch;
 
 // Composes TextureManager primitives (allocate/image/view/sampler) into common texture operations.
 class HALCYON_API TextureFactory
@@ -26,15 +28,29 @@ public:
 	static TextureHandle createOffscreenImage(TextureManager& textureManager, uint32_t width, uint32_t height,
 	                                          vk::Format format);
 	static TextureHandle createShadowMap(TextureManager& textureManager, uint32_t width, uint32_t height);
+	// With uploadBatch the mips come from the compute downsampler and the texture is ready for work submitted
+	// after the batch's submit(); without it the upload and blit mips run in their own blocking submit.
 	static TextureHandle createBindlessTexture(TextureManager& textureManager, VulkanDevice& vulkanDevice,
 	                                           VmaAllocator allocator, const char* texturePath, int texWidth,
 	                                           int texHeight, const unsigned char* pixels,
 	                                           BindlessTextureDSetComponent& dSetComponent,
 	                                           DescriptorManager& descriptorManager,
-	                                           vk::Format format = vk::Format::eR8G8B8A8Srgb);
+	                                           vk::Format format = vk::Format::eR8G8B8A8Srgb,
+	                                           TextureUploadBatch* uploadBatch = nullptr, bool isNormalMap = false);
 	static TextureHandle createBindlessTextureFromKtx(TextureManager& textureManager, VulkanDevice& vulkanDevice,
 	                                                  VmaAllocator allocator, const char* texturePath,
 	                                                  const unsigned char* ktxData, size_t dataSize,
 	                                                  BindlessTextureDSetComponent& dSetComponent,
 	                                                  DescriptorManager& descriptorManager, bool isSrgb);
+	// Same as above for a texture that was already parsed/transcoded; ktxTex stays owned by the caller.
+	static TextureHandle createBindlessTextureFromKtx(TextureManager& textureManager, VulkanDevice& vulkanDevice,
+	                                                  VmaAllocator allocator, const char* texturePath,
+	                                                  ktxTexture2* ktxTex,
+	                                                  BindlessTextureDSetComponent& dSetComponent,
+	                                                  DescriptorManager& descriptorManager);
+
+private:
+	static void finishBindlessKtxTexture(TextureManager& textureManager, const char* texturePath, TextureHandle handle,
+	                                     BindlessTextureDSetComponent& dSetComponent,
+	                                     DescriptorManager& descriptorManager);
 };
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "GraphicsCore/Resources/Factories/MipGenerator.hpp"
+#include "GraphicsCore/Resources/Managers/Texture.hpp"
+#include "GraphicsCore/VulkanDevice.hpp"
+#include "GraphicsCore/VulkanUtils.hpp"
+#include <vulkan/vulkan_raii.hpp>
+#include <vk_mem_alloc.h>
+#include <vector>
+
+// Collects RGBA8 texture uploads and records them, with their compute-generated mips, into one command
+// buffer: a model load then costs one submit instead of a blocking submit (and waitIdle) per texture.
+// Long-lived (MipGeneratorComponent): submit() does not wait, and collect() frees each batch's staging buffers,
+// command buffer and mip views in a later frame once its fence has signalled. Frames submitted afterwards on the
+// graphics queue may sample the textures right away; the batch's final barrier orders their reads after it.
+class HALCYON_API TextureUploadBatch
+{
+public:
+	TextureUploadBatch(VulkanDevice& vulkanDevice, VmaAllocator allocator, MipGenerator& mipGenerator);
+	// Waits for the batches still in flight; the images themselves belong to the TextureManager.
+	~TextureUploadBatch();
+
+	TextureUploadBatch(const TextureUploadBatch&) = delete;
+	TextureUploadBatch& operator=(const TextureUploadBatch&) = delete;
+
+	// texture must be created with MipGenerator::prepareImageDesc; pixels are copied before returning.
+	void uploadRgba(const unsigned char* pixels, Texture& texture, bool isNormalMap);
+	// Records and submits what is queued, returning the fence it signals (null when nothing was queued), valid
+	// until collect() frees the batch. Flushes on its own once MipGenerator::maxBatchSize textures are queued.
+	vk::Fence submit();
+	// Drops uploads queued but not submitted, for a load that failed part-way.
+	void discard();
+	// Frees the batches whose fence has signalled. Once per frame.
+	void collect();
+
+	size_t inFlightCount() const;
+
+private:
+	struct InFlight
+	{
+		vk::raii::Fence fence = nullptr;
+		vk::raii::CommandBuffer commandBuffer = nullptr;
+		std::vector<vk::raii::ImageView> views;
+		std::vector<StagingBuffer> staging;
+		DSetHandle sets;
+	};
+
+	void begin();
+	void release(InFlight& batch);
+
+	VulkanDevice& vulkanDevice;
+	VmaAllocator allocator;
+	MipGenerator& mipGenerator;
+
+	vk::raii::CommandBuffer _commandBuffer = nullptr;
+	std::vector<MipGenerator::Request> _requests;
+	std::vector<StagingBuffer> _staging;
+	std::vector<InFlight> _inFlight;
+};
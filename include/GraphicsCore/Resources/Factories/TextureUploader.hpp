@@ -9,6 +9,7 @@
 #include "GraphicsCore/Resources/Managers/PrimitivesInfo.hpp"
 
 class TextureManager;
+struct ktxTexture2;
 
 class HALCYON_API TextureUploader
 {
@@ -25,7 +26,12 @@ public:
 	                                     VmaAllocator& allocator, VulkanDevice& vulkanDevice);
 	static void generateMipmaps(vk::Image image, vk::Format imageFormat, int32_t texWidth, int32_t texHeight,
 	                            uint32_t mipLevels, VulkanDevice& vulkanDevice);
+	// Parses a KTX2 blob and transcodes Basis payloads to BC7; caller owns the result (ktxTexture_Destroy).
+	static ktxTexture2* loadKtxTexture(const unsigned char* ktxData, size_t dataSize, bool isSrgb);
 	static void uploadKtxTextureData(const unsigned char* ktxData, size_t dataSize, Texture& texture,
 	                                 TextureManager& textureManager, bool isSrgb, VmaAllocator& allocator,
 	                                 VulkanDevice& vulkanDevice);
+	// Uploads an already parsed/transcoded KTX2 texture with all its levels; does not take ownership.
+	static void uploadKtxTexture(ktxTexture2* ktxTex, Texture& texture, TextureManager& textureManager,
+	                             VmaAllocator& allocator, VulkanDevice& vulkanDevice);
 };
\ No newline at end of file
@@ -32,6 +32,14 @@ public:
 	            vk::DeviceSize offset = 0, vk::DeviceSize range = VK_WHOLE_SIZE);
 
 	void updateSingleTextureDSet(DSetHandle dIndex, int binding, vk::ImageView imageView, vk::Sampler sampler);
+	// Same for one buffered copy only, e.g. the frame-in-flight slot whose fence just signaled.
+	void updateSingleTextureDSet(DSetHandle dIndex, int binding, uint32_t copyIndex, vk::ImageView imageView,
+	                             vk::Sampler sampler);
+
+	// Between beginWriteBatch() and flushWrites() update() calls are queued, then go out as one
+	// vkUpdateDescriptorSets.
+	void beginWriteBatch();
+	void flushWrites();
 
 	// Returns the set at the given slot index (0 for single-buffered, currentFrame for per-frame).
 	vk::DescriptorSet getSet(DSetHandle handle, uint32_t index = 0) const
@@ -46,8 +54,19 @@ public:
 	}
 
 private:
+	struct PendingWrite
+	{
+		vk::WriteDescriptorSet write;
+		vk::DescriptorImageInfo imageInfo;
+		vk::DescriptorBufferInfo bufferInfo;
+	};
+	static vk::WriteDescriptorSet resolveWrite(const PendingWrite& pending);
+	void submitWrite(const PendingWrite& pending);
+
 	VulkanDevice& vulkanDevice;
 	DescriptorLayoutRegistry layoutRegistry;
 	vk::raii::DescriptorPool descriptorPool = nullptr;
 	std::vector<std::vector<vk::DescriptorSet>> descriptorSets;
+	std::vector<PendingWrite> pendingWrites;
+	bool batchingWrites = false;
 };
\ No newline at end of file
@@ -22,6 +22,10 @@ public:
 	bool releaseMaterialRef(MaterialHandle handle);
 	void freeMaterial(MaterialHandle handle, uint64_t frameNumber);
 	void collectMaterialFrees(uint64_t frameNumber);
+	// Material textures at `textureIndex` are read from bindless slot `descriptorIndex` on the GPU from now on; the
+	// materials using it are rewritten in place. getMaterial keeps returning the original index.
+	void remapTexture(uint32_t textureIndex, uint32_t descriptorIndex, BindlessTextureDSetComponent& dSetComponent,
+	                  BufferManager& bufferManager);
 	const MaterialData& getMaterial(MaterialHandle handle) const;
 	size_t materialCount() const;
 	size_t freeMaterialSlotCount() const;
@@ -38,6 +42,9 @@ private:
 	std::vector<PendingMaterialFree> _pendingMaterialFrees;
 	std::vector<int> _freeMaterialSlots;
 	std::vector<int> _materialRefCounts;
+	std::unordered_map<uint32_t, uint32_t> _textureRemap;
+
+	MaterialData resolveTextures(const MaterialData& material) const;
 
 	// Content key for deduplication; padding fields are constant and skipped.
 	struct MaterialKeyHash
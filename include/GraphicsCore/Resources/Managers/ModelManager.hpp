@@ -46,6 +46,8 @@ public:
 	ModelHandle getModelHandle(const char path[MAX_PATH_LEN]) const;
 	void registerModelPath(const char path[MAX_PATH_LEN], ModelHandle handle);
 	void unregisterModelPath(ModelHandle handle);
+	// Empty for models that were not loaded from a file
+	std::string getModelPath(ModelHandle handle) const;
 
 	std::optional<GeometryAllocation> allocateGeometry(int bufferIndex, uint32_t vertexCount, uint32_t indexCount);
 	void uploadVertices(int bufferIndex, uint32_t vertexBase, const Vertex* data, uint32_t count);
@@ -53,6 +55,10 @@ public:
 	void freeGeometry(const GeometryAllocation& allocation, uint64_t frameNumber);
 	void collectGeometryFrees(uint64_t frameNumber);
 	void defragment(VertexIndexBuffer& buffer);
+	// Copies a model's geometry back from the GPU: every vertex position, and the indices of each primitive of each
+	// mesh rebased onto those positions. Blocks on a one-shot transfer; meant for cooking colliders, not per frame.
+	void readbackGeometry(ModelHandle handle, std::vector<glm::vec3>& positions, std::vector<uint32_t>& indices,
+	                      std::vector<uint32_t>& primitiveIndexCounts);
 
 	MeshHandle allocateMeshSlot();
 	ModelHandle allocateModelSlot();
@@ -34,7 +34,7 @@ public:
 	void unregisterTexturePath(TextureHandle handle);
 	void resizeTexture(TextureHandle handle, uint32_t newWidth, uint32_t newHeight);
 	void createImageView(Texture& texture, vk::Format format, vk::ImageAspectFlags aspectFlags,
-	                     vk::ImageViewType viewType = vk::ImageViewType::e2D);
+	                     vk::ImageViewType viewType = vk::ImageViewType::e2D, vk::ComponentMapping components = {});
 	SamplerHandle allocateSamplerSlot();
 	void createSampler(SamplerHandle handle, const SamplerDesc& desc);
 	SamplerHandle createSampler(Texture& texture, const SamplerDesc& desc);
@@ -44,10 +44,14 @@ public:
 	                                   vk::FormatFeatureFlags features);
 	void createImage(Texture& texture, const ImageDesc& desc);
 	void destroyTexture(TextureHandle handle);
+	// Slots index the bindless array; throws once all MAX_BINDLESS_TEXTURES are taken
 	TextureHandle allocateTextureSlot();
+	bool hasFreeTextureSlot() const;
 	void addTextureRef(TextureHandle handle);
 	bool releaseTextureRef(TextureHandle handle);
 	void freeTexture(TextureHandle handle, uint64_t frameNumber);
+	// Defers destruction of an image/view that was swapped out of a still-live slot.
+	void retireTextureResources(const Texture& texture, uint64_t frameNumber);
 	void collectTextureFrees(uint64_t frameNumber);
 	Texture& getTexture(TextureHandle handle);
 
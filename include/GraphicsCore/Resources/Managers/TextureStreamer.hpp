@@ -0,0 +1,156 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "GraphicsCore/Resources/Managers/ResourceHandles.hpp"
+#include "GraphicsCore/Resources/Managers/Texture.hpp"
+#include "GraphicsCore/VulkanDevice.hpp"
+#include "GraphicsCore/VulkanUtils.hpp"
+#include <vulkan/vulkan_raii.hpp>
+#include <vk_mem_alloc.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class TextureManager;
+class DescriptorManager;
+class MaterialManager;
+class BufferManager;
+struct BindlessTextureDSetComponent;
+struct ktxTexture2;
+
+// Mip-level streaming for KTX2 textures. A streamed texture keeps only the mip tail resident at load;
+// higher mips are read on a loader thread, uploaded with a fenced submit and swapped in by reallocating
+// the image to the new resident mip range. LRU textures shed mips above the budget.
+// The slot materials sample is never safe to rewrite while frames are in flight, so a swap takes a second
+// bindless slot, writes the new view there and points the materials at it. Once the frames in flight are done
+// with the texture's own slot it moves back there and the spare is freed; no free slot keeps the current mips.
+class HALCYON_API TextureStreamer
+{
+public:
+	TextureStreamer(VulkanDevice& vulkanDevice, VmaAllocator allocator);
+	~TextureStreamer();
+
+	// sourceFile, when given, should hold the same KTX2 bytes; uncompressed levels are then re-read
+	// from disk by offset instead of being kept in memory. A missing file or one of another size is ignored.
+	// `transcoded` skips parsing/transcoding ktxData and stays owned by the caller.
+	TextureHandle createStreamedTexture(TextureManager& textureManager, DescriptorManager& descriptorManager,
+	                                    BindlessTextureDSetComponent& dSetComponent, const char* texturePath,
+	                                    const unsigned char* ktxData, size_t dataSize, bool isSrgb,
+	                                    const std::filesystem::path& sourceFile = {},
+	                                    ktxTexture2* transcoded = nullptr);
+
+	// Asks for `mip` to be resident; lower value wins within a frame. Loads are issued by `priority`, highest
+	// first, taking the highest asked for this frame (screen-space size). Ignored for non-streamed textures.
+	void requestMip(TextureHandle handle, uint32_t mip, uint64_t frameNumber, float priority);
+	bool isStreamed(TextureHandle handle) const;
+	// Base size of the full-resolution image, for screen-space mip selection.
+	uint32_t getFullSize(TextureHandle handle) const;
+	uint32_t getMipCount(TextureHandle handle) const;
+
+	// Completes finished uploads, issues new loads and evicts under budget. Call once per frame.
+	void update(uint64_t frameNumber, TextureManager& textureManager, DescriptorManager& descriptorManager,
+	            BindlessTextureDSetComponent& dSetComponent, MaterialManager& materialManager,
+	            BufferManager& bufferManager);
+
+	uint64_t budgetBytes = 1024ull * 1024ull * 1024ull;
+
+	uint64_t residentBytes() const;
+	size_t streamedTextureCount() const;
+	size_t pendingUploadCount() const;
+
+private:
+	struct MipRange
+	{
+		uint64_t offset;
+		uint64_t size;
+	};
+
+	// Immutable once created; shared with the loader thread so a texture can be dropped mid-load.
+	struct StreamSource
+	{
+		std::filesystem::path file;
+		std::vector<unsigned char> blob;
+		std::vector<MipRange> mips;
+	};
+
+	struct StreamedTexture
+	{
+		std::shared_ptr<const StreamSource> source;
+		vk::Format format = vk::Format::eUndefined;
+		vk::ComponentMapping components;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t mipCount = 0;
+		uint32_t residentMip = 0;
+		uint32_t desiredMip = UINT32_MAX;
+		float priority = 0.0f;
+		uint64_t lastUsedFrame = 0;
+		vk::Image image; // Image the slot held when we last touched it; a mismatch means it was freed
+		bool busy = false;
+		int spareSlot = -1;          // Second bindless slot, held from a swap until the texture is back in its own
+		int descriptorSlot = -1;     // The one materials sample now: the handle's own or the spare
+		uint64_t spareFreeFrame = 0; // From this frame no in-flight frame can still sample the slot swapped from
+	};
+
+	struct LoadJob
+	{
+		int textureId;
+		uint32_t firstMip;
+		uint32_t endMip;
+		vk::Image forImage;
+		std::shared_ptr<const StreamSource> source;
+	};
+
+	struct LoadResult
+	{
+		int textureId;
+		uint32_t firstMip;
+		vk::Image forImage;
+		std::vector<unsigned char> data;
+		std::vector<uint64_t> offsets; // Per loaded mip, into data
+		bool failed = false;
+	};
+
+	struct PendingUpload
+	{
+		int textureId;
+		Texture newTexture;
+		uint32_t newResidentMip;
+		vk::Image oldImage;
+		StagingBuffer staging;
+		vk::raii::CommandBuffer commandBuffer = nullptr;
+		vk::raii::Fence fence = nullptr;
+	};
+
+	void loaderLoop(std::stop_token stopToken);
+	static LoadResult readMips(const LoadJob& job);
+	uint64_t mipBytes(const StreamedTexture& texture, uint32_t firstMip) const;
+	// Records the copy that builds an image holding [newResidentMip, mipCount) out of the current image
+	// (levels already resident) and `loaded` (levels that are not).
+	void recordResidencyChange(vk::raii::CommandBuffer& cmd, const StreamedTexture& streamed, vk::Image oldImage,
+	                           const Texture& newTexture, uint32_t newResidentMip, const LoadResult* loaded,
+	                           vk::Buffer staging);
+	// False, with nothing started, when the swap would need a spare slot and none is free
+	bool beginResidencyChange(int textureId, StreamedTexture& streamed, uint32_t newResidentMip,
+	                          const LoadResult* loaded, TextureManager& textureManager);
+	bool needsSpareSlot(int textureId, const StreamedTexture& streamed) const;
+	void releaseSpareSlot(StreamedTexture& streamed, TextureManager& textureManager, uint64_t frameNumber);
+
+	VulkanDevice& vulkanDevice;
+	VmaAllocator allocator;
+
+	std::unordered_map<int, StreamedTexture> _textures;
+	std::vector<PendingUpload> _pendingUploads;
+
+	std::mutex _loaderMutex;
+	std::condition_variable_any _loaderCv;
+	std::deque<LoadJob> _loadJobs;
+	std::vector<LoadResult> _loadResults;
+	std::jthread _loaderThread;
+};
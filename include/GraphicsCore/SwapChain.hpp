@@ -1,6 +1,7 @@
 #pragma once
 
 #include "HalcyonExport.hpp"
+#include "GraphicsCore/Resources/Managers/ResourceHandles.hpp"
 #include <vulkan/vulkan_raii.hpp>
 
 class HALCYON_API SwapChain
@@ -12,6 +13,12 @@ public:
 	std::vector<vk::Image> swapChainImages;
 	std::vector<vk::raii::ImageView> swapChainImageViews;
 	std::vector<vk::raii::Semaphore> renderFinishedSemaphores;
+	// Mode asked for on the next (re)creation, and the one the surface actually granted
+	vk::PresentModeKHR requestedPresentMode = vk::PresentModeKHR::eMailbox;
+	vk::PresentModeKHR presentMode = vk::PresentModeKHR::eFifo;
+	// Headless only: one offscreen image per frame in flight stands in for swapChainImages, owned by the
+	// TextureManager. Empty for a real swap chain.
+	std::vector<TextureHandle> offscreenTextures;
 
 	vk::Format hdrFormat = vk::Format::eR16G16B16A16Sfloat;
 };
\ No newline at end of file
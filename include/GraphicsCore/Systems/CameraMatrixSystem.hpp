@@ -7,6 +7,8 @@
 #include "GraphicsCore/Components/GlobalTransformComponent.hpp"
 #include "GraphicsCore/Components/DirectLightComponent.hpp"
 #include "GraphicsCore/Components/CurrentFrameComponent.hpp"
+#include "Shared/GpuStructs.h"
+#include <glm/glm.hpp>
 
 using Orhescyon::GeneralManager;
 class HALCYON_API CameraMatrixSystem : public Orhescyon::SystemCore<CameraMatrixSystem>
@@ -15,4 +17,8 @@ public:
 	void update(GeneralManager& gm) override;
 	void onRegistered(GeneralManager& gm) override;
 	void onShutdown(GeneralManager& gm) override;
+
+	// Main camera block for the current frame from the camera's transform as it stands now. Shared with the late
+	// latch in FrameEndSystem, which rebuilds it against the same previous view-projection just before submit.
+	static CameraData buildCameraData(GeneralManager& gm, const glm::mat4& prevViewProjNoJitter);
 };
\ No newline at end of file
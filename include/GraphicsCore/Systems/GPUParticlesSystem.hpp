@@ -5,6 +5,8 @@
 #include <Orhescyon/Systems/SystemCore.hpp>
 #include "GraphicsCore/Components/ParticleEmitorComponent.hpp"
 #include "GraphicsCore/Components/GlobalTransformComponent.hpp"
+#include "Shared/ParticlesStructs.h"
+#include <vector>
 
 using Orhescyon::GeneralManager;
 class HALCYON_API GPUParticlesSystem
@@ -14,8 +16,31 @@ public:
 	void update(GeneralManager& gm) override;
 	void onRegistered(GeneralManager& gm) override;
 	void onShutdown(GeneralManager& gm) override;
+	void onEntityUnsubscribed(Orhescyon::Entity entity, GeneralManager& gm) override;
 
 private:
-	uint32_t numberOfEmiters;
-	uint32_t numberOfParticles;
+	struct RetiredSlot
+	{
+		uint32_t slot;
+		double freeAt; // Once the last particle of the removed emiter has died
+	};
+
+	// Free slot, or UINT32_MAX when the table is full
+	uint32_t allocateSlot();
+	void markDirty(uint32_t slot);
+	// Copies the slots still stale in `frame`'s copy, coalescing neighbours into one memcpy
+	void uploadDirtySlots(EmiterData* dst, uint32_t frame);
+
+	// CPU copy of the GPU emiter table; slots are stable for an emiter's lifetime
+	std::vector<EmiterData> _emiters = std::vector<EmiterData>(MAX_NUMBER_EMITERS);
+	std::vector<uint32_t> _freeSlots;
+	std::vector<RetiredSlot> _retiredSlots;
+	uint32_t _nextSlot = 0;
+
+	// Bit per frame in flight whose copy of the slot is stale
+	std::vector<uint8_t> _dirtyFrames = std::vector<uint8_t>(MAX_NUMBER_EMITERS, 0);
+	std::vector<uint32_t> _dirtySlots;
+
+	std::vector<EmiterSpawnRange> _spawnRanges;
+	double _elapsedTime = 0.0;
 };
\ No newline at end of file
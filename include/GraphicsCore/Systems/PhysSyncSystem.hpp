@@ -13,4 +13,9 @@ public:
 	void update(GeneralManager& gm) override;
 	void onRegistered(GeneralManager& gm) override;
 	void onShutdown(GeneralManager& gm) override;
+
+private:
+	// Tick of the newest snapshot synced. A gap means moved lists were missed, and the agents moved since are found
+	// through PhysSnapshot::movedTicks.
+	uint64_t _lastTick = 0;
 };
\ No newline at end of file
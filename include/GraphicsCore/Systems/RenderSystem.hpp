@@ -13,6 +13,7 @@
 #include "GraphicsCore/Passes/IPass.hpp"
 
 class RenderGraph;
+struct GraphicsSettingsComponent;
 
 using Orhescyon::GeneralManager;
 class HALCYON_API RenderSystem : public Orhescyon::SystemCore<RenderSystem, GlobalTransformComponent, MeshInfoComponent>
@@ -25,6 +26,8 @@ public:
 private:
 	void importFrameResources(GeneralManager& gm, RenderGraph& rg, uint32_t imageIndex);
 	void applySettingsChanges(GeneralManager& gm);
+	// Moves dynamicResolutionScale toward the scale whose GPU frame time would meet dynamicResolutionTargetMs
+	void updateDynamicResolution(GraphicsSettingsComponent& settings, float gpuFrameMs);
 
 	std::vector<std::unique_ptr<IPass>> _passes;
 	uint32_t _lastWidth = 0;
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "GraphicsCore/Components/GlobalTransformComponent.hpp"
+#include "GraphicsCore/Components/CameraComponent.hpp"
+#include "GraphicsCore/Components/CurrentFrameComponent.hpp"
+#include "GraphicsCore/Components/GraphicsSettingsComponent.hpp"
+#include "GraphicsCore/Resources/Components/MeshInfoComponent.hpp"
+#include <Orhescyon/GeneralManager.hpp>
+#include <Orhescyon/Systems/SystemCore.hpp>
+
+using Orhescyon::GeneralManager;
+// Picks the mip each streamed texture needs from the projected size of the primitives using it,
+// then drives TextureStreamer loads/evictions.
+class HALCYON_API TextureStreamingSystem
+    : public Orhescyon::SystemCore<TextureStreamingSystem, GlobalTransformComponent, MeshInfoComponent>
+{
+public:
+	void update(GeneralManager& gm) override;
+	void onRegistered(GeneralManager& gm) override;
+	void onShutdown(GeneralManager& gm) override;
+};
@@ -18,6 +18,12 @@ public:
 	void onRegistered(GeneralManager& gm) override;
 	void onShutdown(GeneralManager& gm) override;
 
+	// Applies an entity's pending global changes now rather than at the next update, for code that reads the
+	// transform after TransformSystem has run this frame (the late latch). `parent` is the parent's global
+	// transform, null for a root. Its children follow at the next update.
+	static void commitPending(GlobalTransformComponent* global, LocalTransformComponent* local,
+	                          const GlobalTransformComponent* parent);
+
 private:
 	static void applyPendingToLocal(LocalTransformComponent* local);
 	static void applyPendingToGlobal(GlobalTransformComponent* global);
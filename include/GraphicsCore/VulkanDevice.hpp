@@ -17,4 +17,6 @@ public:
 	vk::raii::SurfaceKHR surface = nullptr;
 	vk::raii::CommandPool commandPool = nullptr;
 	vk::SampleCountFlagBits maxMsaaSamples = vk::SampleCountFlagBits::e1;
+	bool textureCompressionBC = false;
+	bool headless = false; // No surface or swap chain extension; presentQueue is the graphics queue
 };
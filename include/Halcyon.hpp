@@ -4,6 +4,7 @@
 // Engine core lifecycle
 #include "App.hpp"
 #include "IStartUp.hpp"
+#include "TaskScheduler.hpp"
 
 // Deletion queue
 #include "DeletionQueue.hpp"
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "PhysicsCore/PhysLayers.hpp"
+#include <cstdint>
+#include <string>
+
+// Capacities and layer tables the physics world is created with. Passed to App and read once by PhysManager;
+// changing the context component afterwards has no effect.
+struct HALCYON_API PhysSettingsComponent
+{
+	uint32_t maxBodies = 4096;
+	uint32_t numBodyMutexes = 0; // 0 picks a default for the core count
+	uint32_t maxBodyPairs = 4096;
+	uint32_t maxContactConstraints = 4096;
+	uint32_t tempAllocatorSize = 10 * 1024 * 1024; // Bytes; raise with the contact count
+	PhysLayerConfig layers;
+	// Rebuild the broad-phase trees once after startups have added their bodies and before the first tick. Bodies
+	// added one by one leave the trees unbalanced, which makes every query and the collision pass slower.
+	bool optimizeBroadPhase = true;
+
+	// Deterministic mode: ticks run on the main thread, `stepsPerFrame` of them at the start of every frame, and are
+	// never dropped, so the same inputs reproduce the same session. Physics no longer overlaps the frame.
+	bool deterministic = false;
+	uint32_t stepsPerFrame = 1;
+	// Records the session here for replayPhysRecording; deterministic mode only
+	std::string recordPath;
+	// Full world states kept for PhysManager::rollbackTo, one every `rollbackInterval` ticks; 0 keeps none
+	uint32_t rollbackCapacity = 0;
+	uint32_t rollbackInterval = 1;
+};
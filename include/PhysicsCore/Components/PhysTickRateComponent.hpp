@@ -5,4 +5,17 @@ struct HALCYON_API PhysTickRateComponent
 {
 	float rate = 60.0f;
 	int maxConsecutiveMissedSteps = 5;
+	// Collision steps per tick. More let fast bodies collide reliably at low rates, at the cost of a longer tick.
+	int collisionSteps = 1;
+	// Under sustained load the tick rate halves, down to no less than minRate. Ticks keep their collision steps, so
+	// the physics thread does half the work per simulated second, over twice as long a step; raise collisionSteps if
+	// fast bodies tunnel at minRate. It climbs back once ticks fit easily again. Without it, ticks that keep running
+	// late are dropped. Ignored in deterministic mode.
+	bool adaptive = false;
+	float minRate = 15.0f;
+	// Rendered transforms blend the last two snapshots by where the frame falls between their ticks, so motion stays
+	// smooth at any render rate. When the next tick is late they may run on past the newest snapshot by up to this
+	// fraction of a tick; 0 holds them there instead.
+	bool interpolate = true;
+	float maxExtrapolation = 0.25f;
 };
@@ -1,14 +1,9 @@
 #pragma once
 
 #include "HalcyonExport.hpp"
-#include <Jolt/Jolt.h>
-#include <Jolt/Math/Vec3.h>
-#include <Jolt/Math/Quat.h>
-
-const int maxSnapshots = 3;
 
+// Marks an entity whose transform follows its physics body. The transforms themselves live densely in
+// PhysManager::snapshots, at the agent slot PhysSnapshotSystem gives the entity.
 struct HALCYON_API PhysTransformSnapshotComponent
 {
-	JPH::Vec3 positionSnap[maxSnapshots] = {JPH::Vec3::sZero(), JPH::Vec3::sZero(), JPH::Vec3::sZero()};
-	JPH::Quat rotationSnap[maxSnapshots] = {JPH::Quat::sIdentity(), JPH::Quat::sIdentity(), JPH::Quat::sIdentity()};
-};
\ No newline at end of file
+};
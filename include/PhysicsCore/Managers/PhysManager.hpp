@@ -6,16 +6,27 @@
 #include <Jolt/Physics/PhysicsSystem.h>
 #include <Jolt/Physics/Collision/Shape/Shape.h>
 #include <Jolt/Core/TempAllocator.h>
-#include <Jolt/Core/JobSystemThreadPool.h>
+#include <Jolt/Core/JobSystem.h>
 #include "PhysicsCore/PhysLayers.hpp"
 #include "PhysicsCore/PhysShapes.hpp"
+#include "PhysicsCore/PhysSnapshot.hpp"
+#include "PhysicsCore/Managers/PhysShapeCache.hpp"
+#include "PhysicsCore/Managers/PhysSceneQueries.hpp"
+#include "PhysicsCore/PhysCommand.hpp"
+#include "PhysicsCore/PhysMetrics.hpp"
+#include "PhysicsCore/PhysRecording.hpp"
+#include "PhysicsCore/PhysRollback.hpp"
 #include <glm/ext/vector_float3.hpp>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
 
 struct HALCYON_API SnapshotIndices
 {
 	uint8_t previous;
 	uint8_t current;
-	uint8_t writing;
 };
 
 using Orhescyon::GeneralManager;
@@ -24,23 +35,78 @@ class HALCYON_API PhysManager
 public:
 	PhysManager(GeneralManager& gm);
 
-	MyBroadPhaseLayerInterface sBroadPhaseLayerInterface;
-	MyObjectVsBroadPhaseLayerFilter sObjectVsBroadPhaseLayerFilter;
-	MyObjectLayerPairFilter sObjectLayerPairFilter;
+	PhysLayerTable layerTable;
 
 	JPH::PhysicsSystem* physicsSystem = nullptr;
 	JPH::TempAllocatorImpl* tempAllocator = nullptr;
-	JPH::JobSystemThreadPool* jobSystem = nullptr;
+	JPH::JobSystem* jobSystem = nullptr; // PhysJobSystem on the engine TaskScheduler
 	
-	std::atomic<SnapshotIndices> physSnapshot{{0, 1, 2}};
+	std::atomic<SnapshotIndices> physSnapshot{{0, 1}};
+	// Ring indexed by physSnapshot. A slot is filled before the indices naming it are released, so a
+	// reader that acquired them sees complete snapshots.
+	PhysSnapshot snapshots[maxSnapshots];
+	// For a reader on another thread: pins the published previous and current snapshots, so the writer leaves them
+	// alone however long the read takes, and returns their indices. unpinSnapshots once done. One reader at a time.
+	SnapshotIndices pinSnapshots();
+	void unpinSnapshots();
+	// Writer side: a slot that is neither published nor pinned
+	uint8_t freeSnapshotSlot() const;
+	// Oldest tick a pinned snapshot holds, or UINT64_MAX with none pinned
+	uint64_t oldestPinnedTick() const;
+	// Scheduled time of the tick being simulated, set by the physics thread before each update
+	double tickTime = 0.0;
+	// Length and collision steps of the tick being simulated, set alongside tickTime
+	float tickDeltaTime = 1.0f / 60.0f;
+	int tickCollisionSteps = 1;
 
 	JPH::BodyID createDynamicSphere(glm::vec3 pos, float radius);
 	JPH::BodyID createStaticBox(glm::vec3 pos, glm::vec3 halfExtents);
 
+	// Shapes come from shapeCache, so bodies with the same parameters share one. Creation throws when the world is
+	// out of bodies (PhysSettingsComponent::maxBodies) or the shape is not Ready.
 	JPH::BodyID createBody(const Body& body, const Shape& shape);
+	JPH::BodyID createBody(const Body& body, ShapeHandle shape);
+	// All bodies share `shape` and are inserted into the broad phase as one batch, which is far cheaper than adding
+	// them one by one. IDs are returned in the order of `bodies`.
+	std::vector<JPH::BodyID> createBodies(std::span<const Body> bodies, ShapeHandle shape);
+
+	PhysShapeCache shapeCache;
+	// Submit from any thread; answered after the next tick by PhysQuerySystem
+	PhysSceneQueries queries;
+
+	// Thread-safe; applied at the start of the next tick
+	void submit(const PhysCommand& command);
+	// One tick: pending commands, the update, then recording and the rollback state. Physics thread only.
+	void step(float deltaTime, int collisionSteps);
+	// Recorded, so replays rebuild the same trees. Only while no tick runs.
+	void optimizeBroadPhase();
+	// Puts the world back to how it was after `tick` and resumes counting from there. Needs rollbackCapacity and no
+	// bodies added since; false otherwise. Only between ticks: from the physics systems, or in deterministic mode from
+	// any system.
+	bool rollbackTo(uint64_t tick);
+
+	// Thread-safe copy
+	PhysMetrics metrics() const;
+	// By the tick loop: a tick ended more than an interval late, and `droppedSeconds` of simulation were skipped
+	void recordLateTick(double droppedSeconds);
+
+	uint64_t tick = 0; // Ticks stepped so far
+	// Set by rollbackTo, cleared by PhysSnapshotSystem once it has republished every agent
+	bool stateRestored = false;
 
 private:
-	static JPH::Shape* makeJoltShape(const Shape& shape);
+	JPH::RefConst<JPH::Shape> requireShape(ShapeHandle shape) const;
 
 	GeneralManager* gm;
+
+	std::atomic<uint32_t> _pinnedSnapshots{0}; // One bit per ring slot
+	std::mutex _commandMutex;
+	std::vector<PhysCommand> _commands;
+	std::vector<PhysCommand> _stepCommands; // Taken by the tick in progress
+	std::unique_ptr<PhysRecorder> _recorder;
+	PhysRollbackBuffer _rollback;
+	uint32_t _rollbackInterval = 1;
+
+	mutable std::mutex _metricsMutex;
+	PhysMetrics _metrics;
 };
\ No newline at end of file
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "PhysicsCore/PhysQuery.hpp"
+#include "PhysicsCore/PhysLayers.hpp"
+#include "PhysicsCore/PhysSnapshot.hpp"
+#include "TaskScheduler.hpp"
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+// Scene queries from any thread, answered by the physics thread between ticks so they never race
+// PhysicsSystem::Update. Batches submitted before a tick are run after it by PhysQuerySystem, spread across the
+// TaskScheduler, and their results wait for the caller to collect them.
+class HALCYON_API PhysSceneQueries
+{
+public:
+	PhysQueryTicket submit(PhysQueryBatch batch);
+	// True once the batch has run; moves its results out, after which the ticket is spent. Results of a ticket
+	// nobody collects are kept until then.
+	bool fetch(PhysQueryTicket ticket, PhysQueryResults& out);
+
+	// Physics thread, after the tick's snapshot is published
+	void execute(JPH::PhysicsSystem& physicsSystem, const PhysLayerTable& layers, TaskScheduler& scheduler,
+	             const PhysSnapshot& snapshot);
+
+private:
+	struct Submitted
+	{
+		uint64_t ticket;
+		PhysQueryBatch batch;
+	};
+
+	static void run(JPH::PhysicsSystem& physicsSystem, const PhysLayerTable& layers, TaskScheduler& scheduler,
+	                const PhysSnapshot& snapshot, const PhysQueryBatch& batch, PhysQueryResults& results);
+
+	std::mutex _mutex;
+	uint64_t _nextTicket = 1;
+	std::vector<Submitted> _submitted;
+	std::unordered_map<uint64_t, PhysQueryResults> _completed;
+	std::vector<Submitted> _running; // Physics thread only; kept to reuse its capacity
+};
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "PhysicsCore/PhysShapes.hpp"
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Collision/Shape/Shape.h>
+#include <glm/ext/vector_float3.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Render geometry a mesh collider is cooked from. Indices are triangle lists into `positions`; primitives are
+// consecutive runs of `primitiveIndexCounts[i]` indices.
+struct HALCYON_API MeshColliderGeometry
+{
+	std::vector<glm::vec3> positions;
+	std::vector<uint32_t> indices;
+	std::vector<uint32_t> primitiveIndexCounts;
+};
+
+enum class ShapeState
+{
+	Pending,
+	Ready,
+	Failed
+};
+
+// Owns every JPH::Shape bodies are created from. Primitive shapes are deduplicated by their parameters and built on
+// the calling thread. Mesh colliders are cooked on a worker thread and written next to their source asset, so later
+// runs only read them back.
+class HALCYON_API PhysShapeCache
+{
+public:
+	PhysShapeCache();
+	~PhysShapeCache();
+
+	PhysShapeCache(const PhysShapeCache&) = delete;
+	PhysShapeCache& operator=(const PhysShapeCache&) = delete;
+
+	// Throws std::runtime_error when Jolt rejects the shape (degenerate hull)
+	ShapeHandle get(const Shape& shape);
+
+	// Cache file: "<sourcePath>.<kind>.joltshape". When it is missing or older than sourcePath, `readGeometry` is
+	// called on this thread and cooking runs on the worker. Asking again for the same source and kind returns the
+	// same handle.
+	ShapeHandle requestMesh(const std::filesystem::path& sourcePath, MeshColliderKind kind,
+	                        const std::function<MeshColliderGeometry()>& readGeometry);
+
+	ShapeState state(ShapeHandle handle) const;
+	// Null until the shape is Ready
+	JPH::RefConst<JPH::Shape> shape(ShapeHandle handle) const;
+
+	static std::filesystem::path cachePath(const std::filesystem::path& sourcePath, MeshColliderKind kind);
+
+private:
+	struct Entry
+	{
+		JPH::RefConst<JPH::Shape> shape;
+		ShapeState state = ShapeState::Pending;
+	};
+
+	struct CookJob
+	{
+		int shapeId = -1;
+		MeshColliderKind kind = MeshColliderKind::TriangleMesh;
+		std::filesystem::path cachePath;
+		bool fromCache = false; // Read cachePath instead of cooking `geometry`
+		MeshColliderGeometry geometry;
+	};
+
+	ShapeHandle addEntry(ShapeState state, JPH::RefConst<JPH::Shape> shape);
+	void workerLoop(std::stop_token stopToken);
+	static JPH::RefConst<JPH::Shape> cook(const CookJob& job);
+	static JPH::RefConst<JPH::Shape> loadCooked(const std::filesystem::path& cachePath);
+	static void writeCooked(const std::filesystem::path& cachePath, const JPH::Shape& shape);
+	static std::string shapeKey(const Shape& shape);
+
+	mutable std::mutex _mutex;
+	std::vector<Entry> _entries;
+	std::unordered_map<std::string, ShapeHandle> _shapeKeys; // Parameters or cache path -> handle
+
+	std::condition_variable_any _workerCv;
+	std::deque<CookJob> _jobs;
+	std::jthread _workerThread;
+};
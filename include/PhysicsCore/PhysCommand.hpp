@@ -0,0 +1,32 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Jolt/Physics/Body/BodyInterface.h>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <span>
+
+enum class PhysCommandType : uint8_t
+{
+	AddForce,           // value: force (N), held for the next tick
+	AddImpulse,         // value: impulse (N s)
+	SetLinearVelocity,  // value: m/s
+	SetAngularVelocity, // value: rad/s
+	Teleport            // value: position, rotation
+};
+
+// A change to a body made by gameplay. Submitted to PhysManager and applied at the start of the next tick, so it
+// lands on the same tick however the threads interleave, and recorded with that tick.
+struct HALCYON_API PhysCommand
+{
+	PhysCommandType type = PhysCommandType::AddImpulse;
+	JPH::BodyID body;
+	glm::vec3 value{0.0f};
+	glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+};
+
+// In order; commands on bodies that no longer exist are skipped
+HALCYON_API void applyPhysCommands(JPH::BodyInterface& bodyInterface, std::span<const PhysCommand> commands);
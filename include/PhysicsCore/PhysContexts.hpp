@@ -7,4 +7,8 @@ struct HALCYON_API PhysManagerContext
 
 struct HALCYON_API PhysTickRateContext
 {
+};
+
+struct HALCYON_API PhysSettingsContext
+{
 };
\ No newline at end of file
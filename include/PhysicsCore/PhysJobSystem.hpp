@@ -0,0 +1,29 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "TaskScheduler.hpp"
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/FixedSizeFreeList.h>
+#include <Jolt/Core/JobSystemWithBarrier.h>
+
+// Runs Jolt's jobs on the engine TaskScheduler at Normal priority instead of a thread pool of its own, so physics
+// fills cores the render thread's High tasks leave idle. The physics thread also executes jobs while it waits on a
+// barrier, as with JobSystemThreadPool.
+class HALCYON_API PhysJobSystem final : public JPH::JobSystemWithBarrier
+{
+public:
+	PhysJobSystem(TaskScheduler& scheduler, JPH::uint maxJobs, JPH::uint maxBarriers);
+
+	int GetMaxConcurrency() const override;
+	JobHandle CreateJob(const char* inName, JPH::ColorArg inColor, const JobFunction& inJobFunction,
+	                    JPH::uint32 inNumDependencies = 0) override;
+
+protected:
+	void QueueJob(Job* inJob) override;
+	void QueueJobs(Job** inJobs, JPH::uint inNumJobs) override;
+	void FreeJob(Job* inJob) override;
+
+private:
+	TaskScheduler& _scheduler;
+	JPH::FixedSizeFreeList<Job> _jobs;
+};
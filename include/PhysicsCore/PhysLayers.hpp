@@ -3,57 +3,101 @@
 #include "HalcyonExport.hpp"
 #include <Jolt/Jolt.h>
 #include <Jolt/Physics/Collision/BroadPhase/BroadPhaseLayer.h>
+#include <Jolt/Physics/Collision/ObjectLayer.h>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
+// Object layers of the default layer config. Games with their own tables define their own constants.
 namespace Layers
 {
 static constexpr JPH::ObjectLayer NON_MOVING = 0;
 static constexpr JPH::ObjectLayer MOVING = 1;
-static constexpr JPH::ObjectLayer NUM_LAYERS = 2;
+static constexpr JPH::ObjectLayer DEBRIS = 2;
+static constexpr JPH::ObjectLayer SENSOR = 3;
+static constexpr JPH::ObjectLayer CHARACTER = 4;
+static constexpr JPH::ObjectLayer NUM_LAYERS = 5;
 } // namespace Layers
 
-HALCYON_API class MyBroadPhaseLayerInterface final : public JPH::BroadPhaseLayerInterface
+namespace BroadPhaseLayers
 {
-public:
-	virtual JPH::uint GetNumBroadPhaseLayers() const override
-	{
-		return 2;
-	}
+static constexpr uint8_t NON_MOVING = 0;
+static constexpr uint8_t MOVING = 1;
+static constexpr uint8_t DEBRIS = 2;
+static constexpr uint8_t SENSOR = 3;
+static constexpr uint8_t NUM_LAYERS = 4;
+} // namespace BroadPhaseLayers
 
-	virtual JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer inLayer) const override
-	{
-		switch (inLayer)
-		{
-		case Layers::NON_MOVING:
-			return JPH::BroadPhaseLayer(0);
-		case Layers::MOVING:
-			return JPH::BroadPhaseLayer(1);
-		default:
-			JPH_ASSERT(false);
-			return JPH::BroadPhaseLayer(0);
-		}
-	}
+struct HALCYON_API PhysObjectLayerDesc
+{
+	const char* name;
+	uint8_t broadPhaseLayer;
 };
 
-HALCYON_API class MyObjectVsBroadPhaseLayerFilter final : public JPH::ObjectVsBroadPhaseLayerFilter
+// Object layers, the broad-phase trees they are sorted into and which object layers collide. Object layers are
+// indexed by their position in `objectLayers`, broad-phase layers by theirs in `broadPhaseLayers`. Pairs are
+// symmetric; an object layer tests a broad-phase tree if it collides with any object layer sorted into it.
+// Static geometry gets a tree of its own so the trees that change every tick stay small.
+struct HALCYON_API PhysLayerConfig
+{
+	std::vector<const char*> broadPhaseLayers = {"NonMoving", "Moving", "Debris", "Sensor"};
+	std::vector<PhysObjectLayerDesc> objectLayers = {
+	    {"NonMoving", BroadPhaseLayers::NON_MOVING}, {"Moving", BroadPhaseLayers::MOVING},
+	    {"Debris", BroadPhaseLayers::DEBRIS},        {"Sensor", BroadPhaseLayers::SENSOR},
+	    {"Character", BroadPhaseLayers::MOVING},
+	};
+	// Debris only lands on the world, sensors only see what can walk into them
+	std::vector<std::pair<JPH::ObjectLayer, JPH::ObjectLayer>> collidingPairs = {
+	    {Layers::NON_MOVING, Layers::MOVING},    {Layers::NON_MOVING, Layers::DEBRIS},
+	    {Layers::NON_MOVING, Layers::CHARACTER}, {Layers::MOVING, Layers::MOVING},
+	    {Layers::MOVING, Layers::CHARACTER},     {Layers::CHARACTER, Layers::CHARACTER},
+	    {Layers::SENSOR, Layers::MOVING},        {Layers::SENSOR, Layers::CHARACTER},
+	};
+};
+
+// Lookup tables built once from a PhysLayerConfig, answering all three of Jolt's layer questions. Must outlive the
+// PhysicsSystem it is handed to.
+class HALCYON_API PhysLayerTable final : public JPH::BroadPhaseLayerInterface,
+                                         public JPH::ObjectVsBroadPhaseLayerFilter,
+                                         public JPH::ObjectLayerPairFilter
 {
 public:
-	virtual bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const override
-	{
-		if (inLayer1 == Layers::MOVING) return true;
+	// Throws std::runtime_error when the config names a layer that does not exist
+	void build(const PhysLayerConfig& config);
 
-		if (inLayer1 == Layers::NON_MOVING) return inLayer2 == JPH::BroadPhaseLayer(1);
+	JPH::uint GetNumBroadPhaseLayers() const override { return _numBroadPhaseLayers; }
 
-		return false;
+	JPH::BroadPhaseLayer GetBroadPhaseLayer(JPH::ObjectLayer inLayer) const override
+	{
+		JPH_ASSERT(inLayer < _numObjectLayers);
+		return JPH::BroadPhaseLayer(_broadPhaseOf[inLayer]);
 	}
-};
 
-HALCYON_API class MyObjectLayerPairFilter final : public JPH::ObjectLayerPairFilter
-{
-public:
-	virtual bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::ObjectLayer inLayer2) const override
+#if defined(JPH_EXTERNAL_PROFILE) || defined(JPH_PROFILE_ENABLED)
+	const char* GetBroadPhaseLayerName(JPH::BroadPhaseLayer inLayer) const override
+	{
+		return _broadPhaseNames[static_cast<JPH::BroadPhaseLayer::Type>(inLayer)];
+	}
+#endif
+
+	bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::BroadPhaseLayer inLayer2) const override
 	{
-		if (inLayer1 == Layers::NON_MOVING && inLayer2 == Layers::NON_MOVING) return false;
+		return _objectVsBroadPhase[inLayer1 * _numBroadPhaseLayers + static_cast<JPH::BroadPhaseLayer::Type>(inLayer2)];
+	}
 
-		return true;
+	bool ShouldCollide(JPH::ObjectLayer inLayer1, JPH::ObjectLayer inLayer2) const override
+	{
+		return _objectPairs[inLayer1 * _numObjectLayers + inLayer2];
 	}
+
+	uint32_t numObjectLayers() const { return _numObjectLayers; }
+
+private:
+	uint32_t _numObjectLayers = 0;
+	uint32_t _numBroadPhaseLayers = 0;
+	std::vector<uint8_t> _broadPhaseOf;
+	std::vector<const char*> _broadPhaseNames;
+	// Row-major, one byte per entry: [object layer][object layer] and [object layer][broad-phase layer]
+	std::vector<uint8_t> _objectPairs;
+	std::vector<uint8_t> _objectVsBroadPhase;
 };
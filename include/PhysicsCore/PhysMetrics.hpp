@@ -0,0 +1,19 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include <cstdint>
+
+// Load of the physics world, for sizing its budget. Step times are also recorded in the FrameProfiler as the
+// PhysUpdateSystem scope, with full statistics.
+struct HALCYON_API PhysMetrics
+{
+	uint64_t ticks = 0;
+	float lastStepMs = 0.0f; // PhysicsSystem::Update of the latest tick
+	float avgStepMs = 0.0f;  // Exponential average over roughly the last second
+	float tickRate = 0.0f;   // After adaptation (PhysTickRateComponent::adaptive)
+	int collisionSteps = 0;
+	uint64_t lateTicks = 0;      // Ticks that finished more than a tick interval behind schedule
+	double droppedSeconds = 0.0; // Simulated time skipped to catch up with the wall clock
+	uint32_t activeBodies = 0;
+	uint32_t bodies = 0;
+};
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "PhysicsCore/PhysShapes.hpp"
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/Body/BodyID.h>
+#include <Orhescyon/Entitys/Entity.hpp>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/gtc/quaternion.hpp>
+#include <cstdint>
+#include <variant>
+#include <vector>
+
+// Bit i selects object layer i; layers past 63 cannot be queried
+constexpr uint64_t kAllPhysLayers = ~0ull;
+
+using PhysQueryShape = std::variant<Sphere, Box>;
+
+struct HALCYON_API PhysRayQuery
+{
+	glm::vec3 origin{0.0f};
+	glm::vec3 direction{0.0f, 0.0f, -1.0f}; // Normalized
+	float maxDistance = 100.0f;
+	uint64_t layerMask = kAllPhysLayers;
+};
+
+struct HALCYON_API PhysShapeCastQuery
+{
+	PhysQueryShape shape = Sphere{0.5f};
+	glm::vec3 origin{0.0f};
+	glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+	glm::vec3 direction{0.0f, 0.0f, -1.0f}; // Normalized
+	float maxDistance = 100.0f;
+	uint64_t layerMask = kAllPhysLayers;
+};
+
+struct HALCYON_API PhysOverlapQuery
+{
+	PhysQueryShape shape = Sphere{0.5f};
+	glm::vec3 position{0.0f};
+	glm::quat rotation{1.0f, 0.0f, 0.0f, 0.0f};
+	uint64_t layerMask = kAllPhysLayers;
+	uint32_t maxHits = 16; // Bodies past this many are dropped
+};
+
+// Queries submitted together and answered together
+struct HALCYON_API PhysQueryBatch
+{
+	std::vector<PhysRayQuery> rays;
+	std::vector<PhysShapeCastQuery> casts;
+	std::vector<PhysOverlapQuery> overlaps;
+};
+
+// Closest hit of a ray or cast. `body` is invalid when nothing was hit.
+struct HALCYON_API PhysQueryHit
+{
+	JPH::BodyID body;
+	Orhescyon::Entity entity = Orhescyon::Entity::invalid(); // Invalid for bodies that belong to no agent
+	float distance = 0.0f;
+	glm::vec3 position{0.0f};
+	glm::vec3 normal{0.0f};
+};
+
+struct HALCYON_API PhysOverlapRange
+{
+	uint32_t first = 0; // Into overlapBodies/overlapEntities
+	uint32_t count = 0;
+};
+
+// Dense, in submission order: rayHits[i] answers rays[i], castHits[i] casts[i], overlapRanges[i] overlaps[i]
+struct HALCYON_API PhysQueryResults
+{
+	std::vector<PhysQueryHit> rayHits;
+	std::vector<PhysQueryHit> castHits;
+	std::vector<PhysOverlapRange> overlapRanges;
+	std::vector<JPH::BodyID> overlapBodies;
+	std::vector<Orhescyon::Entity> overlapEntities;
+	uint64_t tick = 0; // Physics tick the world was queried after
+};
+
+struct HALCYON_API PhysQueryTicket
+{
+	uint64_t id = 0; // 0 is never issued
+};
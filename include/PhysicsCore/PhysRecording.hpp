@@ -0,0 +1,64 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "PhysicsCore/Components/PhysSettingsComponent.hpp"
+#include "PhysicsCore/PhysCommand.hpp"
+#include "TaskScheduler.hpp"
+#include <Jolt/Jolt.h>
+#include <Jolt/Core/StreamWrapper.h>
+#include <Jolt/Physics/Body/BodyCreationSettings.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <vector>
+
+// Writes everything a physics session is driven by: the world settings, body batches in the order they were added
+// and each tick's delta time and commands, followed by a hash of every body's state after the tick. A replay re-runs
+// the session from that alone and can name the first tick it diverges on. Changes made through BodyInterface
+// directly rather than through PhysManager are not recorded, so a session with them does not replay.
+class HALCYON_API PhysRecorder
+{
+public:
+	// Throws std::runtime_error when the file cannot be created
+	PhysRecorder(const std::filesystem::path& path, const PhysSettingsComponent& settings);
+	~PhysRecorder();
+
+	PhysRecorder(const PhysRecorder&) = delete;
+	PhysRecorder& operator=(const PhysRecorder&) = delete;
+
+	// One record per AddBodiesPrepare/Finalize batch; `settings[i]` created `ids[i]`
+	void recordBodies(std::span<const JPH::BodyID> ids, std::span<const JPH::BodyCreationSettings> settings,
+	                  JPH::EActivation activation);
+	void recordOptimizeBroadPhase();
+	void recordRollback(uint64_t tick);
+	// After the update: `commands` were applied right before it
+	void recordTick(float deltaTime, int collisionSteps, std::span<const PhysCommand> commands,
+	                const JPH::PhysicsSystem& physicsSystem);
+
+private:
+	std::mutex _mutex;
+	std::ofstream _file;
+	JPH::StreamOutWrapper _stream;
+	// Shapes and materials shared by several bodies are written once
+	JPH::BodyCreationSettings::ShapeToIDMap _shapeIDs;
+	JPH::BodyCreationSettings::MaterialToIDMap _materialIDs;
+	JPH::BodyCreationSettings::GroupFilterToIDMap _groupFilterIDs;
+	JPH::BodyIDVector _bodies;
+};
+
+struct HALCYON_API PhysReplayResult
+{
+	std::vector<double> stepMilliseconds; // PhysicsSystem::Update per tick, ticks re-run after a rollback included
+	double wallSeconds = 0.0;             // Whole replay, body creation included
+	uint32_t peakBodies = 0;
+	int64_t firstDivergentTick = -1; // Index into stepMilliseconds; -1 when every tick matched the recording
+	bool truncated = false;          // The recording ends without its end marker (the session crashed)
+};
+
+// Re-simulates a recording in a world of its own, one tick after the other as fast as the machine allows, with
+// physics jobs on `scheduler`. Needs Jolt's types registered; results only match on the same Jolt build, and across
+// platforms only with JPH_CROSS_PLATFORM_DETERMINISTIC. Throws std::runtime_error on a file it cannot read.
+HALCYON_API PhysReplayResult replayPhysRecording(const std::filesystem::path& path, TaskScheduler& scheduler);
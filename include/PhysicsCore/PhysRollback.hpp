@@ -0,0 +1,36 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/PhysicsSystem.h>
+#include <Jolt/Physics/StateRecorderImpl.h>
+#include <cstdint>
+#include <vector>
+
+// Ring of full world states (bodies, contact cache, constraints) saved through Jolt's StateRecorder. A state only
+// restores into the same set of bodies it was saved from: adding or removing bodies since makes restore fail.
+class HALCYON_API PhysRollbackBuffer
+{
+public:
+	explicit PhysRollbackBuffer(uint32_t capacity = 0);
+
+	// Overwrites the oldest state once full
+	void save(uint64_t tick, const JPH::PhysicsSystem& physicsSystem);
+	// False when `tick` is not held or Jolt rejects the state. On success, states saved after `tick` are dropped:
+	// that future no longer happens.
+	bool restore(uint64_t tick, JPH::PhysicsSystem& physicsSystem);
+
+	uint32_t capacity() const { return static_cast<uint32_t>(_entries.size()); }
+	bool holds(uint64_t tick) const;
+
+private:
+	struct Entry
+	{
+		uint64_t tick = 0;
+		bool valid = false;
+		JPH::StateRecorderImpl state;
+	};
+
+	std::vector<Entry> _entries;
+	uint32_t _next = 0;
+};
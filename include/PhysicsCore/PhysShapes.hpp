@@ -37,6 +37,20 @@ struct HALCYON_API ConvexHull
 
 using Shape = std::variant<Sphere, Box, Capsule, Cylinder, ConvexHull>;
 
+// Cooked shape owned by PhysShapeCache. Bodies made from the same handle share one JPH::Shape.
+struct HALCYON_API ShapeHandle
+{
+	int id = -1;
+};
+
+// How a collider is cooked from render geometry
+enum class MeshColliderKind
+{
+	TriangleMesh,      // Exact triangles; static and kinematic bodies only
+	ConvexHull,        // One hull around every vertex
+	ConvexPerPrimitive // A compound of one hull per primitive, a coarse convex decomposition for dynamic bodies
+};
+
 enum class Motion
 {
 	Static,
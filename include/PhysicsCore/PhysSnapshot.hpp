@@ -0,0 +1,36 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include <Jolt/Jolt.h>
+#include <Jolt/Math/Vec3.h>
+#include <Jolt/Math/Quat.h>
+#include <Orhescyon/Entitys/Entity.hpp>
+#include <cstdint>
+#include <vector>
+
+// previous and current, the two a slow reader may still have pinned (PhysManager::pinSnapshots), and one to write:
+// the writer always finds a slot nobody can be reading
+const int maxSnapshots = 5;
+
+// An agent whose transform changed in the tick a snapshot holds. `teleport` marks agents that joined in that tick:
+// the previous snapshot has nothing for them to interpolate from.
+struct HALCYON_API PhysMovedAgent
+{
+	Orhescyon::Entity entity;
+	uint32_t slot;
+	bool teleport;
+};
+
+// Body transforms after one physics tick, dense and indexed by agent slot (PhysSnapshotSystem assigns the slots).
+// Every slot is valid: agents that did not move carry their transform over from the snapshot before.
+struct HALCYON_API PhysSnapshot
+{
+	std::vector<JPH::Vec3> positions;
+	std::vector<JPH::Quat> rotations;
+	std::vector<Orhescyon::Entity> entities; // Invalid for free slots
+	std::vector<PhysMovedAgent> moved;
+	// Per slot, the last tick it was listed as moved in, so a reader that skipped ticks can tell what changed since
+	std::vector<uint64_t> movedTicks;
+	uint64_t tick = 0;
+	double time = 0.0; // Scheduled steady_clock time (seconds) of the tick, 0 until first written
+};
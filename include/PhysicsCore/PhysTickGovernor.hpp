@@ -0,0 +1,29 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "PhysicsCore/Components/PhysTickRateComponent.hpp"
+#include <cstdint>
+
+// Picks the length and collision steps of each real-time tick from PhysTickRateComponent. With `adaptive` set it
+// tracks how much of its interval each tick takes and lowers the rate while the physics thread cannot keep up;
+// otherwise it passes the component through. Settings changed at runtime apply from the next tick.
+class HALCYON_API PhysTickGovernor
+{
+public:
+	double interval(const PhysTickRateComponent& config) const { return _divisor / static_cast<double>(config.rate); }
+	float deltaTime(const PhysTickRateComponent& config) const { return static_cast<float>(_divisor) / config.rate; }
+	// Kept at the configured count: a tick costs about the same whatever its length, which is what makes a lower
+	// rate cheaper. Multiplying the steps with the divisor would keep the work per simulated second unchanged.
+	int collisionSteps(const PhysTickRateComponent& config) const { return config.collisionSteps; }
+
+	// After each tick: how long it took, and whether it ended more than an interval behind schedule
+	void onTick(const PhysTickRateComponent& config, double workSeconds, bool late);
+
+	uint32_t divisor() const { return _divisor; }
+
+private:
+	uint32_t _divisor = 1; // Configured rate over the current one, a power of two
+	float _load = 0.0f;    // Smoothed fraction of the interval a tick takes
+	uint32_t _overloadedTicks = 0;
+	uint32_t _idleTicks = 0;
+};
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include <Orhescyon/GeneralManager.hpp>
+#include <Orhescyon/Systems/SystemCore.hpp>
+
+// Answers the scene query batches submitted to PhysManager::queries since the last tick, once that tick's snapshot
+// is published and before the next PhysicsSystem::Update starts
+using Orhescyon::GeneralManager;
+class HALCYON_API PhysQuerySystem : public Orhescyon::SystemCore<PhysQuerySystem>
+{
+public:
+	void update(GeneralManager& gm) override;
+	void onRegistered(GeneralManager& gm) override;
+	void onShutdown(GeneralManager& gm) override;
+	std::string_view getSystemManagerName() const override
+	{
+		return "physics";
+	}
+};
@@ -1,14 +1,20 @@
 #pragma once
 
 #include "HalcyonExport.hpp"
+#include <cstdint>
+#include <utility>
 #include <vector>
 #include <mutex>
 #include <Orhescyon/GeneralManager.hpp>
 #include <Orhescyon/Systems/SystemCore.hpp>
+#include <Jolt/Jolt.h>
+#include <Jolt/Physics/PhysicsSystem.h>
 
 #include "PhysicsCore/Components/PhysTransformSnapshotComponent.hpp"
 #include "PhysicsCore/Components/PhysBodyComponent.hpp"
 
+// Publishes body transforms into PhysManager::snapshots after every tick. Subscribed entities get a stable agent
+// slot and their body's user data points back at it, so only the active bodies are visited, without body locks.
 using Orhescyon::GeneralManager;
 class HALCYON_API PhysSnapshotSystem
     : public Orhescyon::SystemCore<PhysSnapshotSystem, PhysTransformSnapshotComponent, PhysBodyComponent>
@@ -17,17 +23,27 @@ public:
 	struct HALCYON_API Agent
 	{
 		Orhescyon::Entity entity;
-		PhysTransformSnapshotComponent* transSnapshot;
-		PhysBodyComponent* physBody;
+		JPH::BodyID bodyID;
 	};
 
-	std::vector<Agent> _agents;
+	// Indexed by agent slot; free slots hold an invalid body
+	std::vector<Agent> _slots;
+	std::vector<uint32_t> _freeSlots;
+	// Freed slots with the tick they were freed on. Reused only once no published snapshot still lists them.
+	std::vector<std::pair<uint32_t, uint64_t>> _retiredSlots;
+	std::vector<uint32_t> _spawned;          // Joined since the last snapshot
+	std::vector<uint32_t> _previouslyActive; // Active in the last tick
+	std::vector<uint32_t> _activeSlots;
+	std::vector<uint64_t> _movedTick; // Per slot, the tick it was last listed as moved
+	JPH::BodyIDVector _activeBodies;
+	uint64_t _tick = 0;
 
 	std::mutex _pendingMutex;
 	std::vector<Agent> _pendingAdd;
 	std::vector<Orhescyon::Entity> _pendingRemove;
 
-	void applyPendingChanges();
+	// Freed slots a snapshot pinned by the renderer still lists wait for it (PhysManager::oldestPinnedTick)
+	void applyPendingChanges(JPH::BodyInterface& bodyInterface, uint64_t oldestPinnedTick);
 
 	void update(GeneralManager& gm) override;
 	void onRegistered(GeneralManager& gm) override;
@@ -38,4 +54,4 @@ public:
 	{
 		return "physics";
 	}
-};
\ No newline at end of file
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include <cstdint>
+
+// Timestamps (steady_clock nanoseconds) of the input consumed since the last submit, for input-to-submit latency.
+struct HALCYON_API InputTimingComponent
+{
+	uint64_t oldestEventNs = 0; // 0 while no event has been consumed
+	uint64_t newestEventNs = 0;
+	uint64_t droppedEvents = 0; // Lost to a full input ring since start
+};
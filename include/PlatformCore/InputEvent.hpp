@@ -1,6 +1,8 @@
 #pragma once
 
 #include "HalcyonExport.hpp"
+#include <cstdint>
+
 struct HALCYON_API InputEvent
 {
 	enum class Type
@@ -13,6 +15,8 @@ struct HALCYON_API InputEvent
 	};
 
 	Type Type;
+	uint64_t timestampNs = 0; // steady_clock time the callback fired
+
 
 	int key = 0;
 	int action = 0;
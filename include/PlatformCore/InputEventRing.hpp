@@ -0,0 +1,56 @@
+#pragma once
+
+#include "PlatformCore/InputEvent.hpp"
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-capacity single-producer/single-consumer ring of input events. The producer is the thread running the GLFW
+// callbacks; the consumer takes everything published so far in one pass. Neither side locks or allocates. When the
+// consumer falls a whole ring behind, new events are dropped and counted instead of overwriting unread ones.
+class InputEventRing
+{
+public:
+	static constexpr size_t kCapacity = 4096; // Half a second of an 8 kHz mouse; must be a power of two
+
+	// Producer side. False when the ring is full and the event was dropped.
+	bool push(const InputEvent& event)
+	{
+		const size_t head = _head.load(std::memory_order_relaxed);
+		if (head - _tail.load(std::memory_order_acquire) == kCapacity)
+		{
+			_dropped.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		_events[head & kMask] = event;
+		_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Consumer side. Calls `fn(const InputEvent&)` for every event published before the call, oldest first, then
+	// releases them all at once. Returns how many were consumed.
+	template <typename Fn> size_t drain(Fn&& fn)
+	{
+		const size_t tail = _tail.load(std::memory_order_relaxed);
+		const size_t head = _head.load(std::memory_order_acquire);
+		for (size_t i = tail; i != head; ++i) fn(_events[i & kMask]);
+		_tail.store(head, std::memory_order_release);
+		return head - tail;
+	}
+
+	bool empty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+	size_t size() const { return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire); }
+	// Events lost to a full ring since construction
+	uint64_t droppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+	static constexpr size_t kMask = kCapacity - 1;
+	static_assert((kCapacity & kMask) == 0, "InputEventRing capacity must be a power of two");
+
+	std::array<InputEvent, kCapacity> _events{};
+	// Separate cache lines, so the producer's and consumer's stores do not contend
+	alignas(64) std::atomic<size_t> _head{0};
+	alignas(64) std::atomic<size_t> _tail{0};
+	std::atomic<uint64_t> _dropped{0};
+};
@@ -8,15 +8,21 @@
 #include "PlatformCore/Components/KeyboardStateComponent.hpp"
 #include "PlatformCore/Components/MouseStateComponent.hpp"
 #include "PlatformCore/Components/ScrollDeltaComponent.hpp"
+#include "PlatformCore/Components/InputTimingComponent.hpp"
 #include "PlatformCore/Components/WindowComponent.hpp"
 
 using Orhescyon::GeneralManager;
 class HALCYON_API InputSolverSystem
     : public Orhescyon::SystemCore<InputSolverSystem, WindowComponent, CursorPositionComponent, WindowSizeComponent,
-                        KeyboardStateComponent, MouseStateComponent, ScrollDeltaComponent>
+                        KeyboardStateComponent, MouseStateComponent, ScrollDeltaComponent, InputTimingComponent>
 {
 public:
 	void update(GeneralManager& gm) override;
 	void onRegistered(GeneralManager& gm) override;
 	void onShutdown(GeneralManager& gm) override;
+
+	// Applies every event queued on `window` in one pass. Also used by the late latch in FrameEndSystem.
+	static void drainInputQueue(Window& window, CursorPositionComponent& cursorPosition, WindowSizeComponent& windowSize,
+	                            KeyboardStateComponent& keyboardState, MouseStateComponent& mouseState,
+	                            ScrollDeltaComponent& scrollDelta, InputTimingComponent& timing);
 };
\ No newline at end of file
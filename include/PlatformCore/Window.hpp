@@ -1,12 +1,12 @@
 #pragma once
 
 #include "HalcyonExport.hpp"
-#include <queue>
 #include <vector>
 #include <functional>
 #include <mutex>
 #include <string>
-#include "PlatformCore/InputEvent.hpp"
+#include "PlatformCore/InputEventRing.hpp"
+#include "PlatformCore/WindowDesc.hpp"
 #include <vulkan/vulkan.hpp>
 
 struct GLFWwindow;
@@ -19,16 +19,23 @@ private:
 	mutable std::vector<std::function<void()>> _deferredActions;
 	int width;
 	int height;
+	bool _headless = false;
+	bool _headlessShouldClose = false;
 
 public:
 	Window(const char* title);
+	// Headless windows own no GLFW window: input stays empty, the size is fixed at desc.width x desc.height and
+	// closing is only requested through setShouldClose.
+	explicit Window(const WindowDesc& desc);
 
 	~Window();
 
-	// Returns raw GLFW window handle.
+	// Returns raw GLFW window handle. Null for headless windows.
 	GLFWwindow* getHandle() const;
+	bool isHeadless() const;
 	bool framebufferResized = false;
-	std::queue<InputEvent> inputQueue;
+	// Filled by the GLFW callbacks, drained by InputSolverSystem
+	InputEventRing inputQueue;
 
 	bool shouldClose() const;
 	void setShouldClose(bool value);
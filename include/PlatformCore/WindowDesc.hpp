@@ -0,0 +1,14 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include <cstdint>
+
+struct HALCYON_API WindowDesc
+{
+	const char* title = "Halcyon";
+	// No OS window, surface or swap chain: frames render into offscreen images of width x height and are never
+	// presented. Used by automated benchmarks on machines without a display.
+	bool headless = false;
+	uint32_t width = 1920; // Headless only; a real window takes the primary monitor's size
+	uint32_t height = 1080;
+};
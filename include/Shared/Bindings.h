@@ -31,6 +31,7 @@
 #define BIND_TEXTURES_REFLECTION_CUBEMAPS 8
 
 #define MAX_BINDLESS_TEXTURES 2048
+#define MAX_MIP_GEN_LEVELS 16u
 #define MAX_POINT_LIGHTS 120u
 #define MAX_REFLECTION_PROBES 32u
 #define MAX_FORWARD_CLUSTER_REFERENCES 16u
@@ -10,7 +10,11 @@ struct HALCYON_API CameraData
 	float4x4 invViewProj;
 	float4 cameraPositionAndPadding;
 	float4 frustumPlanes[6];
-	GPU_ALIGN(16) float2 screenSize;
+	float4x4 viewProjNoJitter;
+	float4x4 prevViewProjNoJitter; // Previous frame, for motion vectors
+	float4 jitter;                 // xy: subpixel jitter of this frame in NDC, zw: unused
+	GPU_ALIGN(16) float2 screenSize; // Render extent, smaller than the output when TAA upscales
+	float2 renderUvScale; // Render extent over the allocation of render-scaled streams (below 1 with dynamic res)
 };
 
 struct HALCYON_API IndirectDrawIndexedCommand
@@ -81,6 +85,7 @@ struct HALCYON_API GPU_ALIGN(16) ModelData
 struct HALCYON_API TransformData
 {
 	float4x4 model;
+	float4x4 prevModel; // Model matrix of the previous frame, for motion vectors
 };
 
 struct HALCYON_API GPU_ALIGN(16) SHGridInfo
@@ -152,14 +157,14 @@ struct HALCYON_API ForwardCluster
 };
 
 #ifdef __cplusplus
-static_assert(sizeof(CameraData) == 384);
+static_assert(sizeof(CameraData) == 528);
 static_assert(sizeof(IndirectDrawIndexedCommand) == 20);
 static_assert(sizeof(IndirectDrawCommand) == 16);
 static_assert(sizeof(IndirectDispatchCommand) == 16);
 static_assert(sizeof(DirectionalLightData) == 256);
 static_assert(sizeof(PointLightData) == 64);
 static_assert(sizeof(ModelData) == 48);
-static_assert(sizeof(TransformData) == 64);
+static_assert(sizeof(TransformData) == 128);
 static_assert(sizeof(SHGridInfo) == 64);
 static_assert(sizeof(SHProbeEntry) == 64);
 static_assert(sizeof(ReflectionProbeData) == 48);
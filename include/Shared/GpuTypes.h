@@ -13,6 +13,7 @@ using float2 = glm::vec2;
 using float3 = glm::vec3;
 using float4 = glm::vec4;
 using int3 = glm::ivec3;
+using uint2 = glm::uvec2;
 
 using float4x4 = glm::mat4;
 
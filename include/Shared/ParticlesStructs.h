@@ -2,21 +2,32 @@
 
 #include "GpuTypes.h"
 
+// Emiter slots; Particle::seedEmiter stores the slot in 16 bits
+#define MAX_NUMBER_EMITERS 16384u
+
+// Depth sort runs over the alive list padded to a power of two; a workgroup sorts one block in shared memory
+#define PARTICLE_SORT_CAPACITY 1048576u
+#define PARTICLE_SORT_BLOCK 1024u
+
+// 32 bytes. Billboards only need a uniform scale and an in-plane rotation, so both are stored as halves;
+// see Common/Particles.slang for the pack/unpack helpers.
 struct HALCYON_API GPU_ALIGN(16) Particle
 {
 	GPU_ALIGN(16) float3 position;
-	GPU_ALIGN(4) uint seed;
-	GPU_ALIGN(16) float3 scale;
 	GPU_ALIGN(4) float liveTime;
-	GPU_ALIGN(16) float3 rotation;
-	GPU_ALIGN(4) uint emiterIndex;
-	GPU_ALIGN(16) float4 color;
-}; // optimise to hold less storage
+	GPU_ALIGN(4) uint seedEmiter;    // seed in the high 16 bits, emiter index in the low 16
+	GPU_ALIGN(4) uint scaleRotation; // half scale in the low 16 bits, half rotation (radians) in the high 16
+	GPU_ALIGN(8) uint2 color;        // half4 rgba
+};
 
+// Persistent per-slot emiter table. Only rewritten when the emiter changes; spawn counts go through the
+// per-frame EmiterSpawnRange list instead.
 struct HALCYON_API GPU_ALIGN(16) EmiterData
 {
 	GPU_ALIGN(4) bool active;
-	GPU_ALIGN(4) uint spawnCount;
+	GPU_ALIGN(4) uint sortByDepth;    // Particles of this emiter are drawn back to front
+	GPU_ALIGN(4) float stepScale;     // Multiplies the frame delta time; 0 while throttled off screen, >1 on catch-up
+	GPU_ALIGN(4) uint depthCollision; // Collide against the scene depth buffer
 	GPU_ALIGN(16) float3 initialPosition;
 	GPU_ALIGN(16) float3 directionalVector;
 	GPU_ALIGN(8) float2 spawnRadius; // 1-min, 2-max
@@ -25,6 +36,24 @@ struct HALCYON_API GPU_ALIGN(16) EmiterData
 	GPU_ALIGN(8) float2 scale; // 1-min, 2-max
 	GPU_ALIGN(16) float4 colorStart;
 	GPU_ALIGN(16) float4 colorEnd;
+	GPU_ALIGN(8) float2 collisionResponse; // 1-restitution, 2-friction
+};
+
+// One entry per emiter spawning this frame, in slot order of the upload
+struct HALCYON_API EmiterSpawnRange
+{
+	uint emiterIndex;
+	uint firstParticle; // Exclusive prefix sum of the spawn counts before this entry
+};
+
+// Indirect dispatch for the spawner plus the size of this frame's spawn list
+struct HALCYON_API SpawnDispatchCommand
+{
+	uint x;
+	uint y;
+	uint z;
+	uint spawnCount;
+	uint rangeCount;
 };
 
 struct HALCYON_API GPU_ALIGN(16) ParticlesMetadata
@@ -32,4 +61,19 @@ struct HALCYON_API GPU_ALIGN(16) ParticlesMetadata
 	GPU_ALIGN(4) uint bottomOfStack;
 	GPU_ALIGN(4) uint maxNumberOfPatricles;
 	GPU_ALIGN(4) uint numberOfEmiters;
-};
\ No newline at end of file
+};
+
+// Key/value pair for the alive-index depth sort
+struct HALCYON_API ParticleSortEntry
+{
+	uint key;
+	uint index;
+};
+
+#ifdef __cplusplus
+static_assert(sizeof(Particle) == 32);
+static_assert(sizeof(EmiterData) == 128);
+static_assert(sizeof(ParticleSortEntry) == 8);
+static_assert(sizeof(EmiterSpawnRange) == 8);
+static_assert(sizeof(SpawnDispatchCommand) == 20);
+#endif
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "AudioCore/AudioHandles.hpp"
+#include "AudioCore/Components/AudioSourceComponent.hpp"
+#include <Orhescyon/GeneralManager.hpp>
+#include <Orhescyon/Entitys/Entity.hpp>
+#include <cstdint>
+#include <string>
+
+namespace Smith::Audio
+{
+// Throws std::runtime_error when the file cannot be opened or decoded
+HALCYON_API SoundHandle loadSound(Orhescyon::GeneralManager& gm, const std::string& filepath,
+                                  SoundLoadMode mode = SoundLoadMode::Preload, uint32_t maxVoices = 8);
+// Makes `e` emit `source` from where its GlobalTransformComponent puts it; one is added at the origin if missing
+HALCYON_API void forgeSource(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, AudioSourceComponent source);
+} // namespace Smith::Audio
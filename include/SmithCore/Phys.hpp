@@ -6,6 +6,8 @@
 #include "PhysicsCore/Components/PhysTransformSnapshotComponent.hpp"
 #include "PhysicsCore/Systems/PhysSnapshotSystem.hpp"
 #include "PhysicsCore/PhysShapes.hpp"
+#include "PhysicsCore/PhysQuery.hpp"
+#include "GraphicsCore/Resources/Managers/ResourceHandles.hpp"
 #include "GraphicsCore/Systems/PhysSyncSystem.hpp"
 #include <Jolt/Jolt.h>
 #include <Jolt/Physics/Collision/Shape/Shape.h>
@@ -19,5 +21,13 @@ HALCYON_API void forgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, B
 HALCYON_API void forgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, Body b, Capsule capsule);
 HALCYON_API void forgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, Body b, Cylinder cylinder);
 HALCYON_API void forgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, Body b, ConvexHull convexHull);
+HALCYON_API void forgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, Body b, ShapeHandle shape);
 HALCYON_API void forgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, JPH::BodyID bodyID);
+// Cooks a collider from a loaded model's geometry on a worker thread, or reads the one cooked on an earlier run.
+// Returns at once; bodies can be forged from the handle once PhysShapeCache::state reports it Ready.
+HALCYON_API ShapeHandle cookMeshCollider(Orhescyon::GeneralManager& gm, ModelHandle model, MeshColliderKind kind);
+// Runs after the next physics tick; collect the results with fetchQueryResults from a later frame
+HALCYON_API PhysQueryTicket submitQueries(Orhescyon::GeneralManager& gm, PhysQueryBatch batch);
+// False while the batch has not run yet
+HALCYON_API bool fetchQueryResults(Orhescyon::GeneralManager& gm, PhysQueryTicket ticket, PhysQueryResults& out);
 } // namespace Smith::Phys
@@ -0,0 +1,117 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum class TaskPriority : uint8_t
+{
+	High,   // Frame-critical work the render thread waits on (transform propagation, draw lists)
+	Normal, // Physics jobs
+	Low     // Background work nobody waits on within a frame (asset loading, cooking)
+};
+
+struct HALCYON_API TaskSchedulerDesc
+{
+	uint32_t workerCount = 0;     // 0: hardware threads minus reservedThreads, at least one
+	uint32_t reservedThreads = 2; // Cores left to the main/render thread and the physics tick thread
+	// Worker i runs only on core reservedThreads + i, so workers never migrate onto the reserved cores
+	bool pinWorkers = false;
+};
+
+// Number of tasks submitted against it that have not finished yet
+class HALCYON_API TaskCounter
+{
+public:
+	bool done() const { return _pending.load(std::memory_order_acquire) == 0; }
+
+private:
+	friend class TaskScheduler;
+	std::atomic<uint32_t> _pending{0};
+};
+
+// Engine-wide worker pool shared by physics, asset loading and per-frame parallel loops, so the engine runs one
+// thread per spare core instead of a pool per subsystem. Each worker owns a deque per priority: it takes its own
+// newest task and steals the oldest from others, and any High task anywhere is taken before a Normal one. A task
+// that throws is logged and counts as done.
+class HALCYON_API TaskScheduler
+{
+public:
+	using Task = std::function<void()>;
+
+	explicit TaskScheduler(const TaskSchedulerDesc& desc = {});
+	~TaskScheduler();
+
+	TaskScheduler(const TaskScheduler&) = delete;
+	TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+	// Thread-safe. `counter`, when given, must outlive the task.
+	void submit(Task task, TaskPriority priority = TaskPriority::Normal, TaskCounter* counter = nullptr);
+	// Runs queued tasks of `helpUpTo` priority or more urgent on the calling thread until `counter` drains, so a
+	// task may wait on tasks it spawned. Lower-priority work is left to the workers, so waiting on the render thread
+	// never picks up a long background job.
+	void wait(TaskCounter& counter, TaskPriority helpUpTo = TaskPriority::Normal);
+
+	// Calls fn(begin, end) over [0, count) in chunks of `grain`, the first chunk on the calling thread. An exception
+	// from that chunk is rethrown once the others have finished.
+	template <typename Fn>
+	void parallelFor(size_t count, size_t grain, Fn&& fn, TaskPriority priority = TaskPriority::High)
+	{
+		if (count == 0) return;
+		grain = std::max<size_t>(grain, 1);
+		TaskCounter counter;
+		for (size_t begin = grain; begin < count; begin += grain)
+			submit([&fn, begin, end = std::min(begin + grain, count)]() { fn(begin, end); }, priority, &counter);
+		// The submitted chunks reference fn and counter, so they must drain before an exception leaves this frame
+		std::exception_ptr inlineException;
+		try
+		{
+			fn(size_t{0}, std::min(grain, count));
+		}
+		catch (...)
+		{
+			inlineException = std::current_exception();
+		}
+		wait(counter, priority);
+		if (inlineException) std::rethrow_exception(inlineException);
+	}
+
+	uint32_t workerCount() const { return static_cast<uint32_t>(_workers.size()); }
+
+private:
+	static constexpr size_t kPriorityCount = 3;
+
+	struct QueuedTask
+	{
+		Task task;
+		TaskCounter* counter = nullptr;
+	};
+
+	struct Worker
+	{
+		std::mutex mutex;
+		std::deque<QueuedTask> queues[kPriorityCount];
+	};
+
+	void workerLoop(uint32_t index, std::stop_token stopToken);
+	// Own queue first (newest), then the others (oldest), one priority level at a time
+	bool tryPop(uint32_t self, TaskPriority helpUpTo, QueuedTask& out);
+	static void run(QueuedTask& queued);
+
+	std::vector<std::unique_ptr<Worker>> _workers;
+	std::atomic<uint32_t> _nextQueue{0}; // Round-robin target for submits from outside the pool
+	std::atomic<uint32_t> _queued{0};
+	std::mutex _sleepMutex;
+	std::condition_variable_any _sleepCv;
+	std::vector<std::jthread> _threads;
+};
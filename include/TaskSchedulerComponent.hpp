@@ -0,0 +1,12 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+#include "TaskScheduler.hpp"
+
+struct HALCYON_API TaskSchedulerComponent
+{
+	TaskScheduler* scheduler = nullptr;
+
+	TaskSchedulerComponent() = default;
+	TaskSchedulerComponent(TaskScheduler* s) : scheduler(s) {}
+};
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "HalcyonExport.hpp"
+struct HALCYON_API TaskSchedulerContext
+{
+};
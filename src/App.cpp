@@ -2,6 +2,7 @@
 
 #include <iostream>
 #include <exception>
+#include <cstdlib>
 
 #include "GraphicsCore/GraphicsInit/GraphicsInit.hpp"
 #include "MainLoop.hpp"
@@ -10,18 +11,35 @@
 
 #include "DeletionQueueComponent.hpp"
 #include "DeletionQueueContext.hpp"
+#include "FrameProfilerComponent.hpp"
+#include "FrameProfilerContext.hpp"
+#include "TaskSchedulerComponent.hpp"
+#include "TaskSchedulerContext.hpp"
 #include "AudioCore/AudioInit.hpp"
 
-App::App() : deletionQueue(&gm)
+App::App() : App(WindowDesc{}) {}
+
+App::App(const WindowDesc& windowDesc, const PhysSettingsComponent& physSettings,
+         const TaskSchedulerDesc& schedulerDesc)
+    : scheduler(std::make_unique<TaskScheduler>(schedulerDesc)), deletionQueue(&gm),
+      profiler(std::make_unique<FrameProfiler>())
 {
 	Orhescyon::Entity dqEntity = gm.createEntity();
 	gm.registerContext<DeletionQueueContext>(dqEntity);
 	gm.addComponent<DeletionQueueComponent>(dqEntity, &deletionQueue);
 
+	Orhescyon::Entity profilerEntity = gm.createEntity();
+	gm.registerContext<FrameProfilerContext>(profilerEntity);
+	gm.addComponent<FrameProfilerComponent>(profilerEntity, profiler.get());
+
+	Orhescyon::Entity schedulerEntity = gm.createEntity();
+	gm.registerContext<TaskSchedulerContext>(schedulerEntity);
+	gm.addComponent<TaskSchedulerComponent>(schedulerEntity, scheduler.get());
+
 	try
 	{
-		PhysicsInit::Run(gm);
-		PlatformInit::Run(gm);
+		PhysicsInit::Run(gm, physSettings);
+		PlatformInit::Run(gm, windowDesc);
 		GraphicsInit::Run(gm);
 		AudioInit::Run(gm);
 	}
@@ -37,6 +55,7 @@ using Orhescyon::GeneralManager;
 
 int App::run()
 {
+	int result = EXIT_SUCCESS;
 	try
 	{
 		MainLoop::startLoop(gm);
@@ -44,10 +63,16 @@ int App::run()
 	catch (const std::exception& e)
 	{
 		std::cerr << "ERROR::APP::MAINLOOP::Exception: " << e.what() << std::endl;
-		return EXIT_FAILURE;
+		result = EXIT_FAILURE;
 	}
 
-	return EXIT_SUCCESS;
+	// HALCYON_PROFILE_DUMP=<file.csv|file.json> writes the profiler history on exit, also in builds without dev tools
+	if (const char* dumpPath = std::getenv("HALCYON_PROFILE_DUMP"))
+	{
+		if (!profiler->dump(dumpPath)) std::cerr << "ERROR::APP::PROFILER::Could not write " << dumpPath << std::endl;
+	}
+
+	return result;
 }
 
 App App::create()
@@ -55,6 +80,11 @@ App App::create()
 	return App();
 }
 
+App App::createHeadless(uint32_t width, uint32_t height)
+{
+	return App(WindowDesc{.headless = true, .width = width, .height = height});
+}
+
 App& App::addStartUp(IStartUp& startUp)
 {
 	try
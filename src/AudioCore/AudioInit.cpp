@@ -9,6 +9,10 @@
 
 #include "AudioCore/Managers/AudioManager.hpp"
 #include "AudioCore/Components/AudioManagerComponent.hpp"
+#include "AudioCore/Components/AudioListenerComponent.hpp"
+#include "AudioCore/Components/AudioSourceComponent.hpp"
+#include "AudioCore/Systems/AudioSpatialSystem.hpp"
+#include "GraphicsCore/Components/GlobalTransformComponent.hpp"
 #include "AudioCore/AudioContexts.hpp"
 
 #pragma region Run
@@ -31,6 +35,7 @@
 void AudioInit::coreInit(Orhescyon::GeneralManager& gm)
 {
 	gm.registerSystemManager("audio");
+	gm.registerSystem<AudioSpatialSystem>().reads<GlobalTransformComponent>().writes<AudioSourceComponent>();
 }
 #pragma endregion
 
@@ -44,5 +49,9 @@ void AudioInit::initAudio(Orhescyon::GeneralManager& gm)
 	gm.addComponent<AudioManagerComponent>(audioManagerEntity, audioManager);
 	gm.registerContext<AudioManagerContext>(audioManagerEntity);
 	dq->push_function([audioManager]() { delete audioManager; });
+
+	Orhescyon::Entity audioListenerEntity = gm.createEntity();
+	gm.addComponent<AudioListenerComponent>(audioListenerEntity);
+	gm.registerContext<AudioListenerContext>(audioListenerEntity);
 }
 #pragma endregion
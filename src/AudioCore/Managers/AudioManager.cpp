@@ -1,35 +1,286 @@
 #define MINIAUDIO_IMPLEMENTATION
 #include "AudioCore/Managers/AudioManager.hpp"
 #include "../miniaudio.h"
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+struct Voice
+{
+	ma_sound sound;
+	bool initialized = false;
+	uint32_t generation = 0;
+	uint64_t startedAt = 0; // Play serial, to find the oldest voice to cut off
+
+	~Voice()
+	{
+		if (initialized) ma_sound_uninit(&sound);
+	}
+};
+
+struct Sound
+{
+	std::string path;
+	SoundLoadMode mode = SoundLoadMode::Preload;
+	uint32_t maxVoices = 1;
+	bool loaded = false;
+	uint64_t decodedBytes = 0;
+	float lengthSeconds = 0.0f;
+	// Grown on demand up to maxVoices. Heap-allocated: miniaudio keeps pointers into an initialized ma_sound.
+	std::vector<std::unique_ptr<Voice>> voices;
+};
+} // namespace
 
 struct AudioManager::Impl
 {
 	ma_engine engine;
-	ma_result result;
+	bool engineReady = false;
+	std::vector<Sound> sounds;
+	std::unordered_map<std::string, int> soundsByPath;
+	uint64_t playSerial = 0;
+	uint64_t voiceSteals = 0;
+	uint64_t failedPlays = 0;
+
+	Sound& requireSound(SoundHandle handle)
+	{
+		if (handle.id < 0 || handle.id >= static_cast<int>(sounds.size()) || !sounds[handle.id].loaded)
+			throw std::runtime_error("Invalid sound handle " + std::to_string(handle.id));
+		return sounds[handle.id];
+	}
+
+	Voice* findVoice(VoiceHandle handle) const
+	{
+		if (handle.sound < 0 || handle.sound >= static_cast<int>(sounds.size())) return nullptr;
+		const Sound& sound = sounds[handle.sound];
+		if (handle.voice >= sound.voices.size()) return nullptr;
+		Voice* voice = sound.voices[handle.voice].get();
+		return voice->generation == handle.generation ? voice : nullptr;
+	}
+
+	// Preloaded voices after the first share its decoded data instead of going back to the resource manager by path
+	ma_result initVoice(Sound& sound, Voice& voice)
+	{
+		if (sound.mode == SoundLoadMode::Preload && !sound.voices.empty())
+			return ma_sound_init_copy(&engine, &sound.voices.front()->sound, MA_SOUND_FLAG_NO_SPATIALIZATION, nullptr,
+			                          &voice.sound);
+		const ma_uint32 flags = MA_SOUND_FLAG_NO_SPATIALIZATION |
+		                        (sound.mode == SoundLoadMode::Stream ? MA_SOUND_FLAG_STREAM : MA_SOUND_FLAG_DECODE);
+		return ma_sound_init_from_file(&engine, sound.path.c_str(), flags, nullptr, nullptr, &voice.sound);
+	}
 };
 
 AudioManager::AudioManager()
 {
 	pImpl = new Impl();
-	pImpl->result = ma_engine_init(NULL, &pImpl->engine);
-	if (pImpl->result != MA_SUCCESS)
+	const ma_result result = ma_engine_init(NULL, &pImpl->engine);
+	pImpl->engineReady = result == MA_SUCCESS;
+	if (!pImpl->engineReady)
 	{
-		std::cerr << "MA: Error, on create MA: (" << pImpl->result << ")\n";
+		std::cerr << "ERROR::AUDIO::Could not start the audio engine: " << ma_result_description(result)
+		          << std::endl;
 	}
 }
 
 AudioManager::~AudioManager()
 {
-	ma_engine_uninit(&pImpl->engine);
+	// Voices before the engine they play on
+	pImpl->sounds.clear();
+	if (pImpl->engineReady) ma_engine_uninit(&pImpl->engine);
 	delete pImpl;
 }
 
-void AudioManager::play(const std::string& filepath)
+SoundHandle AudioManager::load(const std::string& filepath, SoundLoadMode mode, uint32_t maxVoices)
+{
+	auto it = pImpl->soundsByPath.find(filepath);
+	if (it != pImpl->soundsByPath.end()) return SoundHandle{it->second};
+
+	Sound sound;
+	sound.path = filepath;
+	sound.mode = mode;
+	sound.maxVoices = std::max(1u, maxVoices);
+
+	if (pImpl->engineReady)
+	{
+		// The first voice is made now, so preloaded sounds are decoded here rather than on their first play
+		auto voice = std::make_unique<Voice>();
+		const ma_result result = pImpl->initVoice(sound, *voice);
+		if (result != MA_SUCCESS)
+			throw std::runtime_error("Could not load sound " + filepath + ": " + ma_result_description(result));
+		voice->initialized = true;
+
+		if (ma_sound_get_length_in_seconds(&voice->sound, &sound.lengthSeconds) != MA_SUCCESS)
+			sound.lengthSeconds = 0.0f;
+		if (mode == SoundLoadMode::Preload)
+		{
+			ma_format format = ma_format_unknown;
+			ma_uint32 channels = 0;
+			ma_uint64 frames = 0;
+			if (ma_sound_get_data_format(&voice->sound, &format, &channels, nullptr, nullptr, 0) == MA_SUCCESS &&
+			    ma_sound_get_length_in_pcm_frames(&voice->sound, &frames) == MA_SUCCESS)
+				sound.decodedBytes = frames * ma_get_bytes_per_frame(format, channels);
+		}
+		sound.voices.push_back(std::move(voice));
+	}
+	sound.loaded = true;
+
+	const int id = static_cast<int>(pImpl->sounds.size());
+	pImpl->sounds.push_back(std::move(sound));
+	pImpl->soundsByPath.emplace(filepath, id);
+	return SoundHandle{id};
+}
+
+void AudioManager::unload(SoundHandle handle)
+{
+	Sound& sound = pImpl->requireSound(handle);
+	sound.voices.clear();
+	sound.loaded = false;
+	sound.decodedBytes = 0;
+	pImpl->soundsByPath.erase(sound.path);
+}
+
+bool AudioManager::isLoaded(SoundHandle handle) const
+{
+	return handle.id >= 0 && handle.id < static_cast<int>(pImpl->sounds.size()) && pImpl->sounds[handle.id].loaded;
+}
+
+uint32_t AudioManager::maxVoices(SoundHandle handle) const
+{
+	return pImpl->requireSound(handle).maxVoices;
+}
+
+float AudioManager::length(SoundHandle handle) const
+{
+	return pImpl->requireSound(handle).lengthSeconds;
+}
+
+VoiceHandle AudioManager::play(SoundHandle handle, float volume, bool loop, float startSeconds)
 {
-	pImpl->result = ma_engine_play_sound(&pImpl->engine, filepath.c_str(), NULL);
+	Sound& sound = pImpl->requireSound(handle);
+	if (!pImpl->engineReady)
+	{
+		++pImpl->failedPlays;
+		return {};
+	}
+
+	// A voice that has finished, else a new one while the pool has room, else the oldest
+	uint32_t index = 0;
+	while (index < sound.voices.size() && ma_sound_is_playing(&sound.voices[index]->sound)) ++index;
+	if (index == sound.voices.size() && sound.voices.size() < sound.maxVoices)
+	{
+		auto voice = std::make_unique<Voice>();
+		const ma_result result = pImpl->initVoice(sound, *voice);
+		if (result != MA_SUCCESS)
+		{
+			std::cerr << "ERROR::AUDIO::Could not start a voice of " << sound.path << ": "
+			          << ma_result_description(result) << std::endl;
+			++pImpl->failedPlays;
+			return {};
+		}
+		voice->initialized = true;
+		sound.voices.push_back(std::move(voice));
+	}
+	else if (index == sound.voices.size())
+	{
+		auto oldest = std::min_element(sound.voices.begin(), sound.voices.end(),
+		                               [](const std::unique_ptr<Voice>& a, const std::unique_ptr<Voice>& b)
+		                               { return a->startedAt < b->startedAt; });
+		index = static_cast<uint32_t>(oldest - sound.voices.begin());
+		++pImpl->voiceSteals;
+	}
+
+	Voice& voice = *sound.voices[index];
+	ma_sound_stop(&voice.sound);
+	if (startSeconds > 0.0f)
+		ma_sound_seek_to_second(&voice.sound, startSeconds);
+	else
+		ma_sound_seek_to_pcm_frame(&voice.sound, 0);
+	ma_sound_set_volume(&voice.sound, volume);
+	ma_sound_set_pan(&voice.sound, 0.0f);
+	ma_sound_set_pitch(&voice.sound, 1.0f);
+	ma_sound_set_looping(&voice.sound, loop ? MA_TRUE : MA_FALSE);
+	const ma_result result = ma_sound_start(&voice.sound);
+	if (result != MA_SUCCESS)
+	{
+		std::cerr << "ERROR::AUDIO::Could not play " << sound.path << ": " << ma_result_description(result)
+		          << std::endl;
+		++pImpl->failedPlays;
+		return {};
+	}
+
+	++voice.generation;
+	voice.startedAt = ++pImpl->playSerial;
+	return VoiceHandle{handle.id, index, voice.generation};
+}
 
-	if (pImpl->result != MA_SUCCESS)
+VoiceHandle AudioManager::play(const std::string& filepath)
+{
+	try
+	{
+		return play(load(filepath));
+	}
+	catch (const std::exception& e)
 	{
-		std::cerr << "MA: Error, on play: (" << pImpl->result << ")\n";
+		std::cerr << "ERROR::AUDIO::" << e.what() << std::endl;
+		++pImpl->failedPlays;
+		return {};
 	}
-}
\ No newline at end of file
+}
+
+void AudioManager::stop(VoiceHandle handle)
+{
+	if (Voice* voice = pImpl->findVoice(handle)) ma_sound_stop(&voice->sound);
+}
+
+void AudioManager::setVolume(VoiceHandle handle, float volume)
+{
+	if (Voice* voice = pImpl->findVoice(handle)) ma_sound_set_volume(&voice->sound, volume);
+}
+
+void AudioManager::setSpatial(VoiceHandle handle, float volume, float pan, float pitch)
+{
+	if (Voice* voice = pImpl->findVoice(handle))
+	{
+		ma_sound_set_volume(&voice->sound, volume);
+		ma_sound_set_pan(&voice->sound, pan);
+		ma_sound_set_pitch(&voice->sound, pitch);
+	}
+}
+
+bool AudioManager::isPlaying(VoiceHandle handle) const
+{
+	const Voice* voice = pImpl->findVoice(handle);
+	return voice && ma_sound_is_playing(&voice->sound);
+}
+
+float AudioManager::cursor(VoiceHandle handle) const
+{
+	const Voice* voice = pImpl->findVoice(handle);
+	float seconds = 0.0f;
+	if (!voice || ma_sound_get_cursor_in_seconds(&voice->sound, &seconds) != MA_SUCCESS) return 0.0f;
+	return seconds;
+}
+
+AudioMetrics AudioManager::metrics() const
+{
+	AudioMetrics metrics;
+	for (const Sound& sound : pImpl->sounds)
+	{
+		if (!sound.loaded) continue;
+		++metrics.sounds;
+		if (sound.mode == SoundLoadMode::Stream) ++metrics.streamedSounds;
+		metrics.decodedBytes += sound.decodedBytes;
+		metrics.voices += static_cast<uint32_t>(sound.voices.size());
+		for (const std::unique_ptr<Voice>& voice : sound.voices)
+		{
+			if (ma_sound_is_playing(&voice->sound)) ++metrics.playingVoices;
+		}
+	}
+	metrics.voiceSteals = pImpl->voiceSteals;
+	metrics.failedPlays = pImpl->failedPlays;
+	return metrics;
+}
@@ -0,0 +1,217 @@
+#include "AudioCore/Systems/AudioSpatialSystem.hpp"
+#include "AudioCore/AudioContexts.hpp"
+#include "AudioCore/Components/AudioListenerComponent.hpp"
+#include "AudioCore/Components/AudioManagerComponent.hpp"
+#include "GraphicsCore/GraphicsContexts.hpp"
+#include "GraphicsCore/Components/DeltaTimeComponent.hpp"
+#include "FrameProfiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <glm/geometric.hpp>
+
+#ifdef TRACY_ENABLE
+#include <tracy/Tracy.hpp>
+#endif
+
+namespace
+{
+// A real source keeps its voice until a virtual one is this much more audible, so near ties do not swap every frame
+constexpr float kRealVoiceBias = 1.25f;
+// Pitch a doppler shift is clamped to; teleports would otherwise read as near-sonic speeds for a frame
+constexpr float kMinDopplerPitch = 0.5f;
+constexpr float kMaxDopplerPitch = 2.0f;
+
+AudioSpatialSystem::Emitter spatialize(AudioSourceComponent& source, const AudioListenerComponent& listener,
+                                       const glm::vec3& toSource, const glm::vec3& listenerRight,
+                                       const glm::vec3& listenerVelocity, const glm::vec3& sourceVelocity)
+{
+	AudioSpatialSystem::Emitter emitter{&source, 0.0f, 0.0f, 1.0f, false};
+
+	const float minDistance = std::max(source.minDistance, 1e-3f);
+	const float distance = glm::length(toSource);
+	const float clamped = std::clamp(distance, minDistance, std::max(minDistance, source.maxDistance));
+	emitter.gain = source.volume * listener.volume * minDistance /
+	               (minDistance + source.rolloff * (clamped - minDistance));
+	if (distance < 1e-4f) return emitter;
+
+	const glm::vec3 axis = toSource / distance;
+	// Eased to the centre within minDistance, so a source passing through the listener does not jump sides
+	emitter.pan = glm::dot(axis, listenerRight) * std::min(1.0f, distance / minDistance);
+
+	// OpenAL's model along the listener-to-source axis; speeds are positive when closing in
+	const float factor = listener.dopplerFactor * source.dopplerFactor;
+	if (factor > 0.0f)
+	{
+		const float listenerSpeed = glm::dot(listenerVelocity, axis);
+		const float sourceSpeed = -glm::dot(sourceVelocity, axis);
+		const float numerator = listener.speedOfSound + factor * listenerSpeed;
+		const float denominator = listener.speedOfSound - factor * sourceSpeed;
+		emitter.pitch = denominator > 0.0f ? std::clamp(numerator / denominator, kMinDopplerPitch, kMaxDopplerPitch)
+		                                   : kMaxDopplerPitch;
+	}
+	return emitter;
+}
+
+void finish(AudioSourceComponent& source)
+{
+	source.playing = false;
+	source.cursor = 0.0f;
+	source.voice = {};
+}
+} // namespace
+
+void AudioSpatialSystem::onRegistered(GeneralManager& gm)
+{
+	std::cout << "AudioSpatialSystem registered!" << std::endl;
+}
+
+void AudioSpatialSystem::onShutdown(GeneralManager& gm)
+{
+	std::cout << "AudioSpatialSystem shutdown!" << std::endl;
+}
+
+void AudioSpatialSystem::onEntityUnsubscribed(Orhescyon::Entity entity, GeneralManager& gm)
+{
+	AudioSourceComponent* source = gm.getComponent<AudioSourceComponent>(entity);
+	if (!source || source->voice.sound < 0) return;
+	gm.getContextComponent<AudioManagerContext, AudioManagerComponent>()->audioManager->stop(source->voice);
+	source->voice = {};
+}
+
+void AudioSpatialSystem::update(GeneralManager& gm)
+{
+#ifdef TRACY_ENABLE
+	ZoneScopedN("AudioSpatialSystem");
+#endif
+	CpuProfileScope profileScope(gm, "AudioSpatialSystem");
+
+	AudioManager& audioManager = *gm.getContextComponent<AudioManagerContext, AudioManagerComponent>()->audioManager;
+	AudioListenerComponent& listener = *gm.getContextComponent<AudioListenerContext, AudioListenerComponent>();
+	const float deltaTime = gm.getContextComponent<DeltaTimeContext, DeltaTimeComponent>()->deltaTime;
+	const GlobalTransformComponent& camera = *gm.getContextComponent<MainCameraContext, GlobalTransformComponent>();
+
+	const glm::vec3 listenerPosition = camera.getGlobalPosition();
+	glm::vec3 listenerVelocity{0.0f};
+	if (_hasListenerPosition && deltaTime > 0.0f)
+		listenerVelocity = (listenerPosition - _lastListenerPosition) / deltaTime;
+	_lastListenerPosition = listenerPosition;
+	_hasListenerPosition = true;
+
+	// === Spatialize ===
+	_emitters.clear();
+	forEachSubscribedEntity(
+	    gm,
+	    [&](Orhescyon::Entity, GlobalTransformComponent& transform, AudioSourceComponent& source)
+	    {
+		    const glm::vec3& position = transform.getGlobalPosition();
+		    glm::vec3 velocity{0.0f};
+		    if (source.hasLastPosition && deltaTime > 0.0f) velocity = (position - source.lastPosition) / deltaTime;
+		    source.lastPosition = position;
+		    source.hasLastPosition = true;
+
+		    // A handle that was never loaded or has been unloaded since is skipped like a stopped source
+		    if (!source.playing || !audioManager.isLoaded(source.sound))
+		    {
+			    if (source.voice.sound >= 0) audioManager.stop(source.voice);
+			    finish(source);
+			    source.audibility = 0.0f;
+			    return;
+		    }
+
+		    // A voice that stopped on its own either played through or was taken by another play of the sound
+		    if (source.voice.sound >= 0)
+		    {
+			    if (audioManager.isPlaying(source.voice))
+			    {
+				    source.cursor = audioManager.cursor(source.voice);
+			    }
+			    else
+			    {
+				    source.voice = {};
+				    const float length = audioManager.length(source.sound);
+				    if (!source.loop && (length <= 0.0f || source.cursor + deltaTime >= length))
+				    {
+					    finish(source);
+					    source.audibility = 0.0f;
+					    return;
+				    }
+			    }
+		    }
+
+		    _emitters.push_back(spatialize(source, listener, position - listenerPosition, camera.getRight(),
+		                                   listenerVelocity, velocity));
+		    source.audibility = _emitters.back().gain * source.priority;
+	    });
+
+	// === Pick the real voices ===
+	_ranked.clear();
+	for (uint32_t i = 0; i < _emitters.size(); ++i)
+	{
+		if (_emitters[i].gain >= listener.minAudibleGain) _ranked.push_back(i);
+	}
+	auto rank = [&](uint32_t i)
+	{
+		const AudioSourceComponent& source = *_emitters[i].source;
+		return source.voice.sound >= 0 ? source.audibility * kRealVoiceBias : source.audibility;
+	};
+	std::sort(_ranked.begin(), _ranked.end(), [&](uint32_t a, uint32_t b) { return rank(a) > rank(b); });
+
+	// A sound can only have as many voices as its pool, so sources past that leave their place to the next sound
+	_voicesPerSound.clear();
+	uint32_t realCount = 0;
+	for (uint32_t i : _ranked)
+	{
+		if (realCount == listener.maxRealVoices) break;
+		const SoundHandle sound = _emitters[i].source->sound;
+		uint32_t& voices = _voicesPerSound[sound.id];
+		if (voices == audioManager.maxVoices(sound)) continue;
+		++voices;
+		++realCount;
+		_emitters[i].real = true;
+	}
+
+	// === Virtualize, then realize ===
+	// Demoted first, so the voices they free are there for the promoted
+	for (Emitter& emitter : _emitters)
+	{
+		AudioSourceComponent& source = *emitter.source;
+		if (emitter.real || source.voice.sound < 0) continue;
+		source.cursor = audioManager.cursor(source.voice);
+		audioManager.stop(source.voice);
+		source.voice = {};
+	}
+
+	listener.realSources = 0;
+	listener.virtualSources = 0;
+	for (Emitter& emitter : _emitters)
+	{
+		AudioSourceComponent& source = *emitter.source;
+		if (emitter.real && source.voice.sound < 0)
+			source.voice = audioManager.play(source.sound, emitter.gain, source.loop, source.cursor);
+
+		if (source.voice.sound >= 0)
+		{
+			audioManager.setSpatial(source.voice, emitter.gain, emitter.pan, emitter.pitch);
+			++listener.realSources;
+			continue;
+		}
+
+		// Virtual: only the cursor moves. A one-shot whose length is unknown cannot be followed and ends here.
+		++listener.virtualSources;
+		const float length = audioManager.length(source.sound);
+		source.cursor += deltaTime * emitter.pitch;
+		if (length <= 0.0f)
+		{
+			if (!source.loop) finish(source);
+			source.cursor = 0.0f;
+		}
+		else if (source.cursor >= length)
+		{
+			if (source.loop)
+				source.cursor = std::fmod(source.cursor, length);
+			else
+				finish(source);
+		}
+	}
+}
@@ -0,0 +1,183 @@
+#include "FrameProfiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+
+#include "FrameProfilerComponent.hpp"
+#include "FrameProfilerContext.hpp"
+
+namespace
+{
+const char* domainName(FrameProfiler::Domain domain)
+{
+	return domain == FrameProfiler::Domain::Gpu ? "gpu" : "cpu";
+}
+
+// Nearest-rank percentile of an ascending range
+float percentile(const std::vector<float>& sorted, float p)
+{
+	size_t rank = static_cast<size_t>(p * static_cast<float>(sorted.size()) + 0.5f);
+	return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+}
+
+std::string jsonEscape(const std::string& text)
+{
+	std::string escaped;
+	escaped.reserve(text.size());
+	for (char c : text)
+	{
+		if (c == '"' || c == '\\') escaped += '\\';
+		escaped += c;
+	}
+	return escaped;
+}
+} // namespace
+
+void FrameProfiler::record(Domain domain, std::string_view name, float ms)
+{
+	if (!isEnabled()) return;
+
+	std::lock_guard lock(mutex);
+	SeriesMap& map = domain == Domain::Gpu ? gpuSeries : cpuSeries;
+	auto it = map.find(name);
+	if (it == map.end()) it = map.emplace(std::string(name), Series{std::vector<float>(historyLength)}).first;
+
+	Series& series = it->second;
+	const size_t length = series.samples.size();
+	series.samples[series.next] = ms;
+	series.next = (series.next + 1) % length;
+	series.count = std::min(series.count + 1, length);
+}
+
+std::vector<float> FrameProfiler::ordered(const Series& series)
+{
+	const size_t length = series.samples.size();
+	std::vector<float> samples;
+	samples.reserve(series.count);
+	size_t first = (series.next + length - series.count) % length;
+	for (size_t i = 0; i < series.count; ++i) samples.push_back(series.samples[(first + i) % length]);
+	return samples;
+}
+
+FrameProfiler::Stats FrameProfiler::summarize(const std::string& name, Domain domain, const Series& series)
+{
+	Stats stats;
+	stats.name = name;
+	stats.domain = domain;
+	stats.sampleCount = static_cast<uint32_t>(series.count);
+	if (series.count == 0) return stats;
+
+	std::vector<float> samples = ordered(series);
+	stats.lastMs = samples.back();
+	stats.avgMs = std::accumulate(samples.begin(), samples.end(), 0.0f) / static_cast<float>(samples.size());
+
+	std::sort(samples.begin(), samples.end());
+	stats.minMs = samples.front();
+	stats.maxMs = samples.back();
+	stats.p50Ms = percentile(samples, 0.50f);
+	stats.p95Ms = percentile(samples, 0.95f);
+	stats.p99Ms = percentile(samples, 0.99f);
+	return stats;
+}
+
+std::vector<FrameProfiler::Stats> FrameProfiler::collectStats() const
+{
+	std::lock_guard lock(mutex);
+	std::vector<Stats> result;
+	result.reserve(cpuSeries.size() + gpuSeries.size());
+	for (const auto& [name, series] : cpuSeries) result.push_back(summarize(name, Domain::Cpu, series));
+	for (const auto& [name, series] : gpuSeries) result.push_back(summarize(name, Domain::Gpu, series));
+	return result;
+}
+
+std::vector<float> FrameProfiler::history(Domain domain, std::string_view name) const
+{
+	std::lock_guard lock(mutex);
+	const SeriesMap& map = domain == Domain::Gpu ? gpuSeries : cpuSeries;
+	auto it = map.find(name);
+	return it == map.end() ? std::vector<float>{} : ordered(it->second);
+}
+
+void FrameProfiler::clear()
+{
+	std::lock_guard lock(mutex);
+	cpuSeries.clear();
+	gpuSeries.clear();
+	window.fetch_add(1, std::memory_order_relaxed);
+}
+
+void FrameProfiler::setHistoryLength(size_t length)
+{
+	std::lock_guard lock(mutex);
+	historyLength = std::max<size_t>(length, 1);
+	cpuSeries.clear();
+	gpuSeries.clear();
+	window.fetch_add(1, std::memory_order_relaxed);
+}
+
+size_t FrameProfiler::getHistoryLength() const
+{
+	std::lock_guard lock(mutex);
+	return historyLength;
+}
+
+bool FrameProfiler::dumpCsv(const std::filesystem::path& path) const
+{
+	std::ofstream file(path);
+	if (!file) return false;
+
+	file << "domain,name,samples,last_ms,avg_ms,min_ms,max_ms,p50_ms,p95_ms,p99_ms\n";
+	for (const Stats& s : collectStats())
+	{
+		file << domainName(s.domain) << ",\"" << s.name << "\"," << s.sampleCount << ',' << s.lastMs << ','
+		     << s.avgMs << ',' << s.minMs << ',' << s.maxMs << ',' << s.p50Ms << ',' << s.p95Ms << ',' << s.p99Ms
+		     << '\n';
+	}
+	return static_cast<bool>(file);
+}
+
+bool FrameProfiler::dumpJson(const std::filesystem::path& path) const
+{
+	std::ofstream file(path);
+	if (!file) return false;
+
+	std::vector<Stats> stats = collectStats();
+	file << "{\n  \"historyLength\": " << getHistoryLength() << ",\n  \"series\": [";
+	for (size_t i = 0; i < stats.size(); ++i)
+	{
+		const Stats& s = stats[i];
+		file << (i == 0 ? "\n" : ",\n") << "    {\"domain\": \"" << domainName(s.domain) << "\", \"name\": \""
+		     << jsonEscape(s.name) << "\", \"samples\": " << s.sampleCount << ", \"lastMs\": " << s.lastMs
+		     << ", \"avgMs\": " << s.avgMs << ", \"minMs\": " << s.minMs << ", \"maxMs\": " << s.maxMs
+		     << ", \"p50Ms\": " << s.p50Ms << ", \"p95Ms\": " << s.p95Ms << ", \"p99Ms\": " << s.p99Ms
+		     << ", \"history\": [";
+		std::vector<float> samples = history(s.domain, s.name);
+		for (size_t j = 0; j < samples.size(); ++j) file << (j == 0 ? "" : ", ") << samples[j];
+		file << "]}";
+	}
+	file << "\n  ]\n}\n";
+	return static_cast<bool>(file);
+}
+
+bool FrameProfiler::dump(const std::filesystem::path& path) const
+{
+	return path.extension() == ".json" ? dumpJson(path) : dumpCsv(path);
+}
+
+CpuProfileScope::CpuProfileScope(Orhescyon::GeneralManager& gm, const char* name) : name(name)
+{
+	auto* component = gm.getContextComponent<FrameProfilerContext, FrameProfilerComponent>();
+	if (component && component->profiler && component->profiler->isEnabled())
+	{
+		profiler = component->profiler;
+		start = std::chrono::steady_clock::now();
+	}
+}
+
+CpuProfileScope::~CpuProfileScope()
+{
+	if (!profiler) return;
+	std::chrono::duration<float, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+	profiler->record(FrameProfiler::Domain::Cpu, name, elapsed.count());
+}
@@ -1,5 +1,8 @@
 #include "SwapChainFactory.hpp"
 #include "GraphicsCore/VulkanUtils.hpp"
+#include "GraphicsCore/VulkanConst.hpp"
+#include "GraphicsCore/Resources/Managers/TextureManager.hpp"
+#include "GraphicsCore/Resources/Factories/TextureFactory.hpp"
 #include <iostream>
 
 void SwapChainFactory::createSwapChain(SwapChain& swapChain, VulkanDevice& deviceContext, Window& window,
@@ -16,8 +19,8 @@ void SwapChainFactory::createSwapChainHandle(SwapChain& swapChain, VulkanDevice&
 	vk::SurfaceFormatKHR swapChainSurfaceFormat =
 	    chooseSwapSurfaceFormat(deviceContext.physicalDevice.getSurfaceFormatsKHR(deviceContext.surface));
 	swapChain.swapChainExtent = chooseSwapExtent(surfaceCapabilities, window);
-	vk::PresentModeKHR swapChainPresentMode =
-	    chooseSwapPresentMode(deviceContext.physicalDevice.getSurfacePresentModesKHR(deviceContext.surface));
+	swapChain.presentMode = chooseSwapPresentMode(
+	    deviceContext.physicalDevice.getSurfacePresentModesKHR(deviceContext.surface), swapChain.requestedPresentMode);
 	swapChain.swapChainImageFormat = swapChainSurfaceFormat.format;
 
 	// Determine number of images in the swap chain
@@ -42,8 +45,7 @@ void SwapChainFactory::createSwapChainHandle(SwapChain& swapChain, VulkanDevice&
 	swapChainCreateInfo.imageSharingMode = vk::SharingMode::eExclusive;
 	swapChainCreateInfo.preTransform = surfaceCapabilities.currentTransform;
 	swapChainCreateInfo.compositeAlpha = vk::CompositeAlphaFlagBitsKHR::eOpaque;
-	swapChainCreateInfo.presentMode =
-	    chooseSwapPresentMode(deviceContext.physicalDevice.getSurfacePresentModesKHR(deviceContext.surface));
+	swapChainCreateInfo.presentMode = swapChain.presentMode;
 	swapChainCreateInfo.clipped = true;
 	swapChainCreateInfo.oldSwapchain = oldHandle;
 
@@ -70,6 +72,33 @@ void SwapChainFactory::createImageViews(SwapChain& swapChain, VulkanDevice& devi
 	}
 }
 
+void SwapChainFactory::createOffscreenSwapChain(SwapChain& swapChain, VulkanDevice& deviceContext,
+                                                TextureManager& textureManager, Window& window)
+{
+	int width = 0, height = 0;
+	window.getFramebufferSize(&width, &height);
+	swapChain.swapChainExtent = vk::Extent2D{static_cast<uint32_t>(width), static_cast<uint32_t>(height)};
+	// Same format the windowed path prefers, so every pipeline built against it is identical
+	swapChain.swapChainImageFormat = vk::Format::eB8G8R8A8Srgb;
+
+	ImageDesc desc;
+	desc.width = swapChain.swapChainExtent.width;
+	desc.height = swapChain.swapChainExtent.height;
+	desc.format = swapChain.swapChainImageFormat;
+	// TransferSrc: the graph leaves the final image ready to be copied out instead of presented
+	desc.usage = vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc;
+
+	swapChain.offscreenTextures.clear();
+	swapChain.swapChainImages.clear();
+	for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+	{
+		TextureHandle texture = TextureFactory::createTexture(textureManager, desc, SamplerDesc{});
+		swapChain.offscreenTextures.push_back(texture);
+		swapChain.swapChainImages.push_back(textureManager.getTexture(texture).textureImage);
+	}
+	createImageViews(swapChain, deviceContext, window);
+}
+
 vk::SurfaceFormatKHR
 SwapChainFactory::chooseSwapSurfaceFormat(const std::vector<vk::SurfaceFormatKHR>& availableFormats)
 {
@@ -84,11 +113,12 @@ SwapChainFactory::chooseSwapSurfaceFormat(const std::vector<vk::SurfaceFormatKHR
 	return availableFormats[0];
 }
 
-vk::PresentModeKHR SwapChainFactory::chooseSwapPresentMode(const std::vector<vk::PresentModeKHR>& availablePresentModes)
+vk::PresentModeKHR SwapChainFactory::chooseSwapPresentMode(const std::vector<vk::PresentModeKHR>& availablePresentModes,
+                                                           vk::PresentModeKHR requested)
 {
 	for (const auto& availablePresentMode : availablePresentModes)
 	{
-		if (availablePresentMode == vk::PresentModeKHR::eMailbox)
+		if (availablePresentMode == requested)
 		{
 			return availablePresentMode;
 		}
@@ -6,6 +6,8 @@
 #include "GraphicsCore/SwapChain.hpp"
 #include "GraphicsCore/Resources/Managers/BufferManager.hpp"
 
+class TextureManager;
+
 class SwapChainFactory
 {
 public:
@@ -14,10 +16,15 @@ public:
 	static void createSwapChainHandle(SwapChain& swapChain, VulkanDevice& device, Window& window,
 	                                  vk::SwapchainKHR oldHandle = nullptr);
 	static void createImageViews(SwapChain& swapChain, VulkanDevice& device, Window& window);
+	// Headless stand-in: MAX_FRAMES_IN_FLIGHT color images the size of the window, indexed by frame slot
+	static void createOffscreenSwapChain(SwapChain& swapChain, VulkanDevice& device, TextureManager& textureManager,
+	                                     Window& window);
 	static void cleanupSwapChain(SwapChain& swapChain);
 	static void recreateSwapChain(SwapChain& swapChain, VulkanDevice& device, Window& window);
 
 	static vk::SurfaceFormatKHR chooseSwapSurfaceFormat(const std::vector<vk::SurfaceFormatKHR>& availableFormats);
-	static vk::PresentModeKHR chooseSwapPresentMode(const std::vector<vk::PresentModeKHR>& availablePresentModes);
+	// `requested` when the surface supports it, otherwise FIFO, which every surface must
+	static vk::PresentModeKHR chooseSwapPresentMode(const std::vector<vk::PresentModeKHR>& availablePresentModes,
+	                                                vk::PresentModeKHR requested);
 	static vk::Extent2D chooseSwapExtent(const vk::SurfaceCapabilitiesKHR& capabilities, Window& window);
 };
\ No newline at end of file
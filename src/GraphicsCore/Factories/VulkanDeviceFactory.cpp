@@ -11,22 +11,22 @@
 #include <tracy/TracyVulkan.hpp>
 #endif
 
-inline std::vector<const char*> buildDeviceExtensions()
+inline std::vector<const char*> buildDeviceExtensions(bool headless)
 {
 	std::vector<const char*> ext = {
-	    vk::KHRSwapchainExtensionName,
 	    vk::KHRSpirv14ExtensionName,
 	    vk::KHRSynchronization2ExtensionName,
 	    vk::KHRCreateRenderpass2ExtensionName,
 	};
+	if (!headless) ext.push_back(vk::KHRSwapchainExtensionName);
 	return ext;
 }
-inline const std::vector<const char*> deviceExtensions = buildDeviceExtensions();
 
 void VulkanDeviceFactory::createVulkanDevice(Window& window, VulkanDevice& vulkanDevice)
 {
+	vulkanDevice.headless = window.isHeadless();
 	createInstance(window, vulkanDevice);
-	createSurface(window, vulkanDevice);
+	if (!vulkanDevice.headless) createSurface(window, vulkanDevice);
 	pickPhysicalDevice(vulkanDevice);
 	createLogicalDevice(vulkanDevice);
 	createCommandPool(vulkanDevice);
@@ -89,6 +89,7 @@ void VulkanDeviceFactory::createInstance(Window& window, VulkanDevice& vulkanDev
 void VulkanDeviceFactory::pickPhysicalDevice(VulkanDevice& vulkanDevice)
 {
 	auto devices = vulkanDevice.instance.enumeratePhysicalDevices();
+	const std::vector<const char*> deviceExtensions = buildDeviceExtensions(vulkanDevice.headless);
 
 	// Check if a physical device meets the requirements for our application
 	auto isDeviceSuitable = [&](vk::raii::PhysicalDevice const& device) -> bool
@@ -169,6 +170,7 @@ void VulkanDeviceFactory::createLogicalDevice(VulkanDevice& vulkanDevice)
 	{
 		bool supportsGraphics = (queueFamilyProperties[i].queueFlags & vk::QueueFlagBits::eGraphics) != vk::QueueFlags{};
 		bool supportsPresent =
+		    vulkanDevice.headless ||
 		    vulkanDevice.physicalDevice.getSurfaceSupportKHR(static_cast<uint32_t>(i), *vulkanDevice.surface);
 
 		if (supportsGraphics && supportsPresent)
@@ -235,6 +237,9 @@ void VulkanDeviceFactory::createLogicalDevice(VulkanDevice& vulkanDevice)
 	featureChain.get<vk::PhysicalDeviceVulkan11Features>().shaderDrawParameters = true;
 	featureChain.get<vk::PhysicalDeviceFeatures2>().features.samplerAnisotropy = true;
 	featureChain.get<vk::PhysicalDeviceFeatures2>().features.multiDrawIndirect = true;
+	// Optional: without it the importer keeps PNG/JPEG textures as RGBA8
+	vulkanDevice.textureCompressionBC = vulkanDevice.physicalDevice.getFeatures().textureCompressionBC == VK_TRUE;
+	featureChain.get<vk::PhysicalDeviceFeatures2>().features.textureCompressionBC = vulkanDevice.textureCompressionBC;
 	featureChain.get<vk::PhysicalDeviceVulkan12Features>().descriptorIndexing = true;
 	featureChain.get<vk::PhysicalDeviceVulkan12Features>().descriptorBindingPartiallyBound = true;
 	featureChain.get<vk::PhysicalDeviceVulkan12Features>().runtimeDescriptorArray = true;
@@ -248,6 +253,7 @@ void VulkanDeviceFactory::createLogicalDevice(VulkanDevice& vulkanDevice)
 	deviceCreateInfo.pNext = &featureChain.get<vk::PhysicalDeviceFeatures2>();
 	deviceCreateInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
 	deviceCreateInfo.pQueueCreateInfos = queueCreateInfos.data();
+	const std::vector<const char*> deviceExtensions = buildDeviceExtensions(vulkanDevice.headless);
 	deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(deviceExtensions.size());
 	deviceCreateInfo.ppEnabledExtensionNames = deviceExtensions.data();
 
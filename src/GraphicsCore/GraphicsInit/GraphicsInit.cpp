@@ -10,6 +10,7 @@
 #include "GraphicsCore/Components/SwapChainComponent.hpp"
 #include "GraphicsCore/Components/VMAllocatorComponent.hpp"
 #include "GraphicsCore/Components/TextureManagerComponent.hpp"
+#include "GraphicsCore/Components/TextureStreamerComponent.hpp"
 #include "GraphicsCore/Components/BufferManagerComponent.hpp"
 #include "GraphicsCore/Components/ModelManagerComponent.hpp"
 #include "GraphicsCore/Components/DescriptorManagerComponent.hpp"
@@ -22,12 +23,20 @@
 #include "GraphicsCore/Resources/Components/GlobalDSetComponent.hpp"
 #include "GraphicsCore/Resources/Components/ModelDSetComponent.hpp"
 #include "GraphicsCore/Components/DrawInfoComponent.hpp"
+#include "GraphicsCore/Components/CameraLatchComponent.hpp"
 #include "GraphicsCore/Components/NameComponent.hpp"
 #include "PlatformCore/PlatformContexts.hpp"
 #include "PlatformCore/Components/WindowComponent.hpp"
+#include "PlatformCore/Components/KeyboardStateComponent.hpp"
+#include "PlatformCore/Components/MouseStateComponent.hpp"
+#include "PlatformCore/Components/CursorPositionComponent.hpp"
+#include "PlatformCore/Components/ScrollDeltaComponent.hpp"
+#include "PlatformCore/Components/WindowSizeComponent.hpp"
+#include "PlatformCore/Components/InputTimingComponent.hpp"
 #include "GraphicsCore/VulkanDevice.hpp"
 #include "GraphicsCore/SwapChain.hpp"
 #include "GraphicsCore/Resources/Managers/TextureManager.hpp"
+#include "GraphicsCore/Resources/Managers/TextureStreamer.hpp"
 #include "GraphicsCore/Resources/Managers/BufferManager.hpp"
 #include "GraphicsCore/Resources/Managers/ModelManager.hpp"
 #include "GraphicsCore/Resources/Managers/DescriptorManager.hpp"
@@ -51,6 +60,7 @@
 #include "GraphicsCore/Systems/LightUpdateSystem.hpp"
 #include "GraphicsCore/Systems/LightProbeGIBakeSystem.hpp"
 #include "GraphicsCore/Systems/ReflectionProbeUpdateSystem.hpp"
+#include "GraphicsCore/Systems/TextureStreamingSystem.hpp"
 #include "GraphicsCore/Systems/BufferUpdateSystem.hpp"
 #include "GraphicsCore/Systems/RenderSystem.hpp"
 #include "GraphicsCore/Systems/FrameEndSystem.hpp"
@@ -75,7 +85,9 @@ void GraphicsInit::Run(GeneralManager& gm)
 	GraphicsPipelinesInit::initPipelines(gm);
 	PlaceholdersInit::initPlaceholders(gm);
 #ifdef HALCYON_DEV_TOOLS
-	initImGui(gm);
+	// A headless run has no GLFW window for the ImGui backend; without a context the UI system and pass stay off
+	if (!gm.getContextComponent<MainVulkanDeviceContext, VulkanDeviceComponent>()->vulkanDeviceInstance->headless)
+		initImGui(gm);
 #endif
 	coreInit(gm);
 	PlaceholdersInit::initAfterCorePlaceholders(gm);
@@ -100,28 +112,34 @@ void GraphicsInit::coreInit(GeneralManager& gm)
 	    .after<DeltaTimeSystem>()
 	    .before<FrameEndSystem>()
 	    .writes<CurrentFrameComponent, FrameImageComponent>();
+	// Culls emitters against the camera block CameraMatrixSystem writes
 	gm.registerSystem<GPUParticlesSystem>()
-	    .after<FrameBeginSystem>()
-	    .before<FrameEndSystem>()
-	    .reads<ParticleEmitorComponent, GlobalTransformComponent>();
+	    .after<CameraMatrixSystem>()
+	    .before<RenderSystem>()
+	    .reads<GlobalTransformComponent>()
+	    .writes<ParticleEmitorComponent>();
 	gm.registerSystem<PhysSyncSystem>()
 	    .after<FrameBeginSystem>()
 	    .before<BufferUpdateSystem>()
 	    .reads<PhysTransformSnapshotComponent>()
 	    .writes<GlobalTransformComponent>();
 #ifdef HALCYON_DEV_TOOLS
-	gm.registerSystem<ImGuiSystem>()
-	    .after<FrameBeginSystem>()
-	    .before<BufferUpdateSystem>()
-	    .reads<NameComponent, RelationshipComponent, CameraComponent, GraphicsSettingsComponent, DeltaTimeComponent,
-	           PhysBodyComponent>()
-	    .writes<GlobalTransformComponent, LocalTransformComponent, DirectLightComponent, PointLightComponent,
-	            GtaoSettingsComponent, GodRaysSettingsComponent, LightProbeGridComponent>();
+	if (!gm.getContextComponent<MainVulkanDeviceContext, VulkanDeviceComponent>()->vulkanDeviceInstance->headless)
+	{
+		gm.registerSystem<ImGuiSystem>()
+		    .after<FrameBeginSystem>()
+		    .before<BufferUpdateSystem>()
+		    .reads<NameComponent, RelationshipComponent, CameraComponent, GraphicsSettingsComponent,
+		           DeltaTimeComponent, PhysBodyComponent>()
+		    .writes<GlobalTransformComponent, LocalTransformComponent, DirectLightComponent, PointLightComponent,
+		            GtaoSettingsComponent, GodRaysSettingsComponent, LightProbeGridComponent>();
+	}
 #endif
 	gm.registerSystem<CameraMatrixSystem>()
 	    .after<FrameBeginSystem>()
 	    .before<BufferUpdateSystem>()
-	    .reads<CameraComponent, GlobalTransformComponent, DirectLightComponent, CurrentFrameComponent>();
+	    .reads<CameraComponent, GlobalTransformComponent, DirectLightComponent, CurrentFrameComponent>()
+	    .writes<CameraLatchComponent>();
 	gm.registerSystem<LightUpdateSystem>()
 	    .after<FrameBeginSystem>()
 	    .before<BufferUpdateSystem>()
@@ -131,6 +149,11 @@ void GraphicsInit::coreInit(GeneralManager& gm)
 	    .after<LightProbeGIBakeSystem>()
 	    .before<FrameEndSystem>()
 	    .reads<ReflectionProbeComponent, CurrentFrameComponent>();
+	gm.registerSystem<TextureStreamingSystem>()
+	    .after<FrameBeginSystem>()
+	    .before<BufferUpdateSystem>()
+	    .reads<GlobalTransformComponent, MeshInfoComponent, CameraComponent, CurrentFrameComponent,
+	           GraphicsSettingsComponent>();
 	gm.registerSystem<BufferUpdateSystem>()
 	    .after<FrameBeginSystem>()
 	    .before<FrameEndSystem>()
@@ -140,7 +163,12 @@ void GraphicsInit::coreInit(GeneralManager& gm)
 	    .after<BufferUpdateSystem>()
 	    .before<FrameEndSystem>()
 	    .reads<GlobalTransformComponent, MeshInfoComponent, DrawInfoComponent, CurrentFrameComponent>();
-	gm.registerSystem<FrameEndSystem>().reads<FrameImageComponent>();
+	// The late latch re-reads input and moves the main camera before submitting
+	gm.registerSystem<FrameEndSystem>()
+	    .reads<FrameImageComponent, RelationshipComponent>()
+	    .writes<CameraLatchComponent, GlobalTransformComponent, LocalTransformComponent, KeyboardStateComponent,
+	            MouseStateComponent, CursorPositionComponent, ScrollDeltaComponent, WindowSizeComponent,
+	            InputTimingComponent>();
 }
 #pragma endregion
 
@@ -216,6 +244,14 @@ void GraphicsInit::initManagers(GeneralManager& gm)
 	gm.addComponent<NameComponent>(textureManagerEntity, "SYSTEM Texture Manager");
 	dq->push_function([textureManager]() { delete textureManager; });
 
+	// Texture Streamer
+	Orhescyon::Entity textureStreamerEntity = gm.createEntity();
+	gm.registerContext<TextureStreamerContext>(textureStreamerEntity);
+	TextureStreamer* textureStreamer = new TextureStreamer(*vulkanDevice, allocator);
+	gm.addComponent<TextureStreamerComponent>(textureStreamerEntity, textureStreamer);
+	gm.addComponent<NameComponent>(textureStreamerEntity, "SYSTEM Texture Streamer");
+	dq->push_function([textureStreamer]() { delete textureStreamer; });
+
 	// Buffer Manager
 	Orhescyon::Entity bufferManagerEntity = gm.createEntity();
 	gm.registerContext<BufferManagerContext>(bufferManagerEntity);
@@ -291,7 +327,10 @@ void GraphicsInit::initFrameData(GeneralManager& gm)
 	Orhescyon::Entity swapChainEntity = gm.createEntity();
 	gm.registerContext<MainSwapChainContext>(swapChainEntity);
 	SwapChain* swapChain = new SwapChain();
-	SwapChainFactory::createSwapChain(*swapChain, *vulkanDevice, *window);
+	if (vulkanDevice->headless)
+		SwapChainFactory::createOffscreenSwapChain(*swapChain, *vulkanDevice, *textureManager, *window);
+	else
+		SwapChainFactory::createSwapChain(*swapChain, *vulkanDevice, *window);
 	gm.addComponent<SwapChainComponent>(swapChainEntity, swapChain);
 	gm.addComponent<NameComponent>(swapChainEntity, "SYSTEM Swap Chain");
 	dq->push_function(
@@ -13,6 +13,7 @@
 #include "GraphicsCore/Components/DescriptorManagerComponent.hpp"
 #include "GraphicsCore/Components/RenderGraphComponent.hpp"
 #include "GraphicsCore/Components/PipelineManagerComponent.hpp"
+#include "GraphicsCore/Components/MipGeneratorComponent.hpp"
 #include "GraphicsCore/Components/GraphicsSettingsComponent.hpp"
 #include "GraphicsCore/RenderGraph/RenderGraph.hpp"
 #include "GraphicsCore/Components/NameComponent.hpp"
@@ -207,6 +208,21 @@ void GraphicsPipelinesInit::initPipelines(GeneralManager& gm)
 	    .shaderPath = "brdf_lut.spv",
 	    .setLayoutNames = {"textureSet"},
 	});
+	pipelineManager->build(PipelineDescription{
+	    .isCompute = true,
+	    .shaderPath = "mip_downsample.spv",
+	    .setLayoutNames = {"mipGenSet"},
+	    .pushConstants = {{vk::ShaderStageFlagBits::eCompute, 0, sizeof(uint32_t) * 5}},
+	});
+
+	Orhescyon::Entity mipGeneratorEntity = gm.createEntity();
+	gm.registerContext<MipGeneratorContext>(mipGeneratorEntity);
+	MipGenerator* mipGenerator = new MipGenerator(*vulkanDevice, *descriptorManager, *pipelineManager);
+	TextureUploadBatch* uploadBatch = new TextureUploadBatch(*vulkanDevice, vmaAlloc, *mipGenerator);
+	gm.addComponent<MipGeneratorComponent>(mipGeneratorEntity, mipGenerator, uploadBatch);
+	gm.addComponent<NameComponent>(mipGeneratorEntity, "SYSTEM Mip Generator");
+	dq->push_function([mipGenerator]() { delete mipGenerator; });
+	dq->push_function([uploadBatch]() { delete uploadBatch; });
 
 	// === GI light source bake ===
 	pipelineManager->build(
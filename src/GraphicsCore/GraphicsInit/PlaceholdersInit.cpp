@@ -14,6 +14,7 @@
 #include "GraphicsCore/Components/AutoExposureSettingsComponent.hpp"
 #include "GraphicsCore/Components/NameComponent.hpp"
 #include "GraphicsCore/Components/CameraComponent.hpp"
+#include "GraphicsCore/Components/CameraLatchComponent.hpp"
 #include "GraphicsCore/Components/DirectLightComponent.hpp"
 #include "GraphicsCore/Components/LocalTransformComponent.hpp"
 #include "GraphicsCore/Components/GlobalTransformComponent.hpp"
@@ -66,6 +67,7 @@ void PlaceholdersInit::initPlaceholders(GeneralManager& gm)
 	gm.addComponent<GlobalTransformComponent>(cameraEntity, glm::vec3(0.0f, 0.0f, 0.0f));
 	gm.addComponent<LocalTransformComponent>(cameraEntity, glm::vec3(0.0f, 0.0f, 0.0f));
 	gm.addComponent<RelationshipComponent>(cameraEntity);
+	gm.addComponent<CameraLatchComponent>(cameraEntity);
 	gm.registerContext<MainCameraContext>(cameraEntity);
 	CameraComponent* camera = gm.getContextComponent<MainCameraContext, CameraComponent>();
 
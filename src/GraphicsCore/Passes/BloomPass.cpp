@@ -46,8 +46,8 @@ void BloomPass::onInit(Orhescyon::GeneralManager& gm)
 
 	for (uint32_t i = 0; i < kMipCount; ++i)
 	{
-		_downsampleDsets[i] = descriptorManager.allocate("screenSpaceSet");
-		_upsampleDsets[i] = descriptorManager.allocate("screenSpaceSet");
+		_downsampleDsets[i] = descriptorManager.allocate("screenSpaceSet", MAX_FRAMES_IN_FLIGHT);
+		_upsampleDsets[i] = descriptorManager.allocate("screenSpaceSet", MAX_FRAMES_IN_FLIGHT);
 	}
 
 	rg.declareLogicalStream("BloomChain", {swapChain.hdrFormat, RGSizeMode::HalfExtent, vk::ImageAspectFlagBits::eColor,
@@ -72,8 +72,9 @@ void BloomPass::onInit(Orhescyon::GeneralManager& gm)
 }
 
 void BloomPass::drawDownsample(vk::raii::CommandBuffer& cmd, DescriptorManagerComponent& descriptorManager,
-                               DSetHandle dSetHandle, PipelineManager& pipelineManager, float texelSizeX, float texelSizeY,
-                               float threshold, float knee, int isFirstPass, vk::Extent2D extent)
+                               DSetHandle dSetHandle, uint32_t frame, PipelineManager& pipelineManager,
+                               float texelSizeX, float texelSizeY, float threshold, float knee, int isFirstPass,
+                               vk::Extent2D extent)
 {
 	cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["bloom_downsample"].pipeline);
 
@@ -82,7 +83,7 @@ void BloomPass::drawDownsample(vk::raii::CommandBuffer& cmd, DescriptorManagerCo
 	cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), extent));
 
 	cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["bloom_downsample"].layout, 0,
-	                       descriptorManager.descriptorManager->getSet(dSetHandle), nullptr);
+	                       descriptorManager.descriptorManager->getSet(dSetHandle, frame), nullptr);
 
 	struct PushConstants
 	{
@@ -104,8 +105,8 @@ void BloomPass::drawDownsample(vk::raii::CommandBuffer& cmd, DescriptorManagerCo
 }
 
 void BloomPass::drawUpsample(vk::raii::CommandBuffer& cmd, DescriptorManagerComponent& descriptorManager, DSetHandle dSetHandle,
-                             PipelineManager& pipelineManager, float texelSizeX, float texelSizeY, float blendFactor,
-                             vk::Extent2D extent)
+                             uint32_t frame, PipelineManager& pipelineManager, float texelSizeX, float texelSizeY,
+                             float blendFactor, vk::Extent2D extent)
 {
 	cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["bloom_upsample"].pipeline);
 
@@ -114,7 +115,7 @@ void BloomPass::drawUpsample(vk::raii::CommandBuffer& cmd, DescriptorManagerComp
 	cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), extent));
 
 	cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["bloom_upsample"].layout, 0,
-	                       descriptorManager.descriptorManager->getSet(dSetHandle), nullptr);
+	                       descriptorManager.descriptorManager->getSet(dSetHandle, frame), nullptr);
 
 	struct PushConstants
 	{
@@ -131,7 +132,7 @@ void BloomPass::drawUpsample(vk::raii::CommandBuffer& cmd, DescriptorManagerComp
 	cmd.draw(3, 1, 0, 0);
 }
 
-void BloomPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t /*frame*/)
+void BloomPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame)
 {
 	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
 	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>();
@@ -175,18 +176,23 @@ void BloomPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint3
 		    "BloomDown" + std::to_string(i), {.colorAttachments = {colorAtt}},
 		    {{srcName, RGResourceUsage::ShaderRead, srcMip, 1}},
 		    {{"BloomChain", RGResourceUsage::ColorAttachmentWrite, i, 1}},
-		    [&, texelX, texelY, threshold, knee, isFirst, dstExt, dset](vk::raii::CommandBuffer& cmd)
-		    { drawDownsample(cmd, descriptorManager, dset, pipelineManager, texelX, texelY, threshold, knee, isFirst, dstExt); },
+		    [&, texelX, texelY, threshold, knee, isFirst, dstExt, dset, frame](vk::raii::CommandBuffer& cmd)
+		    {
+			    drawDownsample(cmd, descriptorManager, dset, frame, pipelineManager, texelX, texelY, threshold, knee,
+			                   isFirst, dstExt);
+		    },
 		    [descriptorManager, srcName, srcMip, dset](const RenderGraph& graph, const RGPass& pass)
 		    {
 			    auto srcHnd = pass.getPhysicalRead(srcName);
 			    descriptorManager.descriptorManager->updateSingleTextureDSet(
-			        dset, DownsampleBinding::InputTexture, graph.getImageView(srcHnd, srcMip), graph.getSampler(srcHnd));
+			        dset, DownsampleBinding::InputTexture, graph.getUpdateFrame(), graph.getImageView(srcHnd, srcMip),
+			        graph.getSampler(srcHnd));
 		    });
 	}
 
-	// Upsample
-	for (uint32_t i = 0; i < kMipCount; ++i)
+	// Upsample. The fused post-process composites BloomChain mip 0 itself, so the final pass into MainColor is skipped
+	uint32_t upsampleCount = graphicsSettings.enableFusedPostProcess ? kMipCount - 1 : kMipCount;
+	for (uint32_t i = 0; i < upsampleCount; ++i)
 	{
 		uint32_t srcMip = kMipCount - 1 - i;
 		vk::Extent2D srcExt = mipExtent(srcMip);
@@ -209,13 +215,14 @@ void BloomPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint3
 		    "BloomUp" + std::to_string(i), {.colorAttachments = {colorAtt}},
 		    {{"BloomChain", RGResourceUsage::ShaderRead, srcMip, 1}},
 		    {{dstName, RGResourceUsage::ColorAttachmentWrite, dstMip, 1}},
-		    [&, texelX, texelY, intensity, dstExt, dset](vk::raii::CommandBuffer& cmd)
-		    { drawUpsample(cmd, descriptorManager, dset, pipelineManager, texelX, texelY, intensity, dstExt); },
+		    [&, texelX, texelY, intensity, dstExt, dset, frame](vk::raii::CommandBuffer& cmd)
+		    { drawUpsample(cmd, descriptorManager, dset, frame, pipelineManager, texelX, texelY, intensity, dstExt); },
 		    [descriptorManager, srcMip, dset](const RenderGraph& graph, const RGPass& pass)
 		    {
 			    auto srcHnd = pass.getPhysicalRead("BloomChain");
 			    descriptorManager.descriptorManager->updateSingleTextureDSet(
-			        dset, UpsampleBinding::CurrentTexture, graph.getImageView(srcHnd, srcMip), graph.getSampler(srcHnd));
+			        dset, UpsampleBinding::CurrentTexture, graph.getUpdateFrame(), graph.getImageView(srcHnd, srcMip),
+			        graph.getSampler(srcHnd));
 		    });
 	}
 }
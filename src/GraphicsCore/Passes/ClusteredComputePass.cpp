@@ -128,13 +128,12 @@ void ClusteredComputePass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph
 	auto& globalDSetComponent = *gm.getContextComponent<MainDSetsContext, GlobalDSetComponent>();
 	auto& bufferManager = *gm.getContextComponent<BufferManagerContext, BufferManagerComponent>()->bufferManager;
 	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
-	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
 
 	rg.addPass("ComputeClustered", {.isCompute = true}, {}, {},
-	           [&, frame](vk::raii::CommandBuffer& cmd)
+	           [&, frame, extent = rg.getRenderExtent()](vk::raii::CommandBuffer& cmd)
 	           {
 		           computeClustered(cmd, frame, descriptorManager, globalDSetComponent.globalDSets, pipelineManager,
-		                            swapChain.swapChainExtent.width, swapChain.swapChainExtent.height,
+		                            extent.width, extent.height,
 		                            bufferManager.getBuffer(globalDSetComponent.forwardClusteredGridBuffer, frame),
 		                            bufferManager.getBuffer(globalDSetComponent.forwardClusteredInfoBuffer, frame),
 		                            bufferManager.getBuffer(globalDSetComponent.visiblePointLightIndicesBuffer, frame));
@@ -21,6 +21,7 @@
 #include "GraphicsCore/Resources/Managers/TextureManager.hpp"
 #include "GraphicsCore/Managers/PipelineManager.hpp"
 #include "GraphicsCore/Factories/PipelineFactory.hpp"
+#include "GraphicsCore/Passes/PassStreams.hpp"
 #include "GraphicsCore/RenderGraph/RenderGraph.hpp"
 
 struct AABBPush
@@ -89,7 +90,6 @@ void DebugPass::onInit(Orhescyon::GeneralManager& gm)
 
 void DebugPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame)
 {
-	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
 	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>();
 	auto& globalDSetComponent = *gm.getContextComponent<MainDSetsContext, GlobalDSetComponent>();
 	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
@@ -147,19 +147,21 @@ void DebugPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint3
 	}
 
 	vk::ClearValue clearDepth0 = vk::ClearDepthStencilValue(0.0f, 0);
+	const char* sceneColor = sceneColorStream(graphicsSettings);
+	vk::Extent2D extent = rg.getRenderExtent();
 	rg.addPass(
 	    "AABBDebug",
-	    {.colorAttachments = {{"MainColor", vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore}},
+	    {.colorAttachments = {{sceneColor, vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore}},
 	     .depthAttachment =
 	         RGAttachmentConfig{"Depth", vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore, clearDepth0}},
-	    {}, {{"MainColor", RGResourceUsage::ColorAttachmentWrite}, {"Depth", RGResourceUsage::DepthAttachmentWrite}},
-	    [&, pushData, frame](vk::raii::CommandBuffer& cmd)
+	    {}, {{sceneColor, RGResourceUsage::ColorAttachmentWrite}, {"Depth", RGResourceUsage::DepthAttachmentWrite}},
+	    [&, pushData, frame, extent](vk::raii::CommandBuffer& cmd)
 	    {
 		    auto& pip = pipelineManager.pipelines[graphicsSettings.aabbAlwaysOnTop ? "aabb_debug_ontop" : "aabb_debug"];
 		    cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pip.pipeline);
-		    cmd.setViewport(0, vk::Viewport(0.0f, 0.0f, static_cast<float>(swapChain.swapChainExtent.width),
-		                                    static_cast<float>(swapChain.swapChainExtent.height), 0.0f, 1.0f));
-		    cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), swapChain.swapChainExtent));
+		    cmd.setViewport(0, vk::Viewport(0.0f, 0.0f, static_cast<float>(extent.width),
+		                                    static_cast<float>(extent.height), 0.0f, 1.0f));
+		    cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), extent));
 		    cmd.setCullMode(vk::CullModeFlagBits::eNone);
 		    cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pip.layout, 0,
 		                           descriptorManager.descriptorManager->getSet(globalDSetComponent.globalDSets, frame), nullptr);
@@ -189,17 +191,17 @@ void DebugPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint3
 
 		rg.addPass(
 		    "GIProbeDebug",
-		    {.colorAttachments = {{"MainColor", vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore}},
+		    {.colorAttachments = {{sceneColor, vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore}},
 		     .depthAttachment = RGAttachmentConfig{"Depth", vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore}},
-		    {}, {{"MainColor", RGResourceUsage::ColorAttachmentWrite}, {"Depth", RGResourceUsage::DepthAttachmentWrite}},
-		    [&, push, probeCount, frame](vk::raii::CommandBuffer& cmd)
+		    {}, {{sceneColor, RGResourceUsage::ColorAttachmentWrite}, {"Depth", RGResourceUsage::DepthAttachmentWrite}},
+		    [&, push, probeCount, frame, extent](vk::raii::CommandBuffer& cmd)
 		    {
 			    auto& pip = pipelineManager.pipelines["gi_probe_debug"];
 			    cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pip.pipeline);
 			    cmd.setCullMode(vk::CullModeFlagBits::eBack);
-			    cmd.setViewport(0, vk::Viewport(0.0f, 0.0f, static_cast<float>(swapChain.swapChainExtent.width),
-			                                    static_cast<float>(swapChain.swapChainExtent.height), 0.0f, 1.0f));
-			    cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), swapChain.swapChainExtent));
+			    cmd.setViewport(0, vk::Viewport(0.0f, 0.0f, static_cast<float>(extent.width),
+			                                    static_cast<float>(extent.height), 0.0f, 1.0f));
+			    cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), extent));
 			    cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pip.layout, 0,
 			                           descriptorManager.descriptorManager->getSet(globalDSetComponent.globalDSets, frame),
 			                           nullptr);
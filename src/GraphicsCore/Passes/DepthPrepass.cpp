@@ -33,13 +33,24 @@ void DepthPrepass::declareStreams(Orhescyon::GeneralManager& gm, vk::SampleCount
 	auto& textureManager = *gm.getContextComponent<TextureManagerContext, TextureManagerComponent>()->textureManager;
 	auto depthFormat = textureManager.findBestFormat();
 
-	rg.declareLogicalStream("Depth", {depthFormat, RGSizeMode::FullExtent, vk::ImageAspectFlagBits::eDepth});
-	rg.declareLogicalStream("ViewNormals",
-	                        {vk::Format::eR16G16B16A16Sfloat, RGSizeMode::FullExtent, vk::ImageAspectFlagBits::eColor});
-	rg.declareLogicalStream("DepthMSAA",
-	                        {depthFormat, RGSizeMode::FullExtent, vk::ImageAspectFlagBits::eDepth, samples});
-	rg.declareLogicalStream("ViewNormalsMSAA", {vk::Format::eR16G16B16A16Sfloat, RGSizeMode::FullExtent,
-	                                            vk::ImageAspectFlagBits::eColor, samples});
+	auto declare = [&](const char* name, vk::Format format, vk::ImageAspectFlags aspect, vk::SampleCountFlagBits count)
+	{
+		rg.declareLogicalStream(name, {.format = format,
+		                               .sizeMode = RGSizeMode::FullExtent,
+		                               .aspectFlags = aspect,
+		                               .samples = count,
+		                               .renderScaled = true});
+	};
+	auto depthAspect = vk::ImageAspectFlagBits::eDepth;
+	auto colorAspect = vk::ImageAspectFlagBits::eColor;
+	auto e1 = vk::SampleCountFlagBits::e1;
+
+	declare("Depth", depthFormat, depthAspect, e1);
+	declare("ViewNormals", vk::Format::eR16G16B16A16Sfloat, colorAspect, e1);
+	declare("Velocity", kVelocityFormat, colorAspect, e1);
+	declare("DepthMSAA", depthFormat, depthAspect, samples);
+	declare("ViewNormalsMSAA", vk::Format::eR16G16B16A16Sfloat, colorAspect, samples);
+	declare("VelocityMSAA", kVelocityFormat, colorAspect, samples);
 }
 
 void DepthPrepass::buildPipelines(Orhescyon::GeneralManager& gm, vk::SampleCountFlagBits samples, bool rebuild)
@@ -64,8 +75,8 @@ void DepthPrepass::buildPipelines(Orhescyon::GeneralManager& gm, vk::SampleCount
 		    .depthTest = true,
 		    .depthWrite = true,
 		    .depthOp = vk::CompareOp::eGreater,
-		    .colorAttachments = {PipelineFactory::opaqueAttachment()},
-		    .colorFormats = {vk::Format::eR16G16B16A16Sfloat},
+		    .colorAttachments = {PipelineFactory::opaqueAttachment(), PipelineFactory::opaqueAttachment()},
+		    .colorFormats = {vk::Format::eR16G16B16A16Sfloat, kVelocityFormat},
 		    .depthFormat = depthFormat,
 		    .rasterizationSamples = samples,
 		    .alphaToCoverage = useA2C,
@@ -100,7 +111,7 @@ void DepthPrepass::onSettingsChanged(Orhescyon::GeneralManager& gm)
 	buildPipelines(gm, settings.msaaSamples, true);
 }
 
-void DepthPrepass::draw(vk::raii::CommandBuffer& cmd, uint32_t frame, SwapChain& swapChain,
+void DepthPrepass::draw(vk::raii::CommandBuffer& cmd, uint32_t frame, vk::Extent2D extent,
                         DescriptorManagerComponent& descriptorManager, GlobalDSetComponent& globalDSetComponent,
                         BufferManager& bufferManager, ModelDSetComponent& objectDSetComponent,
                         BindlessTextureDSetComponent& bindlessTextureDSetComponent, ModelManager& modelManager,
@@ -114,9 +125,9 @@ void DepthPrepass::draw(vk::raii::CommandBuffer& cmd, uint32_t frame, SwapChain&
 	cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *firstLayout, 2,
 	                       descriptorManager.descriptorManager->getSet(bindlessTextureDSetComponent.bindlessTextureSet), nullptr);
 
-	cmd.setViewport(0, vk::Viewport(0.0f, 0.0f, static_cast<float>(swapChain.swapChainExtent.width),
-	                                static_cast<float>(swapChain.swapChainExtent.height), 0.0f, 1.0f));
-	cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), swapChain.swapChainExtent));
+	cmd.setViewport(0, vk::Viewport(0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height),
+	                                0.0f, 1.0f));
+	cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), extent));
 
 	cmd.bindVertexBuffers(0, modelManager.getVertexIndexBuffer(0).vertexBuffer, {0});
 	cmd.bindIndexBuffer(modelManager.getVertexIndexBuffer(0).indexBuffer, 0,
@@ -142,7 +153,6 @@ void DepthPrepass::draw(vk::raii::CommandBuffer& cmd, uint32_t frame, SwapChain&
 
 void DepthPrepass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame)
 {
-	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
 	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>();
 	auto& globalDSetComponent = *gm.getContextComponent<MainDSetsContext, GlobalDSetComponent>();
 	auto& bufferManager = *gm.getContextComponent<BufferManagerContext, BufferManagerComponent>()->bufferManager;
@@ -165,29 +175,35 @@ void DepthPrepass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, ui
 
 	if (graphicsSettings.msaaSamples & vk::SampleCountFlagBits::e1)
 	{
-		colorAttachments = {{"ViewNormals", vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, clearBlack}};
+		colorAttachments = {{"ViewNormals", vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, clearBlack},
+		                    {"Velocity", vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, clearBlack}};
 		depthAttachment =
 		    RGAttachmentConfig{"Depth", vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, clearDepth0};
 		mainWrites = {{"ViewNormals", RGResourceUsage::ColorAttachmentWrite},
+		              {"Velocity", RGResourceUsage::ColorAttachmentWrite},
 		              {"Depth", RGResourceUsage::DepthAttachmentWrite}};
 	}
 	else
 	{
 		colorAttachments = {{"ViewNormalsMSAA", vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, clearBlack,
-		                     "ViewNormals", colorResolve}};
+		                     "ViewNormals", colorResolve},
+		                    {"VelocityMSAA", vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, clearBlack,
+		                     "Velocity", colorResolve}};
 		depthAttachment = RGAttachmentConfig{
 		    "DepthMSAA", vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, clearDepth0, "Depth", depthResolve};
 		mainWrites = {{"ViewNormalsMSAA", RGResourceUsage::ColorAttachmentWrite},
+		              {"VelocityMSAA", RGResourceUsage::ColorAttachmentWrite},
 		              {"DepthMSAA", RGResourceUsage::DepthAttachmentWrite},
 		              {"ViewNormals", RGResourceUsage::ColorAttachmentWrite},
+		              {"Velocity", RGResourceUsage::ColorAttachmentWrite},
 		              {"Depth", RGResourceUsage::DepthAttachmentWrite}};
 	}
 
 	rg.addPass("DepthPrepass", {.colorAttachments = colorAttachments, .depthAttachment = depthAttachment}, {},
 	           mainWrites,
-	           [&, frame](vk::raii::CommandBuffer& cmd)
+	           [&, frame, extent = rg.getRenderExtent()](vk::raii::CommandBuffer& cmd)
 	           {
-		           draw(cmd, frame, swapChain, descriptorManager, globalDSetComponent, bufferManager, objectDSetComponent,
+		           draw(cmd, frame, extent, descriptorManager, globalDSetComponent, bufferManager, objectDSetComponent,
 		                bindlessTextureDSetComponent, modelManager, drawInfo, pipelineManager);
 	           });
 }
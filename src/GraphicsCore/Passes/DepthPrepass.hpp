@@ -2,7 +2,6 @@
 #include "GraphicsCore/Passes/IPass.hpp"
 #include <vulkan/vulkan_raii.hpp>
 
-class SwapChain;
 class BufferManager;
 class ModelManager;
 class PipelineManager;
@@ -15,12 +14,15 @@ struct DrawInfoComponent;
 class DepthPrepass : public IPass
 {
 public:
+	// Screen-space motion (UV delta from the previous frame), written alongside the view normals
+	static constexpr vk::Format kVelocityFormat = vk::Format::eR16G16Sfloat;
+
 	void onInit(Orhescyon::GeneralManager& gm) override;
 	void onSettingsChanged(Orhescyon::GeneralManager& gm) override;
 	void addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame) override;
 
 private:
-	void draw(vk::raii::CommandBuffer& cmd, uint32_t frame, SwapChain& swapChain, DescriptorManagerComponent& descriptorManager,
+	void draw(vk::raii::CommandBuffer& cmd, uint32_t frame, vk::Extent2D extent, DescriptorManagerComponent& descriptorManager,
 	          GlobalDSetComponent& globalDSetComponent, BufferManager& bufferManager, ModelDSetComponent& objectDSetComponent,
 	          BindlessTextureDSetComponent& bindlessTextureDSetComponent, ModelManager& modelManager,
 	          const DrawInfoComponent& drawInfo, PipelineManager& pipelineManager);
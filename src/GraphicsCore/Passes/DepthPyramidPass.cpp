@@ -33,7 +33,7 @@ void DepthPyramidPass::onInit(Orhescyon::GeneralManager& gm)
 	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
 	auto& rg = *gm.getContextComponent<RenderGraphContext, RenderGraphComponent>()->renderGraph;
 
-	for (uint32_t i = 0; i < kMaxMips; ++i) _dsets[i] = descriptorManager.allocate("hiZSet");
+	for (uint32_t i = 0; i < kMaxMips; ++i) _dsets[i] = descriptorManager.allocate("hiZSet", MAX_FRAMES_IN_FLIGHT);
 
 	// Linear view-space Z pyramid sampling
 	SamplerDesc pyramidSampler;
@@ -46,67 +46,76 @@ void DepthPyramidPass::onInit(Orhescyon::GeneralManager& gm)
 	                                         .samples = vk::SampleCountFlagBits::e1,
 	                                         .mipLevels = RG_FULL_MIP_CHAIN,
 	                                         .extraUsage = vk::ImageUsageFlagBits::eStorage,
-	                                         .samplerOverride = pyramidSampler});
+	                                         .samplerOverride = pyramidSampler,
+	                                         .renderScaled = true});
 
 	pipelineManager.build(
 	    PipelineDescription{
 	        .isCompute = true,
 	        .shaderPath = "depth_pyramid.spv",
 	        .setLayoutNames = {"hiZSet", "globalSet"},
-	        .pushConstants = {{vk::ShaderStageFlagBits::eCompute, 0, sizeof(uint32_t) * 3 + sizeof(float)}},
-	        // push = { dstWidth, dstHeight, passIdx, edgeRange }
+	        .pushConstants = {{vk::ShaderStageFlagBits::eCompute, 0, sizeof(uint32_t) * 5 + sizeof(float)}},
+	        // push = { dstWidth, dstHeight, srcWidth, srcHeight, passIdx, edgeRange }
 	    },
 	    "depth_pyramid");
 }
 
 void DepthPyramidPass::drawDownsample(vk::raii::CommandBuffer& cmd, DescriptorManagerComponent& descriptorManager,
-                                      DSetHandle dSetHandle, DSetHandle globalDSet, PipelineManager& pipelineManager,
-                                      uint32_t dstWidth, uint32_t dstHeight, uint32_t passIdx, float edgeRange)
+                                      DSetHandle dSetHandle, DSetHandle globalDSet, uint32_t frame,
+                                      PipelineManager& pipelineManager,
+                                      vk::Extent2D dstExtent, vk::Extent2D srcExtent, uint32_t passIdx,
+                                      float edgeRange)
 {
 	cmd.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelineManager.pipelines["depth_pyramid"].pipeline);
 	cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipelineManager.pipelines["depth_pyramid"].layout, 0,
-	                       descriptorManager.descriptorManager->getSet(dSetHandle), nullptr);
+	                       descriptorManager.descriptorManager->getSet(dSetHandle, frame), nullptr);
 	cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipelineManager.pipelines["depth_pyramid"].layout, 1,
 	                       descriptorManager.descriptorManager->getSet(globalDSet), nullptr);
 	struct PushConsts
 	{
 		uint32_t dstWidth;
 		uint32_t dstHeight;
+		uint32_t srcWidth;
+		uint32_t srcHeight;
 		uint32_t passIdx;
 		float edgeRange;
 	} push;
 
-	push.dstHeight = dstHeight;
-	push.dstWidth = dstWidth;
+	push.dstHeight = dstExtent.height;
+	push.dstWidth = dstExtent.width;
+	push.srcWidth = srcExtent.width;
+	push.srcHeight = srcExtent.height;
 	push.passIdx = passIdx;
 	push.edgeRange = edgeRange;
 
 	cmd.pushConstants<PushConsts>(*pipelineManager.pipelines["depth_pyramid"].layout, vk::ShaderStageFlagBits::eCompute, 0,
 	                              push);
-	cmd.dispatch((dstWidth + 7) / 8, (dstHeight + 7) / 8, 1);
+	cmd.dispatch((dstExtent.width + 7) / 8, (dstExtent.height + 7) / 8, 1);
 }
 
-void DepthPyramidPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t /*frame*/)
+void DepthPyramidPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame)
 {
-	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
 	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>();
 	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
 	auto& globalDSetComponent = *gm.getContextComponent<MainDSetsContext, GlobalDSetComponent>();
 	auto& gtaoSettings = *gm.getContextComponent<GtaoSettingsContext, GtaoSettingsComponent>();
+	const vk::Extent2D renderExtent = rg.getRenderExtent();
+	// Under dynamic resolution the chain is allocated for the output; keeping every level keeps the pass list, and
+	// with it the descriptor writes, unchanged while the render extent moves
+	const vk::Extent2D allocationExtent = rg.getRenderAllocationExtent();
 
-	const uint32_t kMipCount =
-	    std::bit_width(std::max(swapChain.swapChainExtent.width, swapChain.swapChainExtent.height));
+	const uint32_t kMipCount = std::bit_width(std::max(allocationExtent.width, allocationExtent.height));
 
 	auto mipExtent = [&](uint32_t mip)
 	{
 		uint32_t shift = mip;
-		return vk::Extent2D{std::max(1u, swapChain.swapChainExtent.width >> shift),
-		                    std::max(1u, swapChain.swapChainExtent.height >> shift)};
+		return vk::Extent2D{std::max(1u, renderExtent.width >> shift), std::max(1u, renderExtent.height >> shift)};
 	};
 
 	for (uint32_t i = 0; i < kMipCount; ++i)
 	{
 		vk::Extent2D dstExt = mipExtent(i);
+		vk::Extent2D srcExt = (i == 0) ? renderExtent : mipExtent(i - 1);
 		uint32_t passIdx = i;
 
 		std::string srcName = (i == 0) ? "Depth" : "DepthPyramid";
@@ -118,9 +127,9 @@ void DepthPyramidPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg
 		    "DepthPyramid" + std::to_string(i), {.isCompute = true},
 		    {{srcName, RGResourceUsage::ShaderRead, srcMip, 1}},
 		    {{"DepthPyramid", RGResourceUsage::StorageReadWrite, i, 1}},
-		    [this, &descriptorManager, &pipelineManager, &gtaoSettings, passIdx, dstExt, dset,
+		    [this, &descriptorManager, &pipelineManager, &gtaoSettings, passIdx, dstExt, srcExt, dset, frame,
 		     globalDSet = globalDSetComponent.globalDSets](vk::raii::CommandBuffer& cmd) {
-			    drawDownsample(cmd, descriptorManager, dset, globalDSet, pipelineManager, dstExt.width, dstExt.height, passIdx,
+			    drawDownsample(cmd, descriptorManager, dset, globalDSet, frame, pipelineManager, dstExt, srcExt, passIdx,
 			                   gtaoSettings.pyramidEdgeRange);
 		    },
 		    [&descriptorManager, srcName, srcMip, i, dset](const RenderGraph& graph, const RGPass& pass)
@@ -128,9 +137,9 @@ void DepthPyramidPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg
 			    auto srcHnd = pass.getPhysicalRead(srcName);
 			    auto dstHnd = pass.getPhysicalWrite("DepthPyramid");
 			    descriptorManager.descriptorManager->update(
-			        dset, DepthPyramidBinding::DepthInput, 0, vk::DescriptorType::eCombinedImageSampler,
+			        dset, DepthPyramidBinding::DepthInput, graph.getUpdateFrame(), vk::DescriptorType::eCombinedImageSampler,
 			        graph.getImageView(srcHnd, srcMip), graph.getSampler(dstHnd), vk::ImageLayout::eShaderReadOnlyOptimal);
-			    descriptorManager.descriptorManager->update(dset, DepthPyramidBinding::MipOutput, 0,
+			    descriptorManager.descriptorManager->update(dset, DepthPyramidBinding::MipOutput, graph.getUpdateFrame(),
 			                                       vk::DescriptorType::eStorageImage, graph.getImageView(dstHnd, i),
 			                                       vk::Sampler{}, vk::ImageLayout::eGeneral);
 		    });
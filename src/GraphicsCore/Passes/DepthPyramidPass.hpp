@@ -16,8 +16,8 @@ private:
 	static constexpr uint32_t kMaxMips = 16;
 
 	void drawDownsample(vk::raii::CommandBuffer& cmd, DescriptorManagerComponent& descriptorManager, DSetHandle dSetHandle,
-	                    DSetHandle globalDSet, PipelineManager& pipelineManager, uint32_t dstWidth, uint32_t dstHeight,
-	                    uint32_t passIdx, float edgeRange);
+	                    DSetHandle globalDSet, uint32_t frame, PipelineManager& pipelineManager, vk::Extent2D dstExtent,
+	                    vk::Extent2D srcExtent, uint32_t passIdx, float edgeRange);
 
 	DSetHandle _dsets[kMaxMips];
 };
@@ -118,7 +118,8 @@ void ExposurePass::drawExposurePass(vk::raii::CommandBuffer& cmd, uint32_t frame
 
 	drawBarrier.srcStageMask = vk::PipelineStageFlagBits2::eComputeShader;
 	drawBarrier.srcAccessMask = vk::AccessFlagBits2::eShaderWrite;
-	drawBarrier.dstStageMask = vk::PipelineStageFlagBits2::eFragmentShader;
+	// Read by tone mapping (fragment) or by the fused post-process (compute)
+	drawBarrier.dstStageMask = vk::PipelineStageFlagBits2::eFragmentShader | vk::PipelineStageFlagBits2::eComputeShader;
 	drawBarrier.dstAccessMask = vk::AccessFlagBits2::eShaderRead;
 	cmd.pipelineBarrier2(drawDepInfo);
 }
@@ -196,7 +197,8 @@ void ExposurePass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, ui
 	           [&descriptorManager, dSetMainColor = _dSetMainColor](const RenderGraph& graph, const RGPass& pass)
 	           {
 		           auto colorHnd = pass.getPhysicalRead("MainColor");
-		           descriptorManager.updateSingleTextureDSet(dSetMainColor, Binding::OffscreenInput,
-		                                                               graph.getImageView(colorHnd), graph.getSampler(colorHnd));
+		           descriptorManager.updateSingleTextureDSet(
+		               dSetMainColor, Binding::OffscreenInput, graph.getUpdateFrame(), graph.getImageView(colorHnd),
+		               graph.getSampler(colorHnd));
 	           });
 }
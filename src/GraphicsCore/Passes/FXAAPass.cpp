@@ -23,7 +23,8 @@ enum Binding : uint32_t
 
 bool FXAAPass::isEnabled(Orhescyon::GeneralManager& gm) const
 {
-	return gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>()->enableFxaa;
+	auto& settings = *gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
+	return settings.enableFxaa && !settings.enableFusedPostProcess;
 }
 
 void FXAAPass::onInit(Orhescyon::GeneralManager& gm)
@@ -32,7 +33,7 @@ void FXAAPass::onInit(Orhescyon::GeneralManager& gm)
 	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
 	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
 
-	_dset = descriptorManager.allocate("screenSpaceSet");
+	_dset = descriptorManager.allocate("screenSpaceSet", MAX_FRAMES_IN_FLIGHT);
 
 	pipelineManager.build(PipelineDescription{
 	    .shaderPath = "fxaa.spv",
@@ -44,7 +45,7 @@ void FXAAPass::onInit(Orhescyon::GeneralManager& gm)
 	});
 }
 
-void FXAAPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t /*frame*/)
+void FXAAPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame)
 {
 	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
 	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>();
@@ -57,7 +58,7 @@ void FXAAPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32
 	                           clearBlack}}},
 	    {{"PostProcessColor", RGResourceUsage::ShaderRead}},
 	    {{"PostProcessColor", RGResourceUsage::ColorAttachmentWrite}},
-	    [&, dset = _dset](vk::raii::CommandBuffer& cmd)
+	    [&, dset = _dset, frame](vk::raii::CommandBuffer& cmd)
 	    {
 		    cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["fxaa"].pipeline);
 
@@ -66,7 +67,7 @@ void FXAAPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32
 		    cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), swapChain.swapChainExtent));
 
 		    cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["fxaa"].layout, 0,
-		                           descriptorManager.descriptorManager->getSet(dset), nullptr);
+		                           descriptorManager.descriptorManager->getSet(dset, frame), nullptr);
 
 		    struct PushConstants
 		    {
@@ -83,7 +84,8 @@ void FXAAPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32
 	    [&descriptorManager, dset = _dset](const RenderGraph& graph, const RGPass& pass)
 	    {
 		    auto colorHnd = pass.getPhysicalRead("PostProcessColor");
-		    descriptorManager.descriptorManager->updateSingleTextureDSet(dset, Binding::ColorInput, graph.getImageView(colorHnd),
-		                                                        graph.getSampler(colorHnd));
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, Binding::ColorInput, graph.getUpdateFrame(), graph.getImageView(colorHnd),
+		        graph.getSampler(colorHnd));
 	    });
 }
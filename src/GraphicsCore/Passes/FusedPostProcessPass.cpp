@@ -0,0 +1,280 @@
+#include "FusedPostProcessPass.hpp"
+
+#include <Orhescyon/GeneralManager.hpp>
+
+#include "GraphicsCore/GraphicsContexts.hpp"
+#include "GraphicsCore/SwapChain.hpp"
+#include "GraphicsCore/Components/SwapChainComponent.hpp"
+#include "GraphicsCore/Components/DescriptorManagerComponent.hpp"
+#include "GraphicsCore/Components/PipelineManagerComponent.hpp"
+#include "GraphicsCore/Components/RenderGraphComponent.hpp"
+#include "GraphicsCore/Components/GraphicsSettingsComponent.hpp"
+#include "GraphicsCore/Components/GodRaysSettingsComponent.hpp"
+#include "GraphicsCore/Components/ExposureBufferComponent.hpp"
+#include "GraphicsCore/Components/BufferManagerComponent.hpp"
+#include "GraphicsCore/Resources/Managers/DescriptorManager.hpp"
+#include "GraphicsCore/Resources/Components/BindlessTextureDSetComponent.hpp"
+#include "GraphicsCore/Resources/Components/GlobalDSetComponent.hpp"
+#include "GraphicsCore/Managers/PipelineManager.hpp"
+#include "GraphicsCore/Factories/PipelineFactory.hpp"
+#include "GraphicsCore/RenderGraph/RenderGraph.hpp"
+
+namespace
+{
+namespace FusedBinding
+{
+enum : uint32_t
+{
+	MainColor = 0,
+	BloomInput = 2,
+	DepthInput = 3,
+};
+}
+namespace FxaaBinding
+{
+enum : uint32_t
+{
+	Output = 0,
+	ColorInput = 1,
+};
+}
+namespace OutputBinding
+{
+enum : uint32_t
+{
+	ColorInput = 0,
+};
+}
+
+// Must match the flags in post_fused.slang
+enum FusedFlags : uint32_t
+{
+	FusedGodRays = 1u << 0,
+	FusedBloom = 1u << 1,
+	FusedVignette = 1u << 2,
+	FusedAutoExposure = 1u << 3,
+};
+
+// Must match PushConstants in post_fused.slang
+struct FusedPostPush
+{
+	int space;
+	int toneMapper;
+	float exposure;
+	float contrast;
+	float saturation;
+	float temperature;
+	float tint;
+	uint32_t flags;
+	float bloomIntensity;
+	uint32_t raymarchStepCount;
+	float extinctionCoefficient;
+	float scatteringCoefficient;
+	float fogDensity;
+	uint32_t width;
+	uint32_t height;
+};
+
+struct FxaaPush
+{
+	float rcpFrame[2];
+	uint32_t width;
+	uint32_t height;
+};
+
+constexpr uint32_t kTileSize = 16;
+} // namespace
+
+bool FusedPostProcessPass::isEnabled(Orhescyon::GeneralManager& gm) const
+{
+	return gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>()->enableFusedPostProcess;
+}
+
+void FusedPostProcessPass::onInit(Orhescyon::GeneralManager& gm)
+{
+	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>()->descriptorManager;
+	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
+	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
+	auto& rg = *gm.getContextComponent<RenderGraphContext, RenderGraphComponent>()->renderGraph;
+	auto& exposureComp = *gm.getContextComponent<ExposureBufferContext, ExposureBufferComponent>();
+	auto& bufferManager = *gm.getContextComponent<BufferManagerContext, BufferManagerComponent>()->bufferManager;
+
+	_dSetFused = descriptorManager.allocate("fusedPostSet", MAX_FRAMES_IN_FLIGHT);
+	_dSetFxaa = descriptorManager.allocate("fusedPostSet", MAX_FRAMES_IN_FLIGHT);
+	_dSetOutput = descriptorManager.allocate("screenSpaceSet", MAX_FRAMES_IN_FLIGHT);
+	_dSetExposure = descriptorManager.allocate("exposureSet", MAX_FRAMES_IN_FLIGHT);
+
+	for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+	{
+		descriptorManager.update(_dSetExposure, 1, i, vk::DescriptorType::eStorageBuffer,
+		                         bufferManager.getBuffer(exposureComp.exposureBuffer));
+	}
+
+	// Display-referred result of the tiled FXAA stage, still in the HDR format so it can be a storage target
+	rg.declareLogicalStream("FusedPostColor", {swapChain.hdrFormat, RGSizeMode::FullExtent,
+	                                           vk::ImageAspectFlagBits::eColor, vk::SampleCountFlagBits::e1, 1,
+	                                           vk::ImageUsageFlagBits::eStorage});
+
+	pipelineManager.build(
+	    PipelineDescription{
+	        .isCompute = true,
+	        .shaderPath = "post_fused.spv",
+	        .setLayoutNames = {"fusedPostSet", "globalSet", "textureSet", "exposureSet"},
+	        .pushConstants = {{vk::ShaderStageFlagBits::eCompute, 0, sizeof(FusedPostPush)}},
+	    },
+	    "post_fused");
+	pipelineManager.build(
+	    PipelineDescription{
+	        .isCompute = true,
+	        .shaderPath = "post_fxaa.spv",
+	        .setLayoutNames = {"fusedPostSet"},
+	        .pushConstants = {{vk::ShaderStageFlagBits::eCompute, 0, sizeof(FxaaPush)}},
+	    },
+	    "post_fxaa");
+	pipelineManager.build(PipelineDescription{
+	    .shaderPath = "post_output.spv",
+	    .cullMode = vk::CullModeFlagBits::eNone,
+	    .colorAttachments = {PipelineFactory::opaqueAttachment()},
+	    .colorFormats = {swapChain.swapChainImageFormat},
+	    .setLayoutNames = {"screenSpaceSet"},
+	});
+}
+
+void FusedPostProcessPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame)
+{
+	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
+	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>();
+	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
+	auto& settings = *gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
+	auto& godRaysSettings = *gm.getContextComponent<GodRaysSettingsContext, GodRaysSettingsComponent>();
+	auto& bindlessTextureDSetComponent = *gm.getContextComponent<MainDSetsContext, BindlessTextureDSetComponent>();
+	auto& globalDSetComponent = *gm.getContextComponent<MainDSetsContext, GlobalDSetComponent>();
+
+	vk::Extent2D extent = swapChain.swapChainExtent;
+
+	uint32_t flags = 0;
+	if (settings.enableGodRays) flags |= FusedGodRays;
+	if (settings.enableBloom) flags |= FusedBloom;
+	if (settings.enableVignette) flags |= FusedVignette;
+	if (settings.enableAutoExposure) flags |= FusedAutoExposure;
+
+	FusedPostPush push{
+	    .space = settings.gradingSpace,
+	    .toneMapper = settings.toneMapper,
+	    .exposure = settings.colorExposure,
+	    .contrast = settings.contrast,
+	    .saturation = settings.saturation,
+	    .temperature = settings.temperature,
+	    .tint = settings.tint,
+	    .flags = flags,
+	    .bloomIntensity = settings.bloomIntensity,
+	    .raymarchStepCount = static_cast<uint32_t>(godRaysSettings.raymarchStepCount),
+	    .extinctionCoefficient = godRaysSettings.extinctionCoefficient,
+	    .scatteringCoefficient = godRaysSettings.scatteringCoefficient,
+	    .fogDensity = godRaysSettings.fogDensity,
+	    .width = extent.width,
+	    .height = extent.height,
+	};
+
+	// BloomChain is read even with bloom off so the binding always points at a valid image
+	rg.addPass(
+	    "FusedPost", {.isCompute = true},
+	    {{"BloomChain", RGResourceUsage::ShaderRead, 0, 1}, {"Depth", RGResourceUsage::ShaderRead}},
+	    {{"MainColor", RGResourceUsage::StorageReadWrite}},
+	    [&, frame, push, extent, dset = _dSetFused](vk::raii::CommandBuffer& cmd)
+	    {
+		    auto& pipeline = pipelineManager.pipelines["post_fused"];
+		    cmd.bindPipeline(vk::PipelineBindPoint::eCompute, *pipeline.pipeline);
+		    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipeline.layout, 0,
+		                           descriptorManager.descriptorManager->getSet(dset, frame), nullptr);
+		    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipeline.layout, 1,
+		                           descriptorManager.descriptorManager->getSet(globalDSetComponent.globalDSets, frame),
+		                           nullptr);
+		    cmd.bindDescriptorSets(
+		        vk::PipelineBindPoint::eCompute, *pipeline.layout, 2,
+		        descriptorManager.descriptorManager->getSet(bindlessTextureDSetComponent.bindlessTextureSet), nullptr);
+		    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipeline.layout, 3,
+		                           descriptorManager.descriptorManager->getSet(_dSetExposure, frame), nullptr);
+		    cmd.pushConstants<FusedPostPush>(*pipeline.layout, vk::ShaderStageFlagBits::eCompute, 0, push);
+		    cmd.dispatch((extent.width + kTileSize - 1) / kTileSize, (extent.height + kTileSize - 1) / kTileSize, 1);
+	    },
+	    [&descriptorManager, dset = _dSetFused](const RenderGraph& graph, const RGPass& pass)
+	    {
+		    auto colorHnd = pass.getPhysicalWrite("MainColor");
+		    descriptorManager.descriptorManager->update(dset, FusedBinding::MainColor, graph.getUpdateFrame(),
+		                                                vk::DescriptorType::eStorageImage, graph.getImageView(colorHnd),
+		                                                vk::Sampler{}, vk::ImageLayout::eGeneral);
+		    auto bloomHnd = pass.getPhysicalRead("BloomChain");
+		    descriptorManager.descriptorManager->update(
+		        dset, FusedBinding::BloomInput, graph.getUpdateFrame(), vk::DescriptorType::eCombinedImageSampler,
+		        graph.getImageView(bloomHnd, 0), graph.getSampler(bloomHnd), vk::ImageLayout::eShaderReadOnlyOptimal);
+		    auto depthHnd = pass.getPhysicalRead("Depth");
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, FusedBinding::DepthInput, graph.getUpdateFrame(), graph.getImageView(depthHnd),
+		        graph.getSampler(depthHnd));
+	    });
+
+	std::string outputSource = "MainColor";
+	if (settings.enableFxaa)
+	{
+		outputSource = "FusedPostColor";
+		rg.addPass(
+		    "FusedFXAA", {.isCompute = true}, {{"MainColor", RGResourceUsage::ShaderRead}},
+		    {{"FusedPostColor", RGResourceUsage::StorageReadWrite}},
+		    [&, frame, extent, dset = _dSetFxaa](vk::raii::CommandBuffer& cmd)
+		    {
+			    auto& pipeline = pipelineManager.pipelines["post_fxaa"];
+			    cmd.bindPipeline(vk::PipelineBindPoint::eCompute, *pipeline.pipeline);
+			    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipeline.layout, 0,
+			                           descriptorManager.descriptorManager->getSet(dset, frame), nullptr);
+
+			    FxaaPush fxaaPush{};
+			    fxaaPush.rcpFrame[0] = 1.0f / static_cast<float>(extent.width);
+			    fxaaPush.rcpFrame[1] = 1.0f / static_cast<float>(extent.height);
+			    fxaaPush.width = extent.width;
+			    fxaaPush.height = extent.height;
+			    cmd.pushConstants<FxaaPush>(*pipeline.layout, vk::ShaderStageFlagBits::eCompute, 0, fxaaPush);
+			    cmd.dispatch((extent.width + kTileSize - 1) / kTileSize, (extent.height + kTileSize - 1) / kTileSize,
+			                 1);
+		    },
+		    [&descriptorManager, dset = _dSetFxaa](const RenderGraph& graph, const RGPass& pass)
+		    {
+			    auto dstHnd = pass.getPhysicalWrite("FusedPostColor");
+			    descriptorManager.descriptorManager->update(dset, FxaaBinding::Output, graph.getUpdateFrame(),
+			                                                vk::DescriptorType::eStorageImage, graph.getImageView(dstHnd),
+			                                                vk::Sampler{}, vk::ImageLayout::eGeneral);
+			    auto srcHnd = pass.getPhysicalRead("MainColor");
+			    descriptorManager.descriptorManager->updateSingleTextureDSet(
+			        dset, FxaaBinding::ColorInput, graph.getUpdateFrame(), graph.getImageView(srcHnd),
+			        graph.getSampler(srcHnd));
+		    });
+	}
+
+	// PostProcessColor uses the sRGB swapchain format, which cannot be a storage image
+	vk::ClearValue clearBlack = vk::ClearColorValue(0.0f, 0.0f, 0.0f, 0.0f);
+	rg.addPass(
+	    "FusedPostOutput",
+	    {.colorAttachments = {{"PostProcessColor", vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore,
+	                           clearBlack}}},
+	    {{outputSource, RGResourceUsage::ShaderRead}}, {{"PostProcessColor", RGResourceUsage::ColorAttachmentWrite}},
+	    [&, frame, extent, dset = _dSetOutput](vk::raii::CommandBuffer& cmd)
+	    {
+		    cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["post_output"].pipeline);
+
+		    cmd.setViewport(0, vk::Viewport(0.0f, 0.0f, static_cast<float>(extent.width),
+		                                    static_cast<float>(extent.height), 0.0f, 1.0f));
+		    cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), extent));
+
+		    cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["post_output"].layout, 0,
+		                           descriptorManager.descriptorManager->getSet(dset, frame), nullptr);
+		    cmd.setCullMode(vk::CullModeFlagBits::eNone);
+		    cmd.draw(3, 1, 0, 0);
+	    },
+	    [&descriptorManager, outputSource, dset = _dSetOutput](const RenderGraph& graph, const RGPass& pass)
+	    {
+		    auto srcHnd = pass.getPhysicalRead(outputSource);
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, OutputBinding::ColorInput, graph.getUpdateFrame(), graph.getImageView(srcHnd),
+		        graph.getSampler(srcHnd));
+	    });
+}
@@ -0,0 +1,20 @@
+#pragma once
+#include "GraphicsCore/Passes/IPass.hpp"
+#include "GraphicsCore/Resources/Managers/ResourceHandles.hpp"
+
+// Compute replacement for GodRays, the last bloom upsample, ToneMapping and Vignette: one in-place read-modify-write
+// of MainColor, then an optional tiled FXAA stage and a copy into the swapchain-format PostProcessColor.
+// The raster passes remain the reference path and are skipped while this one is enabled.
+class FusedPostProcessPass : public IPass
+{
+public:
+	void onInit(Orhescyon::GeneralManager& gm) override;
+	void addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame) override;
+	bool isEnabled(Orhescyon::GeneralManager& gm) const override;
+
+private:
+	DSetHandle _dSetFused;
+	DSetHandle _dSetFxaa;
+	DSetHandle _dSetOutput;
+	DSetHandle _dSetExposure;
+};
@@ -55,7 +55,8 @@ RGImageDesc gtaoImageDesc(GtaoResolution resolution)
 	return {.format = vk::Format::eR8Unorm,
 	        .sizeMode = gtaoSizeMode(resolution),
 	        .aspectFlags = vk::ImageAspectFlagBits::eColor,
-	        .samplerOverride = sampler};
+	        .samplerOverride = sampler,
+	        .renderScaled = true};
 }
 
 vk::Extent2D gtaoExtent(const vk::Extent2D& fullExtent, uint32_t divisor)
@@ -99,9 +100,9 @@ void GTAOPass::onInit(Orhescyon::GeneralManager& gm)
 
 	rg.declareLogicalStream("GTAOTexture", gtaoImageDesc(GtaoResolution::Full));
 
-	_gtaoDset  = descriptorManager.allocate("screenSpaceSet");
-	_blurHDset = descriptorManager.allocate("screenSpaceSet");
-	_blurVDset = descriptorManager.allocate("screenSpaceSet");
+	_gtaoDset  = descriptorManager.allocate("screenSpaceSet", MAX_FRAMES_IN_FLIGHT);
+	_blurHDset = descriptorManager.allocate("screenSpaceSet", MAX_FRAMES_IN_FLIGHT);
+	_blurVDset = descriptorManager.allocate("screenSpaceSet", MAX_FRAMES_IN_FLIGHT);
 
 	pipelineManager.build(PipelineDescription{
 	    .shaderPath = "gtao.spv",
@@ -117,7 +118,7 @@ void GTAOPass::onInit(Orhescyon::GeneralManager& gm)
 	    .colorAttachments = {PipelineFactory::opaqueAttachment()},
 	    .colorFormats = {vk::Format::eR8Unorm},
 	    .setLayoutNames = {"screenSpaceSet"},
-	    .pushConstants = {{vk::ShaderStageFlagBits::eFragment, 0, sizeof(float) * 5}},
+	    .pushConstants = {{vk::ShaderStageFlagBits::eFragment, 0, sizeof(float) * 7}},
 	});
 
 	// Noise texture (static, 64x64, lives for the entire app — sampled per pixel by gtao.slang)
@@ -145,9 +146,10 @@ void GTAOPass::onInit(Orhescyon::GeneralManager& gm)
 	                                 textureManager.getSampler(textureManager.getTexture(_noiseTexture).samplerHandle));
 }
 
-void GTAOPass::drawGtao(vk::raii::CommandBuffer& cmd, SwapChain& swapChain, const vk::Extent2D& gtaoExtent,
+void GTAOPass::drawGtao(vk::raii::CommandBuffer& cmd, const vk::Extent2D& renderExtent, const vk::Extent2D& gtaoExtent,
                         DescriptorManagerComponent& descriptorManager,
-                        DSetHandle gtaoDSet, DSetHandle globalDSet, const GtaoSettingsComponent& gtaoSettings,
+                        DSetHandle gtaoDSet, DSetHandle globalDSet, uint32_t frame,
+                        const GtaoSettingsComponent& gtaoSettings,
                         PipelineManager& pipelineManager)
 {
 	cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, pipelineManager.pipelines["gtao"].pipeline);
@@ -157,7 +159,7 @@ void GTAOPass::drawGtao(vk::raii::CommandBuffer& cmd, SwapChain& swapChain, cons
 	cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), gtaoExtent));
 
 	cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipelineManager.pipelines["gtao"].layout, 0,
-	                       descriptorManager.descriptorManager->getSet(gtaoDSet), nullptr);
+	                       descriptorManager.descriptorManager->getSet(gtaoDSet, frame), nullptr);
 
 	cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipelineManager.pipelines["gtao"].layout, 1,
 	                       descriptorManager.descriptorManager->getSet(globalDSet), nullptr);
@@ -186,13 +188,11 @@ void GTAOPass::drawGtao(vk::raii::CommandBuffer& cmd, SwapChain& swapChain, cons
 	push.maxScreenRadius = gtaoSettings.maxScreenRadius;
 	push.fadeStart = gtaoSettings.fadeStart;
 	push.fadeEnd = gtaoSettings.fadeEnd;
-	push.texelSize[0] = 1.0f / static_cast<float>(swapChain.swapChainExtent.width);
-	push.texelSize[1] = 1.0f / static_cast<float>(swapChain.swapChainExtent.height);
+	push.texelSize[0] = 1.0f / static_cast<float>(renderExtent.width);
+	push.texelSize[1] = 1.0f / static_cast<float>(renderExtent.height);
 
 	// Index of the last pyramid mip; the view's mip range clamps sampled LOD as a backstop.
-	push.maxMip = static_cast<int>(std::bit_width(std::max(swapChain.swapChainExtent.width,
-	                                                       swapChain.swapChainExtent.height))) -
-	              1;
+	push.maxMip = static_cast<int>(std::bit_width(std::max(renderExtent.width, renderExtent.height))) - 1;
 	push.mipBias = gtaoSettings.mipBias;
 	push.multiBounceAlbedo = gtaoSettings.multiBounceAlbedo;
 	push.thicknessScale = gtaoSettings.thicknessScale;
@@ -202,9 +202,10 @@ void GTAOPass::drawGtao(vk::raii::CommandBuffer& cmd, SwapChain& swapChain, cons
 	cmd.draw(3, 1, 0, 0);
 }
 
-void GTAOPass::drawBlur(vk::raii::CommandBuffer& cmd, const vk::Extent2D& gtaoExtent,
+void GTAOPass::drawBlur(vk::raii::CommandBuffer& cmd, const vk::Extent2D& gtaoExtent, const glm::vec2& uvScale,
                         DescriptorManagerComponent& descriptorManager,
-                        DSetHandle blurDSet, float dirX, float dirY, const GtaoSettingsComponent& gtaoSettings,
+                        DSetHandle blurDSet, uint32_t frame, float dirX, float dirY,
+                        const GtaoSettingsComponent& gtaoSettings,
                         PipelineManager& pipelineManager)
 {
 	cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["gtao_blur"].pipeline);
@@ -214,17 +215,20 @@ void GTAOPass::drawBlur(vk::raii::CommandBuffer& cmd, const vk::Extent2D& gtaoEx
 	cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), gtaoExtent));
 
 	cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["gtao_blur"].layout, 0,
-	                       descriptorManager.descriptorManager->getSet(blurDSet), nullptr);
+	                       descriptorManager.descriptorManager->getSet(blurDSet, frame), nullptr);
 	struct BlurPushConstants
 	{
 		float texelSize[2];
 		float direction[2];
+		float uvScale[2];
 		float depthTolerance;
 	} push;
 	push.texelSize[0] = 1.0f / static_cast<float>(gtaoExtent.width);
 	push.texelSize[1] = 1.0f / static_cast<float>(gtaoExtent.height);
 	push.direction[0] = dirX;
 	push.direction[1] = dirY;
+	push.uvScale[0] = uvScale.x;
+	push.uvScale[1] = uvScale.y;
 	push.depthTolerance = gtaoSettings.blurDepthTolerance;
 
 	cmd.pushConstants<BlurPushConstants>(*pipelineManager.pipelines["gtao_blur"].layout, vk::ShaderStageFlagBits::eFragment, 0,
@@ -233,7 +237,7 @@ void GTAOPass::drawBlur(vk::raii::CommandBuffer& cmd, const vk::Extent2D& gtaoEx
 	cmd.draw(3, 1, 0, 0);
 }
 
-void GTAOPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t /*frame*/)
+void GTAOPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame)
 {
 	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
 	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>();
@@ -248,7 +252,11 @@ void GTAOPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32
 		rg.handleResize(swapChain.swapChainExtent.width, swapChain.swapChainExtent.height);
 		_appliedResolutionDivisor = resolutionDivisor;
 	}
-	const vk::Extent2D outputExtent = gtaoExtent(swapChain.swapChainExtent, resolutionDivisor);
+	const vk::Extent2D renderExtent = rg.getRenderExtent();
+	const vk::Extent2D outputExtent = gtaoExtent(renderExtent, resolutionDivisor);
+	const vk::Extent2D allocationExtent = rg.getRenderAllocationExtent();
+	const glm::vec2 uvScale(static_cast<float>(renderExtent.width) / static_cast<float>(allocationExtent.width),
+	                        static_cast<float>(renderExtent.height) / static_cast<float>(allocationExtent.height));
 
 	// Static noise — imported only when GTAO is active, layout never changes
 	rg.importImage("NoiseImage", textureManager.getTexture(_noiseTexture).textureImage,
@@ -263,19 +271,21 @@ void GTAOPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32
 	     {"ViewNormals", RGResourceUsage::ShaderRead},
 	     {"NoiseImage", RGResourceUsage::ShaderRead}},
 	    {{"GTAOTexture", RGResourceUsage::ColorAttachmentWrite}},
-	    [&, dset = _gtaoDset, outputExtent](vk::raii::CommandBuffer& cmd)
+	    [&, dset = _gtaoDset, renderExtent, outputExtent, frame](vk::raii::CommandBuffer& cmd)
 	    {
-		    drawGtao(cmd, swapChain, outputExtent, descriptorManager, dset, globalDSetComponent.globalDSets,
+		    drawGtao(cmd, renderExtent, outputExtent, descriptorManager, dset, globalDSetComponent.globalDSets, frame,
 		             gtaoSettings, pipelineManager);
 	    },
 	    [&descriptorManager, dset = _gtaoDset](const RenderGraph& graph, const RGPass& pass)
 	    {
 		    auto depthHnd = pass.getPhysicalRead("DepthPyramid");
 		    auto normHnd = pass.getPhysicalRead("ViewNormals");
-		    descriptorManager.descriptorManager->updateSingleTextureDSet(dset, GtaoBinding::DepthInput,
-		                                                        graph.getImageView(depthHnd), graph.getSampler(depthHnd));
-		    descriptorManager.descriptorManager->updateSingleTextureDSet(dset, GtaoBinding::NormalsInput,
-		                                                        graph.getImageView(normHnd), graph.getSampler(normHnd));
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, GtaoBinding::DepthInput, graph.getUpdateFrame(), graph.getImageView(depthHnd),
+		        graph.getSampler(depthHnd));
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, GtaoBinding::NormalsInput, graph.getUpdateFrame(), graph.getImageView(normHnd),
+		        graph.getSampler(normHnd));
 	    });
 
 	rg.addPass(
@@ -285,21 +295,25 @@ void GTAOPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32
 	     {"DepthPyramid", RGResourceUsage::ShaderRead, 0, 1},
 	     {"ViewNormals", RGResourceUsage::ShaderRead}},
 	    {{"GTAOTexture", RGResourceUsage::ColorAttachmentWrite}},
-	    [&, dset = _blurHDset, outputExtent](vk::raii::CommandBuffer& cmd)
+	    [&, dset = _blurHDset, outputExtent, uvScale, frame](vk::raii::CommandBuffer& cmd)
 	    {
-		    drawBlur(cmd, outputExtent, descriptorManager, dset, 1.0f, 0.0f, gtaoSettings, pipelineManager);
+		    drawBlur(cmd, outputExtent, uvScale, descriptorManager, dset, frame, 1.0f, 0.0f, gtaoSettings,
+		             pipelineManager);
 	    },
 	    [&descriptorManager, dset = _blurHDset](const RenderGraph& graph, const RGPass& pass)
 	    {
 		    auto gtaoHnd = pass.getPhysicalRead("GTAOTexture");
 		    auto depthHnd = pass.getPhysicalRead("DepthPyramid");
 		    auto normHnd = pass.getPhysicalRead("ViewNormals");
-		    descriptorManager.descriptorManager->updateSingleTextureDSet(dset, BlurBinding::GtaoInput,
-		                                                        graph.getImageView(gtaoHnd), graph.getSampler(gtaoHnd));
-		    descriptorManager.descriptorManager->updateSingleTextureDSet(dset, BlurBinding::DepthInput,
-		                                                        graph.getImageView(depthHnd), graph.getSampler(depthHnd));
-		    descriptorManager.descriptorManager->updateSingleTextureDSet(dset, BlurBinding::NormalsInput,
-		                                                        graph.getImageView(normHnd), graph.getSampler(normHnd));
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, BlurBinding::GtaoInput, graph.getUpdateFrame(), graph.getImageView(gtaoHnd),
+		        graph.getSampler(gtaoHnd));
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, BlurBinding::DepthInput, graph.getUpdateFrame(), graph.getImageView(depthHnd),
+		        graph.getSampler(depthHnd));
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, BlurBinding::NormalsInput, graph.getUpdateFrame(), graph.getImageView(normHnd),
+		        graph.getSampler(normHnd));
 	    });
 
 	rg.addPass(
@@ -309,20 +323,24 @@ void GTAOPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32
 	     {"DepthPyramid", RGResourceUsage::ShaderRead, 0, 1},
 	     {"ViewNormals", RGResourceUsage::ShaderRead}},
 	    {{"GTAOTexture", RGResourceUsage::ColorAttachmentWrite}},
-	    [&, dset = _blurVDset, outputExtent](vk::raii::CommandBuffer& cmd)
+	    [&, dset = _blurVDset, outputExtent, uvScale, frame](vk::raii::CommandBuffer& cmd)
 	    {
-		    drawBlur(cmd, outputExtent, descriptorManager, dset, 0.0f, 1.0f, gtaoSettings, pipelineManager);
+		    drawBlur(cmd, outputExtent, uvScale, descriptorManager, dset, frame, 0.0f, 1.0f, gtaoSettings,
+		             pipelineManager);
 	    },
 	    [&descriptorManager, dset = _blurVDset](const RenderGraph& graph, const RGPass& pass)
 	    {
 		    auto gtaoHnd = pass.getPhysicalRead("GTAOTexture");
 		    auto depthHnd = pass.getPhysicalRead("DepthPyramid");
 		    auto normHnd = pass.getPhysicalRead("ViewNormals");
-		    descriptorManager.descriptorManager->updateSingleTextureDSet(dset, BlurBinding::GtaoInput,
-		                                                        graph.getImageView(gtaoHnd), graph.getSampler(gtaoHnd));
-		    descriptorManager.descriptorManager->updateSingleTextureDSet(dset, BlurBinding::DepthInput,
-		                                                        graph.getImageView(depthHnd), graph.getSampler(depthHnd));
-		    descriptorManager.descriptorManager->updateSingleTextureDSet(dset, BlurBinding::NormalsInput,
-		                                                        graph.getImageView(normHnd), graph.getSampler(normHnd));
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, BlurBinding::GtaoInput, graph.getUpdateFrame(), graph.getImageView(gtaoHnd),
+		        graph.getSampler(gtaoHnd));
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, BlurBinding::DepthInput, graph.getUpdateFrame(), graph.getImageView(depthHnd),
+		        graph.getSampler(depthHnd));
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, BlurBinding::NormalsInput, graph.getUpdateFrame(), graph.getImageView(normHnd),
+		        graph.getSampler(normHnd));
 	    });
 }
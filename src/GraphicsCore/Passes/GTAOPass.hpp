@@ -2,6 +2,7 @@
 #include "GraphicsCore/Passes/IPass.hpp"
 #include "GraphicsCore/Resources/Managers/ResourceHandles.hpp"
 #include <vulkan/vulkan_raii.hpp>
+#include <glm/glm.hpp>
 
 class SwapChain;
 class PipelineManager;
@@ -16,13 +17,13 @@ public:
 	bool isEnabled(Orhescyon::GeneralManager& gm) const override;
 
 private:
-	void drawGtao(vk::raii::CommandBuffer& cmd, SwapChain& swapChain, const vk::Extent2D& gtaoExtent,
+	void drawGtao(vk::raii::CommandBuffer& cmd, const vk::Extent2D& renderExtent, const vk::Extent2D& gtaoExtent,
 	              DescriptorManagerComponent& descriptorManager,
-	              DSetHandle gtaoDSet, DSetHandle globalDSet, const GtaoSettingsComponent& gtaoSettings,
+	              DSetHandle gtaoDSet, DSetHandle globalDSet, uint32_t frame, const GtaoSettingsComponent& gtaoSettings,
 	              PipelineManager& pipelineManager);
-	void drawBlur(vk::raii::CommandBuffer& cmd, const vk::Extent2D& gtaoExtent,
+	void drawBlur(vk::raii::CommandBuffer& cmd, const vk::Extent2D& gtaoExtent, const glm::vec2& uvScale,
 	              DescriptorManagerComponent& descriptorManager,
-	              DSetHandle blurDSet, float dirX, float dirY, const GtaoSettingsComponent& gtaoSettings,
+	              DSetHandle blurDSet, uint32_t frame, float dirX, float dirY, const GtaoSettingsComponent& gtaoSettings,
 	              PipelineManager& pipelineManager);
 
 	DSetHandle _gtaoDset;
@@ -9,6 +9,7 @@
 #include "GraphicsCore/Components/PipelineManagerComponent.hpp"
 #include "GraphicsCore/Components/GraphicsSettingsComponent.hpp"
 #include "GraphicsCore/Components/GodRaysSettingsComponent.hpp"
+#include "GraphicsCore/Passes/PassStreams.hpp"
 #include "GraphicsCore/Resources/Managers/DescriptorManager.hpp"
 #include "GraphicsCore/Managers/PipelineManager.hpp"
 #include "GraphicsCore/Factories/PipelineFactory.hpp"
@@ -26,7 +27,8 @@ enum Binding : uint32_t
 
 bool GodRaysPass::isEnabled(Orhescyon::GeneralManager& gm) const
 {
-    return gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>()->enableGodRays;
+	auto& settings = *gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
+	return settings.enableGodRays && !settings.enableFusedPostProcess;
 }
 
 void GodRaysPass::onInit(Orhescyon::GeneralManager& gm)
@@ -50,7 +52,7 @@ void GodRaysPass::onInit(Orhescyon::GeneralManager& gm)
 
 void GodRaysPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame)
 {
-	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
+	auto& graphicsSettings = *gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
 	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>();
 	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
 	auto& bindlessTextureDSetComponent = *gm.getContextComponent<MainDSetsContext, BindlessTextureDSetComponent>();
@@ -58,19 +60,20 @@ void GodRaysPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uin
     auto& godRaysSettings = *gm.getContextComponent<GodRaysSettingsContext, GodRaysSettingsComponent>();
 
 	vk::ClearValue clearBlack = vk::ClearColorValue(0.0f, 0.0f, 0.0f, 0.0f);
+	const char* sceneColor = sceneColorStream(graphicsSettings);
 	rg.addPass(
 	    "GodRays",
-	    {.colorAttachments = {{"MainColor", vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore,
+	    {.colorAttachments = {{sceneColor, vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore,
 	                           clearBlack}}},
-	    {{"MainColor", RGResourceUsage::ShaderRead}, {"Depth", RGResourceUsage::ShaderRead}},
-	    {{"MainColor", RGResourceUsage::ColorAttachmentWrite}},
-	    [&, dset = _dset, frame](vk::raii::CommandBuffer& cmd)
+	    {{sceneColor, RGResourceUsage::ShaderRead}, {"Depth", RGResourceUsage::ShaderRead}},
+	    {{sceneColor, RGResourceUsage::ColorAttachmentWrite}},
+	    [&, dset = _dset, frame, extent = rg.getRenderExtent()](vk::raii::CommandBuffer& cmd)
 	    {
 		    cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["god_rays"].pipeline);
 
-		    cmd.setViewport(0, vk::Viewport(0.0f, 0.0f, static_cast<float>(swapChain.swapChainExtent.width),
-		                                    static_cast<float>(swapChain.swapChainExtent.height), 0.0f, 1.0f));
-		    cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), swapChain.swapChainExtent));
+		    cmd.setViewport(0, vk::Viewport(0.0f, 0.0f, static_cast<float>(extent.width),
+		                                    static_cast<float>(extent.height), 0.0f, 1.0f));
+		    cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), extent));
 
 		    cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["god_rays"].layout, 0,
 		                           descriptorManager.descriptorManager->getSet(dset, frame), nullptr);
@@ -99,13 +102,15 @@ void GodRaysPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uin
 cmd.setCullMode(vk::CullModeFlagBits::eNone);
 		    cmd.draw(3, 1, 0, 0);
 	    },
-	    [&descriptorManager, dset = _dset](const RenderGraph& graph, const RGPass& pass)
+	    [&descriptorManager, dset = _dset, sceneColor](const RenderGraph& graph, const RGPass& pass)
 	    {
-		    auto colorHnd = pass.getPhysicalRead("MainColor");
+		    auto colorHnd = pass.getPhysicalRead(sceneColor);
 		    descriptorManager.descriptorManager->updateSingleTextureDSet(
-		        dset, Binding::ColorInput, graph.getImageView(colorHnd), graph.getSampler(colorHnd));
+		        dset, Binding::ColorInput, graph.getUpdateFrame(), graph.getImageView(colorHnd),
+		        graph.getSampler(colorHnd));
 		    auto depthHnd = pass.getPhysicalRead("Depth");
 		    descriptorManager.descriptorManager->updateSingleTextureDSet(
-		        dset, Binding::DepthInput, graph.getImageView(depthHnd), graph.getSampler(depthHnd));
+		        dset, Binding::DepthInput, graph.getUpdateFrame(), graph.getImageView(depthHnd),
+		        graph.getSampler(depthHnd));
 	    });
 }
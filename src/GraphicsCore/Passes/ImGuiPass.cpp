@@ -5,6 +5,11 @@
 
 #include "GraphicsCore/RenderGraph/RenderGraph.hpp"
 
+bool ImGuiPass::isEnabled(Orhescyon::GeneralManager& /*gm*/) const
+{
+	return ImGui::GetCurrentContext() != nullptr;
+}
+
 void ImGuiPass::addToGraph(Orhescyon::GeneralManager& /*gm*/, RenderGraph& rg, uint32_t /*frame*/)
 {
 	rg.addPass("ImGui",
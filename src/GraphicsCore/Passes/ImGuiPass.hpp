@@ -5,4 +5,5 @@ class ImGuiPass : public IPass
 {
 public:
 	void addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame) override;
+	bool isEnabled(Orhescyon::GeneralManager& gm) const override; // Off for headless runs, which create no context
 };
@@ -1,6 +1,7 @@
 #include "MainPass.hpp"
 #include "GraphicsCore/Passes/PassCommands.hpp"
 #include "GraphicsCore/Passes/DrawVariant.hpp"
+#include "GraphicsCore/Passes/PassStreams.hpp"
 
 #include <Orhescyon/GeneralManager.hpp>
 
@@ -34,9 +35,13 @@ void MainPass::declareStreams(Orhescyon::GeneralManager& gm, vk::SampleCountFlag
 	auto& rg = *gm.getContextComponent<RenderGraphContext, RenderGraphComponent>()->renderGraph;
 	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
 
-	rg.declareLogicalStream("MainColor", {swapChain.hdrFormat, RGSizeMode::FullExtent, vk::ImageAspectFlagBits::eColor});
+	// Storage usage for the in-place fused post-process
+	rg.declareLogicalStream("MainColor", {swapChain.hdrFormat, RGSizeMode::FullExtent, vk::ImageAspectFlagBits::eColor,
+	                                      vk::SampleCountFlagBits::e1, 1, vk::ImageUsageFlagBits::eStorage});
+	// Render-resolution scene color, resolved into MainColor by TAA
+	rg.declareLogicalStream("SceneColor", {.format = swapChain.hdrFormat, .renderScaled = true});
 	rg.declareLogicalStream("MainColorMSAA",
-	                        {swapChain.hdrFormat, RGSizeMode::FullExtent, vk::ImageAspectFlagBits::eColor, samples});
+	                        {.format = swapChain.hdrFormat, .samples = samples, .renderScaled = true});
 }
 
 void MainPass::buildPipelines(Orhescyon::GeneralManager& gm, vk::SampleCountFlagBits samples, int gtaoEnabled,
@@ -131,15 +136,15 @@ void MainPass::onSettingsChanged(Orhescyon::GeneralManager& gm)
 	buildPipelines(gm, settings.msaaSamples, gtaoEnabled, true);
 }
 
-void MainPass::draw(vk::raii::CommandBuffer& cmd, SwapChain& swapChain, uint32_t frame,
+void MainPass::draw(vk::raii::CommandBuffer& cmd, vk::Extent2D extent, uint32_t frame,
                     BindlessTextureDSetComponent& bindlessTextureDSetComponent, DescriptorManagerComponent& descriptorManager,
                     GlobalDSetComponent& globalDSetComponent, BufferManager& bufferManager,
                     ModelDSetComponent& objectDSetComponent, ModelManager& modelManager, const DrawInfoComponent& drawInfo,
                     PipelineManager& pipelineManager, bool hasSkybox)
 {
-	cmd.setViewport(0, vk::Viewport(0.0f, 0.0f, static_cast<float>(swapChain.swapChainExtent.width),
-	                                static_cast<float>(swapChain.swapChainExtent.height), 0.0f, 1.0f));
-	cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), swapChain.swapChainExtent));
+	cmd.setViewport(0, vk::Viewport(0.0f, 0.0f, static_cast<float>(extent.width), static_cast<float>(extent.height),
+	                                0.0f, 1.0f));
+	cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), extent));
 
 	const std::string_view iblSuffix = hasSkybox ? "_forward" : "_forward_no_ibl";
 
@@ -181,7 +186,6 @@ void MainPass::draw(vk::raii::CommandBuffer& cmd, SwapChain& swapChain, uint32_t
 
 void MainPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame)
 {
-	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
 	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>();
 	auto& globalDSetComponent = *gm.getContextComponent<MainDSetsContext, GlobalDSetComponent>();
 	auto& bufferManager = *gm.getContextComponent<BufferManagerContext, BufferManagerComponent>()->bufferManager;
@@ -203,12 +207,13 @@ void MainPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32
 	std::vector<RGAttachmentConfig> colorAttachments;
 	std::optional<RGAttachmentConfig> depthAttachment;
 	vk::ResolveModeFlagBits colorResolve = vk::ResolveModeFlagBits::eAverage;
+	const char* sceneColor = sceneColorStream(graphicsSettings);
 
 	if (graphicsSettings.msaaSamples & vk::SampleCountFlagBits::e1)
 	{
-		mainWrites = {{"MainColor", RGResourceUsage::ColorAttachmentWrite},
+		mainWrites = {{sceneColor, RGResourceUsage::ColorAttachmentWrite},
 		              {"Depth", RGResourceUsage::DepthAttachmentWrite}};
-		colorAttachments = {{"MainColor", vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, clearSky}};
+		colorAttachments = {{sceneColor, vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, clearSky}};
 		depthAttachment =
 		    RGAttachmentConfig{"Depth", vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore, clearDepth0};
 	}
@@ -216,26 +221,26 @@ void MainPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32
 	{
 		mainWrites = {{"MainColorMSAA", RGResourceUsage::ColorAttachmentWrite},
 		              {"DepthMSAA", RGResourceUsage::DepthAttachmentWrite},
-		              {"MainColor", RGResourceUsage::ColorAttachmentWrite}};
+		              {sceneColor, RGResourceUsage::ColorAttachmentWrite}};
 		colorAttachments = {{"MainColorMSAA", vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, clearSky,
-		                     "MainColor", colorResolve}};
+		                     sceneColor, colorResolve}};
 		depthAttachment =
 		    RGAttachmentConfig{"DepthMSAA", vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore, clearDepth0};
 	}
 
 	rg.addPass(
 	    "Main", {.colorAttachments = colorAttachments, .depthAttachment = depthAttachment}, reads, std::move(mainWrites),
-	    [&, frame, hasSkybox](vk::raii::CommandBuffer& cmd)
+	    [&, frame, hasSkybox, extent = rg.getRenderExtent()](vk::raii::CommandBuffer& cmd)
 	    {
-		    draw(cmd, swapChain, frame, bindlessTextureDSetComponent, descriptorManager, globalDSetComponent, bufferManager,
+		    draw(cmd, extent, frame, bindlessTextureDSetComponent, descriptorManager, globalDSetComponent, bufferManager,
 		         objectDSetComponent, modelManager, drawInfo, pipelineManager, hasSkybox);
 	    },
 	    [&descriptorManager, &globalDSetComponent, &graphicsSettings](const RenderGraph& graph, const RGPass& pass)
 	    {
 		    if (!graphicsSettings.enableGtao) return;
 		    auto h = pass.getPhysicalRead("GTAOTexture");
-		    descriptorManager.descriptorManager->updateSingleTextureDSet(globalDSetComponent.globalDSets,
-		                                                        BIND_GLOBAL_GTAO_TEXTURE, graph.getImageView(h),
-		                                                        graph.getSampler(h));
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        globalDSetComponent.globalDSets, BIND_GLOBAL_GTAO_TEXTURE, graph.getUpdateFrame(), graph.getImageView(h),
+		        graph.getSampler(h));
 	    });
 }
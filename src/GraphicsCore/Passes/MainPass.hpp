@@ -2,7 +2,6 @@
 #include "GraphicsCore/Passes/IPass.hpp"
 #include <vulkan/vulkan_raii.hpp>
 
-class SwapChain;
 class BufferManager;
 class ModelManager;
 class PipelineManager;
@@ -20,7 +19,7 @@ public:
 	void addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame) override;
 
 private:
-	void draw(vk::raii::CommandBuffer& cmd, SwapChain& swapChain, uint32_t frame,
+	void draw(vk::raii::CommandBuffer& cmd, vk::Extent2D extent, uint32_t frame,
 	          BindlessTextureDSetComponent& bindlessTextureDSetComponent, DescriptorManagerComponent& descriptorManager,
 	          GlobalDSetComponent& globalDSetComponent, BufferManager& bufferManager, ModelDSetComponent& objectDSetComponent,
 	          ModelManager& modelManager, const DrawInfoComponent& drawInfo, PipelineManager& pipelineManager, bool hasSkybox);
@@ -24,10 +24,13 @@
 #include "GraphicsCore/Components/VMAllocatorComponent.hpp"
 #include "GraphicsCore/Components/ParticlesBufferComponent.hpp"
 #include "Shared/ParticlesStructs.h"
+#include <algorithm>
+#include <cstddef>
 
 const int MAX_NUMBER_PARTICLES = 1000000;
-const int MAX_NUMBER_EMITERS = 1000;
 const int TEST_SPAWN_COUNT = 1000;
+static_assert(MAX_NUMBER_EMITERS <= 0x10000, "Particle::seedEmiter holds the emiter index in 16 bits");
+static_assert(MAX_NUMBER_PARTICLES <= PARTICLE_SORT_CAPACITY);
 
 struct alignas(16) EmitorPushConst
 {
@@ -35,9 +38,76 @@ struct alignas(16) EmitorPushConst
 	alignas(4) uint32_t totalFrames;
 };
 
+struct SortPushConst
+{
+	uint32_t k;
+	uint32_t j;
+};
+
+void ParticleSystemComputePass::recordDepthSort(vk::raii::CommandBuffer& cmd, uint32_t frame,
+                                                DescriptorManagerComponent& descriptorManager,
+                                                BufferManager& bufferManager, PipelineManager& pipelineManager,
+                                                GlobalDSetComponent& globalDSetComponent, uint32_t totalFrames,
+                                                uint32_t aliveUpperBound)
+{
+	// Also orders the rewrite of _sortBuffer after the previous frame's vertex reads
+	vk::MemoryBarrier2 sortBarrier;
+	sortBarrier.srcStageMask = vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eVertexShader;
+	sortBarrier.srcAccessMask = vk::AccessFlagBits2::eShaderWrite | vk::AccessFlagBits2::eShaderRead;
+	sortBarrier.dstStageMask = vk::PipelineStageFlagBits2::eComputeShader | vk::PipelineStageFlagBits2::eDrawIndirect;
+	sortBarrier.dstAccessMask = vk::AccessFlagBits2::eShaderWrite | vk::AccessFlagBits2::eShaderRead |
+	                            vk::AccessFlagBits2::eIndirectCommandRead;
+
+	vk::DependencyInfo sortDepInfo;
+	sortDepInfo.memoryBarrierCount = 1;
+	sortDepInfo.pMemoryBarriers = &sortBarrier;
+	cmd.pipelineBarrier2(sortDepInfo);
+
+	vk::DescriptorSet particlesSet = descriptorManager.descriptorManager->getSet(_dSetParticles, frame);
+	vk::Buffer sortDispatch = bufferManager.getBuffer(_sortDispatchBuffer);
+
+	BuiltPipeline& argsPipeline = pipelineManager.pipelines["particles_sort_args"];
+	cmd.bindPipeline(vk::PipelineBindPoint::eCompute, *argsPipeline.pipeline);
+	cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *argsPipeline.layout, 0, particlesSet, nullptr);
+	cmd.dispatch(1, 1, 1);
+	cmd.pipelineBarrier2(sortDepInfo);
+
+	BuiltPipeline& keysPipeline = pipelineManager.pipelines["particles_sort_keys"];
+	cmd.bindPipeline(vk::PipelineBindPoint::eCompute, *keysPipeline.pipeline);
+	cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *keysPipeline.layout, 0, particlesSet, nullptr);
+	cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *keysPipeline.layout, 1,
+	                       descriptorManager.descriptorManager->getSet(globalDSetComponent.globalDSets, frame), nullptr);
+	cmd.pushConstants<uint32_t>(*keysPipeline.layout, vk::ShaderStageFlagBits::eCompute, 0, totalFrames);
+	cmd.dispatchIndirect(sortDispatch, 0);
+	cmd.pipelineBarrier2(sortDepInfo);
+
+	BuiltPipeline& sortPipeline = pipelineManager.pipelines["particles_sort"];
+	cmd.bindPipeline(vk::PipelineBindPoint::eCompute, *sortPipeline.pipeline);
+	cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *sortPipeline.layout, 0, particlesSet, nullptr);
+
+	auto sortStep = [&](uint32_t k, uint32_t j)
+	{
+		cmd.pushConstants<SortPushConst>(*sortPipeline.layout, vk::ShaderStageFlagBits::eCompute, 0, SortPushConst{k, j});
+		cmd.dispatchIndirect(sortDispatch, 0);
+		cmd.pipelineBarrier2(sortDepInfo);
+	};
+
+	// Stages are recorded up to the CPU-side bound; the shader skips those past this frame's exact padded count
+	uint32_t paddedBound = PARTICLE_SORT_BLOCK;
+	while (paddedBound < std::min(aliveUpperBound, PARTICLE_SORT_CAPACITY)) paddedBound <<= 1;
+	sortStep(0, 0);
+	for (uint32_t k = PARTICLE_SORT_BLOCK * 2; k <= paddedBound; k *= 2)
+	{
+		for (uint32_t j = k / 2; j >= PARTICLE_SORT_BLOCK; j /= 2) sortStep(k, j);
+		sortStep(k, PARTICLE_SORT_BLOCK / 2);
+	}
+}
+
 void ParticleSystemComputePass::drawParticleCompute(vk::raii::CommandBuffer& cmd, uint32_t frame,
                                                     DescriptorManagerComponent& descriptorManager, BufferManager& bufferManager,
-                                                    PipelineManager& pipelineManager, uint32_t totalFrames, float deltaTime)
+                                                    PipelineManager& pipelineManager,
+                                                    GlobalDSetComponent& globalDSetComponent, uint32_t totalFrames,
+                                                    float deltaTime, bool depthSort, uint32_t aliveUpperBound)
 {
 	cmd.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelineManager.pipelines["particles_spawner"].pipeline);
 	cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipelineManager.pipelines["particles_spawner"].layout, 0,
@@ -62,7 +132,7 @@ void ParticleSystemComputePass::drawParticleCompute(vk::raii::CommandBuffer& cmd
 	cmd.pushConstants<uint32_t>(*pipelineManager.pipelines["particles_spawner"].layout, vk::ShaderStageFlagBits::eCompute, 0,
 	                            totalFrames);
 	
-	cmd.dispatchIndirect(bufferManager.getBuffer(_dispatchBuffer), 0);
+	cmd.dispatchIndirect(bufferManager.getBuffer(_dispatchBuffer, frame), 0);
 
 	vk::MemoryBarrier2 fillBarrier;
 	fillBarrier.srcStageMask = vk::PipelineStageFlagBits2::eDrawIndirect | vk::PipelineStageFlagBits2::eComputeShader |
@@ -79,12 +149,7 @@ void ParticleSystemComputePass::drawParticleCompute(vk::raii::CommandBuffer& cmd
 	fillDepInfo.pMemoryBarriers = &fillBarrier;
 	cmd.pipelineBarrier2(fillDepInfo);
 
-	cmd.fillBuffer(bufferManager.getBuffer(_dispatchBuffer), 0, 4,
-	               0); // Nulling x
-	cmd.fillBuffer(bufferManager.getBuffer(_dispatchBuffer), 12, 4,
-	               0); // Nulling spawnCount
-	// ^ We dont want to nulling y and z ^
-	
+	// The spawn dispatch is rewritten by GPUParticlesSystem for every frame copy, no need to null it here
 	cmd.fillBuffer(bufferManager.getBuffer(_indirectBuffer, frame), 4, 4, 0);
 
 	vk::MemoryBarrier2 emiterBarrier;
@@ -102,13 +167,13 @@ void ParticleSystemComputePass::drawParticleCompute(vk::raii::CommandBuffer& cmd
 	cmd.bindPipeline(vk::PipelineBindPoint::eCompute, *pipelineManager.pipelines["particles_emiter"].pipeline);
 	cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipelineManager.pipelines["particles_emiter"].layout, 0,
 	                       descriptorManager.descriptorManager->getSet(_dSetParticles, frame), nullptr);
+	cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipelineManager.pipelines["particles_emiter"].layout, 1,
+	                       descriptorManager.descriptorManager->getSet(globalDSetComponent.globalDSets, frame), nullptr);
 
-	EmitorPushConst push;
-	push.deltaTime = deltaTime;
-	push.totalFrames = totalFrames;
-
-	cmd.pushConstants<EmitorPushConst>(*pipelineManager.pipelines["particles_emiter"].layout, vk::ShaderStageFlagBits::eCompute,
-	                                   0, push);
+	// Scaled per emiter by EmiterData::stepScale so off-screen emiters can be throttled
+	EmitorPushConst emitorPushConst{.deltaTime = deltaTime, .totalFrames = totalFrames};
+	cmd.pushConstants<EmitorPushConst>(*pipelineManager.pipelines["particles_emiter"].layout,
+	                                   vk::ShaderStageFlagBits::eCompute, 0, emitorPushConst);
 
 	if (totalFrames % 2 == 0)
 	{
@@ -119,6 +184,35 @@ void ParticleSystemComputePass::drawParticleCompute(vk::raii::CommandBuffer& cmd
 		cmd.dispatchIndirect(bufferManager.getBuffer(_dispatchBufferForEmiterB), 0);
 	}
 
+	if (depthSort)
+	{
+		recordDepthSort(cmd, frame, descriptorManager, bufferManager, pipelineManager, globalDSetComponent, totalFrames,
+		                aliveUpperBound);
+	}
+
+	// The alive count is final once the emiter pass is done; read back by aliveUpperBound when this slot comes round
+	vk::MemoryBarrier2 countBarrier;
+	countBarrier.srcStageMask = vk::PipelineStageFlagBits2::eComputeShader;
+	countBarrier.srcAccessMask = vk::AccessFlagBits2::eShaderWrite;
+	countBarrier.dstStageMask = vk::PipelineStageFlagBits2::eTransfer;
+	countBarrier.dstAccessMask = vk::AccessFlagBits2::eTransferRead;
+	vk::DependencyInfo countDepInfo;
+	countDepInfo.memoryBarrierCount = 1;
+	countDepInfo.pMemoryBarriers = &countBarrier;
+	cmd.pipelineBarrier2(countDepInfo);
+	cmd.copyBuffer(bufferManager.getBuffer(_indirectBuffer, frame), bufferManager.getBuffer(_aliveCountReadback, frame),
+	               vk::BufferCopy{offsetof(IndirectDrawCommand, instanceCount), 0, sizeof(uint32_t)});
+
+	vk::MemoryBarrier2 hostBarrier;
+	hostBarrier.srcStageMask = vk::PipelineStageFlagBits2::eTransfer;
+	hostBarrier.srcAccessMask = vk::AccessFlagBits2::eTransferWrite;
+	hostBarrier.dstStageMask = vk::PipelineStageFlagBits2::eHost;
+	hostBarrier.dstAccessMask = vk::AccessFlagBits2::eHostRead;
+	vk::DependencyInfo hostDepInfo;
+	hostDepInfo.memoryBarrierCount = 1;
+	hostDepInfo.pMemoryBarriers = &hostBarrier;
+	cmd.pipelineBarrier2(hostDepInfo);
+
 	vk::MemoryBarrier2 renderReadyBarrier;
 	renderReadyBarrier.srcStageMask = vk::PipelineStageFlagBits2::eComputeShader;
 	renderReadyBarrier.srcAccessMask = vk::AccessFlagBits2::eShaderWrite;
@@ -132,6 +226,18 @@ void ParticleSystemComputePass::drawParticleCompute(vk::raii::CommandBuffer& cmd
 	cmd.pipelineBarrier2(renderReadyDepInfo);
 }
 
+uint32_t ParticleSystemComputePass::aliveUpperBound(BufferManager& bufferManager, uint32_t frame) const
+{
+	// This slot's fence has been waited for, so its readback holds the count its last frame ended with. Particles
+	// only join the alive list through spawns, and each slot's dispatch buffer holds one of the frames since.
+	uint64_t bound = *bufferManager.getMapped<uint32_t>(_aliveCountReadback, frame);
+	for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
+	{
+		bound += bufferManager.getMapped<SpawnDispatchCommand>(_dispatchBuffer, i)->spawnCount;
+	}
+	return static_cast<uint32_t>(std::min<uint64_t>(bound, PARTICLE_SORT_CAPACITY));
+}
+
 void ParticleSystemComputePass::onInit(Orhescyon::GeneralManager& gm)
 {
 	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
@@ -148,18 +254,23 @@ void ParticleSystemComputePass::onInit(Orhescyon::GeneralManager& gm)
 	    bufferManager.createBuffer(vk::MemoryPropertyFlagBits::eHostVisible, sizeof(uint32_t) * MAX_NUMBER_PARTICLES, 1,
 	                          vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst);
 
-	_emitersData =
-	    bufferManager.createBuffer(vk::MemoryPropertyFlagBits::eHostVisible, sizeof(EmiterData) * MAX_NUMBER_EMITERS, 1,
-	                          vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst);
-
+	// Host-written every frame, so one copy per frame in flight
+	_emitersData = bufferManager.createBuffer(vk::MemoryPropertyFlagBits::eHostVisible,
+	                                          sizeof(EmiterData) * MAX_NUMBER_EMITERS, MAX_FRAMES_IN_FLIGHT,
+	                                          vk::BufferUsageFlagBits::eStorageBuffer);
+	_spawnRanges = bufferManager.createBuffer(vk::MemoryPropertyFlagBits::eHostVisible,
+	                                          sizeof(EmiterSpawnRange) * MAX_NUMBER_EMITERS, MAX_FRAMES_IN_FLIGHT,
+	                                          vk::BufferUsageFlagBits::eStorageBuffer);
 	_dispatchBuffer =
-	    bufferManager.createBuffer(vk::MemoryPropertyFlagBits::eHostVisible, sizeof(IndirectDispatchCommand), 1,
-	                          vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer |
-	                              vk::BufferUsageFlagBits::eTransferDst);
+	    bufferManager.createBuffer(vk::MemoryPropertyFlagBits::eHostVisible, sizeof(SpawnDispatchCommand),
+	                               MAX_FRAMES_IN_FLIGHT,
+	                               vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer);
 	_indirectBuffer =
 	    bufferManager.createBuffer(vk::MemoryPropertyFlagBits::eDeviceLocal, sizeof(IndirectDrawCommand), MAX_FRAMES_IN_FLIGHT,
 	                          vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer |
-	                              vk::BufferUsageFlagBits::eTransferDst);
+	                              vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eTransferSrc);
+	_aliveCountReadback = bufferManager.createBuffer(vk::MemoryPropertyFlagBits::eHostVisible, sizeof(uint32_t),
+	                                                 MAX_FRAMES_IN_FLIGHT, vk::BufferUsageFlagBits::eTransferDst);
 	_aliveIndicesBufferA =
 	    bufferManager.createBuffer(vk::MemoryPropertyFlagBits::eDeviceLocal, sizeof(uint32_t) * MAX_NUMBER_PARTICLES, 1,
 	                          vk::BufferUsageFlagBits::eStorageBuffer);
@@ -179,6 +290,16 @@ void ParticleSystemComputePass::onInit(Orhescyon::GeneralManager& gm)
 	_particlesMetadata =
 	    bufferManager.createBuffer(vk::MemoryPropertyFlagBits::eHostVisible, sizeof(ParticlesMetadata), 1,
 	                          vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferDst);
+	_sortBuffer = bufferManager.createBuffer(vk::MemoryPropertyFlagBits::eDeviceLocal,
+	                                         sizeof(ParticleSortEntry) * PARTICLE_SORT_CAPACITY, 1,
+	                                         vk::BufferUsageFlagBits::eStorageBuffer);
+	_sortDispatchBuffer =
+	    bufferManager.createBuffer(vk::MemoryPropertyFlagBits::eDeviceLocal, sizeof(IndirectDispatchCommand), 1,
+	                               vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eIndirectBuffer);
+	// Half-precision xyz per particle, written by the spawner and by depth collisions
+	_particleVelocities = bufferManager.createBuffer(vk::MemoryPropertyFlagBits::eDeviceLocal,
+	                                                 sizeof(uint32_t) * 2 * MAX_NUMBER_PARTICLES, 1,
+	                                                 vk::BufferUsageFlagBits::eStorageBuffer);
 
 	for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
 	{
@@ -187,9 +308,9 @@ void ParticleSystemComputePass::onInit(Orhescyon::GeneralManager& gm)
 		descriptorManager.update(_dSetParticles, 1, i, vk::DescriptorType::eStorageBuffer,
 		                bufferManager.getBuffer(_particlesStack));
 		descriptorManager.update(_dSetParticles, 2, i, vk::DescriptorType::eStorageBuffer,
-		                bufferManager.getBuffer(_emitersData));
+		                bufferManager.getBuffer(_emitersData, i));
 		descriptorManager.update(_dSetParticles, 3, i, vk::DescriptorType::eStorageBuffer,
-		                bufferManager.getBuffer(_dispatchBuffer));
+		                bufferManager.getBuffer(_dispatchBuffer, i));
 		descriptorManager.update(_dSetParticles, 4, i, vk::DescriptorType::eStorageBuffer,
 		                bufferManager.getBuffer(_indirectBuffer, i));
 		descriptorManager.update(_dSetParticles, 5, i, vk::DescriptorType::eStorageBuffer,
@@ -202,6 +323,18 @@ void ParticleSystemComputePass::onInit(Orhescyon::GeneralManager& gm)
 		                bufferManager.getBuffer(_dispatchBufferForEmiterB));
 		descriptorManager.update(_dSetParticles, 9, i, vk::DescriptorType::eStorageBuffer,
 		                bufferManager.getBuffer(_particlesMetadata));
+		descriptorManager.update(_dSetParticles, 10, i, vk::DescriptorType::eStorageBuffer,
+		                bufferManager.getBuffer(_sortBuffer));
+		descriptorManager.update(_dSetParticles, 11, i, vk::DescriptorType::eStorageBuffer,
+		                bufferManager.getBuffer(_sortDispatchBuffer));
+		descriptorManager.update(_dSetParticles, 13, i, vk::DescriptorType::eStorageBuffer,
+		                bufferManager.getBuffer(_particleVelocities));
+		descriptorManager.update(_dSetParticles, 14, i, vk::DescriptorType::eStorageBuffer,
+		                bufferManager.getBuffer(_spawnRanges, i));
+
+		*bufferManager.getMapped<SpawnDispatchCommand>(_dispatchBuffer, i) =
+		    SpawnDispatchCommand{.x = 0, .y = 1, .z = 1, .spawnCount = 0, .rangeCount = 0};
+		*bufferManager.getMapped<uint32_t>(_aliveCountReadback, i) = 0;
 	}
 
 	auto& vulkanDevice = *gm.getContextComponent<MainVulkanDeviceContext, VulkanDeviceComponent>()->vulkanDeviceInstance;
@@ -243,22 +376,6 @@ void ParticleSystemComputePass::onInit(Orhescyon::GeneralManager& gm)
 	cmd.copyBuffer(vk::Buffer(stagingParticles.buffer), bufferManager.getBuffer(_particlesBuffer),
 	               copyRegionParticles);
 
-	// dispatch. For some reason cant use updateBuffer for this one, maybe because of the size of the buffer or
-	// something, but copyBuffer works fine
-	// TODO: Find out why updateBuffer is not working for dispatch buffer, maybe we can avoid creating staging buffer for
-	// this
-	IndirectDispatchCommand initialDispatch = {.x = 0, .y = 1, .z = 1, .spawnCount = 0};
-	StagingBuffer stagingDispatch = VulkanUtils::createStagingBuffer(&initialDispatch, sizeof(IndirectDispatchCommand),
-	                                                                 allocator, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
-
-	vk::BufferCopy copyRegionDispatch;
-	copyRegionDispatch.srcOffset = 0;
-	copyRegionDispatch.dstOffset = 0;
-	copyRegionDispatch.size = sizeof(IndirectDispatchCommand);
-
-	cmd.copyBuffer(vk::Buffer(stagingDispatch.buffer), bufferManager.getBuffer(_dispatchBuffer),
-	               copyRegionDispatch);
-
 	// Dispatch for emiter
 	IndirectDispatchCommand initialDispatchForEmiter = {.x = 0, .y = 1, .z = 1, .spawnCount = 0};
 	for (uint32_t i = 0; i < MAX_FRAMES_IN_FLIGHT; ++i)
@@ -275,7 +392,6 @@ void ParticleSystemComputePass::onInit(Orhescyon::GeneralManager& gm)
 
 	VulkanUtils::destroyStagingBuffer(staging, allocator);
 	VulkanUtils::destroyStagingBuffer(stagingParticles, allocator);
-	VulkanUtils::destroyStagingBuffer(stagingDispatch, allocator);
 
 	// Why did cmd continue to brake up after I add new buffers? No idea, but creating new single time command works
 	// fine, maybe some synchronization issue or something
@@ -311,14 +427,35 @@ void ParticleSystemComputePass::onInit(Orhescyon::GeneralManager& gm)
 	pipelineManager.build(PipelineDescription{
 	    .isCompute = true,
 	    .shaderPath = "particles_emiter.spv",
-	    .setLayoutNames = {"particleSystemSet"},
+	    .setLayoutNames = {"particleSystemSet", "globalSet"},
 	    .pushConstants = {{vk::ShaderStageFlagBits::eCompute, 0, sizeof(EmitorPushConst)}},
 	});
 
+	pipelineManager.build(PipelineDescription{
+	    .isCompute = true,
+	    .shaderPath = "particles_sort_args.spv",
+	    .setLayoutNames = {"particleSystemSet"},
+	});
+
+	pipelineManager.build(PipelineDescription{
+	    .isCompute = true,
+	    .shaderPath = "particles_sort_keys.spv",
+	    .setLayoutNames = {"particleSystemSet", "globalSet"},
+	    .pushConstants = {{vk::ShaderStageFlagBits::eCompute, 0, sizeof(uint32_t)}},
+	});
+
+	pipelineManager.build(PipelineDescription{
+	    .isCompute = true,
+	    .shaderPath = "particles_sort.spv",
+	    .setLayoutNames = {"particleSystemSet"},
+	    .pushConstants = {{vk::ShaderStageFlagBits::eCompute, 0, sizeof(SortPushConst)}},
+	});
+
 	Orhescyon::Entity e = gm.createEntity();
 	gm.registerContext<ParticlesBufferContext>(e);
 	gm.addComponent<ParticlesBufferComponent>(e, _particlesBuffer, _indirectBuffer, _aliveIndicesBufferA,
-	                                          _aliveIndicesBufferB, _dispatchBuffer, _emitersData);
+	                                          _aliveIndicesBufferB, _dispatchBuffer, _emitersData, _sortBuffer,
+	                                          _spawnRanges);
 }
 
 void ParticleSystemComputePass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame)
@@ -328,8 +465,22 @@ void ParticleSystemComputePass::addToGraph(Orhescyon::GeneralManager& gm, Render
 	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
 	uint32_t totalFrames = gm.getContextComponent<CurrentFrameContext, CurrentFrameComponent>()->frameNumber;
 	float deltaTime = gm.getContextComponent<DeltaTimeContext, DeltaTimeComponent>()->deltaTime;
-
-	rg.addPass("ParticleSystemCompute", {.isCompute = true}, {}, {},
-	           [&, frame, totalFrames, deltaTime](vk::raii::CommandBuffer& cmd)
-	           { drawParticleCompute(cmd, frame, descriptorManager, bufferManager, pipelineManager, totalFrames, deltaTime); });
+	auto& globalDSetComponent = *gm.getContextComponent<MainDSetsContext, GlobalDSetComponent>();
+	bool depthSort = gm.getContextComponent<ParticlesBufferContext, ParticlesBufferComponent>()->depthSortRequested;
+	uint32_t aliveBound = depthSort ? aliveUpperBound(bufferManager, frame) : 0;
+
+	// Runs after the depth prepass so colliding particles can read this frame's depth
+	rg.addPass(
+	    "ParticleSystemCompute", {.isCompute = true}, {{"Depth", RGResourceUsage::ShaderRead}}, {},
+	    [&, frame, totalFrames, deltaTime, depthSort, aliveBound](vk::raii::CommandBuffer& cmd)
+	    {
+		    drawParticleCompute(cmd, frame, descriptorManager, bufferManager, pipelineManager, globalDSetComponent,
+		                        totalFrames, deltaTime, depthSort, aliveBound);
+	    },
+	    [&descriptorManager, dset = _dSetParticles](const RenderGraph& graph, const RGPass& pass)
+	    {
+		    auto depthHnd = pass.getPhysicalRead("Depth");
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, 12, graph.getUpdateFrame(), graph.getImageView(depthHnd), graph.getSampler(depthHnd));
+	    });
 }
@@ -7,6 +7,7 @@
 class DescriptorManagerComponent;
 class BufferManager;
 class PipelineManager;
+class GlobalDSetComponent;
 
 class ParticleSystemComputePass : public IPass
 {
@@ -17,7 +18,16 @@ public:
 
 private:
 	void drawParticleCompute(vk::raii::CommandBuffer& cmd, uint32_t frame, DescriptorManagerComponent& descriptorManager,
-	                         BufferManager& bufferManager, PipelineManager& pipelineManager, uint32_t totalFrames, float deltaTime);
+	                         BufferManager& bufferManager, PipelineManager& pipelineManager,
+	                         GlobalDSetComponent& globalDSetComponent, uint32_t totalFrames, float deltaTime,
+	                         bool depthSort, uint32_t aliveUpperBound);
+	// Bitonic sort of this frame's alive list by view distance into _sortBuffer. Only the stages up to
+	// aliveUpperBound rounded to a power of two are recorded.
+	void recordDepthSort(vk::raii::CommandBuffer& cmd, uint32_t frame, DescriptorManagerComponent& descriptorManager,
+	                     BufferManager& bufferManager, PipelineManager& pipelineManager,
+	                     GlobalDSetComponent& globalDSetComponent, uint32_t totalFrames, uint32_t aliveUpperBound);
+	// Alive count MAX_FRAMES_IN_FLIGHT frames ago plus every spawn since; never below this frame's alive count
+	uint32_t aliveUpperBound(BufferManager& bufferManager, uint32_t frame) const;
 	DSetHandle _dSetParticles;
 	BufferHandle _emitersData;
 	BufferHandle _particlesStack;
@@ -28,4 +38,9 @@ private:
 	BufferHandle _dispatchBufferForEmiterA;
 	BufferHandle _dispatchBufferForEmiterB;
 	BufferHandle _particlesMetadata;
+	BufferHandle _sortBuffer;
+	BufferHandle _sortDispatchBuffer;
+	BufferHandle _particleVelocities;
+	BufferHandle _spawnRanges;
+	BufferHandle _aliveCountReadback; // Per frame in flight, instanceCount copied out after the emiter pass
 };
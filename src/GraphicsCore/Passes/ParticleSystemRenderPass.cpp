@@ -25,13 +25,20 @@
 #include "GraphicsCore/Components/RenderGraphComponent.hpp"
 #include "GraphicsCore/Components/ParticlesBufferComponent.hpp"
 #include "GraphicsCore/Components/TextureManagerComponent.hpp"
+#include "GraphicsCore/Passes/PassStreams.hpp"
 
 const int MAX_NUMBER_PARTICLES = 100000;
 
+struct RenderPushConst
+{
+	uint32_t totalFrames;
+	uint32_t sorted;
+};
+
 void ParticleSystemRenderPass::drawParticlRender(vk::raii::CommandBuffer& cmd, uint32_t frame,
                                                  DescriptorManagerComponent& descriptorManager, BufferManager& bufferManager,
                                                  PipelineManager& pipelineManager, GlobalDSetComponent& globalDSetComponent,
-                                                 BufferHandle& indirectBuffer, uint32_t totalFrames)
+                                                 BufferHandle& indirectBuffer, uint32_t totalFrames, bool sorted)
 {
 	cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["system_render"].pipeline);
 
@@ -40,8 +47,9 @@ void ParticleSystemRenderPass::drawParticlRender(vk::raii::CommandBuffer& cmd, u
 	cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["system_render"].layout, 1,
 	                       descriptorManager.descriptorManager->getSet(globalDSetComponent.globalDSets, frame), nullptr);
 
-	cmd.pushConstants<uint32_t>(*pipelineManager.pipelines["system_render"].layout, vk::ShaderStageFlagBits::eVertex, 0,
-	                            totalFrames);
+	RenderPushConst push{totalFrames, sorted ? 1u : 0u};
+	cmd.pushConstants<RenderPushConst>(*pipelineManager.pipelines["system_render"].layout,
+	                                   vk::ShaderStageFlagBits::eVertex, 0, push);
 
 	cmd.drawIndirect(bufferManager.getBuffer(indirectBuffer, frame), 0, 1, sizeof(IndirectDrawCommand));
 }
@@ -67,6 +75,8 @@ void ParticleSystemRenderPass::onInit(Orhescyon::GeneralManager& gm)
 		                bufferManager.getBuffer(particlesBuffer.aliveIndicesBufferA));
 		descriptorManager.update(_dSetParticles, 6, i, vk::DescriptorType::eStorageBuffer,
 		                bufferManager.getBuffer(particlesBuffer.aliveIndicesBufferB));
+		descriptorManager.update(_dSetParticles, 10, i, vk::DescriptorType::eStorageBuffer,
+		                bufferManager.getBuffer(particlesBuffer.sortBuffer));
 	}
 
 	pipelineManager.build(PipelineDescription{
@@ -79,7 +89,7 @@ void ParticleSystemRenderPass::onInit(Orhescyon::GeneralManager& gm)
 	    .colorFormats = {swapChain.hdrFormat},
 	    .depthFormat = depthFormat,
 	    .setLayoutNames = {"particleSystemSet", "globalSet"},
-	    .pushConstants = {{vk::ShaderStageFlagBits::eVertex, 0, sizeof(uint32_t)}},
+	    .pushConstants = {{vk::ShaderStageFlagBits::eVertex, 0, sizeof(RenderPushConst)}},
 	});
 }
 
@@ -91,18 +101,23 @@ void ParticleSystemRenderPass::addToGraph(Orhescyon::GeneralManager& gm, RenderG
 	uint32_t totalFrames = gm.getContextComponent<CurrentFrameContext, CurrentFrameComponent>()->frameNumber;
 	float deltaTime = gm.getContextComponent<DeltaTimeContext, DeltaTimeComponent>()->deltaTime;
 	auto& globalDSetComponent = *gm.getContextComponent<MainDSetsContext, GlobalDSetComponent>();
-	auto& indirectBuffer = gm.getContextComponent<ParticlesBufferContext, ParticlesBufferComponent>()->indirectBuffer;
+	auto& particlesBuffer = *gm.getContextComponent<ParticlesBufferContext, ParticlesBufferComponent>();
+	auto& indirectBuffer = particlesBuffer.indirectBuffer;
+	bool sorted = particlesBuffer.depthSortRequested;
 
 	vk::ClearValue clearSky = vk::ClearColorValue(0.0f, 0.637f, 1.0f, 1.0f);
 	vk::ClearValue clearDepth0 = vk::ClearDepthStencilValue(0.0f, 0);
+	const char* sceneColor =
+	    sceneColorStream(*gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>());
 
 	rg.addPass(
 	    "ParticleSystemrender",
-	    {.colorAttachments = {{"MainColor", vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore, clearSky}},
+	    {.colorAttachments = {{sceneColor, vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore, clearSky}},
 	     .depthAttachment = {{"Depth", vk::AttachmentLoadOp::eLoad, vk::AttachmentStoreOp::eStore, clearDepth0}}},
-	    {}, {{"MainColor", RGResourceUsage::ColorAttachmentWrite}, {"Depth", RGResourceUsage::DepthAttachmentWrite}},
-	    [&, frame, totalFrames, deltaTime](vk::raii::CommandBuffer& cmd)
+	    {}, {{sceneColor, RGResourceUsage::ColorAttachmentWrite}, {"Depth", RGResourceUsage::DepthAttachmentWrite}},
+	    [&, frame, totalFrames, deltaTime, sorted](vk::raii::CommandBuffer& cmd)
 	    {
-		    drawParticlRender(cmd, frame, descriptorManager, bufferManager, pipelineManager, globalDSetComponent, indirectBuffer, totalFrames);
+		    drawParticlRender(cmd, frame, descriptorManager, bufferManager, pipelineManager, globalDSetComponent,
+		                      indirectBuffer, totalFrames, sorted);
 	    });
 }
@@ -16,6 +16,6 @@ public:
 private:
 	void drawParticlRender(vk::raii::CommandBuffer& cmd, uint32_t frame, DescriptorManagerComponent& descriptorManager,
 	                       BufferManager& bufferManager, PipelineManager& pipelineManager, GlobalDSetComponent& globalDSetComponent,
-	                       BufferHandle& indirectBuffer, uint32_t totalFrames);
+	                       BufferHandle& indirectBuffer, uint32_t totalFrames, bool sorted);
 	DSetHandle _dSetParticles;
 };
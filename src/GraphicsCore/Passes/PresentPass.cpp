@@ -1,8 +1,17 @@
 #include "PresentPass.hpp"
 
+#include <Orhescyon/GeneralManager.hpp>
+
+#include "GraphicsCore/GraphicsContexts.hpp"
+#include "GraphicsCore/VulkanDevice.hpp"
+#include "GraphicsCore/Components/VulkanDeviceComponent.hpp"
 #include "GraphicsCore/RenderGraph/RenderGraph.hpp"
 
-void PresentPass::addToGraph(Orhescyon::GeneralManager& /*gm*/, RenderGraph& rg, uint32_t /*frame*/)
+void PresentPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t /*frame*/)
 {
-	rg.addPass("Present", {}, {{"swapChainImage", RGResourceUsage::Present}}, {}, nullptr);
+	// Headless output images are never presented; PresentSrc needs the swap chain extension anyway
+	const bool headless =
+	    gm.getContextComponent<MainVulkanDeviceContext, VulkanDeviceComponent>()->vulkanDeviceInstance->headless;
+	rg.addPass("Present", {},
+	           {{"swapChainImage", headless ? RGResourceUsage::TransferSrc : RGResourceUsage::Present}}, {}, nullptr);
 }
@@ -0,0 +1,217 @@
+#include "TaaPass.hpp"
+
+#include <array>
+
+#include <Orhescyon/GeneralManager.hpp>
+
+#include "GraphicsCore/GraphicsContexts.hpp"
+#include "GraphicsCore/SwapChain.hpp"
+#include "GraphicsCore/Components/SwapChainComponent.hpp"
+#include "GraphicsCore/Components/TextureManagerComponent.hpp"
+#include "GraphicsCore/Components/DescriptorManagerComponent.hpp"
+#include "GraphicsCore/Components/PipelineManagerComponent.hpp"
+#include "GraphicsCore/Components/GraphicsSettingsComponent.hpp"
+#include "GraphicsCore/Components/CurrentFrameComponent.hpp"
+#include "GraphicsCore/Resources/Components/GlobalDSetComponent.hpp"
+#include "GraphicsCore/Resources/Managers/TextureManager.hpp"
+#include "GraphicsCore/Resources/Factories/TextureFactory.hpp"
+#include "GraphicsCore/Resources/Managers/DescriptorManager.hpp"
+#include "GraphicsCore/Managers/PipelineManager.hpp"
+#include "GraphicsCore/Factories/PipelineFactory.hpp"
+#include "GraphicsCore/RenderGraph/RenderGraph.hpp"
+
+namespace
+{
+namespace TaaBinding
+{
+enum : uint32_t
+{
+	Output = 0,
+	HistoryOutput = 1,
+	SceneColorInput = 2,
+	VelocityInput = 3,
+	DepthInput = 4,
+	HistoryInput = 5,
+};
+}
+
+// Must match PushConstants in taa_resolve.slang
+struct TaaPush
+{
+	uint32_t outputWidth;
+	uint32_t outputHeight;
+	uint32_t renderWidth;
+	uint32_t renderHeight;
+	float blendFactor;
+	uint32_t resetHistory;
+};
+
+constexpr uint32_t kGroupSize = 8;
+} // namespace
+
+bool TaaPass::isEnabled(Orhescyon::GeneralManager& gm) const
+{
+	return gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>()->enableTaa;
+}
+
+void TaaPass::onInit(Orhescyon::GeneralManager& gm)
+{
+	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>()->descriptorManager;
+	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
+	auto& textureManager = *gm.getContextComponent<TextureManagerContext, TextureManagerComponent>()->textureManager;
+	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
+
+	ImageDesc historyDesc;
+	historyDesc.width = swapChain.swapChainExtent.width;
+	historyDesc.height = swapChain.swapChainExtent.height;
+	historyDesc.format = swapChain.hdrFormat;
+	historyDesc.usage = vk::ImageUsageFlagBits::eStorage | vk::ImageUsageFlagBits::eSampled;
+
+	// Bilinear taps of the Catmull-Rom history filter
+	SamplerDesc historySampler;
+	historySampler.mipmapMode = SamplerMipmapMode::Nearest;
+	historySampler.addressMode = SamplerAddressMode::ClampToEdge;
+
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		_history[i] = TextureFactory::createTexture(textureManager, historyDesc, historySampler);
+		_dSets[i] = descriptorManager.allocate("taaSet", MAX_FRAMES_IN_FLIGHT);
+	}
+	writeHistoryBindings(textureManager, descriptorManager);
+
+	pipelineManager.build(
+	    PipelineDescription{
+	        .isCompute = true,
+	        .shaderPath = "taa_resolve.spv",
+	        .setLayoutNames = {"taaSet", "globalSet"},
+	        .pushConstants = {{vk::ShaderStageFlagBits::eCompute, 0, sizeof(TaaPush)}},
+	    },
+	    "taa_resolve");
+}
+
+void TaaPass::onResize(Orhescyon::GeneralManager& gm, uint32_t width, uint32_t height)
+{
+	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>()->descriptorManager;
+	auto& textureManager = *gm.getContextComponent<TextureManagerContext, TextureManagerComponent>()->textureManager;
+
+	for (TextureHandle history : _history) textureManager.resizeTexture(history, width, height);
+	writeHistoryBindings(textureManager, descriptorManager);
+	_historyUndefined = true;
+	_historyValid = false;
+}
+
+void TaaPass::writeHistoryBindings(TextureManager& textureManager, DescriptorManager& descriptorManager)
+{
+	// Both history images stay in General: each frame one is the storage target and the other is sampled
+	for (uint32_t i = 0; i < 2; ++i)
+	{
+		const Texture& written = textureManager.getTexture(_history[i]);
+		const Texture& read = textureManager.getTexture(_history[i ^ 1]);
+		for (uint32_t copy = 0; copy < MAX_FRAMES_IN_FLIGHT; ++copy)
+		{
+			descriptorManager.update(_dSets[i], TaaBinding::HistoryOutput, copy, vk::DescriptorType::eStorageImage,
+			                         written.textureImageView, vk::Sampler{}, vk::ImageLayout::eGeneral);
+			descriptorManager.update(_dSets[i], TaaBinding::HistoryInput, copy,
+			                         vk::DescriptorType::eCombinedImageSampler, read.textureImageView,
+			                         textureManager.getSampler(read.samplerHandle), vk::ImageLayout::eGeneral);
+		}
+	}
+}
+
+void TaaPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame)
+{
+	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
+	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>();
+	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
+	auto& textureManager = *gm.getContextComponent<TextureManagerContext, TextureManagerComponent>()->textureManager;
+	auto& settings = *gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
+	auto& globalDSetComponent = *gm.getContextComponent<MainDSetsContext, GlobalDSetComponent>();
+	uint32_t frameNumber = gm.getContextComponent<CurrentFrameContext, CurrentFrameComponent>()->frameNumber;
+
+	const vk::Extent2D outputExtent = swapChain.swapChainExtent;
+	const vk::Extent2D renderExtent = rg.getRenderExtent();
+
+	// A skipped frame (TAA was off) leaves nothing valid to reproject. The history is at output resolution, so it
+	// survives render extent changes, which dynamic resolution makes every few frames.
+	const bool resetHistory = !_historyValid || frameNumber != _lastFrameNumber + 1;
+	const bool historyUndefined = _historyUndefined;
+	const uint32_t writeIndex = _writeIndex;
+	_writeIndex ^= 1;
+	_historyUndefined = false;
+	_historyValid = true;
+	_lastFrameNumber = frameNumber;
+
+	TaaPush push{
+	    .outputWidth = outputExtent.width,
+	    .outputHeight = outputExtent.height,
+	    .renderWidth = renderExtent.width,
+	    .renderHeight = renderExtent.height,
+	    .blendFactor = settings.taaBlendFactor,
+	    .resetHistory = resetHistory ? 1u : 0u,
+	};
+	vk::Image historyImages[2] = {textureManager.getTexture(_history[0]).textureImage,
+	                              textureManager.getTexture(_history[1]).textureImage};
+
+	rg.addPass(
+	    "TAA", {.isCompute = true},
+	    {{"SceneColor", RGResourceUsage::ShaderRead},
+	     {"Velocity", RGResourceUsage::ShaderRead},
+	     {"Depth", RGResourceUsage::ShaderRead}},
+	    {{"MainColor", RGResourceUsage::StorageReadWrite}},
+	    [&, frame, push, historyUndefined, historyImages, dset = _dSets[writeIndex]](vk::raii::CommandBuffer& cmd)
+	    {
+		    // Orders last frame's history write before this frame's read, and its read before this frame's write
+		    std::array<vk::ImageMemoryBarrier2, 2> barriers;
+		    for (uint32_t i = 0; i < 2; ++i)
+		    {
+			    barriers[i].srcStageMask = vk::PipelineStageFlagBits2::eComputeShader;
+			    barriers[i].srcAccessMask =
+			        historyUndefined ? vk::AccessFlags2{} : vk::AccessFlags2{vk::AccessFlagBits2::eShaderStorageWrite};
+			    barriers[i].dstStageMask = vk::PipelineStageFlagBits2::eComputeShader;
+			    barriers[i].dstAccessMask =
+			        vk::AccessFlagBits2::eShaderSampledRead | vk::AccessFlagBits2::eShaderStorageWrite;
+			    barriers[i].oldLayout = historyUndefined ? vk::ImageLayout::eUndefined : vk::ImageLayout::eGeneral;
+			    barriers[i].newLayout = vk::ImageLayout::eGeneral;
+			    barriers[i].image = historyImages[i];
+			    barriers[i].subresourceRange = {vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1};
+		    }
+		    vk::DependencyInfo historyDependency;
+		    historyDependency.imageMemoryBarrierCount = static_cast<uint32_t>(barriers.size());
+		    historyDependency.pImageMemoryBarriers = barriers.data();
+		    cmd.pipelineBarrier2(historyDependency);
+
+		    auto& pipeline = pipelineManager.pipelines["taa_resolve"];
+		    cmd.bindPipeline(vk::PipelineBindPoint::eCompute, *pipeline.pipeline);
+		    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipeline.layout, 0,
+		                           descriptorManager.descriptorManager->getSet(dset, frame), nullptr);
+		    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipeline.layout, 1,
+		                           descriptorManager.descriptorManager->getSet(globalDSetComponent.globalDSets, frame),
+		                           nullptr);
+		    cmd.pushConstants<TaaPush>(*pipeline.layout, vk::ShaderStageFlagBits::eCompute, 0, push);
+		    cmd.dispatch((push.outputWidth + kGroupSize - 1) / kGroupSize,
+		                 (push.outputHeight + kGroupSize - 1) / kGroupSize, 1);
+	    },
+	    [&descriptorManager, dSets = std::array{_dSets[0], _dSets[1]}](const RenderGraph& graph, const RGPass& pass)
+	    {
+		    auto colorHnd = pass.getPhysicalWrite("MainColor");
+		    auto sceneHnd = pass.getPhysicalRead("SceneColor");
+		    auto velocityHnd = pass.getPhysicalRead("Velocity");
+		    auto depthHnd = pass.getPhysicalRead("Depth");
+		    for (DSetHandle dset : dSets)
+		    {
+			    descriptorManager.descriptorManager->update(dset, TaaBinding::Output, graph.getUpdateFrame(),
+			                                                vk::DescriptorType::eStorageImage,
+			                                                graph.getImageView(colorHnd), vk::Sampler{},
+			                                                vk::ImageLayout::eGeneral);
+			    descriptorManager.descriptorManager->updateSingleTextureDSet(
+			        dset, TaaBinding::SceneColorInput, graph.getUpdateFrame(), graph.getImageView(sceneHnd),
+			        graph.getSampler(sceneHnd));
+			    descriptorManager.descriptorManager->updateSingleTextureDSet(
+			        dset, TaaBinding::VelocityInput, graph.getUpdateFrame(), graph.getImageView(velocityHnd),
+			        graph.getSampler(velocityHnd));
+			    descriptorManager.descriptorManager->updateSingleTextureDSet(
+			        dset, TaaBinding::DepthInput, graph.getUpdateFrame(), graph.getImageView(depthHnd),
+			        graph.getSampler(depthHnd));
+		    }
+	    });
+}
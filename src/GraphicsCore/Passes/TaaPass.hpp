@@ -0,0 +1,30 @@
+#pragma once
+#include "GraphicsCore/Passes/IPass.hpp"
+#include "GraphicsCore/Resources/Managers/ResourceHandles.hpp"
+#include <vulkan/vulkan_raii.hpp>
+
+class TextureManager;
+class DescriptorManager;
+
+// Temporal anti-aliasing resolve: reprojects the accumulated history with the depth prepass motion vectors,
+// clips it against the current neighbourhood and blends in the jittered SceneColor, writing the full-resolution
+// MainColor. When the render scale is below 1 the same reconstruction upsamples SceneColor to the output.
+// The history pair lives outside the render graph, which has no resources that persist across frames.
+class TaaPass : public IPass
+{
+public:
+	void onInit(Orhescyon::GeneralManager& gm) override;
+	void onResize(Orhescyon::GeneralManager& gm, uint32_t width, uint32_t height) override;
+	void addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame) override;
+	bool isEnabled(Orhescyon::GeneralManager& gm) const override;
+
+private:
+	void writeHistoryBindings(TextureManager& textureManager, DescriptorManager& descriptorManager);
+
+	TextureHandle _history[2];
+	DSetHandle _dSets[2]; // Indexed by the history written this frame
+	uint32_t _writeIndex = 0;
+	bool _historyUndefined = true; // Images were (re)created and still need their first transition
+	bool _historyValid = false;
+	uint32_t _lastFrameNumber = 0;
+};
@@ -23,7 +23,7 @@ enum Binding : uint32_t
 	OffscreenInput = 0,
 };
 
-// Must match ColorGrading in tone_mapping.slang
+// Must match ColorGrading in Common/ToneMapping.slang
 struct ColorGradingPush
 {
 	int space;
@@ -36,6 +36,11 @@ struct ColorGradingPush
 };
 }
 
+bool ToneMappingPass::isEnabled(Orhescyon::GeneralManager& gm) const
+{
+	return !gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>()->enableFusedPostProcess;
+}
+
 void ToneMappingPass::onInit(Orhescyon::GeneralManager& gm)
 {
 	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>()->descriptorManager;
@@ -53,7 +58,7 @@ void ToneMappingPass::onInit(Orhescyon::GeneralManager& gm)
 	                                             .samplerOverride = postProcessSampler});
 	rg.setTerminalOutput("PostProcessColor", "swapChainImage");
 
-	_dSetMainColor = descriptorManager.allocate("screenSpaceSet");
+	_dSetMainColor = descriptorManager.allocate("screenSpaceSet", MAX_FRAMES_IN_FLIGHT);
 	_dSetExposure = descriptorManager.allocate("exposureSet", MAX_FRAMES_IN_FLIGHT);
 
 	auto& exposureComp = *gm.getContextComponent<ExposureBufferContext, ExposureBufferComponent>();
@@ -125,7 +130,7 @@ void ToneMappingPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg,
 		    cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), swapChain.swapChainExtent));
 
 		    cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["tone_mapping"].layout, 0,
-		                           descriptorManager.descriptorManager->getSet(dset), nullptr);
+		                           descriptorManager.descriptorManager->getSet(dset, frame), nullptr);
 		    cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["tone_mapping"].layout, 1,
 		                           descriptorManager.descriptorManager->getSet(_dSetExposure, frame), nullptr);
 
@@ -138,7 +143,8 @@ void ToneMappingPass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg,
 	    [&descriptorManager, dset = _dSetMainColor](const RenderGraph& graph, const RGPass& pass)
 	    {
 		    auto colorHnd = pass.getPhysicalRead("MainColor");
-		    descriptorManager.descriptorManager->updateSingleTextureDSet(dset, Binding::OffscreenInput,
-		                                                        graph.getImageView(colorHnd), graph.getSampler(colorHnd));
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, Binding::OffscreenInput, graph.getUpdateFrame(), graph.getImageView(colorHnd),
+		        graph.getSampler(colorHnd));
 	    });
 }
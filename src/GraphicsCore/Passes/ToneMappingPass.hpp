@@ -8,6 +8,7 @@ public:
 	void onInit(Orhescyon::GeneralManager& gm) override;
 	void addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame) override;
 	void onSettingsChanged(Orhescyon::GeneralManager& gm) override;
+	bool isEnabled(Orhescyon::GeneralManager& gm) const override;
 
 private:
 	DSetHandle _dSetMainColor;
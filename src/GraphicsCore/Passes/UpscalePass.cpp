@@ -0,0 +1,105 @@
+#include "UpscalePass.hpp"
+
+#include <Orhescyon/GeneralManager.hpp>
+
+#include "GraphicsCore/GraphicsContexts.hpp"
+#include "GraphicsCore/SwapChain.hpp"
+#include "GraphicsCore/Components/SwapChainComponent.hpp"
+#include "GraphicsCore/Components/DescriptorManagerComponent.hpp"
+#include "GraphicsCore/Components/PipelineManagerComponent.hpp"
+#include "GraphicsCore/Components/GraphicsSettingsComponent.hpp"
+#include "GraphicsCore/Resources/Managers/DescriptorManager.hpp"
+#include "GraphicsCore/Managers/PipelineManager.hpp"
+#include "GraphicsCore/Factories/PipelineFactory.hpp"
+#include "GraphicsCore/RenderGraph/RenderGraph.hpp"
+
+namespace
+{
+namespace UpscaleBinding
+{
+enum : uint32_t
+{
+	Output = 0,
+	SceneColorInput = 1,
+};
+}
+
+// Must match PushConstants in upscale.slang
+struct UpscalePush
+{
+	uint32_t outputWidth;
+	uint32_t outputHeight;
+	float uvScale[2];
+	float texelSize[2];
+};
+
+constexpr uint32_t kGroupSize = 8;
+} // namespace
+
+bool UpscalePass::isEnabled(Orhescyon::GeneralManager& gm) const
+{
+	auto& settings = *gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
+	return settings.enableDynamicResolution && !settings.enableTaa;
+}
+
+void UpscalePass::onInit(Orhescyon::GeneralManager& gm)
+{
+	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>()->descriptorManager;
+	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
+
+	_dSet = descriptorManager.allocate("fusedPostSet", MAX_FRAMES_IN_FLIGHT);
+
+	pipelineManager.build(
+	    PipelineDescription{
+	        .isCompute = true,
+	        .shaderPath = "upscale.spv",
+	        .setLayoutNames = {"fusedPostSet"},
+	        .pushConstants = {{vk::ShaderStageFlagBits::eCompute, 0, sizeof(UpscalePush)}},
+	    },
+	    "upscale");
+}
+
+void UpscalePass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame)
+{
+	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
+	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>();
+	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
+
+	const vk::Extent2D outputExtent = swapChain.swapChainExtent;
+	const vk::Extent2D renderExtent = rg.getRenderExtent();
+	const vk::Extent2D allocationExtent = rg.getRenderAllocationExtent();
+	const float allocW = static_cast<float>(allocationExtent.width);
+	const float allocH = static_cast<float>(allocationExtent.height);
+
+	UpscalePush push{
+	    .outputWidth = outputExtent.width,
+	    .outputHeight = outputExtent.height,
+	    .uvScale = {static_cast<float>(renderExtent.width) / allocW, static_cast<float>(renderExtent.height) / allocH},
+	    .texelSize = {1.0f / allocW, 1.0f / allocH},
+	};
+
+	rg.addPass(
+	    "Upscale", {.isCompute = true}, {{"SceneColor", RGResourceUsage::ShaderRead}},
+	    {{"MainColor", RGResourceUsage::StorageReadWrite}},
+	    [&, frame, push, dset = _dSet](vk::raii::CommandBuffer& cmd)
+	    {
+		    auto& pipeline = pipelineManager.pipelines["upscale"];
+		    cmd.bindPipeline(vk::PipelineBindPoint::eCompute, *pipeline.pipeline);
+		    cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipeline.layout, 0,
+		                           descriptorManager.descriptorManager->getSet(dset, frame), nullptr);
+		    cmd.pushConstants<UpscalePush>(*pipeline.layout, vk::ShaderStageFlagBits::eCompute, 0, push);
+		    cmd.dispatch((push.outputWidth + kGroupSize - 1) / kGroupSize,
+		                 (push.outputHeight + kGroupSize - 1) / kGroupSize, 1);
+	    },
+	    [&descriptorManager, dset = _dSet](const RenderGraph& graph, const RGPass& pass)
+	    {
+		    auto colorHnd = pass.getPhysicalWrite("MainColor");
+		    auto sceneHnd = pass.getPhysicalRead("SceneColor");
+		    descriptorManager.descriptorManager->update(dset, UpscaleBinding::Output, graph.getUpdateFrame(),
+		                                                vk::DescriptorType::eStorageImage, graph.getImageView(colorHnd),
+		                                                vk::Sampler{}, vk::ImageLayout::eGeneral);
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, UpscaleBinding::SceneColorInput, graph.getUpdateFrame(), graph.getImageView(sceneHnd),
+		        graph.getSampler(sceneHnd));
+	    });
+}
@@ -0,0 +1,16 @@
+#pragma once
+#include "GraphicsCore/Passes/IPass.hpp"
+#include "GraphicsCore/Resources/Managers/ResourceHandles.hpp"
+
+// Bilinear upscale from the render-extent corner of SceneColor to the full-resolution MainColor under dynamic
+// resolution, ahead of post-processing and UI. TAA does this as part of its resolve, so the pass only runs without it.
+class UpscalePass : public IPass
+{
+public:
+	void onInit(Orhescyon::GeneralManager& gm) override;
+	void addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame) override;
+	bool isEnabled(Orhescyon::GeneralManager& gm) const override;
+
+private:
+	DSetHandle _dSet;
+};
@@ -23,7 +23,8 @@ enum Binding : uint32_t
 
 bool VignettePass::isEnabled(Orhescyon::GeneralManager& gm) const
 {
-	return gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>()->enableVignette;
+	auto& settings = *gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
+	return settings.enableVignette && !settings.enableFusedPostProcess;
 }
 
 void VignettePass::onInit(Orhescyon::GeneralManager& gm)
@@ -32,7 +33,7 @@ void VignettePass::onInit(Orhescyon::GeneralManager& gm)
 	auto& pipelineManager = *gm.getContextComponent<PipelineManagerContext, PipelineManagerComponent>()->pipelineManager;
 	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
 
-	_dset = descriptorManager.allocate("screenSpaceSet");
+	_dset = descriptorManager.allocate("screenSpaceSet", MAX_FRAMES_IN_FLIGHT);
 
 	pipelineManager.build(PipelineDescription{
 	    .shaderPath = "vignette.spv",
@@ -43,7 +44,7 @@ void VignettePass::onInit(Orhescyon::GeneralManager& gm)
 	});
 }
 
-void VignettePass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t /*frame*/)
+void VignettePass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, uint32_t frame)
 {
 	auto& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
 	auto& descriptorManager = *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>();
@@ -56,7 +57,7 @@ void VignettePass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, ui
 	                           clearBlack}}},
 	    {{"PostProcessColor", RGResourceUsage::ShaderRead}},
 	    {{"PostProcessColor", RGResourceUsage::ColorAttachmentWrite}},
-	    [&, dset = _dset](vk::raii::CommandBuffer& cmd)
+	    [&, dset = _dset, frame](vk::raii::CommandBuffer& cmd)
 	    {
 		    cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["vignette"].pipeline);
 
@@ -65,7 +66,7 @@ void VignettePass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, ui
 		    cmd.setScissor(0, vk::Rect2D(vk::Offset2D(0, 0), swapChain.swapChainExtent));
 
 		    cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pipelineManager.pipelines["vignette"].layout, 0,
-		                           descriptorManager.descriptorManager->getSet(dset), nullptr);
+		                           descriptorManager.descriptorManager->getSet(dset, frame), nullptr);
 
 		    cmd.setCullMode(vk::CullModeFlagBits::eNone);
 		    cmd.draw(3, 1, 0, 0);
@@ -73,7 +74,8 @@ void VignettePass::addToGraph(Orhescyon::GeneralManager& gm, RenderGraph& rg, ui
 	    [&descriptorManager, dset = _dset](const RenderGraph& graph, const RGPass& pass)
 	    {
 		    auto colorHnd = pass.getPhysicalRead("PostProcessColor");
-		    descriptorManager.descriptorManager->updateSingleTextureDSet(dset, Binding::OffscreenInput,
-		                                                        graph.getImageView(colorHnd), graph.getSampler(colorHnd));
+		    descriptorManager.descriptorManager->updateSingleTextureDSet(
+		        dset, Binding::OffscreenInput, graph.getUpdateFrame(), graph.getImageView(colorHnd),
+		        graph.getSampler(colorHnd));
 	    });
 }
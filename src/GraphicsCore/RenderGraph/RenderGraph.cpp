@@ -1,11 +1,16 @@
 #include "GraphicsCore/RenderGraph/RenderGraph.hpp"
 #include "GraphicsCore/VulkanDevice.hpp"
+#include "GraphicsCore/VulkanConst.hpp"
 #include "GraphicsCore/VulkanUtils.hpp"
 #include "GraphicsCore/Resources/Managers/DescriptorManager.hpp"
 #include "GraphicsCore/Resources/Components/GlobalDSetComponent.hpp"
 #include "Shared/Bindings.h"
 #include "GraphicsCore/Components/GraphicsSettingsComponent.hpp"
 #include "GraphicsCore/Components/TracyContextComponent.hpp"
+#include "GraphicsCore/Components/DescriptorManagerComponent.hpp"
+#include "GraphicsCore/Components/CurrentFrameComponent.hpp"
+#include "FrameProfilerComponent.hpp"
+#include "FrameProfilerContext.hpp"
 
 #include <Orhescyon/GeneralManager.hpp>
 
@@ -41,6 +46,7 @@ bool mipRangesOverlap(uint32_t baseA, uint32_t countA, uint32_t baseB, uint32_t
 RenderGraph::RenderGraph(VulkanDevice& device, VmaAllocator alloc, Orhescyon::GeneralManager* generalManager)
     : vulkanDevice(device), allocator(alloc), gm(generalManager)
 {
+	createTimestampPool();
 }
 
 RenderGraph::~RenderGraph()
@@ -98,47 +104,16 @@ void RenderGraph::handleResize(uint32_t newWidth, uint32_t newHeight)
 	{
 		if (!res.isTransient) continue;
 
-		uint32_t targetW = newWidth;
-		uint32_t targetH = newHeight;
-		if (res.desc.sizeMode == RGSizeMode::HalfExtent)
-		{
-			targetW /= 2;
-			targetH /= 2;
-		}
-		else if (res.desc.sizeMode == RGSizeMode::QuarterExtent)
-		{
-			targetW /= 4;
-			targetH /= 4;
-		}
-		else if (res.desc.sizeMode == RGSizeMode::EighthExtent)
-		{
-			targetW /= 8;
-			targetH /= 8;
-		}
-		else if (res.desc.sizeMode == RGSizeMode::SixteenthExtent)
-		{
-			targetW /= 16;
-			targetH /= 16;
-		}
-		else if (res.desc.sizeMode == RGSizeMode::ThirtySecondExtent)
-		{
-			targetW /= 32;
-			targetH /= 32;
-		}
-		else if (res.desc.sizeMode == RGSizeMode::SixtyFourthExtent)
-		{
-			targetW /= 64;
-			targetH /= 64;
-		}
+		vk::Extent2D target = targetExtent(res.desc);
 
-		if (res.currentWidth == targetW && res.currentHeight == targetH) continue;
+		if (res.currentWidth == target.width && res.currentHeight == target.height) continue;
 
 		// Destroy old resources if they exist
 		destroyTransientImage(res);
 
 		// Allocate with new dimensions
-		res.currentWidth = targetW;
-		res.currentHeight = targetH;
+		res.currentWidth = target.width;
+		res.currentHeight = target.height;
 		allocateTransientImage(res);
 
 		// Create sampler on first allocation
@@ -148,7 +123,60 @@ void RenderGraph::handleResize(uint32_t newWidth, uint32_t newHeight)
 		}
 	}
 
-	needsDescriptorUpdate = true;
+	staleDescriptorFrames = kAllFramesStale;
+}
+
+void RenderGraph::setRenderScale(float scale)
+{
+	scale = std::clamp(scale, 0.25f, 1.0f);
+	if (scale == renderScale) return;
+	renderScale = scale;
+	if (dynamicResolution) return;
+	if (currentWidth != 0 && currentHeight != 0) handleResize(currentWidth, currentHeight);
+}
+
+void RenderGraph::setDynamicResolution(bool enabled)
+{
+	if (enabled == dynamicResolution) return;
+	dynamicResolution = enabled;
+	if (currentWidth != 0 && currentHeight != 0) handleResize(currentWidth, currentHeight);
+}
+
+vk::Extent2D RenderGraph::getRenderAllocationExtent() const
+{
+	return dynamicResolution ? vk::Extent2D{currentWidth, currentHeight} : getRenderExtent();
+}
+
+vk::Extent2D RenderGraph::scaleExtent(vk::Extent2D extent, float scale)
+{
+	return vk::Extent2D{std::max(1u, static_cast<uint32_t>(static_cast<float>(extent.width) * scale + 0.5f)),
+	                    std::max(1u, static_cast<uint32_t>(static_cast<float>(extent.height) * scale + 0.5f))};
+}
+
+vk::Extent2D RenderGraph::getRenderExtent() const
+{
+	return scaleExtent(vk::Extent2D{currentWidth, currentHeight}, renderScale);
+}
+
+vk::Extent2D RenderGraph::targetExtent(const RGImageDesc& desc) const
+{
+	return sizedExtent(desc, desc.renderScaled ? getRenderAllocationExtent() : vk::Extent2D{currentWidth, currentHeight});
+}
+
+vk::Extent2D RenderGraph::sizedExtent(const RGImageDesc& desc, vk::Extent2D base)
+{
+	uint32_t shift = 0;
+	switch (desc.sizeMode)
+	{
+	case RGSizeMode::HalfExtent: shift = 1; break;
+	case RGSizeMode::QuarterExtent: shift = 2; break;
+	case RGSizeMode::EighthExtent: shift = 3; break;
+	case RGSizeMode::SixteenthExtent: shift = 4; break;
+	case RGSizeMode::ThirtySecondExtent: shift = 5; break;
+	case RGSizeMode::SixtyFourthExtent: shift = 6; break;
+	default: break;
+	}
+	return vk::Extent2D{base.width >> shift, base.height >> shift};
 }
 
 void RenderGraph::declareLogicalStream(const std::string& name, const RGImageDesc& desc)
@@ -217,7 +245,7 @@ void RenderGraph::compile()
 	if (currentHash != lastPassHash)
 	{
 		lastPassHash = currentHash;
-		needsDescriptorUpdate = true;
+		staleDescriptorFrames = kAllFramesStale;
 	}
 
 	// Helper to get or create transient resource
@@ -242,38 +270,9 @@ void RenderGraph::compile()
 		entry.aspectFlags = desc.aspectFlags;
 		entry.isTransient = true;
 		entry.desc = desc;
-		entry.currentWidth = currentWidth;
-		entry.currentHeight = currentHeight;
-		if (desc.sizeMode == RGSizeMode::HalfExtent)
-		{
-			entry.currentWidth /= 2;
-			entry.currentHeight /= 2;
-		}
-		else if (desc.sizeMode == RGSizeMode::QuarterExtent)
-		{
-			entry.currentWidth /= 4;
-			entry.currentHeight /= 4;
-		}
-		else if (desc.sizeMode == RGSizeMode::EighthExtent)
-		{
-			entry.currentWidth /= 8;
-			entry.currentHeight /= 8;
-		}
-		else if (desc.sizeMode == RGSizeMode::SixteenthExtent)
-		{
-			entry.currentWidth /= 16;
-			entry.currentHeight /= 16;
-		}
-		else if (desc.sizeMode == RGSizeMode::ThirtySecondExtent)
-		{
-			entry.currentWidth /= 32;
-			entry.currentHeight /= 32;
-		}
-		else if (desc.sizeMode == RGSizeMode::SixtyFourthExtent)
-		{
-			entry.currentWidth /= 64;
-			entry.currentHeight /= 64;
-		}
+		vk::Extent2D target = targetExtent(desc);
+		entry.currentWidth = target.width;
+		entry.currentHeight = target.height;
 		resources.push_back(std::move(entry));
 		allocateTransientImage(resources.back());
 		createSampler(resources.back());
@@ -420,14 +419,20 @@ void RenderGraph::compile()
 		compiledPasses.push_back(std::move(compiled));
 	}
 
-	// Now that everything is mapped, update descriptors if necessary
-	if (needsDescriptorUpdate)
+	// Now that everything is mapped, refresh this frame slot's descriptor copies if they are stale. FrameBeginSystem
+	// has already waited on this slot's fence and the other slots refresh their own copies when they come around,
+	// so nothing in flight is touched and no waitIdle is needed.
+	uint32_t frame = gm->getContextComponent<CurrentFrameContext, CurrentFrameComponent>()->currentFrame;
+	if (staleDescriptorFrames & (1u << frame))
 	{
 #ifdef TRACY_ENABLE
-		ZoneScopedN("RG::waitIdle+updateDescriptors");
+		ZoneScopedN("RG::updateDescriptors");
 		TracyPlot("RG descriptor updates", 1.0);
 #endif
-		(*vulkanDevice.device).waitIdle();
+		DescriptorManager& descriptorManager =
+		    *gm->getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>()->descriptorManager;
+		updateFrame = frame;
+		descriptorManager.beginWriteBatch();
 		for (const auto& pass : passes)
 		{
 			if (pass.updateDescriptors)
@@ -435,13 +440,71 @@ void RenderGraph::compile()
 				pass.updateDescriptors(*this, pass);
 			}
 		}
-		needsDescriptorUpdate = false;
+		descriptorManager.flushWrites();
+		staleDescriptorFrames &= ~(1u << frame);
 	}
 }
 
+void RenderGraph::createTimestampPool()
+{
+	const auto queueFamilies = vulkanDevice.physicalDevice.getQueueFamilyProperties();
+	if (vulkanDevice.graphicsIndex >= queueFamilies.size() ||
+	    queueFamilies[vulkanDevice.graphicsIndex].timestampValidBits == 0)
+		return;
+
+	vk::QueryPoolCreateInfo poolInfo;
+	poolInfo.queryType = vk::QueryType::eTimestamp;
+	poolInfo.queryCount = kTimestampsPerFrame * MAX_FRAMES_IN_FLIGHT;
+	timestampPool = vk::raii::QueryPool(vulkanDevice.device, poolInfo);
+	timestampPeriodNs = vulkanDevice.physicalDevice.getProperties().limits.timestampPeriod;
+	timedPassNames.resize(MAX_FRAMES_IN_FLIGHT);
+	for (auto& names : timedPassNames) names.reserve(kTimestampsPerFrame - 2);
+	timestampWindows.assign(MAX_FRAMES_IN_FLIGHT, 0);
+}
+
+void RenderGraph::readFrameTimestamps(uint32_t frame)
+{
+	// FrameBeginSystem waited on this slot's fence, so its previous submission has finished
+	if (!(pendingTimestampFrames & (1u << frame))) return;
+	pendingTimestampFrames &= ~(1u << frame);
+
+	const std::vector<std::string>& names = timedPassNames[frame];
+	const uint32_t count = static_cast<uint32_t>(names.size()) + 2;
+	auto [result, ticks] = timestampPool.getResults<uint64_t>(frame * kTimestampsPerFrame, count,
+	                                                          count * sizeof(uint64_t), sizeof(uint64_t),
+	                                                          vk::QueryResultFlagBits::e64);
+	if (result != vk::Result::eSuccess) return;
+
+	auto elapsedMs = [this](uint64_t begin, uint64_t end)
+	{
+		if (end < begin) return 0.0f;
+		return static_cast<float>(static_cast<double>(end - begin) * timestampPeriodNs * 1e-6);
+	};
+	gpuFrameTimeMs = elapsedMs(ticks.front(), ticks.back());
+
+	auto* profilerComp = gm->getContextComponent<FrameProfilerContext, FrameProfilerComponent>();
+	if (!profilerComp || !profilerComp->profiler) return;
+	// Measured before the profiler was cleared, e.g. a warm-up frame landing in a benchmark's window
+	if (timestampWindows[frame] != profilerComp->profiler->getWindow()) return;
+	profilerComp->profiler->record(FrameProfiler::Domain::Gpu, "Frame", gpuFrameTimeMs);
+	for (size_t i = 0; i < names.size(); ++i)
+		profilerComp->profiler->record(FrameProfiler::Domain::Gpu, names[i], elapsedMs(ticks[i], ticks[i + 1]));
+}
+
 void RenderGraph::execute(vk::raii::CommandBuffer& cmd)
 {
 	cmd.begin({});
+
+	const uint32_t frame = gm->getContextComponent<CurrentFrameContext, CurrentFrameComponent>()->currentFrame;
+	const uint32_t firstQuery = frame * kTimestampsPerFrame;
+	if (*timestampPool)
+	{
+		readFrameTimestamps(frame);
+		timedPassNames[frame].clear();
+		cmd.resetQueryPool(*timestampPool, firstQuery, kTimestampsPerFrame);
+		cmd.writeTimestamp2(vk::PipelineStageFlagBits2::eTopOfPipe, *timestampPool, firstQuery);
+	}
+
 	for (const auto& compiled : compiledPasses)
 	{
 #ifdef TRACY_ENABLE
@@ -573,7 +636,7 @@ void RenderGraph::execute(vk::raii::CommandBuffer& cmd)
 
 				if (firstHandle != RG_INVALID_HANDLE)
 				{
-					extent = getMipExtent(firstHandle, firstMip);
+					extent = getActiveExtent(firstHandle, firstMip);
 				}
 				else
 				{
@@ -605,6 +668,14 @@ void RenderGraph::execute(vk::raii::CommandBuffer& cmd)
 		{
 			cmd.endRendering();
 		}
+
+		// Barriers are attributed to the pass they precede
+		if (*timestampPool && timedPassNames[frame].size() + 2 < kTimestampsPerFrame)
+		{
+			timedPassNames[frame].push_back(compiled.pass->name);
+			cmd.writeTimestamp2(vk::PipelineStageFlagBits2::eBottomOfPipe, *timestampPool,
+			                    firstQuery + static_cast<uint32_t>(timedPassNames[frame].size()));
+		}
 	}
 
 #ifdef TRACY_ENABLE
@@ -612,6 +683,15 @@ void RenderGraph::execute(vk::raii::CommandBuffer& cmd)
 	TracyVkCollect(tracyCtxComp->context, static_cast<VkCommandBuffer>(*cmd));
 #endif
 
+	if (*timestampPool)
+	{
+		cmd.writeTimestamp2(vk::PipelineStageFlagBits2::eBottomOfPipe, *timestampPool,
+		                    firstQuery + static_cast<uint32_t>(timedPassNames[frame].size()) + 1);
+		pendingTimestampFrames |= 1u << frame;
+		auto* profilerComp = gm->getContextComponent<FrameProfilerContext, FrameProfilerComponent>();
+		if (profilerComp && profilerComp->profiler) timestampWindows[frame] = profilerComp->profiler->getWindow();
+	}
+
 	cmd.end();
 }
 
@@ -664,6 +744,17 @@ vk::Extent2D RenderGraph::getMipExtent(RGResourceHandle handle, uint32_t mip) co
 	return vk::Extent2D{std::max(1u, baseW >> mip), std::max(1u, baseH >> mip)};
 }
 
+vk::Extent2D RenderGraph::getActiveExtent(RGResourceHandle handle, uint32_t mip) const
+{
+	vk::Extent2D extent = getMipExtent(handle, mip);
+	const auto& res = resources[handle];
+	if (!res.isTransient || !res.desc.renderScaled || !dynamicResolution) return extent;
+
+	vk::Extent2D active = sizedExtent(res.desc, getRenderExtent());
+	return vk::Extent2D{std::clamp(active.width >> mip, 1u, extent.width),
+	                    std::clamp(active.height >> mip, 1u, extent.height)};
+}
+
 RGResourceHandle RenderGraph::getHandle(const std::string& name) const
 {
 	for (uint32_t i = 0; i < resources.size(); ++i)
@@ -797,6 +888,8 @@ vk::ImageLayout RenderGraph::usageToLayout(RGResourceUsage usage)
 		return vk::ImageLayout::eGeneral;
 	case RGResourceUsage::Present:
 		return vk::ImageLayout::ePresentSrcKHR;
+	case RGResourceUsage::TransferSrc:
+		return vk::ImageLayout::eTransferSrcOptimal;
 	default:
 		return vk::ImageLayout::eUndefined;
 	}
@@ -818,6 +911,8 @@ vk::AccessFlags2 RenderGraph::usageToAccessMask(RGResourceUsage usage)
 		return vk::AccessFlagBits2::eShaderRead | vk::AccessFlagBits2::eShaderWrite;
 	case RGResourceUsage::Present:
 		return vk::AccessFlags2{};
+	case RGResourceUsage::TransferSrc:
+		return vk::AccessFlagBits2::eTransferRead;
 	default:
 		return vk::AccessFlags2{};
 	}
@@ -840,6 +935,8 @@ vk::PipelineStageFlags2 RenderGraph::usageToDstStageMask(RGResourceUsage usage,
 		return vk::PipelineStageFlagBits2::eComputeShader;
 	case RGResourceUsage::Present:
 		return vk::PipelineStageFlagBits2::eBottomOfPipe;
+	case RGResourceUsage::TransferSrc:
+		return vk::PipelineStageFlagBits2::eAllTransfer;
 	default:
 		return vk::PipelineStageFlagBits2::eTopOfPipe;
 	}
@@ -862,6 +959,8 @@ vk::PipelineStageFlags2 RenderGraph::usageToCompleteStageMask(RGResourceUsage us
 		return vk::PipelineStageFlagBits2::eComputeShader;
 	case RGResourceUsage::Present:
 		return vk::PipelineStageFlagBits2::eBottomOfPipe;
+	case RGResourceUsage::TransferSrc:
+		return vk::PipelineStageFlagBits2::eAllTransfer;
 	default:
 		return vk::PipelineStageFlagBits2::eTopOfPipe;
 	}
@@ -0,0 +1,226 @@
+#include "BcEncoder.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+// Packs fields LSB-first, the bit order used by every BCn format.
+struct BitWriter
+{
+	uint8_t* out;
+	uint32_t bit = 0;
+
+	void write(uint32_t value, uint32_t count)
+	{
+		for (uint32_t i = 0; i < count; i++, bit++)
+		{
+			if (value & (1u << i)) out[bit >> 3] |= static_cast<uint8_t>(1u << (bit & 7));
+		}
+	}
+};
+
+constexpr uint32_t bc7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+int bc7Interpolate(int e0, int e1, uint32_t weight)
+{
+	return ((64 - static_cast<int>(weight)) * e0 + static_cast<int>(weight) * e1 + 32) >> 6;
+}
+
+// Quantizes an RGBA endpoint to 7 bits per channel plus a shared p-bit, picking the p-bit with less error.
+void quantizeBc7Endpoint(const float endpoint[4], uint8_t q[4], uint32_t& pBit)
+{
+	float bestError = 1e30f;
+	for (uint32_t p = 0; p < 2; p++)
+	{
+		uint8_t candidate[4];
+		float error = 0.0f;
+		for (int c = 0; c < 4; c++)
+		{
+			int value = static_cast<int>(std::lround((endpoint[c] - static_cast<float>(p)) * 0.5f));
+			value = std::clamp(value, 0, 127);
+			candidate[c] = static_cast<uint8_t>(value);
+			float diff = static_cast<float>(value * 2 + static_cast<int>(p)) - endpoint[c];
+			error += diff * diff;
+		}
+		if (error < bestError)
+		{
+			bestError = error;
+			pBit = p;
+			std::memcpy(q, candidate, 4);
+		}
+	}
+}
+} // namespace
+
+void BcEncoder::encodeBc4(const uint8_t texels[16][4], uint32_t channel, uint8_t out[8])
+{
+	std::memset(out, 0, 8);
+
+	uint8_t lo = 255;
+	uint8_t hi = 0;
+	for (int i = 0; i < 16; i++)
+	{
+		lo = std::min(lo, texels[i][channel]);
+		hi = std::max(hi, texels[i][channel]);
+	}
+
+	out[0] = hi;
+	out[1] = lo;
+	if (hi == lo) return; // Every index 0 already decodes to the single value
+
+	// hi > lo selects the 8-value interpolation mode
+	int palette[8];
+	palette[0] = hi;
+	palette[1] = lo;
+	for (int i = 2; i < 8; i++) palette[i] = ((8 - i) * hi + (i - 1) * lo + 3) / 7;
+
+	BitWriter writer{out + 2};
+	for (int i = 0; i < 16; i++)
+	{
+		int value = texels[i][channel];
+		uint32_t bestIndex = 0;
+		int bestError = 256;
+		for (uint32_t p = 0; p < 8; p++)
+		{
+			int error = std::abs(palette[p] - value);
+			if (error < bestError)
+			{
+				bestError = error;
+				bestIndex = p;
+			}
+		}
+		writer.write(bestIndex, 3);
+	}
+}
+
+void BcEncoder::encodeBc5(const uint8_t texels[16][4], uint8_t out[16])
+{
+	encodeBc4(texels, 0, out);
+	encodeBc4(texels, 1, out + 8);
+}
+
+void BcEncoder::encodeBc7(const uint8_t texels[16][4], uint8_t out[16])
+{
+	std::memset(out, 0, 16);
+
+	float mean[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+	for (int i = 0; i < 16; i++)
+	{
+		for (int c = 0; c < 4; c++) mean[c] += texels[i][c];
+	}
+	for (int c = 0; c < 4; c++) mean[c] /= 16.0f;
+
+	float cov[4][4] = {};
+	for (int i = 0; i < 16; i++)
+	{
+		float d[4];
+		for (int c = 0; c < 4; c++) d[c] = texels[i][c] - mean[c];
+		for (int a = 0; a < 4; a++)
+		{
+			for (int b = 0; b < 4; b++) cov[a][b] += d[a] * d[b];
+		}
+	}
+
+	// Principal axis by power iteration, seeded with the block's per-channel range
+	float axis[4];
+	for (int c = 0; c < 4; c++)
+	{
+		uint8_t lo = 255, hi = 0;
+		for (int i = 0; i < 16; i++)
+		{
+			lo = std::min(lo, texels[i][c]);
+			hi = std::max(hi, texels[i][c]);
+		}
+		axis[c] = static_cast<float>(hi - lo);
+	}
+	for (int iter = 0; iter < 8; iter++)
+	{
+		float next[4] = {};
+		for (int a = 0; a < 4; a++)
+		{
+			for (int b = 0; b < 4; b++) next[a] += cov[a][b] * axis[b];
+		}
+		float len = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2] + next[3] * next[3]);
+		if (len < 1e-6f) break;
+		for (int c = 0; c < 4; c++) axis[c] = next[c] / len;
+	}
+	float axisLen = std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2] + axis[3] * axis[3]);
+	if (axisLen > 1e-6f)
+	{
+		for (int c = 0; c < 4; c++) axis[c] /= axisLen;
+	}
+
+	float tMin = 0.0f, tMax = 0.0f;
+	for (int i = 0; i < 16; i++)
+	{
+		float t = 0.0f;
+		for (int c = 0; c < 4; c++) t += (texels[i][c] - mean[c]) * axis[c];
+		tMin = std::min(tMin, t);
+		tMax = std::max(tMax, t);
+	}
+
+	float endpoints[2][4];
+	for (int c = 0; c < 4; c++)
+	{
+		endpoints[0][c] = std::clamp(mean[c] + axis[c] * tMin, 0.0f, 255.0f);
+		endpoints[1][c] = std::clamp(mean[c] + axis[c] * tMax, 0.0f, 255.0f);
+	}
+
+	uint8_t q[2][4];
+	uint32_t pBits[2] = {0, 0};
+	quantizeBc7Endpoint(endpoints[0], q[0], pBits[0]);
+	quantizeBc7Endpoint(endpoints[1], q[1], pBits[1]);
+
+	int e[2][4];
+	for (int n = 0; n < 2; n++)
+	{
+		for (int c = 0; c < 4; c++) e[n][c] = q[n][c] * 2 + static_cast<int>(pBits[n]);
+	}
+
+	int palette[16][4];
+	for (uint32_t w = 0; w < 16; w++)
+	{
+		for (int c = 0; c < 4; c++) palette[w][c] = bc7Interpolate(e[0][c], e[1][c], bc7Weights4[w]);
+	}
+
+	uint32_t indices[16];
+	for (int i = 0; i < 16; i++)
+	{
+		int bestError = 0x7fffffff;
+		for (uint32_t p = 0; p < 16; p++)
+		{
+			int error = 0;
+			for (int c = 0; c < 4; c++)
+			{
+				int d = palette[p][c] - texels[i][c];
+				error += d * d;
+			}
+			if (error < bestError)
+			{
+				bestError = error;
+				indices[i] = p;
+			}
+		}
+	}
+
+	// The anchor index drops its MSB, so it must be < 8; swapping endpoints mirrors the indices
+	if (indices[0] & 8)
+	{
+		std::swap(q[0], q[1]);
+		std::swap(pBits[0], pBits[1]);
+		for (uint32_t& index : indices) index = 15 - index;
+	}
+
+	BitWriter writer{out};
+	writer.write(1u << 6, 7); // Mode 6
+	for (int c = 0; c < 4; c++)
+	{
+		writer.write(q[0][c], 7);
+		writer.write(q[1][c], 7);
+	}
+	writer.write(pBits[0], 1);
+	writer.write(pBits[1], 1);
+	writer.write(indices[0], 3);
+	for (int i = 1; i < 16; i++) writer.write(indices[i], 4);
+}
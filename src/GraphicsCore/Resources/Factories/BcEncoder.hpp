@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+// Single-block BCn encoders. Input is a 4x4 block of RGBA8 texels in row-major order.
+class BcEncoder
+{
+public:
+	static constexpr uint32_t BLOCK_BYTES_BC4 = 8;
+	static constexpr uint32_t BLOCK_BYTES_BC5 = 16;
+	static constexpr uint32_t BLOCK_BYTES_BC7 = 16;
+
+	// Encodes the given channel (0..3) of the block.
+	static void encodeBc4(const uint8_t texels[16][4], uint32_t channel, uint8_t out[8]);
+	// Encodes R and G as two BC4 blocks.
+	static void encodeBc5(const uint8_t texels[16][4], uint8_t out[16]);
+	// Mode 6 only: one RGBA subset with 4-bit indices, good enough for albedo/emissive/masks.
+	static void encodeBc7(const uint8_t texels[16][4], uint8_t out[16]);
+};
@@ -1,8 +1,14 @@
 #include "GltfLoader.hpp"
 #include "ImageConverter.hpp"
+#include "TextureCompressor.hpp"
+#include "KtxTranscoder.hpp"
 #include "GraphicsCore/Resources/Factories/TextureFactory.hpp"
+#include "GraphicsCore/Resources/Factories/TextureUploadBatch.hpp"
+#include "GraphicsCore/Resources/Managers/TextureStreamer.hpp"
+#include <ktx.h>
 #include <filesystem>
 #include <algorithm>
+#include <cstring>
 #include <stdexcept>
 #include <utility>
 
@@ -11,10 +17,21 @@ ModelHandle GltfLoader::loadModelFromFile(const char path[MAX_PATH_LEN], int ver
                                           DescriptorManager& descriptorManager, tinygltf::Model& model,
                                           TextureManager& textureManager, ModelManager& modelManager,
                                           MaterialManager& materialManager, VulkanDevice& vulkanDevice,
-                                          VmaAllocator allocator)
+                                          VmaAllocator allocator, TextureStreamer* textureStreamer,
+                                          TextureUploadBatch* uploadBatch)
 {
-	MaterialMaps materialMaps = materialsParser(model, textureManager, materialManager, dSetComponent, descriptorManager,
-	                                            bufferManager, path, vulkanDevice, allocator);
+	MaterialMaps materialMaps;
+	try
+	{
+		materialMaps = materialsParser(model, textureManager, materialManager, dSetComponent, descriptorManager,
+		                               bufferManager, path, vulkanDevice, allocator, textureStreamer, uploadBatch);
+	}
+	catch (...)
+	{
+		// The batch outlives this load; uploads it queued for this model must not reach a later submit
+		if (uploadBatch) uploadBatch->discard();
+		throw;
+	}
 
 	std::vector<Vertex> localVertices;
 	std::vector<uint32_t> localIndices;
@@ -79,44 +96,70 @@ ModelHandle GltfLoader::loadModelFromFile(const char path[MAX_PATH_LEN], int ver
 	return modelHandle;
 }
 
-TextureHandle
-GltfLoader::loadMaterialTexture(tinygltf::Model& model, const std::map<std::string, tinygltf::Parameter>& params,
-                                const char* paramName, bool isSrgb, TextureHandle fallback, const char* filePath,
-                                std::vector<TextureHandle>& ownedTextures, TextureManager& textureManager,
-                                BindlessTextureDSetComponent& dSetComponent, DescriptorManager& descriptorManager,
-                                VulkanDevice& vulkanDevice, VmaAllocator allocator)
+int GltfLoader::resolveImageIndex(const tinygltf::Model& model,
+                                  const std::map<std::string, tinygltf::Parameter>& params, const char* paramName)
 {
 	auto paramIt = params.find(paramName);
-	if (paramIt == params.end()) return fallback;
+	if (paramIt == params.end()) return -1;
 
 	int textureIndex = paramIt->second.TextureIndex();
-	if (textureIndex < 0 || textureIndex >= static_cast<int>(model.textures.size())) return fallback;
+	if (textureIndex < 0 || textureIndex >= static_cast<int>(model.textures.size())) return -1;
 
 	const tinygltf::Texture& tex = model.textures[textureIndex];
 	int sourceImageIndex = tex.source;
 	auto basisuIt = tex.extensions.find("KHR_texture_basisu");
 	if (basisuIt != tex.extensions.end() && basisuIt->second.Has("source"))
 		sourceImageIndex = basisuIt->second.Get("source").GetNumberAsInt();
-	if (sourceImageIndex < 0 || sourceImageIndex >= static_cast<int>(model.images.size())) return fallback;
+	if (sourceImageIndex < 0 || sourceImageIndex >= static_cast<int>(model.images.size())) return -1;
+	return sourceImageIndex;
+}
 
-	tinygltf::Image& img = model.images[sourceImageIndex];
+ImageSource GltfLoader::resolveImageSource(const tinygltf::Model& model, int imageIndex, const char* filePath,
+                                           bool isSrgb)
+{
+	const tinygltf::Image& img = model.images[imageIndex];
+	ImageSource source;
 	// External files key by their resolved on-disk path so models can share them;
 	// embedded images have no identity outside their model file.
-	std::string texName;
 	if (!img.uri.empty() && img.uri.find("data:") != 0)
 	{
 		std::string decodedUri = img.uri;
 		tinygltf::URIDecode(img.uri, &decodedUri, nullptr);
-		texName = std::filesystem::absolute(std::filesystem::path(filePath).parent_path() / decodedUri)
-		              .lexically_normal()
-		              .generic_string();
+		source.path =
+		    std::filesystem::absolute(std::filesystem::path(filePath).parent_path() / decodedUri).lexically_normal();
+		source.name = source.path.generic_string();
 	}
 	else
 	{
-		texName = std::string(filePath) + "#img" + std::to_string(sourceImageIndex);
+		source.name = std::string(filePath) + "#img" + std::to_string(imageIndex);
+		source.path = std::filesystem::path(filePath);
+		source.cacheSuffix = ".img" + std::to_string(imageIndex);
 	}
 	// The same bytes under sRGB vs UNORM are two different images.
-	texName += isSrgb ? "|srgb" : "|linear";
+	source.name += isSrgb ? "|srgb" : "|linear";
+	return source;
+}
+
+TextureRole GltfLoader::textureRole(const char* paramName, bool isSrgb)
+{
+	if (isSrgb) return TextureRole::Color;
+	return std::strcmp(paramName, "normalTexture") == 0 ? TextureRole::Normal : TextureRole::Data;
+}
+
+TextureHandle
+GltfLoader::loadMaterialTexture(tinygltf::Model& model, const std::map<std::string, tinygltf::Parameter>& params,
+                                const char* paramName, bool isSrgb, TextureHandle fallback, const char* filePath,
+                                std::vector<TextureHandle>& ownedTextures, TextureManager& textureManager,
+                                BindlessTextureDSetComponent& dSetComponent, DescriptorManager& descriptorManager,
+                                VulkanDevice& vulkanDevice, VmaAllocator allocator, TextureStreamer* textureStreamer,
+                                BasisTranscodes& transcodes, TextureUploadBatch* uploadBatch)
+{
+	int sourceImageIndex = resolveImageIndex(model, params, paramName);
+	if (sourceImageIndex < 0) return fallback;
+
+	tinygltf::Image& img = model.images[sourceImageIndex];
+	ImageSource source = resolveImageSource(model, sourceImageIndex, filePath, isSrgb);
+	const std::string& texName = source.name;
 
 	TextureHandle cached = textureManager.getTextureHandle(texName.c_str());
 	if (cached.id != -1)
@@ -127,20 +170,78 @@ GltfLoader::loadMaterialTexture(tinygltf::Model& model, const std::map<std::stri
 	}
 	if (img.as_is && img.mimeType == "image/ktx2" && !img.image.empty())
 	{
-		TextureHandle handle = TextureFactory::createBindlessTextureFromKtx(
-		    textureManager, vulkanDevice, allocator, texName.c_str(), img.image.data(), img.image.size(), dSetComponent,
-		    descriptorManager, isSrgb);
+		auto jobIt = transcodes.jobByTexture.find(texName);
+		ktxTexture2* transcoded = jobIt != transcodes.jobByTexture.end() ? transcodes.transcoder->take(jobIt->second)
+		                                                                 : nullptr;
+		// Only separate .ktx2 files can be re-read by offset; embedded ones keep their bytes in the streamer
+		std::filesystem::path streamFile = source.cacheSuffix.empty() ? source.path : std::filesystem::path();
+		TextureHandle handle;
+		try
+		{
+			if (textureStreamer)
+			{
+				handle = textureStreamer->createStreamedTexture(textureManager, descriptorManager, dSetComponent,
+				                                                texName.c_str(), img.image.data(), img.image.size(),
+				                                                isSrgb, streamFile, transcoded);
+			}
+			else if (transcoded)
+			{
+				handle = TextureFactory::createBindlessTextureFromKtx(textureManager, vulkanDevice, allocator,
+				                                                      texName.c_str(), transcoded, dSetComponent,
+				                                                      descriptorManager);
+			}
+			else
+			{
+				handle = TextureFactory::createBindlessTextureFromKtx(textureManager, vulkanDevice, allocator,
+				                                                      texName.c_str(), img.image.data(),
+				                                                      img.image.size(), dSetComponent,
+				                                                      descriptorManager, isSrgb);
+			}
+		}
+		catch (...)
+		{
+			if (transcoded) ktxTexture_Destroy(ktxTexture(transcoded));
+			throw;
+		}
+		if (transcoded) ktxTexture_Destroy(ktxTexture(transcoded));
 		ownedTextures.push_back(handle);
 		return handle;
 	}
 	if (!img.image.empty() && img.width > 0 && img.height > 0)
 	{
 		auto rgbaPixels = ImageConverter::convertToRGBA(img);
+		if (!rgbaPixels.empty() && vulkanDevice.textureCompressionBC)
+		{
+			TextureRole role = textureRole(paramName, isSrgb);
+			BcFormat format = TextureCompressor::chooseFormat(rgbaPixels.data(), img.width, img.height, role);
+			std::filesystem::path cachePath =
+			    TextureCompressor::cachePath(source.path, source.cacheSuffix, format, role);
+
+			std::vector<unsigned char> ktxData;
+			bool cached = TextureCompressor::loadCache(cachePath, source.path, ktxData);
+			if (!cached)
+			{
+				ktxData = TextureCompressor::compressToKtx2(rgbaPixels.data(), img.width, img.height, format, role);
+				cached = TextureCompressor::writeCache(cachePath, ktxData);
+			}
+
+			TextureHandle handle =
+			    textureStreamer
+			        ? textureStreamer->createStreamedTexture(textureManager, descriptorManager, dSetComponent,
+			                                                 texName.c_str(), ktxData.data(), ktxData.size(), isSrgb,
+			                                                 cached ? cachePath : std::filesystem::path())
+			        : TextureFactory::createBindlessTextureFromKtx(textureManager, vulkanDevice, allocator,
+			                                                       texName.c_str(), ktxData.data(), ktxData.size(),
+			                                                       dSetComponent, descriptorManager, isSrgb);
+			ownedTextures.push_back(handle);
+			return handle;
+		}
 		if (!rgbaPixels.empty())
 		{
 			TextureHandle handle = TextureFactory::createBindlessTexture(
 			    textureManager, vulkanDevice, allocator, texName.c_str(), img.width, img.height, rgbaPixels.data(),
-			    dSetComponent, descriptorManager, isSrgb ? vk::Format::eR8G8B8A8Srgb : vk::Format::eR8G8B8A8Unorm);
+			    dSetComponent, descriptorManager, isSrgb ? vk::Format::eR8G8B8A8Srgb : vk::Format::eR8G8B8A8Unorm,
+			    uploadBatch, textureRole(paramName, isSrgb) == TextureRole::Normal);
 			ownedTextures.push_back(handle);
 			return handle;
 		}
@@ -151,9 +252,12 @@ GltfLoader::loadMaterialTexture(tinygltf::Model& model, const std::map<std::stri
 MaterialMaps GltfLoader::materialsParser(tinygltf::Model& model, TextureManager& textureManager,
                                          MaterialManager& materialManager, BindlessTextureDSetComponent& dSetComponent,
                                          DescriptorManager& descriptorManager, BufferManager& bufferManager,
-                                         const char* filePath, VulkanDevice& vulkanDevice, VmaAllocator allocator)
+                                         const char* filePath, VulkanDevice& vulkanDevice, VmaAllocator allocator,
+                                         TextureStreamer* textureStreamer, TextureUploadBatch* uploadBatch)
 {
 	MaterialMaps maps;
+	// Uncompressed textures of this model share one upload submit and compute mip generation
+
 	glm::vec4 colorFactor = {1.0f, 1.0f, 1.0f, 1.0f}; // Default white
 	TextureHandle cachedWhite = textureManager.getTextureHandle("sys_default_white");
 	TextureHandle whiteTexture =
@@ -161,7 +265,7 @@ MaterialMaps GltfLoader::materialsParser(tinygltf::Model& model, TextureManager&
 	        ? cachedWhite
 	        : TextureFactory::createBindlessTexture(textureManager, vulkanDevice, allocator, "sys_default_white", 1, 1,
 	                                                std::vector<unsigned char>{255, 255, 255, 255}.data(), dSetComponent,
-	                                                descriptorManager);
+	                                                descriptorManager, vk::Format::eR8G8B8A8Srgb, uploadBatch);
 	// Default flat normal map: (128,128,255,255) = tangent-space up (0,0,1), loaded as linear
 	TextureHandle cachedNormal = textureManager.getTextureHandle("sys_default_normal");
 	TextureHandle defaultNormalTexture =
@@ -169,21 +273,22 @@ MaterialMaps GltfLoader::materialsParser(tinygltf::Model& model, TextureManager&
 	        ? cachedNormal
 	        : TextureFactory::createBindlessTexture(textureManager, vulkanDevice, allocator, "sys_default_normal", 1, 1,
 	                                                std::vector<unsigned char>{128, 128, 255, 255}.data(), dSetComponent,
-	                                                descriptorManager, vk::Format::eR8G8B8A8Unorm);
+	                                                descriptorManager, vk::Format::eR8G8B8A8Unorm, uploadBatch);
 	TextureHandle cachedMR = textureManager.getTextureHandle("sys_default_mr");
 	TextureHandle defaultMRTexture =
 	    cachedMR.id != -1
 	        ? cachedMR
 	        : TextureFactory::createBindlessTexture(textureManager, vulkanDevice, allocator, "sys_default_mr", 1, 1,
 	                                                std::vector<unsigned char>{255, 255, 255, 255}.data(), dSetComponent,
-	                                                descriptorManager, vk::Format::eR8G8B8A8Unorm);
+	                                                descriptorManager, vk::Format::eR8G8B8A8Unorm, uploadBatch);
 	TextureHandle cachedEmissive = textureManager.getTextureHandle("sys_default_emissive");
 	TextureHandle defaultEmissiveTexture =
 	    cachedEmissive.id != -1
 	        ? cachedEmissive
 	        : TextureFactory::createBindlessTexture(textureManager, vulkanDevice, allocator, "sys_default_emissive", 1,
 	                                                1, std::vector<unsigned char>{255, 255, 255, 255}.data(),
-	                                                dSetComponent, descriptorManager);
+	                                                dSetComponent, descriptorManager, vk::Format::eR8G8B8A8Srgb,
+	                                                uploadBatch);
 
 	MaterialData defaultMaterial{};
 	defaultMaterial.textureIndex = whiteTexture.id;
@@ -194,6 +299,36 @@ MaterialMaps GltfLoader::materialsParser(tinygltf::Model& model, TextureManager&
 	maps.materials.emplace(static_cast<uint32_t>(-1),
 	                       materialManager.emplaceMaterial(dSetComponent, defaultMaterial, bufferManager));
 
+	// Basis textures are transcoded up front across worker threads; the loop below uploads each one as soon as
+	// its own job is done while the rest keep transcoding.
+	BasisTranscodes transcodes;
+	std::vector<KtxTranscoder::Job> transcodeJobs;
+	auto queueTranscode = [&](const std::map<std::string, tinygltf::Parameter>& params, const char* paramName,
+	                          bool isSrgb)
+	{
+		int imageIndex = resolveImageIndex(model, params, paramName);
+		if (imageIndex < 0) return;
+		const tinygltf::Image& img = model.images[imageIndex];
+		if (!img.as_is || img.mimeType != "image/ktx2" ||
+		    !KtxTranscoder::needsTranscoding(img.image.data(), img.image.size()))
+			return;
+
+		std::string texName = resolveImageSource(model, imageIndex, filePath, isSrgb).name;
+		if (transcodes.jobByTexture.contains(texName) || textureManager.getTextureHandle(texName.c_str()).id != -1)
+			return;
+		transcodes.jobByTexture.emplace(texName, transcodeJobs.size());
+		transcodeJobs.push_back({img.image.data(), img.image.size(), isSrgb, textureRole(paramName, isSrgb)});
+	};
+	for (const tinygltf::Material& gltfMaterial : model.materials)
+	{
+		queueTranscode(gltfMaterial.values, "baseColorTexture", true);
+		queueTranscode(gltfMaterial.additionalValues, "normalTexture", false);
+		queueTranscode(gltfMaterial.values, "metallicRoughnessTexture", false);
+		queueTranscode(gltfMaterial.additionalValues, "emissiveTexture", true);
+	}
+	transcodes.transcoder =
+	    std::make_unique<KtxTranscoder>(std::move(transcodeJobs), vulkanDevice.textureCompressionBC);
+
 	for (size_t i = 0; i < model.materials.size(); i++)
 	{
 		MaterialData material{};
@@ -209,7 +344,8 @@ MaterialMaps GltfLoader::materialsParser(tinygltf::Model& model, TextureManager&
 
 		material.textureIndex = loadMaterialTexture(model, model.materials[i].values, "baseColorTexture", /*isSrgb*/ true,
 		                                            whiteTexture, filePath, maps.ownedTextures, textureManager,
-		                                            dSetComponent, descriptorManager, vulkanDevice, allocator)
+		                                            dSetComponent, descriptorManager, vulkanDevice, allocator,
+		                                            textureStreamer, transcodes, uploadBatch)
 		                            .id;
 		if (material.textureIndex != ~0u)
 		{
@@ -218,7 +354,7 @@ MaterialMaps GltfLoader::materialsParser(tinygltf::Model& model, TextureManager&
 		material.normalMapIndex =
 		    loadMaterialTexture(model, model.materials[i].additionalValues, "normalTexture", /*isSrgb*/ false,
 		                        defaultNormalTexture, filePath, maps.ownedTextures, textureManager, dSetComponent,
-		                        descriptorManager, vulkanDevice, allocator)
+		                        descriptorManager, vulkanDevice, allocator, textureStreamer, transcodes, uploadBatch)
 		        .id;
 		if (material.normalMapIndex != ~0u)
 		{
@@ -228,7 +364,7 @@ MaterialMaps GltfLoader::materialsParser(tinygltf::Model& model, TextureManager&
 		material.metallicRoughnessIndex =
 		    loadMaterialTexture(model, model.materials[i].values, "metallicRoughnessTexture", /*isSrgb*/ false,
 		                        defaultMRTexture, filePath, maps.ownedTextures, textureManager, dSetComponent,
-		                        descriptorManager, vulkanDevice, allocator)
+		                        descriptorManager, vulkanDevice, allocator, textureStreamer, transcodes, uploadBatch)
 		        .id;
 		if (material.metallicRoughnessIndex != ~0u)
 		{
@@ -250,7 +386,7 @@ MaterialMaps GltfLoader::materialsParser(tinygltf::Model& model, TextureManager&
 		material.emissiveIndex =
 		    loadMaterialTexture(model, model.materials[i].additionalValues, "emissiveTexture", /*isSrgb*/ true,
 		                        defaultEmissiveTexture, filePath, maps.ownedTextures, textureManager, dSetComponent,
-		                        descriptorManager, vulkanDevice, allocator)
+		                        descriptorManager, vulkanDevice, allocator, textureStreamer, transcodes, uploadBatch)
 		        .id;
 		if (material.emissiveIndex != ~0u)
 		{
@@ -305,6 +441,8 @@ MaterialMaps GltfLoader::materialsParser(tinygltf::Model& model, TextureManager&
 		                       materialManager.emplaceMaterial(dSetComponent, material, bufferManager));
 	}
 
+	// Not waited for: the frames that draw these textures are submitted after it on the same queue
+	if (uploadBatch) uploadBatch->submit();
 	return maps;
 }
 
@@ -12,6 +12,12 @@
 #include "GraphicsCore/Resources/Managers/TextureManager.hpp"
 #include "GraphicsCore/Resources/Managers/MaterialManager.hpp"
 #include "GraphicsCore/Resources/Managers/ModelManager.hpp"
+#include "TextureCompressor.hpp"
+#include "KtxTranscoder.hpp"
+#include <filesystem>
+
+class TextureStreamer;
+class TextureUploadBatch;
 
 struct TextureData
 {
@@ -27,6 +33,21 @@ struct LoadedPrimitive
 	std::shared_ptr<TextureData> texture;
 };
 
+// Where a glTF image lives: texture-manager key, on-disk file and the cache suffix for embedded images.
+struct ImageSource
+{
+	std::string name;
+	std::filesystem::path path;
+	std::string cacheSuffix;
+};
+
+// Basis textures of one model being transcoded in the background, keyed by texture name.
+struct BasisTranscodes
+{
+	std::unique_ptr<KtxTranscoder> transcoder;
+	std::unordered_map<std::string, size_t> jobByTexture;
+};
+
 struct MaterialMaps
 {
 	std::unordered_map<uint32_t, MaterialHandle> materials;
@@ -40,11 +61,14 @@ public:
 	static ModelHandle loadModelFromFile(const char path[MAX_PATH_LEN], int vertexIndexBInt, BufferManager& bufferManager,
 	                             BindlessTextureDSetComponent& dSetComponent, DescriptorManager& descriptorManager,
 	                             tinygltf::Model& model, TextureManager& textureManager, ModelManager& modelManager,
-	                             MaterialManager& materialManager, VulkanDevice& vulkanDevice, VmaAllocator allocator);
+	                             MaterialManager& materialManager, VulkanDevice& vulkanDevice, VmaAllocator allocator,
+	                             TextureStreamer* textureStreamer = nullptr, TextureUploadBatch* uploadBatch = nullptr);
 	static MaterialMaps materialsParser(tinygltf::Model& model, TextureManager& textureManager,
 	                                    MaterialManager& materialManager, BindlessTextureDSetComponent& dSetComponent,
 	                                    DescriptorManager& descriptorManager, BufferManager& bufferManager,
-	                                    const char* filePath, VulkanDevice& vulkanDevice, VmaAllocator allocator);
+	                                    const char* filePath, VulkanDevice& vulkanDevice, VmaAllocator allocator,
+	                                    TextureStreamer* textureStreamer = nullptr,
+	                                    TextureUploadBatch* uploadBatch = nullptr);
 	static std::vector<PrimitivesInfo> primitiveParser(tinygltf::Mesh& mesh, std::vector<Vertex>& outVertices,
 	                                                   std::vector<uint32_t>& outIndices, tinygltf::Model& model,
 	                                                   int32_t globalVertexOffset, const MaterialMaps& materialMaps);
@@ -52,10 +76,17 @@ public:
 	static std::shared_ptr<TextureData> createDefaultWhiteTexture();
 
 private:
+	static int resolveImageIndex(const tinygltf::Model& model,
+	                             const std::map<std::string, tinygltf::Parameter>& params, const char* paramName);
+	static ImageSource resolveImageSource(const tinygltf::Model& model, int imageIndex, const char* filePath,
+	                                      bool isSrgb);
+	static TextureRole textureRole(const char* paramName, bool isSrgb);
 	static TextureHandle loadMaterialTexture(tinygltf::Model& model,
 	                               const std::map<std::string, tinygltf::Parameter>& params,
 	                               const char* paramName, bool isSrgb, TextureHandle fallback, const char* filePath,
 	                               std::vector<TextureHandle>& ownedTextures, TextureManager& textureManager,
 	                               BindlessTextureDSetComponent& dSetComponent, DescriptorManager& descriptorManager,
-	                               VulkanDevice& vulkanDevice, VmaAllocator allocator);
+	                               VulkanDevice& vulkanDevice, VmaAllocator allocator,
+	                               TextureStreamer* textureStreamer, BasisTranscodes& transcodes,
+	                               TextureUploadBatch* uploadBatch);
 };
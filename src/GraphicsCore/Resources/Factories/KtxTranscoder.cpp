@@ -0,0 +1,156 @@
+#include "KtxTranscoder.hpp"
+#include <vulkan/vulkan.hpp>
+#include <ktx.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#ifdef TRACY_ENABLE
+#include <tracy/Tracy.hpp>
+#endif
+
+namespace
+{
+constexpr unsigned char KTX2_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+constexpr size_t KTX2_VK_FORMAT_OFFSET = 12;
+
+// True when the texture's first two channels, after its KTXswizzle if it has one, are its red and green
+bool storesRg(ktxTexture2* ktxTex)
+{
+	unsigned int length = 0;
+	void* value = nullptr;
+	if (ktxHashList_FindValue(&ktxTex->kvDataHead, KTX_SWIZZLE_KEY, &length, &value) != KTX_SUCCESS) return true;
+	const char* swizzle = static_cast<const char*>(value);
+	return length >= 2 && swizzle[0] == 'r' && swizzle[1] == 'g';
+}
+
+ktx_transcode_fmt_e chooseTarget(ktxTexture2* ktxTex, TextureRole role, bool isSrgb, bool bcSupported)
+{
+	if (!bcSupported) return KTX_TTF_RGBA32;
+	// BC4/BC5 have no sRGB variants, so color data always goes to BC7
+	if (isSrgb) return KTX_TTF_BC7_RGBA;
+
+	// BC5 keeps only two channels. That is enough for normals, whose Z the shaders rebuild, but only when the
+	// source really is two-channel XY; RGB or swizzled layouts go to BC7, which keeps every channel.
+	uint32_t components = ktxTexture2_GetNumComponents(ktxTex);
+	if (components == 2 && storesRg(ktxTex)) return KTX_TTF_BC5_RG;
+	if (components == 1 && role != TextureRole::Normal) return KTX_TTF_BC4_R;
+	return KTX_TTF_BC7_RGBA;
+}
+
+vk::Format toSrgb(vk::Format format)
+{
+	switch (format)
+	{
+	case vk::Format::eBc7UnormBlock:
+		return vk::Format::eBc7SrgbBlock;
+	case vk::Format::eR8G8B8A8Unorm:
+		return vk::Format::eR8G8B8A8Srgb;
+	default:
+		return format;
+	}
+}
+} // namespace
+
+KtxTranscoder::KtxTranscoder(std::vector<Job> jobs, bool bcSupported)
+    : _jobs(std::move(jobs)), _slots(_jobs.size()), _bcSupported(bcSupported)
+{
+	if (_jobs.empty()) return;
+
+	// The first job runs inline: libktx initializes its transcoder tables lazily on first use, unsynchronized
+	runJob(_nextJob++);
+
+	// The calling thread is busy uploading finished textures, so leave it a core
+	unsigned int hardwareThreads = std::thread::hardware_concurrency();
+	size_t workerCount = std::min<size_t>(hardwareThreads > 1 ? hardwareThreads - 1 : 1, _jobs.size() - 1);
+	for (size_t i = 0; i < workerCount; i++) _workers.emplace_back([this] { workerLoop(); });
+}
+
+KtxTranscoder::~KtxTranscoder()
+{
+	// Nothing left to hand out; running jobs finish, queued ones are skipped
+	_nextJob = _jobs.size();
+	_workers.clear();
+
+	for (Slot& slot : _slots)
+	{
+		if (slot.texture && !slot.taken) ktxTexture_Destroy(ktxTexture(slot.texture));
+	}
+}
+
+void KtxTranscoder::workerLoop()
+{
+#ifdef TRACY_ENABLE
+	tracy::SetThreadName("KtxTranscoder");
+#endif
+	for (size_t index = _nextJob++; index < _jobs.size(); index = _nextJob++) runJob(index);
+}
+
+void KtxTranscoder::runJob(size_t index)
+{
+#ifdef TRACY_ENABLE
+	ZoneScopedN("KtxTranscoder::runJob");
+#endif
+	ktxTexture2* texture = nullptr;
+	std::exception_ptr error;
+	try
+	{
+		texture = transcode(_jobs[index], _bcSupported);
+	}
+	catch (...)
+	{
+		error = std::current_exception();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_slots[index].texture = texture;
+		_slots[index].error = error;
+		_slots[index].done = true;
+	}
+	_doneCv.notify_all();
+}
+
+ktxTexture2* KtxTranscoder::take(size_t index)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_doneCv.wait(lock, [&] { return _slots[index].done; });
+
+	Slot& slot = _slots[index];
+	if (slot.taken) throw std::runtime_error("KtxTranscoder: job " + std::to_string(index) + " already taken");
+	slot.taken = true;
+	if (slot.error) std::rethrow_exception(slot.error);
+	return slot.texture;
+}
+
+bool KtxTranscoder::needsTranscoding(const unsigned char* data, size_t size)
+{
+	if (size < KTX2_VK_FORMAT_OFFSET + 4 || std::memcmp(data, KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0)
+		return false;
+
+	uint32_t vkFormat;
+	std::memcpy(&vkFormat, data + KTX2_VK_FORMAT_OFFSET, sizeof(vkFormat));
+	return vkFormat == 0;
+}
+
+ktxTexture2* KtxTranscoder::transcode(const Job& job, bool bcSupported)
+{
+	ktxTexture2* ktxTex = nullptr;
+	KTX_error_code res =
+	    ktxTexture2_CreateFromMemory(job.data, job.size, KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &ktxTex);
+	if (res != KTX_SUCCESS) throw std::runtime_error("ktxTexture2_CreateFromMemory failed: " + std::to_string(res));
+
+	if (ktxTexture2_NeedsTranscoding(ktxTex))
+	{
+		res = ktxTexture2_TranscodeBasis(ktxTex, chooseTarget(ktxTex, job.role, job.isSrgb, bcSupported), 0);
+		if (res != KTX_SUCCESS)
+		{
+			ktxTexture_Destroy(ktxTexture(ktxTex));
+			throw std::runtime_error("ktxTexture2_TranscodeBasis failed: " + std::to_string(res));
+		}
+		// libktx reports the UNORM format after transcoding
+		if (job.isSrgb) ktxTex->vkFormat = static_cast<uint32_t>(toSrgb(static_cast<vk::Format>(ktxTex->vkFormat)));
+	}
+	return ktxTex;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "TextureCompressor.hpp"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ktxTexture2;
+
+// Transcodes a batch of Basis (ETC1S/UASTC) KTX2 textures on worker threads while the caller uploads the ones
+// already finished. The target is picked per texture from device caps and channel layout: BC5 for two-channel
+// RG data such as XY normals, BC4 for single-channel data, BC7 otherwise, RGBA8 when BCn is unavailable.
+class KtxTranscoder
+{
+public:
+	struct Job
+	{
+		const unsigned char* data; // Must outlive the transcoder
+		size_t size;
+		bool isSrgb;
+		TextureRole role;
+	};
+
+	KtxTranscoder(std::vector<Job> jobs, bool bcSupported);
+	~KtxTranscoder();
+
+	// Blocks until job `index` is transcoded and hands over the texture (ktxTexture_Destroy when done).
+	// Rethrows the job's error. Each index may be taken once.
+	ktxTexture2* take(size_t index);
+
+	// True for KTX2 payloads that need transcoding before upload (vkFormat left undefined by Basis).
+	static bool needsTranscoding(const unsigned char* data, size_t size);
+	static ktxTexture2* transcode(const Job& job, bool bcSupported);
+
+private:
+	struct Slot
+	{
+		ktxTexture2* texture = nullptr;
+		std::exception_ptr error;
+		bool done = false;
+		bool taken = false;
+	};
+
+	void workerLoop();
+	void runJob(size_t index);
+
+	std::vector<Job> _jobs;
+	std::vector<Slot> _slots;
+	bool _bcSupported;
+	std::atomic<size_t> _nextJob{0};
+	std::mutex _mutex;
+	std::condition_variable _doneCv;
+	std::vector<std::jthread> _workers;
+};
@@ -0,0 +1,186 @@
+#include "GraphicsCore/Resources/Factories/MipGenerator.hpp"
+#include "GraphicsCore/Resources/Managers/DescriptorManager.hpp"
+#include "GraphicsCore/Managers/PipelineManager.hpp"
+#include "GraphicsCore/VulkanUtils.hpp"
+#include "Shared/Bindings.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+	// Must match PushConstants in mip_downsample.slang
+	struct MipDownsamplePush
+	{
+		uint32_t baseWidth;
+		uint32_t baseHeight;
+		uint32_t srcMip;
+		uint32_t levelCount;
+		uint32_t filter;
+	};
+
+	constexpr uint32_t kLevelsPerDispatch = 6; // 64x64 source tile -> 1 texel
+	constexpr uint32_t kTileSize = 64;
+
+	enum MipFilter : uint32_t
+	{
+		MipFilterLinear = 0,
+		MipFilterSrgb = 1,
+		MipFilterNormal = 2,
+	};
+
+	uint32_t filterFor(const MipGenerator::Request& request)
+	{
+		if (request.format == vk::Format::eR8G8B8A8Srgb) return MipFilterSrgb;
+		return request.isNormalMap ? MipFilterNormal : MipFilterLinear;
+	}
+} // namespace
+
+MipGenerator::MipGenerator(VulkanDevice& vulkanDevice, DescriptorManager& descriptorManager,
+                           PipelineManager& pipelineManager)
+    : vulkanDevice(vulkanDevice), descriptorManager(descriptorManager), pipelineManager(pipelineManager)
+{
+	_freeSets.push_back(descriptorManager.allocate("mipGenSet", maxBatchSize));
+}
+
+DSetHandle MipGenerator::acquireSets()
+{
+	if (_freeSets.empty()) return descriptorManager.allocate("mipGenSet", maxBatchSize);
+	DSetHandle sets = _freeSets.back();
+	_freeSets.pop_back();
+	return sets;
+}
+
+void MipGenerator::releaseSets(DSetHandle sets)
+{
+	_freeSets.push_back(sets);
+}
+
+bool MipGenerator::supports(vk::Format format, uint32_t mipLevels)
+{
+	return (format == vk::Format::eR8G8B8A8Srgb || format == vk::Format::eR8G8B8A8Unorm) &&
+	       mipLevels <= MAX_MIP_GEN_LEVELS;
+}
+
+void MipGenerator::prepareImageDesc(ImageDesc& desc)
+{
+	desc.usage |= vk::ImageUsageFlagBits::eStorage;
+	// sRGB formats can't be storage images: write through a UNORM view and decode/encode in the shader
+	if (desc.format == vk::Format::eR8G8B8A8Srgb)
+	{
+		desc.flags |= vk::ImageCreateFlagBits::eMutableFormat | vk::ImageCreateFlagBits::eExtendedUsage;
+	}
+}
+
+std::vector<vk::raii::ImageView> MipGenerator::record(vk::raii::CommandBuffer& cmd,
+                                                      std::span<const Request> requests, DSetHandle sets)
+{
+	if (requests.size() > maxBatchSize)
+	{
+		throw std::runtime_error("MipGenerator: batch exceeds maxBatchSize!");
+	}
+
+	// Mip 0 holds the upload, the rest are undefined; everything goes to General for the storage passes
+	std::vector<vk::ImageMemoryBarrier2> barriers;
+	barriers.reserve(requests.size() * 2);
+	for (const Request& request : requests)
+	{
+		vk::ImageMemoryBarrier2 barrier;
+		barrier.srcStageMask = vk::PipelineStageFlagBits2::eTransfer;
+		barrier.srcAccessMask = vk::AccessFlagBits2::eTransferWrite;
+		barrier.dstStageMask = vk::PipelineStageFlagBits2::eComputeShader;
+		barrier.dstAccessMask = vk::AccessFlagBits2::eShaderStorageRead;
+		barrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
+		barrier.newLayout = vk::ImageLayout::eGeneral;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = request.image;
+		barrier.subresourceRange = {vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1};
+		barriers.push_back(barrier);
+
+		if (request.mipLevels > 1)
+		{
+			barrier.srcStageMask = vk::PipelineStageFlagBits2::eNone;
+			barrier.srcAccessMask = {};
+			barrier.dstAccessMask = vk::AccessFlagBits2::eShaderStorageWrite;
+			barrier.oldLayout = vk::ImageLayout::eUndefined;
+			barrier.subresourceRange = {vk::ImageAspectFlagBits::eColor, 1, request.mipLevels - 1, 0, 1};
+			barriers.push_back(barrier);
+		}
+	}
+	vk::DependencyInfo depInfo;
+	depInfo.imageMemoryBarrierCount = static_cast<uint32_t>(barriers.size());
+	depInfo.pImageMemoryBarriers = barriers.data();
+	cmd.pipelineBarrier2(depInfo);
+
+	std::vector<vk::raii::ImageView> views;
+	descriptorManager.beginWriteBatch();
+	for (uint32_t i = 0; i < requests.size(); i++)
+	{
+		for (uint32_t level = 0; level < requests[i].mipLevels; level++)
+		{
+			views.push_back(VulkanUtils::createImageView(requests[i].image, vk::Format::eR8G8B8A8Unorm,
+			                                             vk::ImageAspectFlagBits::eColor, vulkanDevice,
+			                                             vk::ImageViewType::e2D, 1, level));
+			descriptorManager.update(sets, 0, i, vk::DescriptorType::eStorageImage, *views.back(), nullptr,
+			                         vk::ImageLayout::eGeneral, level);
+		}
+	}
+	descriptorManager.flushWrites();
+
+	BuiltPipeline& pipeline = pipelineManager.pipelines["mip_downsample"];
+	cmd.bindPipeline(vk::PipelineBindPoint::eCompute, *pipeline.pipeline);
+
+	// One pass per six levels; every texture that still has levels left shares the pass and its barrier
+	for (uint32_t srcMip = 0;; srcMip += kLevelsPerDispatch)
+	{
+		bool dispatched = false;
+		for (uint32_t i = 0; i < requests.size(); i++)
+		{
+			const Request& request = requests[i];
+			if (srcMip + 1 >= request.mipLevels) continue;
+
+			cmd.bindDescriptorSets(vk::PipelineBindPoint::eCompute, *pipeline.layout, 0,
+			                       descriptorManager.getSet(sets, i), nullptr);
+			MipDownsamplePush push{request.width, request.height, srcMip,
+			                       std::min(kLevelsPerDispatch, request.mipLevels - 1 - srcMip), filterFor(request)};
+			cmd.pushConstants<MipDownsamplePush>(*pipeline.layout, vk::ShaderStageFlagBits::eCompute, 0, push);
+
+			uint32_t srcWidth = std::max(request.width >> srcMip, 1u);
+			uint32_t srcHeight = std::max(request.height >> srcMip, 1u);
+			cmd.dispatch((srcWidth + kTileSize - 1) / kTileSize, (srcHeight + kTileSize - 1) / kTileSize, 1);
+			dispatched = true;
+		}
+		if (!dispatched) break;
+
+		vk::MemoryBarrier2 barrier;
+		barrier.srcStageMask = vk::PipelineStageFlagBits2::eComputeShader;
+		barrier.srcAccessMask = vk::AccessFlagBits2::eShaderStorageWrite;
+		barrier.dstStageMask = vk::PipelineStageFlagBits2::eComputeShader;
+		barrier.dstAccessMask = vk::AccessFlagBits2::eShaderStorageRead;
+		vk::DependencyInfo passDep;
+		passDep.memoryBarrierCount = 1;
+		passDep.pMemoryBarriers = &barrier;
+		cmd.pipelineBarrier2(passDep);
+	}
+
+	barriers.clear();
+	for (const Request& request : requests)
+	{
+		vk::ImageMemoryBarrier2 barrier;
+		barrier.srcStageMask = vk::PipelineStageFlagBits2::eComputeShader;
+		barrier.srcAccessMask = vk::AccessFlagBits2::eShaderStorageWrite;
+		barrier.dstStageMask = vk::PipelineStageFlagBits2::eFragmentShader | vk::PipelineStageFlagBits2::eComputeShader;
+		barrier.dstAccessMask = vk::AccessFlagBits2::eShaderSampledRead;
+		barrier.oldLayout = vk::ImageLayout::eGeneral;
+		barrier.newLayout = vk::ImageLayout::eShaderReadOnlyOptimal;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.image = request.image;
+		barrier.subresourceRange = {vk::ImageAspectFlagBits::eColor, 0, request.mipLevels, 0, 1};
+		barriers.push_back(barrier);
+	}
+	depInfo.imageMemoryBarrierCount = static_cast<uint32_t>(barriers.size());
+	depInfo.pImageMemoryBarriers = barriers.data();
+	cmd.pipelineBarrier2(depInfo);
+	return views;
+}
@@ -11,6 +11,10 @@
 #include "GraphicsCore/Systems/TransformSystem.hpp"
 #include "GraphicsCore/Systems/RenderSystem.hpp"
 #include "GraphicsCore/Systems/BufferUpdateSystem.hpp"
+#include "GraphicsCore/Systems/TextureStreamingSystem.hpp"
+#include "GraphicsCore/Components/GraphicsSettingsComponent.hpp"
+#include "GraphicsCore/Components/TextureStreamerComponent.hpp"
+#include "GraphicsCore/Components/MipGeneratorComponent.hpp"
 #include "GraphicsCore/Components/NameComponent.hpp"
 #include "GraphicsCore/Resources/Components/ModelComponent.hpp"
 #include "GraphicsCore/Components/CurrentFrameComponent.hpp"
@@ -79,6 +83,7 @@ Orhescyon::Entity createEntityHierarchy(Orhescyon::Entity parentEntity, tinygltf
 		gm.addComponent<MeshInfoComponent>(entity, meshSlots[node.mesh]);
 		gm.subscribeEntity<RenderSystem>(entity);
 		gm.subscribeEntity<BufferUpdateSystem>(entity);
+		gm.subscribeEntity<TextureStreamingSystem>(entity);
 	}
 	gm.subscribeEntity<TransformSystem>(entity);
 
@@ -213,9 +218,18 @@ Orhescyon::Entity ModelFactory::loadModel(const char path[MAX_PATH_LEN], int ver
 	}
 	else
 	{
-		modelHandle =
-		    GltfLoader::loadModelFromFile(path, vertexIndexBInt, bufferManager, dSetComponent, descriptorManager, model,
-		                                  textureManager, modelManager, materialManager, vulkanDevice, allocator);
+		GraphicsSettingsComponent* settings =
+		    gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
+		TextureStreamer* textureStreamer =
+		    settings && settings->enableTextureStreaming
+		        ? gm.getContextComponent<TextureStreamerContext, TextureStreamerComponent>()->textureStreamer
+		        : nullptr;
+		TextureUploadBatch* uploadBatch =
+		    gm.getContextComponent<MipGeneratorContext, MipGeneratorComponent>()->uploadBatch;
+		modelHandle = GltfLoader::loadModelFromFile(path, vertexIndexBInt, bufferManager, dSetComponent,
+		                                            descriptorManager, model, textureManager, modelManager,
+		                                            materialManager, vulkanDevice, allocator, textureStreamer,
+		                                            uploadBatch);
 	}
 
 	// Create root entity for the model
@@ -0,0 +1,361 @@
+#include "TextureCompressor.hpp"
+#include "BcEncoder.hpp"
+#include <vulkan/vulkan.hpp>
+#include <ktx.h>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+#ifdef TRACY_ENABLE
+#include <tracy/Tracy.hpp>
+#endif
+
+namespace
+{
+// Blocks per tile edge; a tile is the unit of work handed to an encoder thread.
+constexpr uint32_t TILE_BLOCKS = 8;
+
+struct EncodeTile
+{
+	uint32_t level;
+	uint32_t blockX0, blockY0;
+	uint32_t blockX1, blockY1;
+};
+
+float srgbToLinear(float c)
+{
+	return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+}
+
+float linearToSrgb(float c)
+{
+	return c <= 0.0031308f ? c * 12.92f : 1.055f * std::pow(c, 1.0f / 2.4f) - 0.055f;
+}
+
+unsigned char toUnorm8(float v)
+{
+	return static_cast<unsigned char>(std::clamp(std::lround(v * 255.0f), 0l, 255l));
+}
+
+uint32_t blockBytes(BcFormat format)
+{
+	switch (format)
+	{
+	case BcFormat::BC4:
+		return BcEncoder::BLOCK_BYTES_BC4;
+	case BcFormat::BC5:
+		return BcEncoder::BLOCK_BYTES_BC5;
+	default:
+		return BcEncoder::BLOCK_BYTES_BC7;
+	}
+}
+
+uint32_t vkFormatFor(BcFormat format, TextureRole role)
+{
+	switch (format)
+	{
+	case BcFormat::BC4:
+		return static_cast<uint32_t>(vk::Format::eBc4UnormBlock);
+	case BcFormat::BC5:
+		return static_cast<uint32_t>(vk::Format::eBc5UnormBlock);
+	default:
+		return static_cast<uint32_t>(role == TextureRole::Color ? vk::Format::eBc7SrgbBlock
+		                                                        : vk::Format::eBc7UnormBlock);
+	}
+}
+} // namespace
+
+BcFormat TextureCompressor::chooseFormat(const unsigned char* rgba, int width, int height, TextureRole role)
+{
+	if (role == TextureRole::Normal) return BcFormat::BC5;
+	if (role == TextureRole::Color) return BcFormat::BC7;
+
+	const size_t pixelCount = static_cast<size_t>(width) * static_cast<size_t>(height);
+	for (size_t i = 0; i < pixelCount; i++)
+	{
+		const unsigned char* p = rgba + i * 4;
+		if (p[0] != p[1] || p[0] != p[2] || p[3] != 255) return BcFormat::BC7;
+	}
+	return BcFormat::BC4;
+}
+
+std::vector<std::vector<unsigned char>> TextureCompressor::buildMipChain(const unsigned char* rgba, int width,
+                                                                         int height, TextureRole role)
+{
+	const uint32_t levelCount = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
+
+	std::vector<std::vector<unsigned char>> levels;
+	levels.reserve(levelCount);
+	levels.emplace_back(rgba, rgba + static_cast<size_t>(width) * static_cast<size_t>(height) * 4);
+
+	float toLinear[256];
+	for (int i = 0; i < 256; i++)
+	{
+		float c = static_cast<float>(i) / 255.0f;
+		if (role == TextureRole::Color)
+			toLinear[i] = srgbToLinear(c);
+		else if (role == TextureRole::Normal)
+			toLinear[i] = c * 2.0f - 1.0f;
+		else
+			toLinear[i] = c;
+	}
+
+	// Filter in linear space from a float copy so each level does not compound 8-bit rounding
+	std::vector<float> src(levels[0].size());
+	for (size_t i = 0; i < levels[0].size(); i++)
+	{
+		src[i] = (i % 4 == 3) ? static_cast<float>(levels[0][i]) / 255.0f : toLinear[levels[0][i]];
+	}
+
+	int srcW = width;
+	int srcH = height;
+	for (uint32_t level = 1; level < levelCount; level++)
+	{
+		const int dstW = std::max(1, srcW / 2);
+		const int dstH = std::max(1, srcH / 2);
+		std::vector<float> dst(static_cast<size_t>(dstW) * static_cast<size_t>(dstH) * 4);
+		std::vector<unsigned char> bytes(dst.size());
+
+		for (int y = 0; y < dstH; y++)
+		{
+			const int y0 = std::min(y * 2, srcH - 1);
+			const int y1 = std::min(y * 2 + 1, srcH - 1);
+			for (int x = 0; x < dstW; x++)
+			{
+				const int x0 = std::min(x * 2, srcW - 1);
+				const int x1 = std::min(x * 2 + 1, srcW - 1);
+				float* out = &dst[(static_cast<size_t>(y) * dstW + x) * 4];
+				for (int c = 0; c < 4; c++)
+				{
+					out[c] = 0.25f * (src[(static_cast<size_t>(y0) * srcW + x0) * 4 + c] +
+					                  src[(static_cast<size_t>(y0) * srcW + x1) * 4 + c] +
+					                  src[(static_cast<size_t>(y1) * srcW + x0) * 4 + c] +
+					                  src[(static_cast<size_t>(y1) * srcW + x1) * 4 + c]);
+				}
+
+				unsigned char* outBytes = &bytes[(static_cast<size_t>(y) * dstW + x) * 4];
+				if (role == TextureRole::Normal)
+				{
+					// Averaged normals shrink towards the origin; renormalize before storing
+					float len = std::sqrt(out[0] * out[0] + out[1] * out[1] + out[2] * out[2]);
+					if (len > 1e-6f)
+					{
+						out[0] /= len;
+						out[1] /= len;
+						out[2] /= len;
+					}
+					for (int c = 0; c < 3; c++) outBytes[c] = toUnorm8(out[c] * 0.5f + 0.5f);
+				}
+				else if (role == TextureRole::Color)
+				{
+					for (int c = 0; c < 3; c++) outBytes[c] = toUnorm8(linearToSrgb(out[c]));
+				}
+				else
+				{
+					for (int c = 0; c < 3; c++) outBytes[c] = toUnorm8(out[c]);
+				}
+				outBytes[3] = toUnorm8(out[3]);
+			}
+		}
+
+		levels.push_back(std::move(bytes));
+		src = std::move(dst);
+		srcW = dstW;
+		srcH = dstH;
+	}
+
+	return levels;
+}
+
+std::vector<unsigned char> TextureCompressor::compressToKtx2(const unsigned char* rgba, int width, int height,
+                                                             BcFormat format, TextureRole role)
+{
+#ifdef TRACY_ENABLE
+	ZoneScopedN("TextureCompressor::compressToKtx2");
+#endif
+	if (!rgba || width <= 0 || height <= 0)
+	{
+		throw std::runtime_error("TextureCompressor: invalid source image!");
+	}
+
+	std::vector<std::vector<unsigned char>> mips = buildMipChain(rgba, width, height, role);
+	const uint32_t levelCount = static_cast<uint32_t>(mips.size());
+	const uint32_t bytesPerBlock = blockBytes(format);
+
+	std::vector<std::vector<unsigned char>> encoded(levelCount);
+	std::vector<EncodeTile> tiles;
+	for (uint32_t level = 0; level < levelCount; level++)
+	{
+		const uint32_t levelW = std::max(1u, static_cast<uint32_t>(width) >> level);
+		const uint32_t levelH = std::max(1u, static_cast<uint32_t>(height) >> level);
+		const uint32_t blocksX = (levelW + 3) / 4;
+		const uint32_t blocksY = (levelH + 3) / 4;
+		encoded[level].resize(static_cast<size_t>(blocksX) * blocksY * bytesPerBlock);
+
+		for (uint32_t by = 0; by < blocksY; by += TILE_BLOCKS)
+		{
+			for (uint32_t bx = 0; bx < blocksX; bx += TILE_BLOCKS)
+			{
+				tiles.push_back({level, bx, by, std::min(bx + TILE_BLOCKS, blocksX), std::min(by + TILE_BLOCKS, blocksY)});
+			}
+		}
+	}
+
+	std::atomic<size_t> nextTile{0};
+	auto worker = [&]()
+	{
+		uint8_t texels[16][4];
+		for (size_t t = nextTile.fetch_add(1); t < tiles.size(); t = nextTile.fetch_add(1))
+		{
+			const EncodeTile& tile = tiles[t];
+			const uint32_t levelW = std::max(1u, static_cast<uint32_t>(width) >> tile.level);
+			const uint32_t levelH = std::max(1u, static_cast<uint32_t>(height) >> tile.level);
+			const uint32_t blocksX = (levelW + 3) / 4;
+			const unsigned char* pixels = mips[tile.level].data();
+
+			for (uint32_t by = tile.blockY0; by < tile.blockY1; by++)
+			{
+				for (uint32_t bx = tile.blockX0; bx < tile.blockX1; bx++)
+				{
+					// Edge blocks replicate the last row/column, which keeps endpoints tight
+					for (uint32_t i = 0; i < 16; i++)
+					{
+						const uint32_t px = std::min(bx * 4 + (i & 3), levelW - 1);
+						const uint32_t py = std::min(by * 4 + (i >> 2), levelH - 1);
+						const unsigned char* p = pixels + (static_cast<size_t>(py) * levelW + px) * 4;
+						texels[i][0] = p[0];
+						texels[i][1] = p[1];
+						texels[i][2] = p[2];
+						texels[i][3] = p[3];
+					}
+
+					uint8_t* out = encoded[tile.level].data() + (static_cast<size_t>(by) * blocksX + bx) * bytesPerBlock;
+					switch (format)
+					{
+					case BcFormat::BC4:
+						BcEncoder::encodeBc4(texels, 0, out);
+						break;
+					case BcFormat::BC5:
+						BcEncoder::encodeBc5(texels, out);
+						break;
+					case BcFormat::BC7:
+						BcEncoder::encodeBc7(texels, out);
+						break;
+					}
+				}
+			}
+		}
+	};
+
+	const size_t threadCount =
+	    std::min<size_t>(tiles.size(), std::max(1u, std::thread::hardware_concurrency()));
+	{
+		std::vector<std::jthread> threads;
+		threads.reserve(threadCount - 1);
+		for (size_t i = 1; i < threadCount; i++) threads.emplace_back(worker);
+		worker();
+	}
+
+	ktxTextureCreateInfo createInfo{};
+	createInfo.vkFormat = vkFormatFor(format, role);
+	createInfo.baseWidth = static_cast<ktx_uint32_t>(width);
+	createInfo.baseHeight = static_cast<ktx_uint32_t>(height);
+	createInfo.baseDepth = 1;
+	createInfo.numDimensions = 2;
+	createInfo.numLevels = levelCount;
+	createInfo.numLayers = 1;
+	createInfo.numFaces = 1;
+	createInfo.isArray = KTX_FALSE;
+	createInfo.generateMipmaps = KTX_FALSE;
+
+	ktxTexture2* ktxTex = nullptr;
+	KTX_error_code res = ktxTexture2_Create(&createInfo, KTX_TEXTURE_CREATE_ALLOC_STORAGE, &ktxTex);
+	if (res != KTX_SUCCESS) throw std::runtime_error("ktxTexture2_Create failed: " + std::to_string(res));
+
+	for (uint32_t level = 0; level < levelCount; level++)
+	{
+		res = ktxTexture_SetImageFromMemory(ktxTexture(ktxTex), level, 0, 0, encoded[level].data(),
+		                                    encoded[level].size());
+		if (res != KTX_SUCCESS)
+		{
+			ktxTexture_Destroy(ktxTexture(ktxTex));
+			throw std::runtime_error("ktxTexture_SetImageFromMemory failed: " + std::to_string(res));
+		}
+	}
+
+	ktx_uint8_t* fileData = nullptr;
+	ktx_size_t fileSize = 0;
+	res = ktxTexture_WriteToMemory(ktxTexture(ktxTex), &fileData, &fileSize);
+	ktxTexture_Destroy(ktxTexture(ktxTex));
+	if (res != KTX_SUCCESS) throw std::runtime_error("ktxTexture_WriteToMemory failed: " + std::to_string(res));
+
+	std::vector<unsigned char> result(fileData, fileData + fileSize);
+	std::free(fileData);
+	return result;
+}
+
+std::filesystem::path TextureCompressor::cachePath(const std::filesystem::path& assetPath, const std::string& suffix,
+                                                   BcFormat format, TextureRole role)
+{
+	std::string tag;
+	switch (format)
+	{
+	case BcFormat::BC4:
+		tag = "bc4";
+		break;
+	case BcFormat::BC5:
+		tag = "bc5";
+		break;
+	case BcFormat::BC7:
+		tag = role == TextureRole::Color ? "bc7_srgb" : "bc7";
+		break;
+	}
+	return std::filesystem::path(assetPath.generic_string() + suffix + "." + tag + ".ktx2");
+}
+
+bool TextureCompressor::loadCache(const std::filesystem::path& cachePath, const std::filesystem::path& sourcePath,
+                                  std::vector<unsigned char>& outData)
+{
+	std::error_code ec;
+	auto cacheTime = std::filesystem::last_write_time(cachePath, ec);
+	if (ec) return false;
+	auto sourceTime = std::filesystem::last_write_time(sourcePath, ec);
+	if (!ec && sourceTime > cacheTime) return false;
+
+	std::ifstream file(cachePath, std::ios::binary | std::ios::ate);
+	if (!file) return false;
+	std::streamsize size = file.tellg();
+	if (size <= 0) return false;
+	file.seekg(0);
+	outData.resize(static_cast<size_t>(size));
+	return static_cast<bool>(file.read(reinterpret_cast<char*>(outData.data()), size));
+}
+
+bool TextureCompressor::writeCache(const std::filesystem::path& cachePath, const std::vector<unsigned char>& data)
+{
+	// Write-then-rename so a crash or a parallel run never leaves a truncated cache behind
+	std::filesystem::path tmpPath = cachePath;
+	tmpPath += ".tmp";
+	{
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!file || !file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size())))
+		{
+			std::cout << "Warning: could not write texture cache " << cachePath.generic_string() << std::endl;
+			return false;
+		}
+	}
+	std::error_code ec;
+	std::filesystem::rename(tmpPath, cachePath, ec);
+	if (ec)
+	{
+		std::filesystem::remove(tmpPath, ec);
+		std::cout << "Warning: could not write texture cache " << cachePath.generic_string() << std::endl;
+		return false;
+	}
+	return true;
+}
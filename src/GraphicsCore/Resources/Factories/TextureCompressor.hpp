@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+enum class TextureRole
+{
+	Color,  // sRGB albedo/emissive
+	Normal, // Tangent-space normal map, XY kept, Z rebuilt in shader
+	Data    // Linear data (metallic/roughness, masks)
+};
+
+enum class BcFormat
+{
+	BC7,
+	BC5,
+	BC4
+};
+
+// Offline-style import path for PNG/JPEG: CPU mip chain + parallel BCn encoding, written out as KTX2
+// so later loads go straight through TextureUploader::uploadKtxTextureData.
+class TextureCompressor
+{
+public:
+	// Picks BC5 for normals, BC4 for linear grayscale without alpha, BC7 otherwise.
+	static BcFormat chooseFormat(const unsigned char* rgba, int width, int height, TextureRole role);
+	// Returns a complete KTX2 file in memory.
+	static std::vector<unsigned char> compressToKtx2(const unsigned char* rgba, int width, int height,
+	                                                 BcFormat format, TextureRole role);
+
+	// Cache file sits next to the asset: "<asset><suffix>.<format>.ktx2".
+	static std::filesystem::path cachePath(const std::filesystem::path& assetPath, const std::string& suffix,
+	                                       BcFormat format, TextureRole role);
+	// Reads the cache only if it is newer than the source asset.
+	static bool loadCache(const std::filesystem::path& cachePath, const std::filesystem::path& sourcePath,
+	                      std::vector<unsigned char>& outData);
+	// False, after a warning, when the cache could not be written (e.g. a read-only asset directory).
+	static bool writeCache(const std::filesystem::path& cachePath, const std::vector<unsigned char>& data);
+
+private:
+	static std::vector<std::vector<unsigned char>> buildMipChain(const unsigned char* rgba, int width, int height,
+	                                                             TextureRole role);
+};
@@ -2,6 +2,7 @@
 #include "GraphicsCore/Resources/Managers/TextureManager.hpp"
 #include "GraphicsCore/Resources/Managers/DescriptorManager.hpp"
 #include "GraphicsCore/Resources/Factories/TextureUploader.hpp"
+#include "GraphicsCore/Resources/Factories/TextureUploadBatch.hpp"
 #include "Shared/Bindings.h"
 #include <algorithm>
 #include <cmath>
@@ -71,7 +72,8 @@ TextureHandle TextureFactory::createBindlessTexture(TextureManager& textureManag
                                                     VmaAllocator allocator, const char* texturePath, int texWidth,
                                                     int texHeight, const unsigned char* pixels,
                                                     BindlessTextureDSetComponent& dSetComponent,
-                                                    DescriptorManager& descriptorManager, vk::Format format)
+                                                    DescriptorManager& descriptorManager, vk::Format format,
+                                                    TextureUploadBatch* uploadBatch, bool isNormalMap)
 {
 	if (!pixels)
 	{
@@ -92,8 +94,17 @@ TextureHandle TextureFactory::createBindlessTexture(TextureManager& textureManag
 	desc.usage =
 	    vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
 	desc.mipLevels = mipLevels;
+	bool batched = uploadBatch && MipGenerator::supports(format, mipLevels);
+	if (batched) MipGenerator::prepareImageDesc(desc);
 	textureManager.createImage(texture, desc);
-	TextureUploader::uploadTextureFromBuffer(pixels, texWidth, texHeight, texture, allocator, vulkanDevice);
+	if (batched)
+	{
+		uploadBatch->uploadRgba(pixels, texture, isNormalMap);
+	}
+	else
+	{
+		TextureUploader::uploadTextureFromBuffer(pixels, texWidth, texHeight, texture, allocator, vulkanDevice);
+	}
 	textureManager.createImageView(texture, format, vk::ImageAspectFlagBits::eColor);
 	textureManager.createSampler(texture, samplerPresets::texture());
 
@@ -115,7 +126,38 @@ TextureHandle TextureFactory::createBindlessTextureFromKtx(TextureManager& textu
 	Texture& texture = textureManager.getTexture(handle);
 
 	TextureUploader::uploadKtxTextureData(ktxData, dataSize, texture, textureManager, isSrgb, allocator, vulkanDevice);
-	textureManager.createImageView(texture, texture.format, vk::ImageAspectFlagBits::eColor);
+	finishBindlessKtxTexture(textureManager, texturePath, handle, dSetComponent, descriptorManager);
+	return handle;
+}
+
+TextureHandle TextureFactory::createBindlessTextureFromKtx(TextureManager& textureManager, VulkanDevice& vulkanDevice,
+                                                           VmaAllocator allocator, const char* texturePath,
+                                                           ktxTexture2* ktxTex,
+                                                           BindlessTextureDSetComponent& dSetComponent,
+                                                           DescriptorManager& descriptorManager)
+{
+	TextureHandle handle = textureManager.allocateTextureSlot();
+	Texture& texture = textureManager.getTexture(handle);
+
+	TextureUploader::uploadKtxTexture(ktxTex, texture, textureManager, allocator, vulkanDevice);
+	finishBindlessKtxTexture(textureManager, texturePath, handle, dSetComponent, descriptorManager);
+	return handle;
+}
+
+void TextureFactory::finishBindlessKtxTexture(TextureManager& textureManager, const char* texturePath,
+                                              TextureHandle handle, BindlessTextureDSetComponent& dSetComponent,
+                                              DescriptorManager& descriptorManager)
+{
+	Texture& texture = textureManager.getTexture(handle);
+	// BC4 only stores R; broadcast it so grayscale masks sample the same as their RGBA8 originals
+	vk::ComponentMapping components;
+	if (texture.format == vk::Format::eBc4UnormBlock)
+	{
+		components = {vk::ComponentSwizzle::eR, vk::ComponentSwizzle::eR, vk::ComponentSwizzle::eR,
+		              vk::ComponentSwizzle::eOne};
+	}
+	textureManager.createImageView(texture, texture.format, vk::ImageAspectFlagBits::eColor, vk::ImageViewType::e2D,
+	                               components);
 	textureManager.createSampler(texture, samplerPresets::texture());
 
 	textureManager.registerTexturePath(texturePath, handle);
@@ -123,5 +165,4 @@ TextureHandle TextureFactory::createBindlessTextureFromKtx(TextureManager& textu
 	                         vk::DescriptorType::eCombinedImageSampler, texture.textureImageView,
 	                         textureManager.getSampler(texture.samplerHandle), vk::ImageLayout::eShaderReadOnlyOptimal,
 	                         static_cast<uint32_t>(handle.id));
-	return handle;
 }
@@ -0,0 +1,146 @@
+#include "GraphicsCore/Resources/Factories/TextureUploadBatch.hpp"
+
+#ifdef TRACY_ENABLE
+#include <tracy/Tracy.hpp>
+#endif
+
+namespace
+{
+// Each batch in flight holds a group of MipGenerator descriptor sets; past this many the oldest is waited for
+// rather than growing the descriptor pool use without bound
+constexpr size_t kMaxBatchesInFlight = 2;
+} // namespace
+
+TextureUploadBatch::TextureUploadBatch(VulkanDevice& vulkanDevice, VmaAllocator allocator,
+                                       MipGenerator& mipGenerator)
+    : vulkanDevice(vulkanDevice), allocator(allocator), mipGenerator(mipGenerator)
+{
+}
+
+TextureUploadBatch::~TextureUploadBatch()
+{
+	discard();
+	for (InFlight& batch : _inFlight)
+	{
+		(void)vulkanDevice.device.waitForFences(*batch.fence, vk::True, UINT64_MAX);
+		release(batch);
+	}
+	_inFlight.clear();
+}
+
+void TextureUploadBatch::begin()
+{
+	vk::CommandBufferAllocateInfo allocInfo;
+	allocInfo.commandPool = vulkanDevice.commandPool;
+	allocInfo.level = vk::CommandBufferLevel::ePrimary;
+	allocInfo.commandBufferCount = 1;
+	_commandBuffer = std::move(vulkanDevice.device.allocateCommandBuffers(allocInfo).front());
+
+	vk::CommandBufferBeginInfo beginInfo;
+	beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
+	_commandBuffer.begin(beginInfo);
+}
+
+void TextureUploadBatch::release(InFlight& batch)
+{
+	for (StagingBuffer& staging : batch.staging)
+	{
+		VulkanUtils::destroyStagingBuffer(staging, allocator);
+	}
+	batch.staging.clear();
+	batch.views.clear();
+	batch.commandBuffer = nullptr;
+	mipGenerator.releaseSets(batch.sets);
+}
+
+void TextureUploadBatch::discard()
+{
+	for (StagingBuffer& staging : _staging)
+	{
+		VulkanUtils::destroyStagingBuffer(staging, allocator);
+	}
+	_staging.clear();
+	_requests.clear();
+	_commandBuffer = nullptr;
+}
+
+void TextureUploadBatch::collect()
+{
+	for (auto it = _inFlight.begin(); it != _inFlight.end();)
+	{
+		if (it->fence.getStatus() == vk::Result::eSuccess)
+		{
+			release(*it);
+			it = _inFlight.erase(it);
+		}
+		else
+			++it;
+	}
+}
+
+size_t TextureUploadBatch::inFlightCount() const
+{
+	return _inFlight.size();
+}
+
+void TextureUploadBatch::uploadRgba(const unsigned char* pixels, Texture& texture, bool isNormalMap)
+{
+	if (!*_commandBuffer) begin();
+
+	vk::DeviceSize imageSize = static_cast<vk::DeviceSize>(texture.width) * texture.height * 4;
+	_staging.push_back(VulkanUtils::createStagingBuffer(pixels, imageSize, allocator));
+
+	VulkanUtils::transitionImageLayout(_commandBuffer, texture.textureImage, vk::ImageLayout::eUndefined,
+	                                   vk::ImageLayout::eTransferDstOptimal, {}, vk::AccessFlagBits2::eTransferWrite,
+	                                   vk::PipelineStageFlagBits2::eNone, vk::PipelineStageFlagBits2::eTransfer,
+	                                   vk::ImageAspectFlagBits::eColor, 1, 1);
+
+	vk::BufferImageCopy region;
+	region.imageSubresource = {vk::ImageAspectFlagBits::eColor, 0, 0, 1};
+	region.imageExtent = vk::Extent3D{texture.width, texture.height, 1};
+	_commandBuffer.copyBufferToImage(_staging.back().buffer, texture.textureImage,
+	                                 vk::ImageLayout::eTransferDstOptimal, region);
+
+	_requests.push_back(
+	    {texture.textureImage, texture.format, texture.width, texture.height, texture.mipLevels, isNormalMap});
+	// Descriptor sets are per batch slot, so a full batch has to go out before more can be recorded
+	if (_requests.size() == MipGenerator::maxBatchSize) submit();
+}
+
+vk::Fence TextureUploadBatch::submit()
+{
+	if (_requests.empty()) return nullptr;
+#ifdef TRACY_ENABLE
+	ZoneScopedN("TextureUploadBatch::submit");
+#endif
+
+	// Only a long burst of loads within one frame gets here; their sets must be free before they are rewritten
+	collect();
+	while (_inFlight.size() >= kMaxBatchesInFlight)
+	{
+		(void)vulkanDevice.device.waitForFences(*_inFlight.front().fence, vk::True, UINT64_MAX);
+		release(_inFlight.front());
+		_inFlight.erase(_inFlight.begin());
+	}
+
+	InFlight batch;
+	batch.sets = mipGenerator.acquireSets();
+	batch.views = mipGenerator.record(_commandBuffer, _requests, batch.sets);
+	_commandBuffer.end();
+
+	batch.fence = vk::raii::Fence(vulkanDevice.device, vk::FenceCreateInfo{});
+	vk::SubmitInfo submitInfo;
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &*_commandBuffer;
+	vulkanDevice.graphicsQueue.submit(submitInfo, *batch.fence);
+
+	batch.commandBuffer = std::move(_commandBuffer);
+	batch.staging = std::move(_staging);
+	_commandBuffer = nullptr;
+	_staging.clear();
+	_requests.clear();
+
+	const vk::Fence fence = *batch.fence;
+	_inFlight.push_back(std::move(batch));
+	return fence;
+}
@@ -161,9 +161,7 @@ void TextureUploader::uploadHdrTextureFromFile(const char* texturePath, Texture&
 	}
 }
 
-void TextureUploader::uploadKtxTextureData(const unsigned char* ktxData, size_t dataSize, Texture& texture,
-                                           TextureManager& textureManager, bool isSrgb, VmaAllocator& allocator,
-                                           VulkanDevice& vulkanDevice)
+ktxTexture2* TextureUploader::loadKtxTexture(const unsigned char* ktxData, size_t dataSize, bool isSrgb)
 {
 	ktxTexture2* ktxTex = nullptr;
 	KTX_error_code res =
@@ -181,7 +179,29 @@ void TextureUploader::uploadKtxTextureData(const unsigned char* ktxData, size_t
 		// libktx sets vkFormat to BC7_UNORM_BLOCK after transcoding — promote to sRGB variant if needed
 		if (isSrgb) ktxTex->vkFormat = VK_FORMAT_BC7_SRGB_BLOCK;
 	}
+	return ktxTex;
+}
+
+void TextureUploader::uploadKtxTextureData(const unsigned char* ktxData, size_t dataSize, Texture& texture,
+                                           TextureManager& textureManager, bool isSrgb, VmaAllocator& allocator,
+                                           VulkanDevice& vulkanDevice)
+{
+	ktxTexture2* ktxTex = loadKtxTexture(ktxData, dataSize, isSrgb);
+	try
+	{
+		uploadKtxTexture(ktxTex, texture, textureManager, allocator, vulkanDevice);
+	}
+	catch (...)
+	{
+		ktxTexture_Destroy(ktxTexture(ktxTex));
+		throw;
+	}
+	ktxTexture_Destroy(ktxTexture(ktxTex));
+}
 
+void TextureUploader::uploadKtxTexture(ktxTexture2* ktxTex, Texture& texture, TextureManager& textureManager,
+                                       VmaAllocator& allocator, VulkanDevice& vulkanDevice)
+{
 	vk::Format vkFmt = static_cast<vk::Format>(ktxTex->vkFormat);
 	uint32_t mipLevels = ktxTex->numLevels;
 	uint32_t width = ktxTex->baseWidth;
@@ -194,30 +214,13 @@ void TextureUploader::uploadKtxTextureData(const unsigned char* ktxData, size_t
 	desc.format = vkFmt;
 	desc.usage = vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
 	desc.mipLevels = mipLevels;
-	try
-	{
-		textureManager.createImage(texture, desc);
-	}
-	catch (...)
-	{
-		ktxTexture_Destroy(ktxTexture(ktxTex));
-		throw;
-	}
+	textureManager.createImage(texture, desc);
 
 	// Staging buffer — copy the full KTX data blob (all mip levels contiguous)
 	ktx_size_t totalSize = ktxTexture_GetDataSize(ktxTexture(ktxTex));
 	ktx_uint8_t* dataPtr = ktxTexture_GetData(ktxTexture(ktxTex));
 
-	StagingBuffer staging;
-	try
-	{
-		staging = VulkanUtils::createStagingBuffer(dataPtr, totalSize, allocator);
-	}
-	catch (...)
-	{
-		ktxTexture_Destroy(ktxTexture(ktxTex));
-		throw;
-	}
+	StagingBuffer staging = VulkanUtils::createStagingBuffer(dataPtr, totalSize, allocator);
 
 	auto cmd = VulkanUtils::beginSingleTimeCommands(vulkanDevice);
 
@@ -263,7 +266,6 @@ void TextureUploader::uploadKtxTextureData(const unsigned char* ktxData, size_t
 
 	VulkanUtils::endSingleTimeCommands(cmd, vulkanDevice);
 	VulkanUtils::destroyStagingBuffer(staging, allocator);
-	ktxTexture_Destroy(ktxTexture(ktxTex));
 }
 
 void TextureUploader::generateMipmaps(vk::Image image, vk::Format imageFormat, int32_t texWidth, int32_t texHeight,
@@ -137,6 +137,43 @@ DescriptorManager::DescriptorManager(VulkanDevice& vulkanDevice)
 		registerLayout("hiZSet", depthPyramidBindings);
 	}
 
+	// Fused compute post-process: in-place storage target plus up to three sampled inputs
+	{
+		using S = vk::ShaderStageFlagBits;
+		std::array fusedPostBindings = {
+		    vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eStorageImage, 1, S::eCompute),
+		    vk::DescriptorSetLayoutBinding(1, vk::DescriptorType::eCombinedImageSampler, 1, S::eCompute),
+		    vk::DescriptorSetLayoutBinding(2, vk::DescriptorType::eCombinedImageSampler, 1, S::eCompute),
+		    vk::DescriptorSetLayoutBinding(3, vk::DescriptorType::eCombinedImageSampler, 1, S::eCompute)};
+		registerLayout("fusedPostSet", fusedPostBindings);
+	}
+
+	// TAA resolve: output and history storage targets, then scene color, velocity, depth and the previous history
+	{
+		using S = vk::ShaderStageFlagBits;
+		std::array taaBindings = {
+		    vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eStorageImage, 1, S::eCompute),
+		    vk::DescriptorSetLayoutBinding(1, vk::DescriptorType::eStorageImage, 1, S::eCompute),
+		    vk::DescriptorSetLayoutBinding(2, vk::DescriptorType::eCombinedImageSampler, 1, S::eCompute),
+		    vk::DescriptorSetLayoutBinding(3, vk::DescriptorType::eCombinedImageSampler, 1, S::eCompute),
+		    vk::DescriptorSetLayoutBinding(4, vk::DescriptorType::eCombinedImageSampler, 1, S::eCompute),
+		    vk::DescriptorSetLayoutBinding(5, vk::DescriptorType::eCombinedImageSampler, 1, S::eCompute)};
+		registerLayout("taaSet", taaBindings);
+	}
+
+	// Compute mip generation: one storage view per level, unused tail slots stay unbound
+	{
+		std::array mipGenBindings = {vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eStorageImage,
+		                                                            MAX_MIP_GEN_LEVELS,
+		                                                            vk::ShaderStageFlagBits::eCompute)};
+		std::array<vk::DescriptorBindingFlags, 1> mipGenBindingFlags = {
+		    vk::DescriptorBindingFlagBits::ePartiallyBound};
+		vk::DescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo;
+		bindingFlagsInfo.bindingCount = static_cast<uint32_t>(mipGenBindingFlags.size());
+		bindingFlagsInfo.pBindingFlags = mipGenBindingFlags.data();
+		registerLayout("mipGenSet", mipGenBindings, {}, &bindingFlagsInfo);
+	}
+
 	using S = vk::ShaderStageFlagBits;
 	std::array exposureBindings = {
 	    vk::DescriptorSetLayoutBinding(0, vk::DescriptorType::eStorageBuffer, 1, S::eCompute),
@@ -157,6 +194,11 @@ DescriptorManager::DescriptorManager(VulkanDevice& vulkanDevice)
 	    vk::DescriptorSetLayoutBinding(7, vk::DescriptorType::eStorageBuffer, 1, S::eCompute),
 	    vk::DescriptorSetLayoutBinding(8, vk::DescriptorType::eStorageBuffer, 1, S::eCompute),
 	    vk::DescriptorSetLayoutBinding(9, vk::DescriptorType::eStorageBuffer, 1, S::eCompute),
+	    vk::DescriptorSetLayoutBinding(10, vk::DescriptorType::eStorageBuffer, 1, S::eCompute | S::eVertex),
+	    vk::DescriptorSetLayoutBinding(11, vk::DescriptorType::eStorageBuffer, 1, S::eCompute),
+	    vk::DescriptorSetLayoutBinding(12, vk::DescriptorType::eCombinedImageSampler, 1, S::eCompute),
+	    vk::DescriptorSetLayoutBinding(13, vk::DescriptorType::eStorageBuffer, 1, S::eCompute),
+	    vk::DescriptorSetLayoutBinding(14, vk::DescriptorType::eStorageBuffer, 1, S::eCompute),
 	};
 	registerLayout("particleSystemSet", particleSystemBindings);
 
@@ -193,39 +235,75 @@ void DescriptorManager::update(DSetHandle dSet, uint32_t binding, uint32_t copyI
                                vk::ImageView view, vk::Sampler sampler, vk::ImageLayout imageLayout,
                                uint32_t arrayElement)
 {
-	vk::DescriptorImageInfo imageInfo;
-	imageInfo.sampler = sampler;
-	imageInfo.imageView = view;
-	imageInfo.imageLayout = imageLayout;
-
-	vk::WriteDescriptorSet write;
-	write.dstSet = descriptorSets[dSet.id][copyIndex];
-	write.dstBinding = binding;
-	write.dstArrayElement = arrayElement;
-	write.descriptorType = type;
-	write.descriptorCount = 1;
-	write.pImageInfo = &imageInfo;
-
-	vulkanDevice.device.updateDescriptorSets(write, {});
+	PendingWrite pending;
+	pending.imageInfo.sampler = sampler;
+	pending.imageInfo.imageView = view;
+	pending.imageInfo.imageLayout = imageLayout;
+
+	pending.write.dstSet = descriptorSets[dSet.id][copyIndex];
+	pending.write.dstBinding = binding;
+	pending.write.dstArrayElement = arrayElement;
+	pending.write.descriptorType = type;
+	pending.write.descriptorCount = 1;
+	submitWrite(pending);
 }
 
 void DescriptorManager::update(DSetHandle dSet, uint32_t binding, uint32_t copyIndex, vk::DescriptorType type,
                                vk::Buffer buffer, vk::DeviceSize offset, vk::DeviceSize range)
 {
-	vk::DescriptorBufferInfo bufferInfo;
-	bufferInfo.buffer = buffer;
-	bufferInfo.offset = offset;
-	bufferInfo.range = range;
-
-	vk::WriteDescriptorSet write;
-	write.dstSet = descriptorSets[dSet.id][copyIndex];
-	write.dstBinding = binding;
-	write.dstArrayElement = 0;
-	write.descriptorType = type;
-	write.descriptorCount = 1;
-	write.pBufferInfo = &bufferInfo;
-
-	vulkanDevice.device.updateDescriptorSets(write, {});
+	PendingWrite pending;
+	pending.bufferInfo.buffer = buffer;
+	pending.bufferInfo.offset = offset;
+	pending.bufferInfo.range = range;
+
+	pending.write.dstSet = descriptorSets[dSet.id][copyIndex];
+	pending.write.dstBinding = binding;
+	pending.write.dstArrayElement = 0;
+	pending.write.descriptorType = type;
+	pending.write.descriptorCount = 1;
+	submitWrite(pending);
+}
+
+// Info pointers are patched in at submit time so queued entries can live in a growing vector.
+vk::WriteDescriptorSet DescriptorManager::resolveWrite(const PendingWrite& pending)
+{
+	vk::WriteDescriptorSet write = pending.write;
+	bool isBuffer = write.descriptorType == vk::DescriptorType::eStorageBuffer ||
+	                write.descriptorType == vk::DescriptorType::eUniformBuffer ||
+	                write.descriptorType == vk::DescriptorType::eStorageBufferDynamic ||
+	                write.descriptorType == vk::DescriptorType::eUniformBufferDynamic;
+	if (isBuffer)
+		write.pBufferInfo = &pending.bufferInfo;
+	else
+		write.pImageInfo = &pending.imageInfo;
+	return write;
+}
+
+void DescriptorManager::submitWrite(const PendingWrite& pending)
+{
+	if (batchingWrites)
+	{
+		pendingWrites.push_back(pending);
+		return;
+	}
+	vulkanDevice.device.updateDescriptorSets(resolveWrite(pending), {});
+}
+
+void DescriptorManager::beginWriteBatch()
+{
+	batchingWrites = true;
+}
+
+void DescriptorManager::flushWrites()
+{
+	batchingWrites = false;
+	if (pendingWrites.empty()) return;
+
+	std::vector<vk::WriteDescriptorSet> writes;
+	writes.reserve(pendingWrites.size());
+	for (const PendingWrite& pending : pendingWrites) writes.push_back(resolveWrite(pending));
+	vulkanDevice.device.updateDescriptorSets(writes, {});
+	pendingWrites.clear();
 }
 
 void DescriptorManager::updateSingleTextureDSet(DSetHandle dIndex, int binding, vk::ImageView imageView,
@@ -234,3 +312,10 @@ void DescriptorManager::updateSingleTextureDSet(DSetHandle dIndex, int binding,
 	for (uint32_t i = 0; i < getSetCount(dIndex); ++i)
 		update(dIndex, static_cast<uint32_t>(binding), i, vk::DescriptorType::eCombinedImageSampler, imageView, sampler);
 }
+
+void DescriptorManager::updateSingleTextureDSet(DSetHandle dIndex, int binding, uint32_t copyIndex,
+                                                vk::ImageView imageView, vk::Sampler sampler)
+{
+	update(dIndex, static_cast<uint32_t>(binding), copyIndex, vk::DescriptorType::eCombinedImageSampler, imageView,
+	       sampler);
+}
\ No newline at end of file
@@ -27,10 +27,46 @@ MaterialHandle MaterialManager::emplaceMaterial(BindlessTextureDSetComponent& dS
 		slot = static_cast<int>(materials.size() - 1);
 	}
 	_materialCache.emplace(material, MaterialHandle{slot});
-	bufferManager.writeToBuffer(dSetComponent.materialBuffer, 0, slot, material);
+	bufferManager.writeToBuffer(dSetComponent.materialBuffer, 0, slot, resolveTextures(material));
 	return MaterialHandle{slot};
 }
 
+MaterialData MaterialManager::resolveTextures(const MaterialData& material) const
+{
+	if (_textureRemap.empty()) return material;
+
+	MaterialData resolved = material;
+	for (uint32_t* index : {&resolved.textureIndex, &resolved.normalMapIndex, &resolved.metallicRoughnessIndex,
+	                        &resolved.emissiveIndex})
+	{
+		auto it = _textureRemap.find(*index);
+		if (it != _textureRemap.end()) *index = it->second;
+	}
+	return resolved;
+}
+
+void MaterialManager::remapTexture(uint32_t textureIndex, uint32_t descriptorIndex,
+                                   BindlessTextureDSetComponent& dSetComponent, BufferManager& bufferManager)
+{
+	if (textureIndex == descriptorIndex)
+		_textureRemap.erase(textureIndex);
+	else
+		_textureRemap[textureIndex] = descriptorIndex;
+
+	// In-flight frames may read these while they change; each index flips between two slots that both stay bound
+	// until those frames are done
+	for (size_t slot = 0; slot < materials.size(); ++slot)
+	{
+		const MaterialData& material = materials[slot];
+		if (material.textureIndex == textureIndex || material.normalMapIndex == textureIndex ||
+		    material.metallicRoughnessIndex == textureIndex || material.emissiveIndex == textureIndex)
+		{
+			bufferManager.writeToBuffer(dSetComponent.materialBuffer, 0, static_cast<uint32_t>(slot),
+			                            resolveTextures(material));
+		}
+	}
+}
+
 void MaterialManager::addMaterialRef(MaterialHandle handle)
 {
 	if (handle.id < 0 || handle.id >= static_cast<int>(materials.size())) return;
@@ -96,6 +96,15 @@ void ModelManager::unregisterModelPath(ModelHandle handle)
 	}
 }
 
+std::string ModelManager::getModelPath(ModelHandle handle) const
+{
+	for (const auto& [path, pathHandle] : modelPaths)
+	{
+		if (pathHandle.id == handle.id) return path;
+	}
+	return {};
+}
+
 std::optional<GeometryAllocation> ModelManager::allocateGeometry(int bufferIndex, uint32_t vertexCount,
                                                                  uint32_t indexCount)
 {
@@ -284,6 +293,68 @@ void ModelManager::defragment(VertexIndexBuffer& buffer)
 	        &GeometryAllocation::indexCount, &PrimitivesInfo::indexOffset);
 }
 
+void ModelManager::readbackGeometry(ModelHandle handle, std::vector<glm::vec3>& positions,
+                                    std::vector<uint32_t>& indices, std::vector<uint32_t>& primitiveIndexCounts)
+{
+	positions.clear();
+	indices.clear();
+	primitiveIndexCounts.clear();
+
+	const Model& model = models[handle.id];
+	const GeometryAllocation& allocation = model.allocation;
+	if (allocation.vertexCount == 0 || allocation.indexCount == 0) return;
+	VertexIndexBuffer& buffer = vertexIndexBuffers[allocation.bufferIndex];
+
+	const vk::DeviceSize vertexBytes = sizeof(Vertex) * allocation.vertexCount;
+	const vk::DeviceSize indexBytes = sizeof(uint32_t) * allocation.indexCount;
+
+	VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+	bufferInfo.size = vertexBytes + indexBytes;
+	bufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT;
+
+	VmaAllocationCreateInfo allocInfo = {};
+	allocInfo.usage = VMA_MEMORY_USAGE_AUTO;
+	allocInfo.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT;
+
+	VkBuffer readback;
+	VmaAllocation readbackAllocation;
+	VmaAllocationInfo readbackInfo;
+	if (vmaCreateBuffer(allocator, &bufferInfo, &allocInfo, &readback, &readbackAllocation, &readbackInfo) !=
+	    VK_SUCCESS)
+	{
+		throw std::runtime_error("Failed to create geometry readback buffer!");
+	}
+
+	auto cmd = VulkanUtils::beginSingleTimeCommands(vulkanDevice);
+	cmd.copyBuffer(buffer.vertexBuffer, readback, vk::BufferCopy{sizeof(Vertex) * allocation.vertexBase, 0, vertexBytes});
+	cmd.copyBuffer(buffer.indexBuffer, readback,
+	               vk::BufferCopy{sizeof(uint32_t) * allocation.indexBase, vertexBytes, indexBytes});
+	VulkanUtils::endSingleTimeCommands(cmd, vulkanDevice);
+	vmaInvalidateAllocation(allocator, readbackAllocation, 0, VK_WHOLE_SIZE);
+
+	const auto* vertices = static_cast<const Vertex*>(readbackInfo.pMappedData);
+	const auto* modelIndices =
+	    reinterpret_cast<const uint32_t*>(static_cast<const char*>(readbackInfo.pMappedData) + vertexBytes);
+
+	positions.resize(allocation.vertexCount);
+	for (uint32_t i = 0; i < allocation.vertexCount; ++i) positions[i] = vertices[i].pos;
+
+	indices.reserve(allocation.indexCount);
+	for (MeshHandle meshSlot : model.meshes)
+	{
+		for (const PrimitivesInfo& primitive : meshes[meshSlot.id].primitives)
+		{
+			const uint32_t firstVertex = primitive.vertexOffset - allocation.vertexBase;
+			const uint32_t firstIndex = primitive.indexOffset - allocation.indexBase;
+			for (uint32_t i = 0; i < primitive.indexCount; ++i)
+				indices.push_back(modelIndices[firstIndex + i] + firstVertex);
+			primitiveIndexCounts.push_back(primitive.indexCount);
+		}
+	}
+
+	vmaDestroyBuffer(allocator, readback, readbackAllocation);
+}
+
 MeshHandle ModelManager::allocateMeshSlot()
 {
 	if (!_freeMeshSlots.empty())
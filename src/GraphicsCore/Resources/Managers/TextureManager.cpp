@@ -5,6 +5,8 @@
 #include "GraphicsCore/VulkanUtils.hpp"
 #include "Shared/Bindings.h"
 #include <random>
+#include <stdexcept>
+#include <string>
 #include <cmath>
 
 TextureManager::TextureManager(VulkanDevice& vulkanDevice, VmaAllocator allocator)
@@ -69,11 +71,18 @@ TextureHandle TextureManager::allocateTextureSlot()
 		_textureRefCounts[slot] = 1;
 		return TextureHandle{slot};
 	}
+	if (textures.size() >= MAX_BINDLESS_TEXTURES)
+		throw std::runtime_error("Out of bindless texture slots (" + std::to_string(MAX_BINDLESS_TEXTURES) + ")");
 	textures.push_back(Texture());
 	_textureRefCounts.push_back(1);
 	return TextureHandle{static_cast<int>(textures.size() - 1)};
 }
 
+bool TextureManager::hasFreeTextureSlot() const
+{
+	return !_freeTextureSlots.empty() || textures.size() < MAX_BINDLESS_TEXTURES;
+}
+
 void TextureManager::addTextureRef(TextureHandle handle)
 {
 	if (handle.id < 0 || handle.id >= static_cast<int>(textures.size())) return;
@@ -105,6 +114,11 @@ void TextureManager::freeTexture(TextureHandle handle, uint64_t frameNumber)
 	live.textureImageAllocation = nullptr;
 }
 
+void TextureManager::retireTextureResources(const Texture& texture, uint64_t frameNumber)
+{
+	_pendingFrees.push_back({texture, -1, frameNumber + MAX_FRAMES_IN_FLIGHT});
+}
+
 void TextureManager::collectTextureFrees(uint64_t frameNumber)
 {
 	for (auto it = _pendingFrees.begin(); it != _pendingFrees.end();)
@@ -112,7 +126,7 @@ void TextureManager::collectTextureFrees(uint64_t frameNumber)
 		if (it->retireFrame <= frameNumber)
 		{
 			destroyTextureResources(it->texture);
-			_freeTextureSlots.push_back(it->slot);
+			if (it->slot >= 0) _freeTextureSlots.push_back(it->slot);
 			it = _pendingFrees.erase(it);
 		}
 		else
@@ -211,17 +225,21 @@ size_t TextureManager::pendingTextureFreeCount() const
 }
 
 void TextureManager::createImageView(Texture& texture, vk::Format format, vk::ImageAspectFlags aspectFlags,
-                                     vk::ImageViewType viewType)
+                                     vk::ImageViewType viewType, vk::ComponentMapping components)
 {
 	vk::ImageViewCreateInfo viewInfo;
 	viewInfo.image = texture.textureImage;
 	viewInfo.viewType = viewType;
 	viewInfo.format = format;
+	viewInfo.components = components;
 	viewInfo.subresourceRange.aspectMask = aspectFlags;
 	viewInfo.subresourceRange.baseMipLevel = 0;
 	viewInfo.subresourceRange.levelCount = texture.mipLevels;
 	viewInfo.subresourceRange.baseArrayLayer = 0;
 	viewInfo.subresourceRange.layerCount = texture.layerCount;
+	// Extended-usage images carry usages (e.g. storage on sRGB) that only their aliased-format views support
+	vk::ImageViewUsageCreateInfo usageInfo(texture.usage & ~vk::ImageUsageFlagBits::eStorage);
+	if (texture.imageCreateFlags & vk::ImageCreateFlagBits::eExtendedUsage) viewInfo.pNext = &usageInfo;
 
 	texture.textureImageView = (*vulkanDevice.device).createImageView(viewInfo);
 	texture.aspectFlags = aspectFlags;
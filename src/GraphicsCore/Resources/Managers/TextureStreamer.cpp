@@ -0,0 +1,594 @@
+#include "GraphicsCore/Resources/Managers/TextureStreamer.hpp"
+#include "GraphicsCore/Resources/Managers/TextureManager.hpp"
+#include "GraphicsCore/Resources/Managers/DescriptorManager.hpp"
+#include "GraphicsCore/Resources/Managers/MaterialManager.hpp"
+#include "GraphicsCore/VulkanConst.hpp"
+#include "GraphicsCore/Resources/Components/BindlessTextureDSetComponent.hpp"
+#include "GraphicsCore/Resources/Factories/TextureUploader.hpp"
+#include "Shared/Bindings.h"
+#include <ktx.h>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#ifdef TRACY_ENABLE
+#include <tracy/Tracy.hpp>
+#endif
+
+namespace
+{
+// Largest mip edge kept resident for every streamed texture.
+constexpr uint32_t STREAMING_TAIL_SIZE = 128;
+// Caps new disk reads per frame so a camera cut doesn't queue the whole scene at once.
+constexpr uint32_t MAX_STREAMING_LOADS_PER_FRAME = 16;
+
+// KTX2 file layout: fixed header, then one {byteOffset, byteLength, uncompressedByteLength} per level.
+constexpr size_t KTX2_VK_FORMAT_OFFSET = 12;
+constexpr size_t KTX2_SUPERCOMPRESSION_OFFSET = 44;
+constexpr size_t KTX2_LEVEL_INDEX_OFFSET = 80;
+constexpr size_t KTX2_LEVEL_INDEX_STRIDE = 24;
+
+template <typename T> T readLE(const unsigned char* data)
+{
+	T value;
+	std::memcpy(&value, data, sizeof(T));
+	return value;
+}
+} // namespace
+
+TextureStreamer::TextureStreamer(VulkanDevice& vulkanDevice, VmaAllocator allocator)
+    : vulkanDevice(vulkanDevice), allocator(allocator)
+{
+	_loaderThread = std::jthread([this](std::stop_token stopToken) { loaderLoop(stopToken); });
+}
+
+TextureStreamer::~TextureStreamer()
+{
+	_loaderThread.request_stop();
+	_loaderCv.notify_all();
+	if (_loaderThread.joinable()) _loaderThread.join();
+
+	for (PendingUpload& upload : _pendingUploads)
+	{
+		(void)vulkanDevice.device.waitForFences(*upload.fence, vk::True, UINT64_MAX);
+		vmaDestroyImage(allocator, upload.newTexture.textureImage, upload.newTexture.textureImageAllocation);
+		if (upload.staging.buffer) VulkanUtils::destroyStagingBuffer(upload.staging, allocator);
+	}
+}
+
+void TextureStreamer::loaderLoop(std::stop_token stopToken)
+{
+#ifdef TRACY_ENABLE
+	tracy::SetThreadName("TextureStreamer");
+#endif
+	while (!stopToken.stop_requested())
+	{
+		LoadJob job;
+		{
+			std::unique_lock<std::mutex> lock(_loaderMutex);
+			if (!_loaderCv.wait(lock, stopToken, [this] { return !_loadJobs.empty(); })) return;
+			job = std::move(_loadJobs.front());
+			_loadJobs.pop_front();
+		}
+
+		LoadResult result = readMips(job);
+
+		std::lock_guard<std::mutex> lock(_loaderMutex);
+		_loadResults.push_back(std::move(result));
+	}
+}
+
+TextureStreamer::LoadResult TextureStreamer::readMips(const LoadJob& job)
+{
+#ifdef TRACY_ENABLE
+	ZoneScopedN("TextureStreamer::readMips");
+#endif
+	LoadResult result;
+	result.textureId = job.textureId;
+	result.firstMip = job.firstMip;
+	result.forImage = job.forImage;
+
+	const StreamSource& source = *job.source;
+	std::ifstream file;
+	if (!source.file.empty())
+	{
+		file.open(source.file, std::ios::binary);
+		if (!file)
+		{
+			result.failed = true;
+			return result;
+		}
+	}
+
+	for (uint32_t mip = job.firstMip; mip < job.endMip; mip++)
+	{
+		const MipRange& range = source.mips[mip];
+		const size_t at = result.data.size();
+		result.offsets.push_back(at);
+		result.data.resize(at + range.size);
+		if (source.file.empty())
+		{
+			std::memcpy(result.data.data() + at, source.blob.data() + range.offset, range.size);
+		}
+		else if (!file.seekg(static_cast<std::streamoff>(range.offset)) ||
+		         !file.read(reinterpret_cast<char*>(result.data.data() + at), static_cast<std::streamsize>(range.size)))
+		{
+			result.failed = true;
+			return result;
+		}
+	}
+	return result;
+}
+
+TextureHandle TextureStreamer::createStreamedTexture(TextureManager& textureManager,
+                                                     DescriptorManager& descriptorManager,
+                                                     BindlessTextureDSetComponent& dSetComponent,
+                                                     const char* texturePath, const unsigned char* ktxData,
+                                                     size_t dataSize, bool isSrgb,
+                                                     const std::filesystem::path& sourceFile,
+                                                     ktxTexture2* transcoded)
+{
+	ktxTexture2* ktxTex = transcoded ? transcoded : TextureUploader::loadKtxTexture(ktxData, dataSize, isSrgb);
+
+	StreamedTexture streamed;
+	streamed.format = static_cast<vk::Format>(ktxTex->vkFormat);
+	streamed.width = ktxTex->baseWidth;
+	streamed.height = ktxTex->baseHeight;
+	streamed.mipCount = ktxTex->numLevels;
+	if (streamed.format == vk::Format::eBc4UnormBlock)
+	{
+		streamed.components = {vk::ComponentSwizzle::eR, vk::ComponentSwizzle::eR, vk::ComponentSwizzle::eR,
+		                       vk::ComponentSwizzle::eOne};
+	}
+
+	auto source = std::make_shared<StreamSource>();
+	source->mips.resize(streamed.mipCount);
+
+	// Levels can be read straight from the file only when they are stored as-is (no Basis, no zstd), and only
+	// from a file that really holds these bytes; anything else keeps the in-memory copy
+	std::error_code fileError;
+	const bool fileBacked = !sourceFile.empty() &&
+	                        dataSize >= KTX2_LEVEL_INDEX_OFFSET + KTX2_LEVEL_INDEX_STRIDE * streamed.mipCount &&
+	                        readLE<uint32_t>(ktxData + KTX2_VK_FORMAT_OFFSET) != 0 &&
+	                        readLE<uint32_t>(ktxData + KTX2_SUPERCOMPRESSION_OFFSET) == 0 &&
+	                        std::filesystem::file_size(sourceFile, fileError) == dataSize && !fileError;
+	if (fileBacked)
+	{
+		source->file = sourceFile;
+		for (uint32_t mip = 0; mip < streamed.mipCount; mip++)
+		{
+			const unsigned char* entry = ktxData + KTX2_LEVEL_INDEX_OFFSET + KTX2_LEVEL_INDEX_STRIDE * mip;
+			source->mips[mip] = {readLE<uint64_t>(entry), readLE<uint64_t>(entry + 8)};
+		}
+	}
+	else
+	{
+		const ktx_uint8_t* data = ktxTexture_GetData(ktxTexture(ktxTex));
+		source->blob.assign(data, data + ktxTexture_GetDataSize(ktxTexture(ktxTex)));
+		for (uint32_t mip = 0; mip < streamed.mipCount; mip++)
+		{
+			ktx_size_t offset = 0;
+			ktxTexture_GetImageOffset(ktxTexture(ktxTex), mip, 0, 0, &offset);
+			source->mips[mip] = {offset, ktxTexture_GetImageSize(ktxTexture(ktxTex), mip)};
+		}
+	}
+	if (!transcoded) ktxTexture_Destroy(ktxTexture(ktxTex));
+	streamed.source = source;
+
+	uint32_t tailMip = 0;
+	while (tailMip + 1 < streamed.mipCount &&
+	       std::max(streamed.width >> tailMip, streamed.height >> tailMip) > STREAMING_TAIL_SIZE)
+	{
+		tailMip++;
+	}
+
+	LoadResult tail = readMips({-1, tailMip, streamed.mipCount, nullptr, source});
+	if (tail.failed)
+	{
+		throw std::runtime_error("[TextureStreamer] Failed to read mip tail of " + std::string(texturePath));
+	}
+
+	TextureHandle handle = textureManager.allocateTextureSlot();
+	Texture& texture = textureManager.getTexture(handle);
+
+	ImageDesc desc;
+	desc.width = std::max(1u, streamed.width >> tailMip);
+	desc.height = std::max(1u, streamed.height >> tailMip);
+	desc.format = streamed.format;
+	desc.usage =
+	    vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
+	desc.mipLevels = streamed.mipCount - tailMip;
+	textureManager.createImage(texture, desc);
+
+	StagingBuffer staging = VulkanUtils::createStagingBuffer(tail.data.data(), tail.data.size(), allocator);
+	auto cmd = VulkanUtils::beginSingleTimeCommands(vulkanDevice);
+	recordResidencyChange(cmd, streamed, nullptr, texture, tailMip, &tail, staging.buffer);
+	VulkanUtils::endSingleTimeCommands(cmd, vulkanDevice);
+	VulkanUtils::destroyStagingBuffer(staging, allocator);
+
+	textureManager.createImageView(texture, texture.format, vk::ImageAspectFlagBits::eColor, vk::ImageViewType::e2D,
+	                               streamed.components);
+	textureManager.createSampler(texture, samplerPresets::texture());
+	textureManager.registerTexturePath(texturePath, handle);
+	descriptorManager.update(dSetComponent.bindlessTextureSet, BIND_TEXTURES_ARRAY, 0,
+	                         vk::DescriptorType::eCombinedImageSampler, texture.textureImageView,
+	                         textureManager.getSampler(texture.samplerHandle), vk::ImageLayout::eShaderReadOnlyOptimal,
+	                         static_cast<uint32_t>(handle.id));
+
+	streamed.residentMip = tailMip;
+	streamed.image = texture.textureImage;
+	streamed.descriptorSlot = handle.id;
+	_textures[handle.id] = std::move(streamed);
+	return handle;
+}
+
+void TextureStreamer::requestMip(TextureHandle handle, uint32_t mip, uint64_t frameNumber, float priority)
+{
+	auto it = _textures.find(handle.id);
+	if (it == _textures.end()) return;
+
+	it->second.desiredMip = std::min(it->second.desiredMip, mip);
+	it->second.priority = std::max(it->second.priority, priority);
+	it->second.lastUsedFrame = frameNumber;
+}
+
+bool TextureStreamer::isStreamed(TextureHandle handle) const
+{
+	return _textures.contains(handle.id);
+}
+
+uint32_t TextureStreamer::getFullSize(TextureHandle handle) const
+{
+	auto it = _textures.find(handle.id);
+	return it == _textures.end() ? 0 : std::max(it->second.width, it->second.height);
+}
+
+uint32_t TextureStreamer::getMipCount(TextureHandle handle) const
+{
+	auto it = _textures.find(handle.id);
+	return it == _textures.end() ? 0 : it->second.mipCount;
+}
+
+uint64_t TextureStreamer::mipBytes(const StreamedTexture& texture, uint32_t firstMip) const
+{
+	uint64_t bytes = 0;
+	for (uint32_t mip = firstMip; mip < texture.mipCount; mip++) bytes += texture.source->mips[mip].size;
+	return bytes;
+}
+
+uint64_t TextureStreamer::residentBytes() const
+{
+	uint64_t bytes = 0;
+	for (const auto& [id, texture] : _textures) bytes += mipBytes(texture, texture.residentMip);
+	return bytes;
+}
+
+size_t TextureStreamer::streamedTextureCount() const
+{
+	return _textures.size();
+}
+
+size_t TextureStreamer::pendingUploadCount() const
+{
+	return _pendingUploads.size();
+}
+
+void TextureStreamer::recordResidencyChange(vk::raii::CommandBuffer& cmd, const StreamedTexture& streamed,
+                                            vk::Image oldImage, const Texture& newTexture, uint32_t newResidentMip,
+                                            const LoadResult* loaded, vk::Buffer staging)
+{
+	const vk::PipelineStageFlags2 samplingStages =
+	    vk::PipelineStageFlagBits2::eFragmentShader | vk::PipelineStageFlagBits2::eComputeShader;
+	const uint32_t oldLevels = streamed.mipCount - streamed.residentMip;
+
+	VulkanUtils::transitionImageLayout(cmd, newTexture.textureImage, vk::ImageLayout::eUndefined,
+	                                   vk::ImageLayout::eTransferDstOptimal, {}, vk::AccessFlagBits2::eTransferWrite,
+	                                   vk::PipelineStageFlagBits2::eTopOfPipe, vk::PipelineStageFlagBits2::eTransfer,
+	                                   vk::ImageAspectFlagBits::eColor, 1, newTexture.mipLevels);
+	if (oldImage)
+	{
+		VulkanUtils::transitionImageLayout(cmd, oldImage, vk::ImageLayout::eShaderReadOnlyOptimal,
+		                                   vk::ImageLayout::eTransferSrcOptimal, {}, vk::AccessFlagBits2::eTransferRead,
+		                                   samplingStages, vk::PipelineStageFlagBits2::eTransfer,
+		                                   vk::ImageAspectFlagBits::eColor, 1, oldLevels);
+	}
+
+	std::vector<vk::BufferImageCopy> bufferRegions;
+	std::vector<vk::ImageCopy> imageRegions;
+	for (uint32_t mip = newResidentMip; mip < streamed.mipCount; mip++)
+	{
+		const vk::Extent3D extent{std::max(1u, streamed.width >> mip), std::max(1u, streamed.height >> mip), 1};
+		const uint32_t dstLevel = mip - newResidentMip;
+
+		if (oldImage && mip >= streamed.residentMip)
+		{
+			vk::ImageCopy region;
+			region.srcSubresource = {vk::ImageAspectFlagBits::eColor, mip - streamed.residentMip, 0, 1};
+			region.dstSubresource = {vk::ImageAspectFlagBits::eColor, dstLevel, 0, 1};
+			region.extent = extent;
+			imageRegions.push_back(region);
+		}
+		else
+		{
+			vk::BufferImageCopy region;
+			region.bufferOffset = loaded->offsets[mip - loaded->firstMip];
+			region.imageSubresource = {vk::ImageAspectFlagBits::eColor, dstLevel, 0, 1};
+			region.imageExtent = extent;
+			bufferRegions.push_back(region);
+		}
+	}
+	if (!bufferRegions.empty())
+	{
+		cmd.copyBufferToImage(staging, newTexture.textureImage, vk::ImageLayout::eTransferDstOptimal, bufferRegions);
+	}
+	if (!imageRegions.empty())
+	{
+		cmd.copyImage(oldImage, vk::ImageLayout::eTransferSrcOptimal, newTexture.textureImage,
+		              vk::ImageLayout::eTransferDstOptimal, imageRegions);
+	}
+
+	if (oldImage)
+	{
+		// In-flight frames keep sampling the old image until the swap, so hand it back
+		VulkanUtils::transitionImageLayout(cmd, oldImage, vk::ImageLayout::eTransferSrcOptimal,
+		                                   vk::ImageLayout::eShaderReadOnlyOptimal, {}, vk::AccessFlagBits2::eShaderRead,
+		                                   vk::PipelineStageFlagBits2::eTransfer, samplingStages,
+		                                   vk::ImageAspectFlagBits::eColor, 1, oldLevels);
+	}
+	VulkanUtils::transitionImageLayout(cmd, newTexture.textureImage, vk::ImageLayout::eTransferDstOptimal,
+	                                   vk::ImageLayout::eShaderReadOnlyOptimal, vk::AccessFlagBits2::eTransferWrite,
+	                                   vk::AccessFlagBits2::eShaderRead, vk::PipelineStageFlagBits2::eTransfer,
+	                                   samplingStages, vk::ImageAspectFlagBits::eColor, 1, newTexture.mipLevels);
+}
+
+bool TextureStreamer::needsSpareSlot(int textureId, const StreamedTexture& streamed) const
+{
+	return streamed.descriptorSlot == textureId && streamed.spareSlot < 0;
+}
+
+void TextureStreamer::releaseSpareSlot(StreamedTexture& streamed, TextureManager& textureManager,
+                                       uint64_t frameNumber)
+{
+	// Deferred like any freed slot, so frames still sampling it keep a valid descriptor until they are done
+	textureManager.freeTexture(TextureHandle{streamed.spareSlot}, frameNumber);
+	streamed.spareSlot = -1;
+}
+
+bool TextureStreamer::beginResidencyChange(int textureId, StreamedTexture& streamed, uint32_t newResidentMip,
+                                           const LoadResult* loaded, TextureManager& textureManager)
+{
+	if (needsSpareSlot(textureId, streamed))
+	{
+		if (!textureManager.hasFreeTextureSlot()) return false;
+		streamed.spareSlot = textureManager.allocateTextureSlot().id;
+	}
+
+	PendingUpload upload;
+	upload.textureId = textureId;
+	upload.newResidentMip = newResidentMip;
+	upload.oldImage = streamed.image;
+
+	ImageDesc desc;
+	desc.width = std::max(1u, streamed.width >> newResidentMip);
+	desc.height = std::max(1u, streamed.height >> newResidentMip);
+	desc.format = streamed.format;
+	desc.usage =
+	    vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled;
+	desc.mipLevels = streamed.mipCount - newResidentMip;
+	textureManager.createImage(upload.newTexture, desc);
+
+	if (loaded)
+	{
+		upload.staging = VulkanUtils::createStagingBuffer(loaded->data.data(), loaded->data.size(), allocator);
+	}
+
+	vk::CommandBufferAllocateInfo allocInfo;
+	allocInfo.commandPool = vulkanDevice.commandPool;
+	allocInfo.level = vk::CommandBufferLevel::ePrimary;
+	allocInfo.commandBufferCount = 1;
+	upload.commandBuffer = std::move(vulkanDevice.device.allocateCommandBuffers(allocInfo).front());
+	upload.commandBuffer.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
+	recordResidencyChange(upload.commandBuffer, streamed, streamed.image, upload.newTexture, newResidentMip, loaded,
+	                      upload.staging.buffer);
+	upload.commandBuffer.end();
+
+	// Fenced instead of waitIdle: the frame loop keeps running and we poll for completion next update
+	upload.fence = vk::raii::Fence(vulkanDevice.device, vk::FenceCreateInfo{});
+	vk::SubmitInfo submitInfo;
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &*upload.commandBuffer;
+	vulkanDevice.graphicsQueue.submit(submitInfo, *upload.fence);
+
+	streamed.busy = true;
+	_pendingUploads.push_back(std::move(upload));
+	return true;
+}
+
+void TextureStreamer::update(uint64_t frameNumber, TextureManager& textureManager,
+                             DescriptorManager& descriptorManager, BindlessTextureDSetComponent& dSetComponent,
+                             MaterialManager& materialManager, BufferManager& bufferManager)
+{
+#ifdef TRACY_ENABLE
+	ZoneScopedN("TextureStreamer::update");
+#endif
+
+	// Forget textures whose slot was freed (freeTexture nulls the image) or reused since we last swapped
+	for (auto it = _textures.begin(); it != _textures.end();)
+	{
+		if (!it->second.busy && textureManager.getTexture(TextureHandle{it->first}).textureImage != it->second.image)
+		{
+			// The slot is pending free, so the remap must go before it can be handed to another texture
+			materialManager.remapTexture(it->first, it->first, dSetComponent, bufferManager);
+			if (it->second.spareSlot >= 0) releaseSpareSlot(it->second, textureManager, frameNumber);
+			it = _textures.erase(it);
+		}
+		else
+			++it;
+	}
+
+	for (auto it = _pendingUploads.begin(); it != _pendingUploads.end();)
+	{
+		if (it->fence.getStatus() != vk::Result::eSuccess)
+		{
+			++it;
+			continue;
+		}
+
+		auto textureIt = _textures.find(it->textureId);
+		Texture& live = textureManager.getTexture(TextureHandle{it->textureId});
+		if (textureIt != _textures.end() && live.textureImage == it->oldImage)
+		{
+			StreamedTexture& streamed = textureIt->second;
+			// Into the spare taken for this swap, or back into the texture's own slot once the frames that sampled
+			// it before the last swap are done
+			const bool toOwnSlot = streamed.descriptorSlot != it->textureId;
+			if (toOwnSlot && frameNumber < streamed.spareFreeFrame)
+			{
+				++it;
+				continue;
+			}
+			const int target = toOwnSlot ? it->textureId : streamed.spareSlot;
+
+			Texture old = live;
+			live.textureImage = it->newTexture.textureImage;
+			live.textureImageAllocation = it->newTexture.textureImageAllocation;
+			live.width = it->newTexture.width;
+			live.height = it->newTexture.height;
+			live.mipLevels = it->newTexture.mipLevels;
+			textureManager.createImageView(live, streamed.format, vk::ImageAspectFlagBits::eColor,
+			                               vk::ImageViewType::e2D, streamed.components);
+			descriptorManager.update(dSetComponent.bindlessTextureSet, BIND_TEXTURES_ARRAY, 0,
+			                         vk::DescriptorType::eCombinedImageSampler, live.textureImageView,
+			                         textureManager.getSampler(live.samplerHandle),
+			                         vk::ImageLayout::eShaderReadOnlyOptimal, static_cast<uint32_t>(target));
+			materialManager.remapTexture(static_cast<uint32_t>(it->textureId), static_cast<uint32_t>(target),
+			                             dSetComponent, bufferManager);
+			// The slot left behind keeps the old view, which in-flight frames sample until it is retired
+			textureManager.retireTextureResources(old, frameNumber);
+
+			streamed.image = live.textureImage;
+			streamed.residentMip = it->newResidentMip;
+			streamed.descriptorSlot = target;
+			streamed.spareFreeFrame = frameNumber + MAX_FRAMES_IN_FLIGHT;
+			if (toOwnSlot) releaseSpareSlot(streamed, textureManager, frameNumber);
+		}
+		else
+		{
+			// Never bound anywhere, safe to drop right away
+			vmaDestroyImage(allocator, it->newTexture.textureImage, it->newTexture.textureImageAllocation);
+		}
+		if (textureIt != _textures.end()) textureIt->second.busy = false;
+		if (it->staging.buffer) VulkanUtils::destroyStagingBuffer(it->staging, allocator);
+		it = _pendingUploads.erase(it);
+	}
+
+	// Idle textures still on their spare move back to their own slot once no frame in flight samples it, so a
+	// spare is only held around a swap
+	for (auto& [id, streamed] : _textures)
+	{
+		if (streamed.busy || streamed.descriptorSlot == id || frameNumber < streamed.spareFreeFrame) continue;
+		Texture& live = textureManager.getTexture(TextureHandle{id});
+		descriptorManager.update(dSetComponent.bindlessTextureSet, BIND_TEXTURES_ARRAY, 0,
+		                         vk::DescriptorType::eCombinedImageSampler, live.textureImageView,
+		                         textureManager.getSampler(live.samplerHandle), vk::ImageLayout::eShaderReadOnlyOptimal,
+		                         static_cast<uint32_t>(id));
+		materialManager.remapTexture(static_cast<uint32_t>(id), static_cast<uint32_t>(id), dSetComponent,
+		                             bufferManager);
+		streamed.descriptorSlot = id;
+		streamed.spareFreeFrame = frameNumber + MAX_FRAMES_IN_FLIGHT;
+		releaseSpareSlot(streamed, textureManager, frameNumber);
+	}
+
+	std::vector<LoadResult> results;
+	{
+		std::lock_guard<std::mutex> lock(_loaderMutex);
+		results.swap(_loadResults);
+	}
+	for (LoadResult& result : results)
+	{
+		auto textureIt = _textures.find(result.textureId);
+		if (textureIt == _textures.end()) continue;
+		StreamedTexture& streamed = textureIt->second;
+		if (result.failed || streamed.image != result.forImage ||
+		    textureManager.getTexture(TextureHandle{result.textureId}).textureImage != streamed.image)
+		{
+			streamed.busy = false;
+			continue;
+		}
+		// Out of bindless slots: keep the current mips
+		if (!beginResidencyChange(result.textureId, streamed, result.firstMip, &result, textureManager))
+			streamed.busy = false;
+	}
+
+	uint64_t resident = residentBytes();
+	uint64_t wanted = 0;
+	for (const auto& [id, streamed] : _textures)
+	{
+		if (!streamed.busy && streamed.desiredMip < streamed.residentMip)
+			wanted += mipBytes(streamed, streamed.desiredMip) - mipBytes(streamed, streamed.residentMip);
+	}
+
+	// Evict from textures nobody asked for this frame, least recently used first, one mip per step
+	if (resident + wanted > budgetBytes)
+	{
+		std::vector<std::pair<uint64_t, int>> candidates;
+		for (const auto& [id, streamed] : _textures)
+		{
+			if (!streamed.busy && streamed.lastUsedFrame < frameNumber && streamed.residentMip + 1 < streamed.mipCount &&
+			    std::max(streamed.width >> streamed.residentMip, streamed.height >> streamed.residentMip) >
+			        STREAMING_TAIL_SIZE)
+			{
+				candidates.push_back({streamed.lastUsedFrame, id});
+			}
+		}
+		std::sort(candidates.begin(), candidates.end());
+
+		for (const auto& [lastUsed, id] : candidates)
+		{
+			if (resident + wanted <= budgetBytes) break;
+			StreamedTexture& streamed = _textures[id];
+			const uint64_t shed = streamed.source->mips[streamed.residentMip].size;
+			if (beginResidencyChange(id, streamed, streamed.residentMip + 1, nullptr, textureManager))
+				resident -= shed;
+		}
+	}
+
+	// Largest on screen first, so a camera cut streams in what is closest before the background
+	std::vector<std::pair<float, int>> loads;
+	for (const auto& [id, streamed] : _textures)
+	{
+		if (streamed.busy || streamed.desiredMip >= streamed.residentMip) continue;
+		// A swap needs a spare slot; without one the read would only be thrown away
+		if (needsSpareSlot(id, streamed) && !textureManager.hasFreeTextureSlot()) continue;
+		loads.push_back({streamed.priority, id});
+	}
+	std::sort(loads.begin(), loads.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+	uint32_t issued = 0;
+	{
+		std::lock_guard<std::mutex> lock(_loaderMutex);
+		for (const auto& [priority, id] : loads)
+		{
+			if (issued >= MAX_STREAMING_LOADS_PER_FRAME) break;
+			StreamedTexture& streamed = _textures[id];
+
+			const uint64_t cost = mipBytes(streamed, streamed.desiredMip) - mipBytes(streamed, streamed.residentMip);
+			if (resident + cost > budgetBytes) continue;
+
+			_loadJobs.push_back({id, streamed.desiredMip, streamed.residentMip, streamed.image, streamed.source});
+			streamed.busy = true;
+			resident += cost;
+			issued++;
+		}
+	}
+	if (issued > 0) _loaderCv.notify_one();
+
+	for (auto& [id, streamed] : _textures)
+	{
+		streamed.desiredMip = UINT32_MAX;
+		streamed.priority = 0.0f;
+	}
+}
@@ -17,6 +17,7 @@
 #include "GraphicsCore/Components/MaterialManagerComponent.hpp"
 #include "GraphicsCore/Resources/Managers/MaterialManager.hpp"
 #include "Shared/GpuStructs.h"
+#include "FrameProfiler.hpp"
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
@@ -37,6 +38,7 @@ void BufferUpdateSystem::update(GeneralManager& gm)
 #ifdef TRACY_ENABLE
 	ZoneScopedN("BufferUpdateSystem");
 #endif
+	CpuProfileScope profileScope(gm, "BufferUpdateSystem");
 
 	CurrentFrameComponent* currentFrameComp = gm.getContextComponent<CurrentFrameContext, CurrentFrameComponent>();
 	uint32_t currentFrame = currentFrameComp->currentFrame;
@@ -84,7 +86,12 @@ void BufferUpdateSystem::update(GeneralManager& gm)
 		baseTransformPerBatch[b] = globalTransformIndex;
 		for (const auto& agent : batch[b])
 		{
-			transfromMeshPtr[globalTransformIndex].model = agent.transform->getGlobalModelMatrix();
+			glm::mat4 model = agent.transform->getGlobalModelMatrix();
+			transfromMeshPtr[globalTransformIndex].model = model;
+			transfromMeshPtr[globalTransformIndex].prevModel =
+			    agent.meshInfo->hasPreviousModel ? agent.meshInfo->previousModel : model;
+			agent.meshInfo->previousModel = model;
+			agent.meshInfo->hasPreviousModel = true;
 			globalTransformIndex++;
 		}
 	}
@@ -13,12 +13,34 @@
 #include "GraphicsCore/Components/CameraComponent.hpp"
 #include "GraphicsCore/Components/GlobalTransformComponent.hpp"
 #include "GraphicsCore/Components/DirectLightComponent.hpp"
+#include "GraphicsCore/Components/GraphicsSettingsComponent.hpp"
+#include "GraphicsCore/Components/CameraLatchComponent.hpp"
+#include "GraphicsCore/RenderGraph/RenderGraph.hpp"
+#include "GraphicsCore/Passes/PassStreams.hpp"
 #include "Shared/GpuStructs.h"
+#include "FrameProfiler.hpp"
+#include <glm/gtc/matrix_transform.hpp>
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
 #endif
 
+namespace
+{
+float halton(uint32_t index, uint32_t base)
+{
+	float result = 0.0f;
+	float fraction = 1.0f;
+	while (index > 0)
+	{
+		fraction /= static_cast<float>(base);
+		result += fraction * static_cast<float>(index % base);
+		index /= base;
+	}
+	return result;
+}
+} // namespace
+
 void CameraMatrixSystem::onRegistered(GeneralManager& gm)
 {
 	std::cout << "CameraMatrixSystem registered!" << std::endl;
@@ -29,26 +51,25 @@ void CameraMatrixSystem::onShutdown(GeneralManager& gm)
 	std::cout << "CameraMatrixSystem shutdown!" << std::endl;
 }
 
-void CameraMatrixSystem::update(GeneralManager& gm)
+CameraData CameraMatrixSystem::buildCameraData(GeneralManager& gm, const glm::mat4& prevViewProjNoJitter)
 {
-#ifdef TRACY_ENABLE
-	ZoneScopedN("CameraMatrixSystem");
-#endif
-
 	CurrentFrameComponent* currentFrameComp = gm.getContextComponent<CurrentFrameContext, CurrentFrameComponent>();
-	uint32_t currentFrame = currentFrameComp->currentFrame;
-	BufferManager& bufferManager =
-	    *gm.getContextComponent<BufferManagerContext, BufferManagerComponent>()->bufferManager;
 	SwapChain& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
 	CameraComponent* mainCamera = gm.getContextComponent<MainCameraContext, CameraComponent>();
 	GlobalTransformComponent* mainCameraTransform =
 	    gm.getContextComponent<MainCameraContext, GlobalTransformComponent>();
-	CameraComponent* sunCamera = gm.getContextComponent<SunContext, CameraComponent>();
-	GlobalTransformComponent* sunCameraTransform = gm.getContextComponent<SunContext, GlobalTransformComponent>();
-	GlobalDSetComponent* globalDSetComponent = gm.getContextComponent<MainDSetsContext, GlobalDSetComponent>();
-	DirectLightComponent* lightComponent = gm.getContextComponent<SunContext, DirectLightComponent>();
+	GraphicsSettingsComponent* settings = gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
+
+	// Scene passes render at the render extent; it only differs from the swapchain when TAA or dynamic resolution
+	// upscales. Under dynamic resolution it is a corner of images still allocated at the swapchain extent.
+	const float renderScale = activeRenderScale(*settings);
+	const vk::Extent2D renderExtent = RenderGraph::scaleExtent(swapChain.swapChainExtent, renderScale);
+	const glm::vec2 renderUvScale =
+	    settings->enableDynamicResolution
+	        ? glm::vec2(renderExtent.width, renderExtent.height) /
+	              glm::vec2(swapChain.swapChainExtent.width, swapChain.swapChainExtent.height)
+	        : glm::vec2(1.0f);
 
-	// === Camera ===
 	glm::mat4 view = mainCameraTransform->getViewMatrix();
 	glm::mat4 proj = glm::perspectiveRH_ZO(glm::radians(mainCamera->fov),
 	                                       static_cast<float>(swapChain.swapChainExtent.width) /
@@ -56,6 +77,21 @@ void CameraMatrixSystem::update(GeneralManager& gm)
 	                                       mainCamera->zFar, mainCamera->zNear);
 	proj[1][1] *= -1; // Y-flip
 
+	const glm::mat4 viewProjNoJitter = proj * view;
+
+	// Sub-pixel Halton(2,3) offsets for TAA. Lower render scales spread the output pixels over more render
+	// pixels, so the sequence is lengthened to keep covering each of them.
+	glm::vec2 jitterNdc(0.0f);
+	if (settings->enableTaa)
+	{
+		const uint32_t phaseCount =
+		    std::clamp(static_cast<uint32_t>(std::ceil(8.0f / (renderScale * renderScale))), 8u, 32u);
+		const uint32_t phase = currentFrameComp->frameNumber % phaseCount + 1;
+		const glm::vec2 jitterPx(halton(phase, 2) - 0.5f, halton(phase, 3) - 0.5f);
+		jitterNdc = jitterPx * 2.0f / glm::vec2(renderExtent.width, renderExtent.height);
+		proj = glm::translate(glm::mat4(1.0f), glm::vec3(jitterNdc, 0.0f)) * proj;
+	}
+
 	glm::mat4 cameraSpaceMatrix = proj * view;
 
 	glm::mat4 transCamera = glm::transpose(cameraSpaceMatrix);
@@ -80,11 +116,50 @@ void CameraMatrixSystem::update(GeneralManager& gm)
 	cameraUbo.invViewProj = glm::inverse(cameraSpaceMatrix);
 	cameraUbo.cameraPositionAndPadding = glm::vec4(mainCameraTransform->getGlobalPosition(), 0.0f);
 	for (int i = 0; i < 6; ++i) cameraUbo.frustumPlanes[i] = frustumPlanes[i];
-	cameraUbo.screenSize = glm::vec2(swapChain.swapChainExtent.width, swapChain.swapChainExtent.height);
+	cameraUbo.viewProjNoJitter = viewProjNoJitter;
+	cameraUbo.prevViewProjNoJitter = prevViewProjNoJitter;
+	cameraUbo.jitter = glm::vec4(jitterNdc, 0.0f, 0.0f);
+	cameraUbo.screenSize = glm::vec2(renderExtent.width, renderExtent.height);
+	cameraUbo.renderUvScale = renderUvScale;
+	return cameraUbo;
+}
+
+void CameraMatrixSystem::update(GeneralManager& gm)
+{
+#ifdef TRACY_ENABLE
+	ZoneScopedN("CameraMatrixSystem");
+#endif
+	CpuProfileScope profileScope(gm, "CameraMatrixSystem");
+
+	CurrentFrameComponent* currentFrameComp = gm.getContextComponent<CurrentFrameContext, CurrentFrameComponent>();
+	uint32_t currentFrame = currentFrameComp->currentFrame;
+	BufferManager& bufferManager =
+	    *gm.getContextComponent<BufferManagerContext, BufferManagerComponent>()->bufferManager;
+	SwapChain& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
+	CameraComponent* mainCamera = gm.getContextComponent<MainCameraContext, CameraComponent>();
+	CameraLatchComponent* latch = gm.getContextComponent<MainCameraContext, CameraLatchComponent>();
+	CameraComponent* sunCamera = gm.getContextComponent<SunContext, CameraComponent>();
+	GlobalTransformComponent* sunCameraTransform = gm.getContextComponent<SunContext, GlobalTransformComponent>();
+	GlobalDSetComponent* globalDSetComponent = gm.getContextComponent<MainDSetsContext, GlobalDSetComponent>();
+	DirectLightComponent* lightComponent = gm.getContextComponent<SunContext, DirectLightComponent>();
+
+	// === Camera ===
+	// Motion vectors start from what the previous frame rendered with, late latch included; after a skipped frame
+	// there is no such frame and the camera counts as still.
+	const bool continuous = latch->valid && currentFrameComp->frameNumber == latch->frameNumber + 1;
+	CameraData cameraUbo = buildCameraData(gm, latch->viewProj);
+	if (!continuous) cameraUbo.prevViewProjNoJitter = cameraUbo.viewProjNoJitter;
+
+	latch->prevViewProj = cameraUbo.prevViewProjNoJitter;
+	latch->viewProj = cameraUbo.viewProjNoJitter;
+	latch->frameNumber = currentFrameComp->frameNumber;
+	latch->valid = true;
 
 	memcpy(bufferManager.getMapped<CameraData>(globalDSetComponent->cameraBuffers, currentFrame), &cameraUbo,
 	       sizeof(cameraUbo));
 
+	const glm::mat4 view = cameraUbo.viewMatrix;
+
 	// === Sun (Shadows) ===
 
 	// Calculate frustum corners in world space
@@ -2,6 +2,7 @@
 #include "GraphicsCore/GraphicsContexts.hpp"
 #include "GraphicsCore/Components/DeltaTimeComponent.hpp"
 #include "PlatformCore/Window.hpp"
+#include "FrameProfiler.hpp"
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
@@ -12,11 +13,12 @@ void DeltaTimeSystem::update(GeneralManager& gm)
 #ifdef TRACY_ENABLE
 	ZoneScopedN("DeltaTimeSystem");
 #endif
+	CpuProfileScope profileScope(gm, "DeltaTimeSystem");
 
 
 	DeltaTimeComponent* dt = gm.getContextComponent<DeltaTimeContext, DeltaTimeComponent>();
 	float currentTime = static_cast<float>(Window::getTime());
-	dt->deltaTime = currentTime - dt->lastFrameTime;
+	dt->deltaTime = dt->fixedDeltaTime > 0.0f ? dt->fixedDeltaTime : currentTime - dt->lastFrameTime;
 	dt->lastFrameTime = currentTime;
 	dt->totalTime += dt->deltaTime;
 }
@@ -236,6 +236,20 @@ ImGui::Checkbox("Enable God Rays", &settings.enableGodRays);
 	ImGui::Checkbox("Enable Bloom", &settings.enableBloom);
 	ImGui::Checkbox("Enable Vignette", &settings.enableVignette);
 	ImGui::Checkbox("Enable Auto Exposure", &settings.enableAutoExposure);
+	ImGui::Checkbox("Fused Post Process (compute)", &settings.enableFusedPostProcess);
+	ImGui::Checkbox("Enable TAA", &settings.enableTaa);
+	if (settings.enableTaa)
+	{
+		ImGui::SliderFloat("Render Scale", &settings.renderScale, 0.5f, 1.0f);
+		ImGui::SliderFloat("TAA Blend", &settings.taaBlendFactor, 0.02f, 0.5f);
+	}
+	ImGui::Checkbox("Dynamic Resolution", &settings.enableDynamicResolution);
+	if (settings.enableDynamicResolution)
+	{
+		ImGui::DragFloat("Target GPU ms", &settings.dynamicResolutionTargetMs, 0.1f, 1.0f, 100.0f);
+		ImGui::SliderFloat("Min Scale", &settings.dynamicResolutionMinScale, 0.25f, 1.0f);
+		ImGui::Text("Current Scale: %.2f", settings.dynamicResolutionScale);
+	}
 	if (settings.enableBloom)
 	{
 		ImGui::DragFloat("Bloom Threshold", &settings.bloomThreshold, 0.1f, 0.0f, 10.0f);
@@ -266,6 +280,21 @@ ImGui::Checkbox("Enable God Rays", &settings.enableGodRays);
 	}
 
 	drawMsaaSelector(gm, settings);
+
+	ImGui::SeparatorText("Frame Pacing");
+	const char* presentModes[] = {"FIFO (VSync)", "Mailbox", "Immediate"};
+	const vk::PresentModeKHR presentModeValues[] = {vk::PresentModeKHR::eFifo, vk::PresentModeKHR::eMailbox,
+	                                                vk::PresentModeKHR::eImmediate};
+	int presentMode = 0;
+	for (int i = 0; i < IM_ARRAYSIZE(presentModeValues); ++i)
+		if (settings.presentMode == presentModeValues[i]) presentMode = i;
+	if (ImGui::Combo("Present Mode", &presentMode, presentModes, IM_ARRAYSIZE(presentModes)))
+		settings.presentMode = presentModeValues[presentMode];
+	int framesInFlight = static_cast<int>(settings.framesInFlight);
+	if (ImGui::SliderInt("Frames In Flight", &framesInFlight, 1, MAX_FRAMES_IN_FLIGHT))
+		settings.framesInFlight = static_cast<uint32_t>(framesInFlight);
+	ImGui::DragFloat("FPS Limit (0 = off)", &settings.frameRateLimit, 1.0f, 0.0f, 1000.0f);
+	ImGui::Checkbox("Late Latch Camera", &settings.enableLateLatch);
 }
 
 inline void inspectAutoExposure(GeneralManager& gm, Entity, AutoExposureSettingsComponent& autoExposure)
@@ -34,6 +34,11 @@
 #include "PhysicsCore/Components/PhysManagerComponent.hpp"
 #include "PhysicsCore/Components/PhysBodyComponent.hpp"
 #include "PhysicsCore/JoltGlm.hpp"
+#include "AudioCore/AudioContexts.hpp"
+#include "AudioCore/Components/AudioManagerComponent.hpp"
+#include "AudioCore/Components/AudioListenerComponent.hpp"
+#include "PlatformCore/PlatformContexts.hpp"
+#include "PlatformCore/Components/InputTimingComponent.hpp"
 #include "GraphicsCore/Components/ModelManagerComponent.hpp"
 #include "GraphicsCore/Components/TextureManagerComponent.hpp"
 #include "GraphicsCore/Components/MaterialManagerComponent.hpp"
@@ -43,6 +48,8 @@
 #include "GraphicsCore/Resources/Components/ModelComponent.hpp"
 #include "GraphicsCore/Resources/Factories/ModelFactory.hpp"
 #include "GraphicsCore/Systems/DevSystems/ComponentInspector.hpp"
+#include "FrameProfilerComponent.hpp"
+#include "FrameProfilerContext.hpp"
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
@@ -79,6 +86,95 @@ void drawArenaBar(const RangeAllocator& arena, const char* label, size_t element
 	ImGui::Text("%s: %.2f / %.2f MB used, %zu free block(s)", label, usedMb, capacityMb, arena.freeRanges().size());
 }
 
+void drawProfilerTable(const char* id, const std::vector<FrameProfiler::Stats>& stats, FrameProfiler::Domain domain)
+{
+	const ImGuiTableFlags flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingFixedFit;
+	if (!ImGui::BeginTable(id, 7, flags)) return;
+
+	ImGui::TableSetupColumn("Name", ImGuiTableColumnFlags_WidthStretch);
+	for (const char* column : {"Last", "Avg", "Min", "Max", "P95", "P99"}) ImGui::TableSetupColumn(column);
+	ImGui::TableHeadersRow();
+	for (const FrameProfiler::Stats& s : stats)
+	{
+		if (s.domain != domain) continue;
+		ImGui::TableNextRow();
+		ImGui::TableNextColumn();
+		ImGui::TextUnformatted(s.name.c_str());
+		for (float ms : {s.lastMs, s.avgMs, s.minMs, s.maxMs, s.p95Ms, s.p99Ms})
+		{
+			ImGui::TableNextColumn();
+			ImGui::Text("%.3f", ms);
+		}
+	}
+	ImGui::EndTable();
+}
+
+void drawProfilerWindow(GeneralManager& gm)
+{
+	auto* profilerComp = gm.getContextComponent<FrameProfilerContext, FrameProfilerComponent>();
+	if (!profilerComp || !profilerComp->profiler) return;
+	FrameProfiler& profiler = *profilerComp->profiler;
+
+	ImGui::Begin("Profiler");
+
+	bool enabled = profiler.isEnabled();
+	if (ImGui::Checkbox("Record", &enabled)) profiler.setEnabled(enabled);
+	ImGui::SameLine();
+	if (ImGui::Button("Clear")) profiler.clear();
+	ImGui::SameLine();
+	static const char* dumpStatus = "";
+	if (ImGui::Button("Dump CSV"))
+		dumpStatus = profiler.dumpCsv("halcyon_profile.csv") ? "Wrote halcyon_profile.csv" : "CSV dump failed";
+	ImGui::SameLine();
+	if (ImGui::Button("Dump JSON"))
+		dumpStatus = profiler.dumpJson("halcyon_profile.json") ? "Wrote halcyon_profile.json" : "JSON dump failed";
+	ImGui::TextUnformatted(dumpStatus);
+	if (auto* inputTiming = gm.getContextComponent<InputDataContext, InputTimingComponent>())
+		ImGui::Text("Dropped input events: %llu", static_cast<unsigned long long>(inputTiming->droppedEvents));
+
+	std::vector<float> cpuFrames = profiler.history(FrameProfiler::Domain::Cpu, "Frame");
+	std::vector<float> gpuFrames = profiler.history(FrameProfiler::Domain::Gpu, "Frame");
+	const ImVec2 plotSize(ImGui::GetContentRegionAvail().x, 60.0f);
+	if (!cpuFrames.empty())
+		ImGui::PlotLines("##CpuFrame", cpuFrames.data(), static_cast<int>(cpuFrames.size()), 0, "CPU frame (ms)",
+		                 0.0f, FLT_MAX, plotSize);
+	if (!gpuFrames.empty())
+		ImGui::PlotLines("##GpuFrame", gpuFrames.data(), static_cast<int>(gpuFrames.size()), 0, "GPU frame (ms)",
+		                 0.0f, FLT_MAX, plotSize);
+
+	// Statistics over the retained history of each scope (FrameProfiler::getHistoryLength samples)
+	std::vector<FrameProfiler::Stats> stats = profiler.collectStats();
+	if (ImGui::CollapsingHeader("GPU passes", ImGuiTreeNodeFlags_DefaultOpen))
+		drawProfilerTable("GpuPasses", stats, FrameProfiler::Domain::Gpu);
+	if (ImGui::CollapsingHeader("CPU scopes", ImGuiTreeNodeFlags_DefaultOpen))
+		drawProfilerTable("CpuScopes", stats, FrameProfiler::Domain::Cpu);
+	if (ImGui::CollapsingHeader("Physics", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		const PhysMetrics physics =
+		    gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager->metrics();
+		ImGui::Text("Step: %.3f ms (avg %.3f ms)", physics.lastStepMs, physics.avgStepMs);
+		ImGui::Text("Rate: %.1f Hz, %d collision steps", physics.tickRate, physics.collisionSteps);
+		ImGui::Text("Bodies: %u active / %u", physics.activeBodies, physics.bodies);
+		ImGui::Text("Late ticks: %llu, dropped %.3f s", static_cast<unsigned long long>(physics.lateTicks),
+		            physics.droppedSeconds);
+	}
+
+	if (ImGui::CollapsingHeader("Audio", ImGuiTreeNodeFlags_DefaultOpen))
+	{
+		const AudioMetrics audio =
+		    gm.getContextComponent<AudioManagerContext, AudioManagerComponent>()->audioManager->metrics();
+		ImGui::Text("Sounds: %u (%u streamed), %.2f MB decoded", audio.sounds, audio.streamedSounds,
+		            audio.decodedBytes / (1024.0 * 1024.0));
+		ImGui::Text("Voices: %u playing / %u", audio.playingVoices, audio.voices);
+		const auto* listener = gm.getContextComponent<AudioListenerContext, AudioListenerComponent>();
+		ImGui::Text("Sources: %u real, %u virtual", listener->realSources, listener->virtualSources);
+		ImGui::Text("Steals: %llu, failed plays: %llu", static_cast<unsigned long long>(audio.voiceSteals),
+		            static_cast<unsigned long long>(audio.failedPlays));
+	}
+
+	ImGui::End();
+}
+
 void drawMemoryWindow(GeneralManager& gm)
 {
 	ModelManager* modelManager = gm.getContextComponent<ModelManagerContext, ModelManagerComponent>()->modelManager;
@@ -217,6 +313,7 @@ void ImGuiSystem::update(GeneralManager& gm)
 #ifdef TRACY_ENABLE
 	ZoneScopedN("ImGuiSystem");
 #endif
+	CpuProfileScope profileScope(gm, "ImGuiSystem");
 
 	CurrentFrameComponent* currentFrameComp = gm.getContextComponent<CurrentFrameContext, CurrentFrameComponent>();
 	if (!currentFrameComp || !currentFrameComp->frameValid)
@@ -355,6 +452,7 @@ void ImGuiSystem::update(GeneralManager& gm)
 	ImGui::End();
 
 	drawMemoryWindow(gm);
+	drawProfilerWindow(gm);
 
 	// ImGui::ShowDemoWindow();
 }
@@ -18,9 +18,12 @@
 #include "GraphicsCore/Components/TextureManagerComponent.hpp"
 #include "GraphicsCore/Resources/Managers/TextureManager.hpp"
 #include "GraphicsCore/Components/MaterialManagerComponent.hpp"
+#include "GraphicsCore/Components/MipGeneratorComponent.hpp"
 #include "GraphicsCore/Resources/Managers/MaterialManager.hpp"
 #include "GraphicsCore/Components/ModelManagerComponent.hpp"
 #include "GraphicsCore/Resources/Managers/ModelManager.hpp"
+#include "GraphicsCore/Components/GraphicsSettingsComponent.hpp"
+#include "FrameProfiler.hpp"
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
@@ -41,6 +44,7 @@ void FrameBeginSystem::update(GeneralManager& gm)
 #ifdef TRACY_ENABLE
 	ZoneScopedN("FrameBeginSystem");
 #endif
+	CpuProfileScope profileScope(gm, "FrameBeginSystem");
 
 	VulkanDevice& vulkanDevice =
 	    *gm.getContextComponent<MainVulkanDeviceContext, VulkanDeviceComponent>()->vulkanDeviceInstance;
@@ -95,6 +99,8 @@ void FrameBeginSystem::update(GeneralManager& gm)
 	    *gm.getContextComponent<ModelManagerContext, ModelManagerComponent>()->modelManager;
 	modelManager.collectGeometryFrees(currentFrameComp->frameNumber);
 
+	gm.getContextComponent<MipGeneratorContext, MipGeneratorComponent>()->uploadBatch->collect();
+
 	// Handle window resize
 	if (window.framebufferResized)
 	{
@@ -103,12 +109,25 @@ void FrameBeginSystem::update(GeneralManager& gm)
 		return;
 	}
 
+	// The present mode is fixed at swap chain creation
+	GraphicsSettingsComponent* settings = gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
+	if (!vulkanDevice.headless && settings->presentMode != swapChain.requestedPresentMode)
+	{
+		swapChain.requestedPresentMode = settings->presentMode;
+		SwapChainFactory::recreateSwapChain(swapChain, vulkanDevice, window);
+		return;
+	}
+
+	// Headless output images are per frame slot, and the fence wait above has already freed this one
+	uint32_t imageIndex = currentFrameComp->currentFrame;
+
 	// Acquire the next image from the swap chain
+	if (!vulkanDevice.headless)
 	{
 #ifdef TRACY_ENABLE
 		ZoneScopedN("acquireNextImage");
 #endif
-		auto [result, imageIndex] = swapChain.swapChainHandle.acquireNextImage(
+		auto [result, acquiredIndex] = swapChain.swapChainHandle.acquireNextImage(
 		    UINT64_MAX, *frameManager->frames[currentFrameComp->currentFrame].presentCompleteSemaphore, nullptr);
 
 		try
@@ -129,13 +148,14 @@ void FrameBeginSystem::update(GeneralManager& gm)
 		{
 			throw std::runtime_error("failed to acquire swap chain image!");
 		}
+		imageIndex = acquiredIndex;
+	}
 
-		vulkanDevice.device.resetFences(*frameManager->frames[currentFrameComp->currentFrame].inFlightFence);
-		frameManager->frames[currentFrameComp->currentFrame].commandBuffer.reset();
+	vulkanDevice.device.resetFences(*frameManager->frames[currentFrameComp->currentFrame].inFlightFence);
+	frameManager->frames[currentFrameComp->currentFrame].commandBuffer.reset();
 
-		FrameImageComponent* frameImageComponent = gm.getContextComponent<FrameImageContext, FrameImageComponent>();
-		frameImageComponent->imageIndex = imageIndex;
-	}
+	FrameImageComponent* frameImageComponent = gm.getContextComponent<FrameImageContext, FrameImageComponent>();
+	frameImageComponent->imageIndex = imageIndex;
 
 	currentFrameComp->frameValid = true;
 	rg->clearFrame();
@@ -16,11 +16,91 @@
 #include "GraphicsCore/Components/FrameManagerComponent.hpp"
 #include "GraphicsCore/Components/RenderGraphComponent.hpp"
 #include "GraphicsCore/RenderGraph/RenderGraph.hpp"
+#include "GraphicsCore/Components/GraphicsSettingsComponent.hpp"
+#include "GraphicsCore/Components/CameraLatchComponent.hpp"
+#include "GraphicsCore/Components/BufferManagerComponent.hpp"
+#include "GraphicsCore/Resources/Components/GlobalDSetComponent.hpp"
+#include "GraphicsCore/Resources/Managers/BufferManager.hpp"
+#include "GraphicsCore/Systems/CameraMatrixSystem.hpp"
+#include "GraphicsCore/Systems/TransformSystem.hpp"
+#include "PlatformCore/Systems/InputSolverSystem.hpp"
+#include "PlatformCore/Components/InputTimingComponent.hpp"
+#include "FrameProfiler.hpp"
+#include "FrameProfilerComponent.hpp"
+#include "FrameProfilerContext.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
 #endif
 
+namespace
+{
+// Late latch: the command buffer is recorded but not yet submitted, and the GPU only reads the camera block once it
+// runs, so input that arrived while the frame was being built still reaches this frame. Only the main camera block
+// is refreshed; the sun's shadow fit and CPU-side culling keep the pose from CameraMatrixSystem.
+void lateLatchCamera(GeneralManager& gm, Window& window, uint32_t currentFrame)
+{
+#ifdef TRACY_ENABLE
+	ZoneScopedN("LateLatch");
+#endif
+	CpuProfileScope profileScope(gm, "LateLatch");
+
+	window.pollEvents();
+	InputSolverSystem::drainInputQueue(window, *gm.getContextComponent<InputDataContext, CursorPositionComponent>(),
+	                                   *gm.getContextComponent<InputDataContext, WindowSizeComponent>(),
+	                                   *gm.getContextComponent<InputDataContext, KeyboardStateComponent>(),
+	                                   *gm.getContextComponent<InputDataContext, MouseStateComponent>(),
+	                                   *gm.getContextComponent<InputDataContext, ScrollDeltaComponent>(),
+	                                   *gm.getContextComponent<InputDataContext, InputTimingComponent>());
+
+	CameraLatchComponent* latch = gm.getContextComponent<MainCameraContext, CameraLatchComponent>();
+	if (latch->resample) latch->resample(gm);
+	// Resampled input only queues deltas on the transform, and the camera block is built from the committed pose
+	const RelationshipComponent* cameraRelationship =
+	    gm.getContextComponent<MainCameraContext, RelationshipComponent>();
+	const GlobalTransformComponent* cameraParent =
+	    cameraRelationship && cameraRelationship->parent != NULL_ENTITY
+	        ? gm.getComponent<GlobalTransformComponent>(cameraRelationship->parent)
+	        : nullptr;
+	TransformSystem::commitPending(gm.getContextComponent<MainCameraContext, GlobalTransformComponent>(),
+	                               gm.getContextComponent<MainCameraContext, LocalTransformComponent>(), cameraParent);
+
+	// Same previous view-projection as the early block, so motion vectors span exactly one rendered frame
+	CameraData cameraUbo = CameraMatrixSystem::buildCameraData(gm, latch->prevViewProj);
+	latch->viewProj = cameraUbo.viewProjNoJitter;
+
+	BufferManager& bufferManager =
+	    *gm.getContextComponent<BufferManagerContext, BufferManagerComponent>()->bufferManager;
+	GlobalDSetComponent* globalDSetComponent = gm.getContextComponent<MainDSetsContext, GlobalDSetComponent>();
+	memcpy(bufferManager.getMapped<CameraData>(globalDSetComponent->cameraBuffers, currentFrame), &cameraUbo,
+	       sizeof(cameraUbo));
+}
+
+// Time from the oldest and newest input event this frame consumed to its submission
+void recordInputLatency(GeneralManager& gm)
+{
+	InputTimingComponent* timing = gm.getContextComponent<InputDataContext, InputTimingComponent>();
+	if (!timing || timing->oldestEventNs == 0) return;
+
+	FrameProfilerComponent* profilerComponent = gm.getContextComponent<FrameProfilerContext, FrameProfilerComponent>();
+	if (profilerComponent && profilerComponent->profiler)
+	{
+		const uint64_t nowNs = static_cast<uint64_t>(
+		    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+		        .count());
+		profilerComponent->profiler->record(FrameProfiler::Domain::Cpu, "InputToSubmit",
+		                                    static_cast<float>(nowNs - timing->oldestEventNs) / 1.0e6f);
+		profilerComponent->profiler->record(FrameProfiler::Domain::Cpu, "InputToSubmitNewest",
+		                                    static_cast<float>(nowNs - timing->newestEventNs) / 1.0e6f);
+	}
+	timing->oldestEventNs = 0;
+	timing->newestEventNs = 0;
+}
+} // namespace
+
 void FrameEndSystem::onRegistered(GeneralManager& gm)
 {
 	std::cout << "FrameEndSystem registered!" << std::endl;
@@ -36,6 +116,7 @@ void FrameEndSystem::update(GeneralManager& gm)
 #ifdef TRACY_ENABLE
 	ZoneScopedN("FrameEndSystem");
 #endif
+	CpuProfileScope profileScope(gm, "FrameEndSystem");
 
 	VulkanDevice& vulkanDevice =
 	    *gm.getContextComponent<MainVulkanDeviceContext, VulkanDeviceComponent>()->vulkanDeviceInstance;
@@ -44,9 +125,18 @@ void FrameEndSystem::update(GeneralManager& gm)
 	FrameManager* frameManager = gm.getContextComponent<FrameManagerContext, FrameManagerComponent>()->frameManager;
 	CurrentFrameComponent* currentFrameComp = gm.getContextComponent<CurrentFrameContext, CurrentFrameComponent>();
 	uint32_t imageIndex = gm.getContextComponent<FrameImageContext, FrameImageComponent>()->imageIndex;
+	GraphicsSettingsComponent* settings = gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
 
 	if (!currentFrameComp->frameValid) return;
 
+	// Slots past the active count sit idle with their fences signaled, so the count may change between any frames
+	const uint32_t framesInFlight = std::clamp<uint32_t>(settings->framesInFlight, 1u, MAX_FRAMES_IN_FLIGHT);
+	auto advanceFrame = [&]()
+	{
+		currentFrameComp->currentFrame = (currentFrameComp->currentFrame + 1) % framesInFlight;
+		currentFrameComp->frameNumber++;
+	};
+
 
 	{
 #ifdef TRACY_ENABLE
@@ -58,6 +148,20 @@ void FrameEndSystem::update(GeneralManager& gm)
 
 	}
 
+	if (settings->enableLateLatch && !vulkanDevice.headless) lateLatchCamera(gm, window, currentFrameComp->currentFrame);
+
+	if (vulkanDevice.headless)
+	{
+		// Nothing was acquired and nothing is presented: the fence alone paces the frame slot
+		const vk::SubmitInfo submitInfo({}, {}, *frameManager->frames[currentFrameComp->currentFrame].commandBuffer);
+		vulkanDevice.graphicsQueue.submit(submitInfo,
+		                                  *frameManager->frames[currentFrameComp->currentFrame].inFlightFence);
+		recordInputLatency(gm);
+
+		advanceFrame();
+		return;
+	}
+
 	vk::PipelineStageFlags waitDestinationStageMask(vk::PipelineStageFlagBits::eColorAttachmentOutput);
 
 	const vk::SubmitInfo submitInfo(*frameManager->frames[currentFrameComp->currentFrame].presentCompleteSemaphore,
@@ -66,6 +170,7 @@ void FrameEndSystem::update(GeneralManager& gm)
 	                                *swapChain.renderFinishedSemaphores[imageIndex]);
 
 	vulkanDevice.graphicsQueue.submit(submitInfo, *frameManager->frames[currentFrameComp->currentFrame].inFlightFence);
+	recordInputLatency(gm);
 
 	// Present the image
 	const vk::PresentInfoKHR presentInfoKHR(*swapChain.renderFinishedSemaphores[imageIndex],
@@ -95,6 +200,5 @@ void FrameEndSystem::update(GeneralManager& gm)
 		throw std::runtime_error("failed to present swap chain image!");
 	}
 
-	currentFrameComp->currentFrame = (currentFrameComp->currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
-	currentFrameComp->frameNumber++;
+	advanceFrame();
 }
\ No newline at end of file
@@ -5,13 +5,34 @@
 #include "GraphicsCore/Components/ParticlesBufferComponent.hpp"
 #include "GraphicsCore/Resources/Managers/BufferManager.hpp"
 #include "GraphicsCore/Components/BufferManagerComponent.hpp"
+#include "GraphicsCore/Components/CurrentFrameComponent.hpp"
+#include "GraphicsCore/Resources/Components/GlobalDSetComponent.hpp"
 #include "../Passes/ParticleSystemComputePass.hpp"
 #include "Shared/ParticlesStructs.h"
+#include "Shared/GpuStructs.h"
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
 #endif
 #include "GraphicsCore/Components/DeltaTimeComponent.hpp"
+#include "FrameProfiler.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Extra wait before a removed emiter's slot is reused, covering spawns still queued in frames in flight
+static constexpr double SLOT_REUSE_MARGIN = 0.5;
+
+// Worst-case reach of a particle from the emitter: spawn offset, travel over its lifetime and its quad size
+static float derivedBoundsRadius(const ParticleEmitorComponent& emitor)
+{
+	float spawnExtent = std::abs(emitor.spawnRadius.y - emitor.spawnRadius.x) * 0.5f * std::sqrt(3.0f);
+	float speed = std::max(std::abs(emitor.velocity.x), std::abs(emitor.velocity.y));
+	float lifetime = std::max(emitor.timeToLive.x, emitor.timeToLive.y);
+	float size = std::max(emitor.scale.x, emitor.scale.y);
+	return spawnExtent + speed * lifetime + size;
+}
 
 void GPUParticlesSystem::onRegistered(GeneralManager& gm)
 {
@@ -23,47 +44,194 @@ void GPUParticlesSystem::onShutdown(GeneralManager& gm)
 	std::cout << "GPUParticlesSystem shutdown!" << std::endl;
 }
 
+void GPUParticlesSystem::onEntityUnsubscribed(Orhescyon::Entity entity, GeneralManager& gm)
+{
+	ParticleEmitorComponent* emitor = gm.getComponent<ParticleEmitorComponent>(entity);
+	if (!emitor || emitor->gpuSlot == UINT32_MAX) return;
+
+	// Particles already spawned keep reading the slot, so it stops spawning but is only reused once they are gone
+	const uint32_t slot = emitor->gpuSlot;
+	emitor->gpuSlot = UINT32_MAX;
+	_emiters[slot].active = false;
+	_emiters[slot].stepScale = 1.0f;
+	markDirty(slot);
+	double maxLifetime = std::max(_emiters[slot].timeToLive.x, _emiters[slot].timeToLive.y);
+	_retiredSlots.push_back({slot, _elapsedTime + maxLifetime + SLOT_REUSE_MARGIN});
+}
+
+uint32_t GPUParticlesSystem::allocateSlot()
+{
+	if (!_freeSlots.empty())
+	{
+		uint32_t slot = _freeSlots.back();
+		_freeSlots.pop_back();
+		return slot;
+	}
+	if (_nextSlot < MAX_NUMBER_EMITERS) return _nextSlot++;
+	return UINT32_MAX;
+}
+
+void GPUParticlesSystem::markDirty(uint32_t slot)
+{
+	if (_dirtyFrames[slot] == 0) _dirtySlots.push_back(slot);
+	_dirtyFrames[slot] = (1u << MAX_FRAMES_IN_FLIGHT) - 1;
+}
+
+void GPUParticlesSystem::uploadDirtySlots(EmiterData* dst, uint32_t frame)
+{
+	std::sort(_dirtySlots.begin(), _dirtySlots.end());
+
+	const uint8_t frameBit = static_cast<uint8_t>(1u << frame);
+	uint32_t runBegin = 0;
+	uint32_t runEnd = 0;
+	auto flushRun = [&]()
+	{
+		if (runEnd > runBegin)
+		{
+			std::memcpy(dst + runBegin, _emiters.data() + runBegin, sizeof(EmiterData) * (runEnd - runBegin));
+		}
+	};
+
+	size_t kept = 0;
+	for (uint32_t slot : _dirtySlots)
+	{
+		if (_dirtyFrames[slot] & frameBit)
+		{
+			if (slot != runEnd)
+			{
+				flushRun();
+				runBegin = slot;
+			}
+			runEnd = slot + 1;
+			_dirtyFrames[slot] &= ~frameBit;
+		}
+		if (_dirtyFrames[slot] != 0) _dirtySlots[kept++] = slot;
+	}
+	flushRun();
+	_dirtySlots.resize(kept);
+}
+
 void GPUParticlesSystem::update(GeneralManager& gm)
 {
 #ifdef TRACY_ENABLE
 	ZoneScopedN("GPUParticlesSystem");
 #endif
+	CpuProfileScope profileScope(gm, "GPUParticlesSystem");
+
+	CurrentFrameComponent* currentFrameComp = gm.getContextComponent<CurrentFrameContext, CurrentFrameComponent>();
+	// A skipped frame may still have its buffer copies in use on the GPU
+	if (!currentFrameComp->frameValid) return;
+	const uint32_t currentFrame = currentFrameComp->currentFrame;
 
-	ParticlesBufferComponent& dispatchSpawnBuffer =
+	ParticlesBufferComponent& particlesBuffer =
 	    *gm.getContextComponent<ParticlesBufferContext, ParticlesBufferComponent>();
 
 	BufferManager& bufferManager = *gm.getContextComponent<BufferManagerContext, BufferManagerComponent>()->bufferManager;
 	float deltaTime = gm.getContextComponent<DeltaTimeContext, DeltaTimeComponent>()->deltaTime;
+	_elapsedTime += deltaTime;
+
+	for (size_t i = 0; i < _retiredSlots.size();)
+	{
+		if (_retiredSlots[i].freeAt <= _elapsedTime)
+		{
+			_freeSlots.push_back(_retiredSlots[i].slot);
+			_retiredSlots[i] = _retiredSlots.back();
+			_retiredSlots.pop_back();
+		}
+		else
+		{
+			++i;
+		}
+	}
+
+	// The main camera's frustum as CameraMatrixSystem wrote it for this frame
+	GlobalDSetComponent* globalDSetComponent = gm.getContextComponent<MainDSetsContext, GlobalDSetComponent>();
+	const CameraData* cameraData = bufferManager.getMapped<CameraData>(globalDSetComponent->cameraBuffers, currentFrame);
+	glm::vec4 frustumPlanes[6];
+	std::memcpy(frustumPlanes, cameraData->frustumPlanes, sizeof(frustumPlanes));
 
-	auto* dispatchSpawnBufferPtr = bufferManager.getMapped<IndirectDispatchCommand>(dispatchSpawnBuffer.dispatchBuffer);
-	auto* emitersDataBufferPtr = bufferManager.getMapped<EmiterData>(dispatchSpawnBuffer.emitersData);
+	auto isVisible = [&](const glm::vec3& center, float radius)
+	{
+		for (const glm::vec4& plane : frustumPlanes)
+		{
+			if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) return false;
+		}
+		return true;
+	};
 
-	int spawnCountAll = 0;
-	uint32_t emitterIndex = 0;
+	uint32_t spawnCountAll = 0;
+	bool depthSortRequested = false;
+	_spawnRanges.clear();
 	forEachSubscribedEntity(
 	    gm,
 	    [&](Orhescyon::Entity, ParticleEmitorComponent& particleEmitor, GlobalTransformComponent& transform)
 	    {
-		    const uint32_t i = emitterIndex++;
+		    if (particleEmitor.gpuSlot == UINT32_MAX)
+		    {
+			    particleEmitor.gpuSlot = allocateSlot();
+			    if (particleEmitor.gpuSlot == UINT32_MAX) return; // Table full, retried next frame
+		    }
+		    const uint32_t slot = particleEmitor.gpuSlot;
+
+		    // Off-screen emitters bank their time and step with it on the throttled tick
+		    glm::vec3 position = transform.getGlobalPosition();
+		    float boundsRadius =
+		        particleEmitor.boundsRadius > 0.0f ? particleEmitor.boundsRadius : derivedBoundsRadius(particleEmitor);
+		    float stepTime = 0.0f;
+		    particleEmitor.pendingDeltaTime += deltaTime;
+		    if (isVisible(position, boundsRadius) ||
+		        particleEmitor.pendingDeltaTime >= particleEmitor.offscreenTickInterval)
+		    {
+			    stepTime = particleEmitor.pendingDeltaTime;
+			    particleEmitor.pendingDeltaTime = 0.0f;
+		    }
+
+		    // Written into a copy and compared, so a steady emiter costs no upload. Padding bytes stay as they
+		    // are in the shadow and never cause a false mismatch.
+		    EmiterData data;
+		    std::memcpy(&data, &_emiters[slot], sizeof(EmiterData));
+		    data.active = particleEmitor.active;
+		    // Exactly 1 for a visible emiter with no banked time
+		    data.stepScale = deltaTime > 0.0f ? stepTime / deltaTime : 1.0f;
+		    data.initialPosition = position;
+		    data.directionalVector = particleEmitor.directionalVector;
+		    data.spawnRadius = particleEmitor.spawnRadius;
+		    data.timeToLive = particleEmitor.timeToLive;
+		    data.velocity = particleEmitor.velocity;
+		    data.scale = particleEmitor.scale;
+		    data.colorStart = particleEmitor.colorStart;
+		    data.colorEnd = particleEmitor.colorEnd;
+		    data.sortByDepth = particleEmitor.sortByDepth ? 1u : 0u;
+		    data.depthCollision = particleEmitor.depthCollision ? 1u : 0u;
+		    data.collisionResponse = {particleEmitor.restitution, particleEmitor.friction};
+		    if (std::memcmp(&data, &_emiters[slot], sizeof(EmiterData)) != 0)
+		    {
+			    std::memcpy(&_emiters[slot], &data, sizeof(EmiterData));
+			    markDirty(slot);
+		    }
+		    depthSortRequested |= particleEmitor.sortByDepth;
+
 		    if (particleEmitor.active)
 		    {
-			    particleEmitor.emissionAccumulator += particleEmitor.spawnCount * deltaTime;
+			    particleEmitor.emissionAccumulator += particleEmitor.spawnCount * stepTime;
 			    uint32_t spawnCountParticle = static_cast<uint32_t>(particleEmitor.emissionAccumulator);
-			    spawnCountAll += spawnCountParticle;
 			    particleEmitor.emissionAccumulator -= static_cast<float>(spawnCountParticle);
-
-			    emitersDataBufferPtr[i].active = particleEmitor.active;
-			    emitersDataBufferPtr[i].directionalVector = particleEmitor.directionalVector;
-			    emitersDataBufferPtr[i].initialPosition = transform.getGlobalPosition();
-			    emitersDataBufferPtr[i].scale = particleEmitor.scale;
-			    emitersDataBufferPtr[i].spawnRadius = particleEmitor.spawnRadius;
-			    emitersDataBufferPtr[i].spawnCount = spawnCountParticle;
-			    emitersDataBufferPtr[i].timeToLive = particleEmitor.timeToLive;
-			    emitersDataBufferPtr[i].velocity = particleEmitor.velocity;
-			    emitersDataBufferPtr[i].colorStart = particleEmitor.colorStart;
-			    emitersDataBufferPtr[i].colorEnd = particleEmitor.colorEnd;
+			    if (spawnCountParticle > 0)
+			    {
+				    _spawnRanges.push_back({.emiterIndex = slot, .firstParticle = spawnCountAll});
+				    spawnCountAll += spawnCountParticle;
+			    }
 		    }
 	    });
-	dispatchSpawnBufferPtr->x = (spawnCountAll + 63) / 64;
-	dispatchSpawnBufferPtr->spawnCount = spawnCountAll;
+
+	uploadDirtySlots(bufferManager.getMapped<EmiterData>(particlesBuffer.emitersData, currentFrame), currentFrame);
+
+	std::memcpy(bufferManager.getMapped<EmiterSpawnRange>(particlesBuffer.spawnRanges, currentFrame),
+	            _spawnRanges.data(), sizeof(EmiterSpawnRange) * _spawnRanges.size());
+	SpawnDispatchCommand* dispatch =
+	    bufferManager.getMapped<SpawnDispatchCommand>(particlesBuffer.dispatchBuffer, currentFrame);
+	dispatch->x = (spawnCountAll + 63) / 64;
+	dispatch->spawnCount = spawnCountAll;
+	dispatch->rangeCount = static_cast<uint32_t>(_spawnRanges.size());
+	particlesBuffer.depthSortRequested = depthSortRequested;
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "GraphicsCore/Components/LightProbeGridComponent.hpp"
 #include "GraphicsCore/Components/ReflectionProbeComponent.hpp"
 #include "GraphicsCore/GIBaker/LightProbeGIBaking.hpp"
+#include "FrameProfiler.hpp"
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
@@ -24,6 +25,7 @@ void LightProbeGIBakeSystem::update(GeneralManager& gm)
 #ifdef TRACY_ENABLE
 	ZoneScopedN("LightProbeGIBakeSystem");
 #endif
+	CpuProfileScope profileScope(gm, "LightProbeGIBakeSystem");
 
 	LightProbeGridComponent* probeGrid = gm.getContextComponent<LightProbeGridContext, LightProbeGridComponent>();
 	if (probeGrid == nullptr || !probeGrid->needBake) return;
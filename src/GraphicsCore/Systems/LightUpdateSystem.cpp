@@ -16,6 +16,7 @@
 #include "GraphicsCore/Resources/Managers/TextureManager.hpp"
 #include "Shared/GpuStructs.h"
 #include "GraphicsCore/Resources/Components/GlobalDSetComponent.hpp"
+#include "FrameProfiler.hpp"
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
@@ -36,6 +37,7 @@ void LightUpdateSystem::update(GeneralManager& gm)
 #ifdef TRACY_ENABLE
 	ZoneScopedN("LightUpdateSystem");
 #endif
+	CpuProfileScope profileScope(gm, "LightUpdateSystem");
 
 	CurrentFrameComponent* currentFrameComp = gm.getContextComponent<CurrentFrameContext, CurrentFrameComponent>();
 	uint32_t currentFrame = currentFrameComp->currentFrame;
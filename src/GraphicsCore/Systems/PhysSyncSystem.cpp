@@ -5,7 +5,11 @@
 #include "PhysicsCore/PhysContexts.hpp"
 #include "PhysicsCore/Components/PhysManagerComponent.hpp"
 #include "PhysicsCore/Components/PhysBodyComponent.hpp"
+#include "PhysicsCore/Components/PhysTickRateComponent.hpp"
 #include "PhysicsCore/JoltGlm.hpp"
+#include "FrameProfiler.hpp"
+#include <algorithm>
+#include <chrono>
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
@@ -26,19 +30,74 @@ void PhysSyncSystem::update(GeneralManager& gm)
 #ifdef TRACY_ENABLE
 	ZoneScopedN("PhysSyncSystem");
 #endif
+	CpuProfileScope profileScope(gm, "PhysSyncSystem");
 
 	PhysManager& physManager = *gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager;
 
-	SnapshotIndices indicies = physManager.physSnapshot.load(std::memory_order_acquire);
+	const PhysTickRateComponent* tickRate = gm.getContextComponent<PhysTickRateContext, PhysTickRateComponent>();
 
-	forEachSubscribedEntity(
-	    gm,
-	    [&](Orhescyon::Entity, GlobalTransformComponent& global, PhysTransformSnapshotComponent& physSnap)
-	    {
-		    JPH::RVec3 physPosition = physSnap.positionSnap[indicies.previous];
-		    JPH::Quat physRotation = physSnap.rotationSnap[indicies.previous];
+	// Pinned for the whole sync: the physics thread may run several ticks before it is done
+	SnapshotIndices indicies = physManager.pinSnapshots();
+	const PhysSnapshot& previous = physManager.snapshots[indicies.previous];
+	const PhysSnapshot& current = physManager.snapshots[indicies.current];
+	if (current.time <= 0.0) // No tick yet: keep the authored transforms
+	{
+		physManager.unpinSnapshots();
+		return;
+	}
 
-		    global.setGlobalPosition(toGlm(physPosition));
-		    global.setGlobalRotation(toGlm(physRotation));
-	    });
+	// The frame is shown one tick behind the newest snapshot, so it normally falls between the two latest ones:
+	// alpha 0 is the previous snapshot, 1 the current one, above 1 extrapolation while the next tick is late.
+	float alpha = 1.0f;
+	const double span = current.time - previous.time;
+	if (tickRate->interpolate && previous.time > 0.0 && span > 0.0)
+	{
+		const double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		alpha = std::clamp(static_cast<float>((now - current.time) / span), 0.0f,
+		                   1.0f + std::max(tickRate->maxExtrapolation, 0.0f));
+	}
+
+	// Only agents that moved in either tick can have a different blend than they had last frame. The current
+	// snapshot goes last so its teleports win over an older entry for the same slot.
+	auto apply = [&](const PhysMovedAgent& agent, bool teleport)
+	{
+		GlobalTransformComponent* global = gm.getComponent<GlobalTransformComponent>(agent.entity);
+		if (!global) return;
+
+		const JPH::Vec3 currentPosition = current.positions[agent.slot];
+		const JPH::Quat currentRotation = current.rotations[agent.slot];
+		if (teleport || agent.slot >= previous.positions.size())
+		{
+			global->setGlobalPosition(toGlm(currentPosition));
+			global->setGlobalRotation(toGlm(currentRotation));
+			return;
+		}
+
+		const JPH::Vec3 previousPosition = previous.positions[agent.slot];
+		const JPH::Quat previousRotation = previous.rotations[agent.slot];
+		global->setGlobalPosition(toGlm(previousPosition + (currentPosition - previousPosition) * alpha));
+		global->setGlobalRotation(toGlm(previousRotation.SLERP(currentRotation, alpha)));
+	};
+
+	if (current.tick > _lastTick + 1)
+	{
+		// Frames stalled for more than a tick (loading, resize): the moved lists in between are gone, so the agents
+		// that moved since the last synced tick are found by their moved tick instead. Those that moved in that tick
+		// itself were last shown part-way or extrapolated and need their final pose too. The current tick's own
+		// movers follow below.
+		for (uint32_t slot = 0; slot < current.entities.size(); ++slot)
+		{
+			if (current.entities[slot] == Orhescyon::Entity::invalid()) continue;
+			const uint64_t movedTick = current.movedTicks[slot];
+			if (movedTick >= _lastTick && movedTick < current.tick) apply({current.entities[slot], slot, false}, false);
+		}
+	}
+	else
+	{
+		for (const PhysMovedAgent& agent : previous.moved)
+			if (agent.slot < current.positions.size()) apply(agent, false);
+	}
+	for (const PhysMovedAgent& agent : current.moved) apply(agent, agent.teleport);
+	_lastTick = current.tick;
+	physManager.unpinSnapshots();
 }
\ No newline at end of file
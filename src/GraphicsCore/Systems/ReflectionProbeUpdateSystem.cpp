@@ -6,6 +6,7 @@
 #include "Shared/GpuStructs.h"
 #include "GraphicsCore/Resources/Components/GlobalDSetComponent.hpp"
 #include "GraphicsCore/GIBaker/ReflectionProbeBaker.hpp"
+#include "FrameProfiler.hpp"
 #include <iostream>
 #include <vector>
 
@@ -41,6 +42,7 @@ int ReflectionProbeUpdateSystem::acquireSlot(ReflectionProbeComponent* probe)
 
 void ReflectionProbeUpdateSystem::update(GeneralManager& gm)
 {
+	CpuProfileScope profileScope(gm, "ReflectionProbeUpdateSystem");
 	CurrentFrameComponent* currentFrameComp = gm.getContextComponent<CurrentFrameContext, CurrentFrameComponent>();
 	uint32_t currentFrame = currentFrameComp->currentFrame;
 	BufferManager& bufferManager =
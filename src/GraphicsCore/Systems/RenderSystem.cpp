@@ -20,6 +20,7 @@
 #include "GraphicsCore/RenderGraph/RenderGraph.hpp"
 
 #include "GraphicsCore/Passes/IPass.hpp"
+#include "GraphicsCore/Passes/PassStreams.hpp"
 #include "../Passes/DirectLightPass.hpp"
 #include "../Passes/CullPass.hpp"
 #include "../Passes/DepthPrepass.hpp"
@@ -28,6 +29,7 @@
 #include "../Passes/GTAOPass.hpp"
 #include "../Passes/BloomPass.hpp"
 #include "../Passes/ToneMappingPass.hpp"
+#include "../Passes/FusedPostProcessPass.hpp"
 #include "../Passes/FXAAPass.hpp"
 #include "../Passes/VignettePass.hpp"
 #ifdef HALCYON_DEV_TOOLS
@@ -38,13 +40,25 @@
 #include "../Passes/ExposurePass.hpp"
 #include "../Passes/ParticleSystemComputePass.hpp"
 #include "../Passes/GodRaysPass.hpp"
+#include "../Passes/TaaPass.hpp"
+#include "../Passes/UpscalePass.hpp"
 #include "../Passes/ClusteredComputePass.hpp"
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
 #endif
 #include "../Passes/ParticleSystemRenderPass.hpp"
+#include "FrameProfiler.hpp"
 
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+// Fraction of the way to the estimated target scale covered per frame, and the relative error left alone
+constexpr float kDynamicResolutionGain = 0.1f;
+constexpr float kDynamicResolutionDeadband = 0.05f;
+} // namespace
 
 void RenderSystem::onRegistered(GeneralManager& gm)
 {
@@ -54,19 +68,22 @@ void RenderSystem::onRegistered(GeneralManager& gm)
 		_passes.back()->onInit(gm);
 	};
 
-	add(std::make_unique<ParticleSystemComputePass>());
 	add(std::make_unique<DirectLightPass>());
 	add(std::make_unique<CullPass>());
 	add(std::make_unique<DepthPrepass>());
+	add(std::make_unique<ParticleSystemComputePass>());
 	add(std::make_unique<DepthPyramidPass>());
 	add(std::make_unique<GTAOPass>());
 	add(std::make_unique<ClusteredComputePass>());
 	add(std::make_unique<MainPass>());
 	add(std::make_unique<ParticleSystemRenderPass>());
 	add(std::make_unique<GodRaysPass>());
-	add(std::make_unique<ExposurePass>());
 	add(std::make_unique<DebugPass>());
+	add(std::make_unique<TaaPass>());
+	add(std::make_unique<UpscalePass>());
+	add(std::make_unique<ExposurePass>());
 	add(std::make_unique<BloomPass>());
+	add(std::make_unique<FusedPostProcessPass>());
 	add(std::make_unique<ToneMappingPass>());
 	add(std::make_unique<FXAAPass>());
 	add(std::make_unique<VignettePass>());
@@ -130,12 +147,13 @@ void RenderSystem::update(GeneralManager& gm)
 #ifdef TRACY_ENABLE
 	ZoneScopedN("RenderSystem");
 #endif
+	CpuProfileScope profileScope(gm, "RenderSystem");
 
 	auto& currentFrameComp = *gm.getContextComponent<CurrentFrameContext, CurrentFrameComponent>();
 	if (!currentFrameComp.frameValid) return;
 
 #ifdef HALCYON_DEV_TOOLS
-	ImGui::Render();
+	if (ImGui::GetCurrentContext()) ImGui::Render();
 #endif
 
 	auto& rg = *gm.getContextComponent<RenderGraphContext, RenderGraphComponent>()->renderGraph;
@@ -156,6 +174,31 @@ void RenderSystem::update(GeneralManager& gm)
 	importFrameResources(gm, rg, imageIndex);
 	applySettingsChanges(gm);
 
+	auto& graphicsSettings = *gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
+	rg.setDynamicResolution(graphicsSettings.enableDynamicResolution);
+	rg.setRenderScale(activeRenderScale(graphicsSettings));
+
 	for (auto& pass : _passes)
 		if (pass->isEnabled(gm)) pass->addToGraph(gm, rg, frame);
+
+	// The new scale takes effect next frame, when CameraMatrixSystem and the graph both pick it up
+	if (graphicsSettings.enableDynamicResolution)
+		updateDynamicResolution(graphicsSettings, rg.getGpuFrameTimeMs());
+	else
+		graphicsSettings.dynamicResolutionScale = 1.0f;
+}
+
+void RenderSystem::updateDynamicResolution(GraphicsSettingsComponent& settings, float gpuFrameMs)
+{
+	if (gpuFrameMs <= 0.0f) return;
+
+	const float minScale = std::clamp(settings.dynamicResolutionMinScale, 0.25f, 1.0f);
+	const float ratio = std::max(settings.dynamicResolutionTargetMs, 1.0f) / gpuFrameMs;
+	if (std::abs(ratio - 1.0f) < kDynamicResolutionDeadband) return;
+
+	// GPU cost grows roughly with pixel count, the square of the scale. The measurement trails the scale by the
+	// frames in flight, so only part of the step is taken per frame to keep the loop from oscillating.
+	const float scale = settings.dynamicResolutionScale;
+	const float estimate = scale * std::sqrt(ratio);
+	settings.dynamicResolutionScale = std::clamp(scale + (estimate - scale) * kDynamicResolutionGain, minScale, 1.0f);
 }
@@ -0,0 +1,115 @@
+#include "GraphicsCore/Systems/TextureStreamingSystem.hpp"
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include "GraphicsCore/GraphicsContexts.hpp"
+#include "GraphicsCore/Components/SwapChainComponent.hpp"
+#include "GraphicsCore/Components/TextureManagerComponent.hpp"
+#include "GraphicsCore/Components/TextureStreamerComponent.hpp"
+#include "GraphicsCore/Components/DescriptorManagerComponent.hpp"
+#include "GraphicsCore/Components/BufferManagerComponent.hpp"
+#include "GraphicsCore/Components/ModelManagerComponent.hpp"
+#include "GraphicsCore/Components/MaterialManagerComponent.hpp"
+#include "GraphicsCore/Resources/Managers/BufferManager.hpp"
+#include "GraphicsCore/Resources/Managers/MaterialManager.hpp"
+#include "GraphicsCore/Resources/Managers/ModelManager.hpp"
+#include "GraphicsCore/Resources/Components/BindlessTextureDSetComponent.hpp"
+#include "FrameProfiler.hpp"
+
+#ifdef TRACY_ENABLE
+#include <tracy/Tracy.hpp>
+#endif
+
+void TextureStreamingSystem::onRegistered(GeneralManager& gm)
+{
+	std::cout << "TextureStreamingSystem registered!" << std::endl;
+}
+
+void TextureStreamingSystem::onShutdown(GeneralManager& gm)
+{
+	std::cout << "TextureStreamingSystem shutdown!" << std::endl;
+}
+
+void TextureStreamingSystem::update(GeneralManager& gm)
+{
+#ifdef TRACY_ENABLE
+	ZoneScopedN("TextureStreamingSystem");
+#endif
+	CpuProfileScope profileScope(gm, "TextureStreamingSystem");
+
+	TextureStreamer& streamer =
+	    *gm.getContextComponent<TextureStreamerContext, TextureStreamerComponent>()->textureStreamer;
+	if (streamer.streamedTextureCount() == 0 && streamer.pendingUploadCount() == 0) return;
+
+	CurrentFrameComponent* currentFrameComp = gm.getContextComponent<CurrentFrameContext, CurrentFrameComponent>();
+	uint64_t frameNumber = currentFrameComp->frameNumber;
+	GraphicsSettingsComponent* settings = gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
+	SwapChain& swapChain = *gm.getContextComponent<MainSwapChainContext, SwapChainComponent>()->swapChainInstance;
+	CameraComponent* mainCamera = gm.getContextComponent<MainCameraContext, CameraComponent>();
+	GlobalTransformComponent* mainCameraTransform =
+	    gm.getContextComponent<MainCameraContext, GlobalTransformComponent>();
+	TextureManager& textureManager =
+	    *gm.getContextComponent<TextureManagerContext, TextureManagerComponent>()->textureManager;
+	DescriptorManager& descriptorManager =
+	    *gm.getContextComponent<DescriptorManagerContext, DescriptorManagerComponent>()->descriptorManager;
+	ModelManager& modelManager = *gm.getContextComponent<ModelManagerContext, ModelManagerComponent>()->modelManager;
+	MaterialManager& materialManager =
+	    *gm.getContextComponent<MaterialManagerContext, MaterialManagerComponent>()->materialManager;
+	BindlessTextureDSetComponent* dSetComponent =
+	    gm.getContextComponent<MainDSetsContext, BindlessTextureDSetComponent>();
+	BufferManager& bufferManager =
+	    *gm.getContextComponent<BufferManagerContext, BufferManagerComponent>()->bufferManager;
+
+	streamer.budgetBytes = static_cast<uint64_t>(settings->textureStreamingBudgetMB) * 1024ull * 1024ull;
+
+	const glm::vec3 cameraPosition = mainCameraTransform->getGlobalPosition();
+	// Pixels covered per world unit at distance 1; projected size = radius * pixelsPerUnit / distance
+	const float pixelsPerUnit = static_cast<float>(swapChain.swapChainExtent.height) /
+	                            std::tan(glm::radians(mainCamera->fov) * 0.5f);
+
+	auto request = [&](uint32_t textureIndex, float projectedPx)
+	{
+		TextureHandle handle{static_cast<int>(textureIndex)};
+		uint32_t fullSize = streamer.getFullSize(handle);
+		if (fullSize == 0) return;
+
+		// One texel per pixel across the primitive's screen footprint
+		float ratio = static_cast<float>(fullSize) / std::max(projectedPx, 1.0f);
+		uint32_t mip = ratio > 1.0f ? static_cast<uint32_t>(std::floor(std::log2(ratio))) : 0;
+		streamer.requestMip(handle, std::min(mip, streamer.getMipCount(handle) - 1), frameNumber, projectedPx);
+	};
+
+	struct Agent
+	{
+		GlobalTransformComponent* transform;
+		MeshInfoComponent* meshInfo;
+	};
+	std::vector<Agent> agents;
+	forEachSubscribedEntity(gm, [&](Orhescyon::Entity, GlobalTransformComponent& transform, MeshInfoComponent& meshInfo)
+	                        { agents.push_back({&transform, &meshInfo}); });
+
+	for (const Agent& agent : agents)
+	{
+		const glm::mat4& model = agent.transform->getGlobalModelMatrix();
+		const glm::vec3& scale = agent.transform->getGlobalScale();
+		const float maxScale = std::max({std::abs(scale.x), std::abs(scale.y), std::abs(scale.z)});
+
+		for (const PrimitivesInfo& primitive : modelManager.getMesh(agent.meshInfo->mesh).primitives)
+		{
+			// Bounding sphere of the AABB, distance clamped so the camera being inside it requests mip 0
+			glm::vec3 center = glm::vec3(model * glm::vec4((primitive.AABBMin + primitive.AABBMax) * 0.5f, 1.0f));
+			float radius = glm::length(primitive.AABBMax - primitive.AABBMin) * 0.5f * maxScale;
+			float distance = std::max(glm::length(center - cameraPosition) - radius, mainCamera->zNear);
+			float projectedPx = radius * pixelsPerUnit / distance;
+
+			const MaterialData& material = materialManager.getMaterial(primitive.materialIndex);
+			request(material.textureIndex, projectedPx);
+			request(material.normalMapIndex, projectedPx);
+			request(material.metallicRoughnessIndex, projectedPx);
+			request(material.emissiveIndex, projectedPx);
+		}
+	}
+
+	streamer.update(frameNumber, textureManager, descriptorManager, *dSetComponent, materialManager, bufferManager);
+}
@@ -4,11 +4,21 @@
 #include <glm/gtc/quaternion.hpp>
 #include "GraphicsCore/GraphicsContexts.hpp"
 #include "GraphicsCore/Components/RelationshipComponent.hpp"
+#include "FrameProfiler.hpp"
+#include "TaskSchedulerComponent.hpp"
+#include "TaskSchedulerContext.hpp"
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
 #endif
 
+namespace
+{
+// Below this many root subtrees with children, handing them to workers costs more than walking them here
+constexpr size_t kParallelSubtreeThreshold = 64;
+constexpr size_t kSubtreesPerTask = 16;
+} // namespace
+
 void TransformSystem::onRegistered(GeneralManager& gm)
 {
 	std::cout << "TransformSystem registered!" << std::endl;
@@ -35,11 +45,40 @@ void TransformSystem::applyPendingToGlobal(GlobalTransformComponent* global)
 	global->_updateDirectionVectors();
 }
 
+void TransformSystem::commitPending(GlobalTransformComponent* global, LocalTransformComponent* local,
+                                    const GlobalTransformComponent* parent)
+{
+	if (!global->_wasExternallyModified) return;
+
+	applyPendingToGlobal(global);
+	global->_clearPending();
+	global->_isModelDirty = true;
+	if (!local) return;
+
+	// Local back-computed from the new global, as phase 1 of update does
+	if (parent)
+	{
+		local->_localScale = global->_globalScale / parent->_globalScale;
+		local->_localRotation = glm::normalize(glm::inverse(parent->_globalRotation) * global->_globalRotation);
+		local->_localPosition = glm::inverse(parent->_globalRotation) *
+		                        ((global->_globalPosition - parent->_globalPosition) / parent->_globalScale);
+	}
+	else
+	{
+		local->_localPosition = global->_globalPosition;
+		local->_localRotation = global->_globalRotation;
+		local->_localScale = global->_globalScale;
+	}
+	local->_updateDirectionVectors();
+	local->_isModelDirty = true; // Children pick the new pose up next update
+}
+
 void TransformSystem::update(GeneralManager& gm)
 {
 #ifdef TRACY_ENABLE
 	ZoneScopedN("TransformSystem");
 #endif
+	CpuProfileScope profileScope(gm, "TransformSystem");
 
 	struct StackItem
 	{
@@ -47,8 +86,9 @@ void TransformSystem::update(GeneralManager& gm)
 		bool isParentDirty;
 	};
 
-	std::vector<StackItem> nodeStack;
-	nodeStack.reserve(128);
+	// First child of every root that has any; the subtrees below them are disjoint
+	std::vector<StackItem> subtrees;
+	subtrees.reserve(128);
 
 	// === Root entities ===
 
@@ -89,56 +129,76 @@ void TransformSystem::update(GeneralManager& gm)
 			    dirty = true;
 		    }
 
-		    if (relationship.firstChild != NULL_ENTITY) nodeStack.push_back({relationship.firstChild, dirty});
+		    if (relationship.firstChild != NULL_ENTITY) subtrees.push_back({relationship.firstChild, dirty});
 	    });
 
 	// === Child entities (depth-first) ===
 
-	while (!nodeStack.empty())
+	// Each subtree only writes its own entities, so subtrees propagate in parallel
+	auto propagate = [&](size_t begin, size_t end)
 	{
-		StackItem item = nodeStack.back();
-		nodeStack.pop_back();
-
-		LocalTransformComponent* local = gm.getComponent<LocalTransformComponent>(item.entity);
-		GlobalTransformComponent* global = gm.getComponent<GlobalTransformComponent>(item.entity);
-		RelationshipComponent* rel = gm.getComponent<RelationshipComponent>(item.entity);
-		GlobalTransformComponent* pg = gm.getComponent<GlobalTransformComponent>(rel->parent);
-
-		bool dirty = false;
-
-		// Phase 1: apply global pending -> back-compute local from new global
-		if (global->_wasExternallyModified)
+		std::vector<StackItem> nodeStack;
+		nodeStack.reserve(64);
+		for (size_t subtree = begin; subtree < end; ++subtree)
 		{
-			applyPendingToGlobal(global);
-			local->_localScale = global->_globalScale / pg->_globalScale;
-			local->_localRotation = glm::normalize(glm::inverse(pg->_globalRotation) * global->_globalRotation);
-			local->_localPosition =
-			    glm::inverse(pg->_globalRotation) * ((global->_globalPosition - pg->_globalPosition) / pg->_globalScale);
-			local->_updateDirectionVectors();
-			global->_clearPending();
-			local->_isModelDirty = true;
-			dirty = true;
-		}
-
-		bool needsUpdate = local->_isModelDirty || item.isParentDirty;
-
-		// Phase 2: apply local pending -> propagate local -> global
-		if (needsUpdate)
-		{
-			if (local->_isModelDirty) applyPendingToLocal(local);
-
-			global->_globalScale = pg->_globalScale * local->_localScale;
-			global->_globalRotation = glm::normalize(pg->_globalRotation * local->_localRotation);
-			global->_globalPosition =
-			    pg->_globalPosition + (pg->_globalRotation * (pg->_globalScale * local->_localPosition));
-			global->_updateDirectionVectors();
-			global->_isModelDirty = true;
-			global->_isViewDirty = true;
-			local->_clearPending();
-			dirty = true;
+			nodeStack.push_back(subtrees[subtree]);
+			while (!nodeStack.empty())
+			{
+				StackItem item = nodeStack.back();
+				nodeStack.pop_back();
+
+				LocalTransformComponent* local = gm.getComponent<LocalTransformComponent>(item.entity);
+				GlobalTransformComponent* global = gm.getComponent<GlobalTransformComponent>(item.entity);
+				RelationshipComponent* rel = gm.getComponent<RelationshipComponent>(item.entity);
+				GlobalTransformComponent* pg = gm.getComponent<GlobalTransformComponent>(rel->parent);
+
+				bool dirty = false;
+
+				// Phase 1: apply global pending -> back-compute local from new global
+				if (global->_wasExternallyModified)
+				{
+					applyPendingToGlobal(global);
+					local->_localScale = global->_globalScale / pg->_globalScale;
+					local->_localRotation = glm::normalize(glm::inverse(pg->_globalRotation) * global->_globalRotation);
+					local->_localPosition = glm::inverse(pg->_globalRotation) *
+					                        ((global->_globalPosition - pg->_globalPosition) / pg->_globalScale);
+					local->_updateDirectionVectors();
+					global->_clearPending();
+					local->_isModelDirty = true;
+					dirty = true;
+				}
+
+				bool needsUpdate = local->_isModelDirty || item.isParentDirty;
+
+				// Phase 2: apply local pending -> propagate local -> global
+				if (needsUpdate)
+				{
+					if (local->_isModelDirty) applyPendingToLocal(local);
+
+					global->_globalScale = pg->_globalScale * local->_localScale;
+					global->_globalRotation = glm::normalize(pg->_globalRotation * local->_localRotation);
+					global->_globalPosition =
+					    pg->_globalPosition + (pg->_globalRotation * (pg->_globalScale * local->_localPosition));
+					global->_updateDirectionVectors();
+					global->_isModelDirty = true;
+					global->_isViewDirty = true;
+					local->_clearPending();
+					dirty = true;
+				}
+
+				if (rel->nextSibling != NULL_ENTITY) nodeStack.push_back({rel->nextSibling, item.isParentDirty});
+				if (rel->firstChild != NULL_ENTITY) nodeStack.push_back({rel->firstChild, dirty});
+			}
 		}
+	};
 
-		if (rel->nextSibling != NULL_ENTITY) nodeStack.push_back({rel->nextSibling, item.isParentDirty});
-		if (rel->firstChild != NULL_ENTITY) nodeStack.push_back({rel->firstChild, dirty});
+	if (subtrees.size() >= kParallelSubtreeThreshold)
+	{
+		TaskScheduler& scheduler = *gm.getContextComponent<TaskSchedulerContext, TaskSchedulerComponent>()->scheduler;
+		scheduler.parallelFor(subtrees.size(), kSubtreesPerTask, propagate);
+	}
+	else
+	{
+		propagate(0, subtrees.size());
 	}
 }
@@ -3,77 +3,171 @@
 #include <exception>
 #include <iostream>
 #include <thread>
+#include "GraphicsCore/Components/GraphicsSettingsComponent.hpp"
+#include "GraphicsCore/GraphicsContexts.hpp"
+#include "PhysicsCore/Components/PhysManagerComponent.hpp"
+#include "PhysicsCore/Components/PhysSettingsComponent.hpp"
 #include "PhysicsCore/Components/PhysTickRateComponent.hpp"
 #include "PhysicsCore/PhysContexts.hpp"
+#include "PhysicsCore/PhysTickGovernor.hpp"
 #include "PlatformCore/Components/WindowComponent.hpp"
 #include "PlatformCore/PlatformContexts.hpp"
 #include "PlatformCore/Window.hpp"
+#include "FrameProfiler.hpp"
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
 #endif
 
+namespace
+{
+using FrameClock = std::chrono::steady_clock;
+
+// Sleeps overshoot by up to the OS timer resolution, so the last stretch before the deadline is spun instead
+constexpr auto kLimiterSpinMargin = std::chrono::microseconds(2000);
+
+// Holds the start of the next frame until `nextFrameStart`. Runs before input is polled, so the wait lands between
+// frames rather than between sampling input and submitting it.
+void limitFrameRate(GeneralManager& gm, float frameRateLimit, FrameClock::time_point& nextFrameStart)
+{
+	const auto now = FrameClock::now();
+	if (frameRateLimit <= 0.0f)
+	{
+		nextFrameStart = now;
+		return;
+	}
+
+	CpuProfileScope profileScope(gm, "FrameLimiter");
+	const auto interval =
+	    std::chrono::duration_cast<FrameClock::duration>(std::chrono::duration<double>(1.0 / frameRateLimit));
+	nextFrameStart += interval;
+	// A hitch or a raised limit left the schedule behind; restart it instead of bursting frames to catch up
+	if (nextFrameStart < now)
+	{
+		nextFrameStart = now;
+		return;
+	}
+
+	if (nextFrameStart - now > kLimiterSpinMargin) std::this_thread::sleep_until(nextFrameStart - kLimiterSpinMargin);
+	while (FrameClock::now() < nextFrameStart) std::this_thread::yield();
+}
+
+// Deterministic mode: a fixed number of ticks at the start of every frame instead of on the wall clock, none ever
+// dropped. They are stamped with the frame's start so the renderer still has times to blend between.
+void stepPhysicsLockstep(GeneralManager& gm, PhysManager& physManager, uint32_t steps)
+{
+	const auto* tickRate = gm.getContextComponent<PhysTickRateContext, PhysTickRateComponent>();
+	const double frameStart = std::chrono::duration<double>(FrameClock::now().time_since_epoch()).count();
+	const float fixedDt = 1.0f / tickRate->rate;
+	for (uint32_t step = 0; step < steps; ++step)
+	{
+		// One fixed step apart, so the snapshots interpolation reads are never stamped with the same time
+		physManager.tickTime = frameStart + step * static_cast<double>(fixedDt);
+		physManager.tickDeltaTime = fixedDt;
+		physManager.tickCollisionSteps = tickRate->collisionSteps;
+		CpuProfileScope tickScope(gm, "PhysicsTick");
+		gm.update("physics");
+	}
+}
+} // namespace
+
 void MainLoop::startLoop(GeneralManager& gm)
 {
 #ifdef TRACY_ENABLE
 	tracy::SetThreadName("Main");
 #endif
 	Window* window = gm.getContextComponent<MainWindowContext, WindowComponent>()->windowInstance;
+	const auto* graphicsSettings = gm.getContextComponent<GraphicsSettingsContext, GraphicsSettingsComponent>();
+	const auto* physSettings = gm.getContextComponent<PhysSettingsContext, PhysSettingsComponent>();
+	PhysManager* physManager = gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager;
+	// Startups have added their bodies by now and the physics thread has not started, so nothing else touches them
+	if (physSettings->optimizeBroadPhase)
+	{
+		CpuProfileScope optimizeScope(gm, "OptimizeBroadPhase");
+		physManager->optimizeBroadPhase();
+	}
 	std::atomic<bool> physRunning{true};
 	std::exception_ptr physException;
 
-	std::jthread physThread(
-	    [&]
-	    {
+	// Deterministic mode ticks on this thread instead, see stepPhysicsLockstep
+	std::jthread physThread;
+	if (!physSettings->deterministic)
+	{
+		physThread = std::jthread(
+		    [&]
+		    {
 #ifdef TRACY_ENABLE
-		    tracy::SetThreadName("Physics");
+			    tracy::SetThreadName("Physics");
 #endif
-		    const auto* tickRate = gm.getContextComponent<PhysTickRateContext, PhysTickRateComponent>();
+			    const auto* tickRate = gm.getContextComponent<PhysTickRateContext, PhysTickRateComponent>();
+			    PhysTickGovernor governor;
 
-		    using clock = std::chrono::steady_clock;
-		    auto nextStepTime = clock::now() + std::chrono::duration_cast<clock::duration>(
-		                                           std::chrono::duration<double>(1.0 / tickRate->rate));
-		    int missedSteps = 0;
-		    try
-		    {
-			    while (physRunning.load(std::memory_order_relaxed))
+			    using clock = std::chrono::steady_clock;
+			    auto toDuration = [](double seconds)
+			    { return std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(seconds)); };
+			    auto nextStepTime = clock::now() + toDuration(governor.interval(*tickRate));
+			    int missedSteps = 0;
+			    try
 			    {
-				    std::this_thread::sleep_until(nextStepTime);
-				    gm.update("physics");
-
-				    const auto interval =
-				        std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / tickRate->rate));
-				    nextStepTime += interval;
-				    const auto now = clock::now();
-
-				    if (now > nextStepTime + interval)
+				    while (physRunning.load(std::memory_order_relaxed))
 				    {
-					    if (++missedSteps >= tickRate->maxConsecutiveMissedSteps)
+					    std::this_thread::sleep_until(nextStepTime);
+					    // Stamped with the scheduled time rather than the wake-up, so snapshots stay evenly spaced
+					    physManager->tickTime =
+					        std::chrono::duration<double>(nextStepTime.time_since_epoch()).count();
+					    physManager->tickDeltaTime = governor.deltaTime(*tickRate);
+					    physManager->tickCollisionSteps = governor.collisionSteps(*tickRate);
+					    const auto interval = toDuration(governor.interval(*tickRate));
+					    const auto workStart = clock::now();
+					    {
+						    CpuProfileScope tickScope(gm, "PhysicsTick");
+						    gm.update("physics");
+					    }
+					    const auto now = clock::now();
+					    nextStepTime += interval;
+
+					    const bool late = now > nextStepTime + interval;
+					    governor.onTick(*tickRate, std::chrono::duration<double>(now - workStart).count(), late);
+					    if (late)
+					    {
+						    double droppedSeconds = 0.0;
+						    // Still behind after this many: drop the missed ticks. An adaptive governor has already
+						    // slowed the rate down by then, unless it is at minRate.
+						    if (++missedSteps >= tickRate->maxConsecutiveMissedSteps)
+						    {
+							    droppedSeconds = std::chrono::duration<double>(now - nextStepTime).count();
+							    nextStepTime = now + toDuration(governor.interval(*tickRate));
+							    missedSteps = 0;
+						    }
+						    physManager->recordLateTick(droppedSeconds);
+					    }
+					    else
 					    {
-						    nextStepTime = now + interval;
 						    missedSteps = 0;
 					    }
 				    }
-				    else
-				    {
-					    missedSteps = 0;
-				    }
 			    }
-		    }
-		    catch (...)
-		    {
-			    physException = std::current_exception();
-			    physRunning.store(false, std::memory_order_relaxed);
-			    window->setShouldClose(true);
-		    }
-	    });
+			    catch (...)
+			    {
+				    physException = std::current_exception();
+				    physRunning.store(false, std::memory_order_relaxed);
+				    window->setShouldClose(true);
+			    }
+		    });
+	}
 
 	try
 	{
+		FrameClock::time_point nextFrameStart = FrameClock::now();
 		while (!window->shouldClose())
 		{
+			limitFrameRate(gm, graphicsSettings->frameRateLimit, nextFrameStart);
+			CpuProfileScope frameScope(gm, "Frame");
 			window->pollEvents();
+			if (physSettings->deterministic) stepPhysicsLockstep(gm, *physManager, physSettings->stepsPerFrame);
 			gm.update();
+			// Once this frame's transforms are final; AudioManager is main thread only
+			gm.update("audio");
 #ifdef TRACY_ENABLE
 			FrameMark;
 #endif
@@ -82,12 +176,12 @@ void MainLoop::startLoop(GeneralManager& gm)
 	catch (...)
 	{
 		physRunning.store(false, std::memory_order_relaxed);
-		physThread.join();
+		if (physThread.joinable()) physThread.join();
 		throw;
 	}
 
 	physRunning.store(false, std::memory_order_relaxed);
-	physThread.join();
+	if (physThread.joinable()) physThread.join();
 
 	if (physException)
 	{
@@ -1,54 +1,56 @@
 #include "PhysicsCore/Managers/PhysManager.hpp"
 #include "PhysicsCore/JoltGlm.hpp"
 #include <Jolt/Physics/Body/BodyCreationSettings.h>
-#include <Jolt/Physics/Collision/Shape/SphereShape.h>
-#include <Jolt/Physics/Collision/Shape/BoxShape.h>
-#include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
-#include <Jolt/Physics/Collision/Shape/CylinderShape.h>
-#include <Jolt/Physics/Collision/Shape/ConvexHullShape.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
 #include <stdexcept>
-#include <thread>
+#include <string>
 #include "DeletionQueueComponent.hpp"
 #include "DeletionQueueContext.hpp"
+#include "PhysicsCore/Components/PhysSettingsComponent.hpp"
+#include "PhysicsCore/PhysContexts.hpp"
+#include "PhysicsCore/PhysJobSystem.hpp"
+#include "TaskSchedulerComponent.hpp"
+#include "TaskSchedulerContext.hpp"
 
 PhysManager::PhysManager(GeneralManager& gm) : gm(&gm)
 {
 	DeletionQueue* dq = gm.getContextComponent<DeletionQueueContext, DeletionQueueComponent>()->queue;
+	const PhysSettingsComponent* settings = gm.getContextComponent<PhysSettingsContext, PhysSettingsComponent>();
 
-	tempAllocator = new JPH::TempAllocatorImpl(10 * 1024 * 1024);
+	layerTable.build(settings->layers);
+
+	tempAllocator = new JPH::TempAllocatorImpl(settings->tempAllocatorSize);
 	dq->push_function([ta = tempAllocator]() { delete ta; });
 
-	jobSystem = new JPH::JobSystemThreadPool(JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers,
-	                                         std::thread::hardware_concurrency() - 1);
+	TaskScheduler& scheduler = *gm.getContextComponent<TaskSchedulerContext, TaskSchedulerComponent>()->scheduler;
+	jobSystem = new PhysJobSystem(scheduler, JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
 	dq->push_function([js = jobSystem]() { delete js; });
 
 	physicsSystem = new JPH::PhysicsSystem();
 	dq->push_function([ps = physicsSystem]() { delete ps; });
 
-	physicsSystem->Init(4096, 0, 4096, 4096, sBroadPhaseLayerInterface, sObjectVsBroadPhaseLayerFilter,
-	                    sObjectLayerPairFilter);
-}
+	physicsSystem->Init(settings->maxBodies, settings->numBodyMutexes, settings->maxBodyPairs,
+	                    settings->maxContactConstraints, layerTable, layerTable, layerTable);
 
-JPH::BodyID PhysManager::createDynamicSphere(glm::vec3 pos, float radius)
-{
-	JPH::BodyCreationSettings dynamicSphere(new JPH::SphereShape(radius), toJolt(pos), JPH::Quat::sIdentity(),
-	                                        JPH::EMotionType::Dynamic, Layers::MOVING);
+	_rollback = PhysRollbackBuffer(settings->rollbackCapacity);
+	_rollbackInterval = std::max(1u, settings->rollbackInterval);
 
-	return physicsSystem->GetBodyInterface().CreateAndAddBody(dynamicSphere, JPH::EActivation::Activate);
+	if (!settings->recordPath.empty())
+	{
+		// Without lockstep, when commands and new bodies land depends on thread timing
+		if (settings->deterministic)
+			_recorder = std::make_unique<PhysRecorder>(settings->recordPath, *settings);
+		else
+			std::cout << "Warning: physics recording needs deterministic mode, not recording" << std::endl;
+	}
 }
 
-JPH::BodyID PhysManager::createStaticBox(glm::vec3 pos, glm::vec3 halfExtents)
+namespace
 {
-	JPH::BodyCreationSettings staticBox(new JPH::BoxShape(toJolt(halfExtents)), toJolt(pos), JPH::Quat::sIdentity(),
-	                                    JPH::EMotionType::Static, Layers::NON_MOVING);
-
-	return physicsSystem->GetBodyInterface().CreateAndAddBody(staticBox, JPH::EActivation::Activate);
-}
-
-JPH::BodyID PhysManager::createBody(const Body& body, const Shape& shape)
+JPH::BodyCreationSettings makeCreationSettings(const Body& body, const JPH::Shape* shape)
 {
-	JPH::Shape* jShape = makeJoltShape(shape);
-
 	JPH::EMotionType motion = JPH::EMotionType::Dynamic;
 	switch (body.motion)
 	{
@@ -63,42 +65,196 @@ JPH::BodyID PhysManager::createBody(const Body& body, const Shape& shape)
 		break;
 	}
 
-	JPH::BodyCreationSettings settings(jShape, toJolt(body.pos), toJolt(body.rot), motion, body.layer);
+	JPH::BodyCreationSettings settings(shape, toJolt(body.pos), toJolt(body.rot), motion, body.layer);
 	settings.mFriction = body.friction;
 	settings.mRestitution = body.restitution;
+	return settings;
+}
+
+JPH::EActivation activationFor(const Body& body)
+{
+	return (body.motion == Motion::Static) ? JPH::EActivation::DontActivate : JPH::EActivation::Activate;
+}
+} // namespace
+
+JPH::BodyID PhysManager::createDynamicSphere(glm::vec3 pos, float radius)
+{
+	return createBody(Body{.pos = pos, .motion = Motion::Dynamic, .layer = Layers::MOVING}, Sphere{radius});
+}
+
+JPH::BodyID PhysManager::createStaticBox(glm::vec3 pos, glm::vec3 halfExtents)
+{
+	return createBody(Body{.pos = pos, .motion = Motion::Static, .layer = Layers::NON_MOVING}, Box{halfExtents});
+}
+
+JPH::BodyID PhysManager::createBody(const Body& body, const Shape& shape)
+{
+	return createBody(body, shapeCache.get(shape));
+}
+
+JPH::BodyID PhysManager::createBody(const Body& body, ShapeHandle shape)
+{
+	JPH::RefConst<JPH::Shape> jShape = requireShape(shape);
+	const JPH::BodyCreationSettings creationSettings = makeCreationSettings(body, jShape);
+	const JPH::EActivation activation = activationFor(body);
+	JPH::BodyID id = physicsSystem->GetBodyInterface().CreateAndAddBody(creationSettings, activation);
+	if (id.IsInvalid()) throw std::runtime_error("Out of physics bodies, raise PhysSettingsComponent::maxBodies");
+	if (_recorder) _recorder->recordBodies({&id, 1}, {&creationSettings, 1}, activation);
+	return id;
+}
+
+std::vector<JPH::BodyID> PhysManager::createBodies(std::span<const Body> bodies, ShapeHandle shape)
+{
+	JPH::RefConst<JPH::Shape> jShape = requireShape(shape);
+	JPH::BodyInterface& bodyInterface = physicsSystem->GetBodyInterface();
+
+	std::vector<JPH::BodyID> ids;
+	ids.reserve(bodies.size());
+	// One batch per activation state; AddBodiesPrepare also reorders the array it is given
+	std::vector<JPH::BodyID> asleep;
+	std::vector<JPH::BodyID> awake;
+	std::vector<JPH::BodyCreationSettings> asleepSettings; // Kept for the recorder only
+	std::vector<JPH::BodyCreationSettings> awakeSettings;
+	for (const Body& body : bodies)
+	{
+		JPH::BodyCreationSettings creationSettings = makeCreationSettings(body, jShape);
+		JPH::Body* created = bodyInterface.CreateBody(creationSettings);
+		if (!created)
+		{
+			if (!ids.empty()) bodyInterface.DestroyBodies(ids.data(), static_cast<int>(ids.size()));
+			throw std::runtime_error("Out of physics bodies, raise PhysSettingsComponent::maxBodies");
+		}
+		ids.push_back(created->GetID());
+		const bool activate = activationFor(body) == JPH::EActivation::Activate;
+		(activate ? awake : asleep).push_back(created->GetID());
+		if (_recorder) (activate ? awakeSettings : asleepSettings).push_back(std::move(creationSettings));
+	}
+
+	auto addBatch = [&](std::vector<JPH::BodyID>& batch, const std::vector<JPH::BodyCreationSettings>& settings,
+	                    JPH::EActivation activation)
+	{
+		if (batch.empty()) return;
+		// Before AddBodiesPrepare reorders the batch; the replay hands it the same order
+		if (_recorder) _recorder->recordBodies(batch, settings, activation);
+		const int count = static_cast<int>(batch.size());
+		JPH::BodyInterface::AddState state = bodyInterface.AddBodiesPrepare(batch.data(), count);
+		bodyInterface.AddBodiesFinalize(batch.data(), count, state, activation);
+	};
+	addBatch(asleep, asleepSettings, JPH::EActivation::DontActivate);
+	addBatch(awake, awakeSettings, JPH::EActivation::Activate);
+	return ids;
+}
+
+void PhysManager::submit(const PhysCommand& command)
+{
+	std::lock_guard<std::mutex> lock(_commandMutex);
+	_commands.push_back(command);
+}
 
-	JPH::EActivation activation =
-	    (body.motion == Motion::Static) ? JPH::EActivation::DontActivate : JPH::EActivation::Activate;
-
-	return physicsSystem->GetBodyInterface().CreateAndAddBody(settings, activation);
-}
-
-JPH::Shape* PhysManager::makeJoltShape(const Shape& shape)
-{
-	return std::visit(
-	    [](const auto& s) -> JPH::Shape*
-	    {
-		    using T = std::decay_t<decltype(s)>;
-		    if constexpr (std::is_same_v<T, Sphere>)
-			    return new JPH::SphereShape(s.radius);
-		    else if constexpr (std::is_same_v<T, Box>)
-			    return new JPH::BoxShape(toJolt(s.halfExtents));
-		    else if constexpr (std::is_same_v<T, Capsule>)
-			    return new JPH::CapsuleShape(s.halfHeight, s.radius);
-		    else if constexpr (std::is_same_v<T, Cylinder>)
-			    return new JPH::CylinderShape(s.halfHeight, s.radius);
-		    else if constexpr (std::is_same_v<T, ConvexHull>)
-		    {
-			    JPH::Array<JPH::Vec3> pts;
-			    pts.reserve(s.points.size());
-			    for (const glm::vec3& p : s.points) pts.push_back(toJolt(p));
-
-			    JPH::ConvexHullShapeSettings settings(pts);
-			    JPH::ShapeSettings::ShapeResult result = settings.Create();
-			    if (result.HasError())
-				    throw std::runtime_error(std::string("ConvexHull build failed: ") + result.GetError().c_str());
-			    return result.Get();
-		    }
-	    },
-	    shape);
-}
\ No newline at end of file
+void PhysManager::step(float deltaTime, int collisionSteps)
+{
+	{
+		std::lock_guard<std::mutex> lock(_commandMutex);
+		_stepCommands.swap(_commands);
+	}
+	applyPhysCommands(physicsSystem->GetBodyInterface(), _stepCommands);
+
+	const auto updateStart = std::chrono::steady_clock::now();
+	physicsSystem->Update(deltaTime, collisionSteps, tempAllocator, jobSystem);
+	const float stepMs =
+	    std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - updateStart).count();
+	++tick;
+
+	{
+		std::lock_guard<std::mutex> lock(_metricsMutex);
+		// Weighted so the average spans about a second of ticks at any rate
+		const float weight = std::clamp(deltaTime, 0.01f, 1.0f);
+		_metrics.avgStepMs = _metrics.ticks == 0 ? stepMs : _metrics.avgStepMs + (stepMs - _metrics.avgStepMs) * weight;
+		_metrics.lastStepMs = stepMs;
+		_metrics.ticks = tick;
+		_metrics.tickRate = 1.0f / deltaTime;
+		_metrics.collisionSteps = collisionSteps;
+		_metrics.activeBodies = physicsSystem->GetNumActiveBodies(JPH::EBodyType::RigidBody);
+		_metrics.bodies = physicsSystem->GetNumBodies();
+	}
+
+	if (_recorder) _recorder->recordTick(deltaTime, collisionSteps, _stepCommands, *physicsSystem);
+	if (_rollback.capacity() > 0 && tick % _rollbackInterval == 0) _rollback.save(tick, *physicsSystem);
+	_stepCommands.clear();
+}
+
+SnapshotIndices PhysManager::pinSnapshots()
+{
+	// Pinned, then checked to still be published: the writer either saw the pins before it picked a slot, or had
+	// not published over these snapshots yet when the check ran. Both sides are sequentially consistent for that.
+	SnapshotIndices indices = physSnapshot.load();
+	while (true)
+	{
+		_pinnedSnapshots.store((1u << indices.previous) | (1u << indices.current));
+		const SnapshotIndices published = physSnapshot.load();
+		if (published.previous == indices.previous && published.current == indices.current) return indices;
+		indices = published;
+	}
+}
+
+void PhysManager::unpinSnapshots()
+{
+	_pinnedSnapshots.store(0, std::memory_order_release);
+}
+
+uint8_t PhysManager::freeSnapshotSlot() const
+{
+	const SnapshotIndices indices = physSnapshot.load(std::memory_order_relaxed);
+	const uint32_t busy = _pinnedSnapshots.load() | (1u << indices.previous) | (1u << indices.current);
+	for (uint8_t slot = 0; slot < maxSnapshots; ++slot)
+	{
+		if (!(busy & (1u << slot))) return slot;
+	}
+	throw std::runtime_error("No free physics snapshot slot");
+}
+
+uint64_t PhysManager::oldestPinnedTick() const
+{
+	const uint32_t pinned = _pinnedSnapshots.load(std::memory_order_acquire);
+	uint64_t oldest = UINT64_MAX;
+	for (uint8_t slot = 0; slot < maxSnapshots; ++slot)
+	{
+		if (pinned & (1u << slot)) oldest = std::min(oldest, snapshots[slot].tick);
+	}
+	return oldest;
+}
+
+PhysMetrics PhysManager::metrics() const
+{
+	std::lock_guard<std::mutex> lock(_metricsMutex);
+	return _metrics;
+}
+
+void PhysManager::recordLateTick(double droppedSeconds)
+{
+	std::lock_guard<std::mutex> lock(_metricsMutex);
+	++_metrics.lateTicks;
+	_metrics.droppedSeconds += droppedSeconds;
+}
+
+void PhysManager::optimizeBroadPhase()
+{
+	physicsSystem->OptimizeBroadPhase();
+	if (_recorder) _recorder->recordOptimizeBroadPhase();
+}
+
+bool PhysManager::rollbackTo(uint64_t target)
+{
+	if (!_rollback.restore(target, *physicsSystem)) return false;
+	if (_recorder) _recorder->recordRollback(target);
+	tick = target;
+	stateRestored = true;
+	return true;
+}
+
+JPH::RefConst<JPH::Shape> PhysManager::requireShape(ShapeHandle shape) const
+{
+	JPH::RefConst<JPH::Shape> jShape = shapeCache.shape(shape);
+	if (!jShape) throw std::runtime_error("Physics shape " + std::to_string(shape.id) + " is not ready");
+	return jShape;
+}
@@ -0,0 +1,270 @@
+#include "PhysicsCore/Managers/PhysSceneQueries.hpp"
+#include "PhysicsCore/JoltGlm.hpp"
+#include <Jolt/Physics/Body/BodyLock.h>
+#include <Jolt/Physics/Collision/CastResult.h>
+#include <Jolt/Physics/Collision/CollideShape.h>
+#include <Jolt/Physics/Collision/CollisionCollectorImpl.h>
+#include <Jolt/Physics/Collision/RayCast.h>
+#include <Jolt/Physics/Collision/ShapeCast.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+#include <algorithm>
+#include <bitset>
+#include <type_traits>
+
+#ifdef TRACY_ENABLE
+#include <tracy/Tracy.hpp>
+#endif
+
+namespace
+{
+// Queries per task: enough work to pay for the hand-off, small enough that thousands spread over every worker
+constexpr size_t kRaysPerTask = 64;
+constexpr size_t kShapeQueriesPerTask = 16;
+
+class LayerMaskFilter final : public JPH::ObjectLayerFilter
+{
+public:
+	explicit LayerMaskFilter(uint64_t mask) : _mask(mask) {}
+
+	bool ShouldCollide(JPH::ObjectLayer inLayer) const override
+	{
+		return inLayer < 64 && ((_mask >> inLayer) & 1) != 0;
+	}
+
+private:
+	uint64_t _mask;
+};
+
+// Broad-phase trees holding at least one of the masked object layers
+class BroadPhaseMaskFilter final : public JPH::BroadPhaseLayerFilter
+{
+public:
+	BroadPhaseMaskFilter(const PhysLayerTable& layers, uint64_t mask)
+	{
+		const uint32_t count = std::min<uint32_t>(layers.numObjectLayers(), 64);
+		for (uint32_t layer = 0; layer < count; ++layer)
+		{
+			if ((mask >> layer) & 1)
+				_allowed.set(static_cast<JPH::BroadPhaseLayer::Type>(
+				    layers.GetBroadPhaseLayer(static_cast<JPH::ObjectLayer>(layer))));
+		}
+	}
+
+	bool ShouldCollide(JPH::BroadPhaseLayer inLayer) const override
+	{
+		return _allowed.test(static_cast<JPH::BroadPhaseLayer::Type>(inLayer));
+	}
+
+private:
+	std::bitset<256> _allowed;
+};
+
+JPH::RVec3 toJoltPoint(const glm::vec3& v)
+{
+	return JPH::RVec3(v.x, v.y, v.z);
+}
+
+glm::vec3 toGlmPoint(JPH::RVec3Arg v)
+{
+	return glm::vec3(static_cast<float>(v.GetX()), static_cast<float>(v.GetY()), static_cast<float>(v.GetZ()));
+}
+
+// Not taken from PhysShapeCache: query sizes vary freely and would pile up there for the lifetime of the world
+JPH::RefConst<JPH::Shape> makeQueryShape(const PhysQueryShape& shape)
+{
+	return std::visit(
+	    [](const auto& s) -> JPH::RefConst<JPH::Shape>
+	    {
+		    using T = std::decay_t<decltype(s)>;
+		    if constexpr (std::is_same_v<T, Sphere>)
+			    return new JPH::SphereShape(s.radius);
+		    else
+			    return new JPH::BoxShape(toJolt(s.halfExtents));
+	    },
+	    shape);
+}
+
+// User data is the agent slot + 1 (PhysSnapshotSystem), resolved through the snapshot published with this tick
+Orhescyon::Entity entityOf(const JPH::Body& body, const PhysSnapshot& snapshot)
+{
+	const JPH::uint64 userData = body.GetUserData();
+	if (userData == 0 || userData > snapshot.entities.size()) return Orhescyon::Entity::invalid();
+	return snapshot.entities[userData - 1];
+}
+} // namespace
+
+PhysQueryTicket PhysSceneQueries::submit(PhysQueryBatch batch)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	const uint64_t ticket = _nextTicket++;
+	_submitted.push_back({ticket, std::move(batch)});
+	return PhysQueryTicket{ticket};
+}
+
+bool PhysSceneQueries::fetch(PhysQueryTicket ticket, PhysQueryResults& out)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _completed.find(ticket.id);
+	if (it == _completed.end()) return false;
+	out = std::move(it->second);
+	_completed.erase(it);
+	return true;
+}
+
+void PhysSceneQueries::execute(JPH::PhysicsSystem& physicsSystem, const PhysLayerTable& layers,
+                               TaskScheduler& scheduler, const PhysSnapshot& snapshot)
+{
+	_running.clear();
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_running.swap(_submitted);
+	}
+
+	for (Submitted& submitted : _running)
+	{
+		PhysQueryResults results;
+		run(physicsSystem, layers, scheduler, snapshot, submitted.batch, results);
+		results.tick = snapshot.tick;
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_completed[submitted.ticket] = std::move(results);
+	}
+}
+
+void PhysSceneQueries::run(JPH::PhysicsSystem& physicsSystem, const PhysLayerTable& layers, TaskScheduler& scheduler,
+                           const PhysSnapshot& snapshot, const PhysQueryBatch& batch, PhysQueryResults& results)
+{
+#ifdef TRACY_ENABLE
+	ZoneScopedN("PhysSceneQueries::run");
+#endif
+	const JPH::NarrowPhaseQuery& query = physicsSystem.GetNarrowPhaseQuery();
+	const JPH::BodyLockInterface& locks = physicsSystem.GetBodyLockInterface();
+
+	// === Rays ===
+	results.rayHits.assign(batch.rays.size(), PhysQueryHit{});
+	scheduler.parallelFor(
+	    batch.rays.size(), kRaysPerTask,
+	    [&](size_t begin, size_t end)
+	    {
+		    for (size_t i = begin; i < end; ++i)
+		    {
+			    const PhysRayQuery& ray = batch.rays[i];
+			    const JPH::RRayCast cast(toJoltPoint(ray.origin), toJolt(ray.direction * ray.maxDistance));
+			    JPH::RayCastResult hit;
+			    if (!query.CastRay(cast, hit, BroadPhaseMaskFilter(layers, ray.layerMask),
+			                       LayerMaskFilter(ray.layerMask)))
+				    continue;
+
+			    JPH::BodyLockRead lock(locks, hit.mBodyID);
+			    if (!lock.Succeeded()) continue;
+			    const JPH::RVec3 point = cast.GetPointOnRay(hit.mFraction);
+			    PhysQueryHit& out = results.rayHits[i];
+			    out.body = hit.mBodyID;
+			    out.entity = entityOf(lock.GetBody(), snapshot);
+			    out.distance = hit.mFraction * ray.maxDistance;
+			    out.position = toGlmPoint(point);
+			    out.normal = toGlm(lock.GetBody().GetWorldSpaceSurfaceNormal(hit.mSubShapeID2, point));
+		    }
+	    },
+	    TaskPriority::Normal);
+
+	// === Shape casts ===
+	std::vector<JPH::RefConst<JPH::Shape>> castShapes;
+	castShapes.reserve(batch.casts.size());
+	for (const PhysShapeCastQuery& cast : batch.casts) castShapes.push_back(makeQueryShape(cast.shape));
+
+	results.castHits.assign(batch.casts.size(), PhysQueryHit{});
+	scheduler.parallelFor(
+	    batch.casts.size(), kShapeQueriesPerTask,
+	    [&](size_t begin, size_t end)
+	    {
+		    JPH::ShapeCastSettings settings;
+		    for (size_t i = begin; i < end; ++i)
+		    {
+			    const PhysShapeCastQuery& cast = batch.casts[i];
+			    const JPH::RShapeCast shapeCast(
+			        castShapes[i], JPH::Vec3::sReplicate(1.0f),
+			        JPH::RMat44::sRotationTranslation(toJolt(cast.rotation), toJoltPoint(cast.origin)),
+			        toJolt(cast.direction * cast.maxDistance));
+			    JPH::ClosestHitCollisionCollector<JPH::CastShapeCollector> collector;
+			    query.CastShape(shapeCast, settings, JPH::RVec3::sZero(), collector,
+			                    BroadPhaseMaskFilter(layers, cast.layerMask), LayerMaskFilter(cast.layerMask));
+			    if (!collector.HadHit()) continue;
+
+			    const JPH::ShapeCastResult& hit = collector.mHit;
+			    JPH::BodyLockRead lock(locks, hit.mBodyID2);
+			    if (!lock.Succeeded()) continue;
+			    PhysQueryHit& out = results.castHits[i];
+			    out.body = hit.mBodyID2;
+			    out.entity = entityOf(lock.GetBody(), snapshot);
+			    out.distance = hit.mFraction * cast.maxDistance;
+			    out.position = toGlm(hit.mContactPointOn2);
+			    if (!hit.mPenetrationAxis.IsNearZero()) out.normal = toGlm(-hit.mPenetrationAxis.Normalized());
+		    }
+	    },
+	    TaskPriority::Normal);
+
+	// === Overlaps ===
+	// Each overlap writes into a window of maxHits, compacted afterwards so the result stays dense
+	std::vector<JPH::RefConst<JPH::Shape>> overlapShapes;
+	overlapShapes.reserve(batch.overlaps.size());
+	std::vector<uint32_t> windows(batch.overlaps.size() + 1, 0);
+	for (size_t i = 0; i < batch.overlaps.size(); ++i)
+	{
+		overlapShapes.push_back(makeQueryShape(batch.overlaps[i].shape));
+		windows[i + 1] = windows[i] + batch.overlaps[i].maxHits;
+	}
+
+	results.overlapRanges.assign(batch.overlaps.size(), PhysOverlapRange{});
+	results.overlapBodies.assign(windows.back(), JPH::BodyID());
+	results.overlapEntities.assign(windows.back(), Orhescyon::Entity::invalid());
+	scheduler.parallelFor(
+	    batch.overlaps.size(), kShapeQueriesPerTask,
+	    [&](size_t begin, size_t end)
+	    {
+		    JPH::CollideShapeSettings settings;
+		    JPH::AllHitCollisionCollector<JPH::CollideShapeCollector> collector;
+		    for (size_t i = begin; i < end; ++i)
+		    {
+			    const PhysOverlapQuery& overlap = batch.overlaps[i];
+			    collector.Reset();
+			    query.CollideShape(
+			        overlapShapes[i], JPH::Vec3::sReplicate(1.0f),
+			        JPH::RMat44::sRotationTranslation(toJolt(overlap.rotation), toJoltPoint(overlap.position)), settings,
+			        JPH::RVec3::sZero(), collector, BroadPhaseMaskFilter(layers, overlap.layerMask),
+			        LayerMaskFilter(overlap.layerMask));
+
+			    PhysOverlapRange& range = results.overlapRanges[i];
+			    range.first = windows[i];
+			    for (const JPH::CollideShapeResult& hit : collector.mHits)
+			    {
+				    if (range.count == overlap.maxHits) break;
+				    JPH::BodyID* bodies = &results.overlapBodies[range.first];
+				    // Compound shapes report a hit per sub-shape
+				    if (std::find(bodies, bodies + range.count, hit.mBodyID2) != bodies + range.count) continue;
+
+				    JPH::BodyLockRead lock(locks, hit.mBodyID2);
+				    if (!lock.Succeeded()) continue;
+				    bodies[range.count] = hit.mBodyID2;
+				    results.overlapEntities[range.first + range.count] = entityOf(lock.GetBody(), snapshot);
+				    ++range.count;
+			    }
+		    }
+	    },
+	    TaskPriority::Normal);
+
+	uint32_t packed = 0;
+	for (PhysOverlapRange& range : results.overlapRanges)
+	{
+		for (uint32_t i = 0; i < range.count; ++i)
+		{
+			results.overlapBodies[packed + i] = results.overlapBodies[range.first + i];
+			results.overlapEntities[packed + i] = results.overlapEntities[range.first + i];
+		}
+		range.first = packed;
+		packed += range.count;
+	}
+	results.overlapBodies.resize(packed);
+	results.overlapEntities.resize(packed);
+}
@@ -0,0 +1,328 @@
+#include "PhysicsCore/Managers/PhysShapeCache.hpp"
+#include "PhysicsCore/JoltGlm.hpp"
+#include <Jolt/Core/StreamWrapper.h>
+#include <Jolt/Geometry/IndexedTriangle.h>
+#include <Jolt/Physics/Collision/Shape/BoxShape.h>
+#include <Jolt/Physics/Collision/Shape/CapsuleShape.h>
+#include <Jolt/Physics/Collision/Shape/ConvexHullShape.h>
+#include <Jolt/Physics/Collision/Shape/CylinderShape.h>
+#include <Jolt/Physics/Collision/Shape/MeshShape.h>
+#include <Jolt/Physics/Collision/Shape/SphereShape.h>
+#include <Jolt/Physics/Collision/Shape/StaticCompoundShape.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#ifdef TRACY_ENABLE
+#include <tracy/Tracy.hpp>
+#endif
+
+namespace
+{
+constexpr char kCookedMagic[4] = {'H', 'C', 'O', 'L'};
+// Bump when the cooking changes or Jolt's binary shape format does; older files are then cooked again
+constexpr uint32_t kCookedVersion = 1;
+
+template <typename T> void appendBytes(std::string& key, const T& value)
+{
+	key.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// Magic and version only; checked before a load is queued so an outdated file is cooked again instead
+bool readCookedHeader(std::istream& file)
+{
+	char magic[4];
+	uint32_t version = 0;
+	if (!file.read(magic, sizeof(magic)) || std::memcmp(magic, kCookedMagic, sizeof(magic)) != 0) return false;
+	return file.read(reinterpret_cast<char*>(&version), sizeof(version)) && version == kCookedVersion;
+}
+
+JPH::RefConst<JPH::Shape> takeResult(const JPH::ShapeSettings::ShapeResult& result, const char* what)
+{
+	if (result.HasError()) throw std::runtime_error(std::string(what) + " build failed: " + result.GetError().c_str());
+	return result.Get();
+}
+} // namespace
+
+PhysShapeCache::PhysShapeCache()
+{
+	_workerThread = std::jthread([this](std::stop_token stopToken) { workerLoop(stopToken); });
+}
+
+PhysShapeCache::~PhysShapeCache()
+{
+	_workerThread.request_stop();
+	_workerCv.notify_all();
+	if (_workerThread.joinable()) _workerThread.join();
+}
+
+ShapeHandle PhysShapeCache::get(const Shape& shape)
+{
+	std::string key = shapeKey(shape);
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto it = _shapeKeys.find(key);
+		if (it != _shapeKeys.end()) return it->second;
+	}
+
+	JPH::RefConst<JPH::Shape> joltShape = std::visit(
+	    [](const auto& s) -> JPH::RefConst<JPH::Shape>
+	    {
+		    using T = std::decay_t<decltype(s)>;
+		    if constexpr (std::is_same_v<T, Sphere>)
+			    return new JPH::SphereShape(s.radius);
+		    else if constexpr (std::is_same_v<T, Box>)
+			    return new JPH::BoxShape(toJolt(s.halfExtents));
+		    else if constexpr (std::is_same_v<T, Capsule>)
+			    return new JPH::CapsuleShape(s.halfHeight, s.radius);
+		    else if constexpr (std::is_same_v<T, Cylinder>)
+			    return new JPH::CylinderShape(s.halfHeight, s.radius);
+		    else if constexpr (std::is_same_v<T, ConvexHull>)
+		    {
+			    JPH::Array<JPH::Vec3> pts;
+			    pts.reserve(s.points.size());
+			    for (const glm::vec3& p : s.points) pts.push_back(toJolt(p));
+			    return takeResult(JPH::ConvexHullShapeSettings(pts).Create(), "ConvexHull");
+		    }
+	    },
+	    shape);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	// Another thread may have built the same shape meanwhile; keep the first so handles stay unique per key
+	auto [it, inserted] = _shapeKeys.try_emplace(key);
+	if (inserted) it->second = addEntry(ShapeState::Ready, joltShape);
+	return it->second;
+}
+
+ShapeHandle PhysShapeCache::requestMesh(const std::filesystem::path& sourcePath, MeshColliderKind kind,
+                                        const std::function<MeshColliderGeometry()>& readGeometry)
+{
+	CookJob job;
+	job.kind = kind;
+	job.cachePath = cachePath(sourcePath, kind);
+	const std::string key = job.cachePath.generic_string();
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto it = _shapeKeys.find(key);
+		if (it != _shapeKeys.end()) return it->second;
+	}
+
+	std::error_code ec;
+	auto cacheTime = std::filesystem::last_write_time(job.cachePath, ec);
+	if (!ec)
+	{
+		auto sourceTime = std::filesystem::last_write_time(sourcePath, ec);
+		std::ifstream file(job.cachePath, std::ios::binary);
+		job.fromCache = (ec || sourceTime <= cacheTime) && readCookedHeader(file);
+	}
+	if (!job.fromCache) job.geometry = readGeometry();
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto [it, inserted] = _shapeKeys.try_emplace(key);
+	if (!inserted) return it->second;
+	it->second = addEntry(ShapeState::Pending, nullptr);
+	job.shapeId = it->second.id;
+	_jobs.push_back(std::move(job));
+	_workerCv.notify_one();
+	return it->second;
+}
+
+ShapeState PhysShapeCache::state(ShapeHandle handle) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (handle.id < 0 || handle.id >= static_cast<int>(_entries.size())) return ShapeState::Failed;
+	return _entries[handle.id].state;
+}
+
+JPH::RefConst<JPH::Shape> PhysShapeCache::shape(ShapeHandle handle) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	if (handle.id < 0 || handle.id >= static_cast<int>(_entries.size())) return nullptr;
+	return _entries[handle.id].shape;
+}
+
+std::filesystem::path PhysShapeCache::cachePath(const std::filesystem::path& sourcePath, MeshColliderKind kind)
+{
+	const char* tag = "mesh";
+	switch (kind)
+	{
+	case MeshColliderKind::TriangleMesh:
+		tag = "mesh";
+		break;
+	case MeshColliderKind::ConvexHull:
+		tag = "hull";
+		break;
+	case MeshColliderKind::ConvexPerPrimitive:
+		tag = "hulls";
+		break;
+	}
+	return std::filesystem::path(sourcePath.generic_string() + "." + tag + ".joltshape");
+}
+
+ShapeHandle PhysShapeCache::addEntry(ShapeState state, JPH::RefConst<JPH::Shape> shape)
+{
+	_entries.push_back({std::move(shape), state});
+	return ShapeHandle{static_cast<int>(_entries.size() - 1)};
+}
+
+void PhysShapeCache::workerLoop(std::stop_token stopToken)
+{
+#ifdef TRACY_ENABLE
+	tracy::SetThreadName("PhysShapeCooker");
+#endif
+	while (!stopToken.stop_requested())
+	{
+		CookJob job;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			if (!_workerCv.wait(lock, stopToken, [this] { return !_jobs.empty(); })) return;
+			job = std::move(_jobs.front());
+			_jobs.pop_front();
+		}
+
+		JPH::RefConst<JPH::Shape> cooked;
+		try
+		{
+			if (job.fromCache)
+				cooked = loadCooked(job.cachePath);
+			else
+			{
+				cooked = cook(job);
+				writeCooked(job.cachePath, *cooked);
+			}
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "ERROR::PHYSSHAPECACHE::" << job.cachePath.generic_string() << ": " << e.what() << std::endl;
+		}
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_entries[job.shapeId].shape = cooked;
+		_entries[job.shapeId].state = cooked ? ShapeState::Ready : ShapeState::Failed;
+	}
+}
+
+JPH::RefConst<JPH::Shape> PhysShapeCache::cook(const CookJob& job)
+{
+#ifdef TRACY_ENABLE
+	ZoneScopedN("PhysShapeCache::cook");
+#endif
+	const MeshColliderGeometry& geometry = job.geometry;
+	if (geometry.positions.empty() || geometry.indices.size() < 3)
+		throw std::runtime_error("mesh collider has no triangles");
+	for (uint32_t index : geometry.indices)
+		if (index >= geometry.positions.size()) throw std::runtime_error("mesh collider index out of range");
+
+	switch (job.kind)
+	{
+	case MeshColliderKind::TriangleMesh:
+	{
+		JPH::VertexList vertices;
+		vertices.reserve(geometry.positions.size());
+		for (const glm::vec3& p : geometry.positions) vertices.push_back(JPH::Float3(p.x, p.y, p.z));
+		JPH::IndexedTriangleList triangles;
+		triangles.reserve(geometry.indices.size() / 3);
+		for (size_t i = 0; i + 2 < geometry.indices.size(); i += 3)
+			triangles.push_back(
+			    JPH::IndexedTriangle(geometry.indices[i], geometry.indices[i + 1], geometry.indices[i + 2]));
+		return takeResult(JPH::MeshShapeSettings(std::move(vertices), std::move(triangles)).Create(), "MeshShape");
+	}
+	case MeshColliderKind::ConvexHull:
+	{
+		JPH::Array<JPH::Vec3> pts;
+		pts.reserve(geometry.positions.size());
+		for (const glm::vec3& p : geometry.positions) pts.push_back(toJolt(p));
+		return takeResult(JPH::ConvexHullShapeSettings(pts).Create(), "ConvexHull");
+	}
+	case MeshColliderKind::ConvexPerPrimitive:
+	{
+		JPH::StaticCompoundShapeSettings compound;
+		size_t first = 0;
+		for (uint32_t count : geometry.primitiveIndexCounts)
+		{
+			JPH::Array<JPH::Vec3> pts;
+			pts.reserve(count);
+			for (size_t i = first; i < first + count && i < geometry.indices.size(); ++i)
+				pts.push_back(toJolt(geometry.positions[geometry.indices[i]]));
+			first += count;
+			if (pts.size() < 4) continue;
+			compound.AddShape(JPH::Vec3::sZero(), JPH::Quat::sIdentity(), new JPH::ConvexHullShapeSettings(pts));
+		}
+		return takeResult(compound.Create(), "ConvexPerPrimitive");
+	}
+	}
+	throw std::runtime_error("unknown mesh collider kind");
+}
+
+JPH::RefConst<JPH::Shape> PhysShapeCache::loadCooked(const std::filesystem::path& cachePath)
+{
+	std::ifstream file(cachePath, std::ios::binary);
+	if (!file) return nullptr;
+
+	if (!readCookedHeader(file)) return nullptr;
+
+	JPH::StreamInWrapper in(file);
+	JPH::Shape::IDToShapeMap shapeMap;
+	JPH::Shape::IDToMaterialMap materialMap;
+	JPH::Shape::ShapeResult result = JPH::Shape::sRestoreWithChildren(in, shapeMap, materialMap);
+	if (result.HasError())
+		throw std::runtime_error(std::string("cooked shape unreadable: ") + result.GetError().c_str());
+	return result.Get();
+}
+
+void PhysShapeCache::writeCooked(const std::filesystem::path& cachePath, const JPH::Shape& shape)
+{
+	std::ostringstream stream(std::ios::binary);
+	stream.write(kCookedMagic, sizeof(kCookedMagic));
+	stream.write(reinterpret_cast<const char*>(&kCookedVersion), sizeof(kCookedVersion));
+	JPH::StreamOutWrapper out(stream);
+	JPH::Shape::ShapeToIDMap shapeMap;
+	JPH::Shape::MaterialToIDMap materialMap;
+	shape.SaveWithChildren(out, shapeMap, materialMap);
+	const std::string data = stream.str();
+
+	// Write-then-rename so a crash or a parallel run never leaves a truncated cache behind
+	std::filesystem::path tmpPath = cachePath;
+	tmpPath += ".tmp";
+	{
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!file || !file.write(data.data(), static_cast<std::streamsize>(data.size())))
+		{
+			std::cout << "Warning: could not write collider cache " << cachePath.generic_string() << std::endl;
+			return;
+		}
+	}
+	std::error_code ec;
+	std::filesystem::rename(tmpPath, cachePath, ec);
+	if (ec)
+	{
+		std::filesystem::remove(tmpPath, ec);
+		std::cout << "Warning: could not write collider cache " << cachePath.generic_string() << std::endl;
+	}
+}
+
+std::string PhysShapeCache::shapeKey(const Shape& shape)
+{
+	std::string key;
+	key.push_back(static_cast<char>(shape.index()));
+	std::visit(
+	    [&](const auto& s)
+	    {
+		    using T = std::decay_t<decltype(s)>;
+		    if constexpr (std::is_same_v<T, Sphere>)
+			    appendBytes(key, s.radius);
+		    else if constexpr (std::is_same_v<T, Box>)
+			    appendBytes(key, s.halfExtents);
+		    else if constexpr (std::is_same_v<T, Capsule> || std::is_same_v<T, Cylinder>)
+		    {
+			    appendBytes(key, s.halfHeight);
+			    appendBytes(key, s.radius);
+		    }
+		    else if constexpr (std::is_same_v<T, ConvexHull>)
+			    key.append(reinterpret_cast<const char*>(s.points.data()), s.points.size_bytes());
+	    },
+	    shape);
+	return key;
+}
@@ -0,0 +1,33 @@
+#include "PhysicsCore/PhysCommand.hpp"
+#include "PhysicsCore/JoltGlm.hpp"
+
+void applyPhysCommands(JPH::BodyInterface& bodyInterface, std::span<const PhysCommand> commands)
+{
+	for (const PhysCommand& command : commands)
+	{
+		if (!bodyInterface.IsAdded(command.body)) continue;
+
+		switch (command.type)
+		{
+		case PhysCommandType::AddForce:
+			bodyInterface.AddForce(command.body, toJolt(command.value));
+			break;
+		case PhysCommandType::AddImpulse:
+			bodyInterface.AddImpulse(command.body, toJolt(command.value));
+			break;
+		case PhysCommandType::SetLinearVelocity:
+			bodyInterface.SetLinearVelocity(command.body, toJolt(command.value));
+			break;
+		case PhysCommandType::SetAngularVelocity:
+			bodyInterface.SetAngularVelocity(command.body, toJolt(command.value));
+			break;
+		case PhysCommandType::Teleport:
+		{
+			const JPH::RVec3 position(command.value.x, command.value.y, command.value.z);
+			bodyInterface.SetPositionAndRotation(command.body, position, toJolt(command.rotation),
+			                                     JPH::EActivation::Activate);
+			break;
+		}
+		}
+	}
+}
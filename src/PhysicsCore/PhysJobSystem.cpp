@@ -0,0 +1,56 @@
+#include "PhysicsCore/PhysJobSystem.hpp"
+#include <chrono>
+#include <thread>
+
+PhysJobSystem::PhysJobSystem(TaskScheduler& scheduler, JPH::uint maxJobs, JPH::uint maxBarriers)
+    : JPH::JobSystemWithBarrier(maxBarriers), _scheduler(scheduler)
+{
+	_jobs.Init(maxJobs, maxJobs);
+}
+
+int PhysJobSystem::GetMaxConcurrency() const
+{
+	// The physics thread runs jobs too while it waits
+	return static_cast<int>(_scheduler.workerCount()) + 1;
+}
+
+PhysJobSystem::JobHandle PhysJobSystem::CreateJob(const char* inName, JPH::ColorArg inColor,
+                                                  const JobFunction& inJobFunction, JPH::uint32 inNumDependencies)
+{
+	JPH::uint32 index;
+	for (;;)
+	{
+		index = _jobs.ConstructObject(inName, inColor, this, inJobFunction, inNumDependencies);
+		if (index != JPH::FixedSizeFreeList<Job>::cInvalidObjectIndex) break;
+		// Every job slot is in flight; raise maxJobs if this shows up in profiles
+		std::this_thread::sleep_for(std::chrono::microseconds(100));
+	}
+	Job* job = &_jobs.Get(index);
+
+	// The handle keeps the job alive: once queued it may finish and be released at any moment
+	JobHandle handle(job);
+	if (inNumDependencies == 0) QueueJob(job);
+	return handle;
+}
+
+void PhysJobSystem::QueueJob(Job* inJob)
+{
+	inJob->AddRef();
+	_scheduler.submit(
+	    [inJob]()
+	    {
+		    inJob->Execute();
+		    inJob->Release();
+	    },
+	    TaskPriority::Normal);
+}
+
+void PhysJobSystem::QueueJobs(Job** inJobs, JPH::uint inNumJobs)
+{
+	for (JPH::uint i = 0; i < inNumJobs; ++i) QueueJob(inJobs[i]);
+}
+
+void PhysJobSystem::FreeJob(Job* inJob)
+{
+	_jobs.DestructObject(inJob);
+}
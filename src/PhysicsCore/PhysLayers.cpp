@@ -0,0 +1,37 @@
+#include "PhysicsCore/PhysLayers.hpp"
+#include <stdexcept>
+#include <string>
+
+void PhysLayerTable::build(const PhysLayerConfig& config)
+{
+	if (config.broadPhaseLayers.empty() || config.broadPhaseLayers.size() > 256)
+		throw std::runtime_error("PhysLayerConfig: broad-phase layer count must be between 1 and 256");
+	if (config.objectLayers.empty() || config.objectLayers.size() > JPH::cObjectLayerInvalid)
+		throw std::runtime_error("PhysLayerConfig: object layer count out of range");
+
+	_numObjectLayers = static_cast<uint32_t>(config.objectLayers.size());
+	_numBroadPhaseLayers = static_cast<uint32_t>(config.broadPhaseLayers.size());
+	_broadPhaseNames = config.broadPhaseLayers;
+
+	_broadPhaseOf.resize(_numObjectLayers);
+	for (uint32_t layer = 0; layer < _numObjectLayers; ++layer)
+	{
+		const PhysObjectLayerDesc& desc = config.objectLayers[layer];
+		if (desc.broadPhaseLayer >= _numBroadPhaseLayers)
+			throw std::runtime_error(std::string("PhysLayerConfig: object layer ") + desc.name +
+			                         " names a broad-phase layer that does not exist");
+		_broadPhaseOf[layer] = desc.broadPhaseLayer;
+	}
+
+	_objectPairs.assign(_numObjectLayers * _numObjectLayers, 0);
+	_objectVsBroadPhase.assign(_numObjectLayers * _numBroadPhaseLayers, 0);
+	for (const auto& [a, b] : config.collidingPairs)
+	{
+		if (a >= _numObjectLayers || b >= _numObjectLayers)
+			throw std::runtime_error("PhysLayerConfig: colliding pair names an object layer that does not exist");
+		_objectPairs[a * _numObjectLayers + b] = 1;
+		_objectPairs[b * _numObjectLayers + a] = 1;
+		_objectVsBroadPhase[a * _numBroadPhaseLayers + _broadPhaseOf[b]] = 1;
+		_objectVsBroadPhase[b * _numBroadPhaseLayers + _broadPhaseOf[a]] = 1;
+	}
+}
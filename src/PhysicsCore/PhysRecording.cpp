@@ -0,0 +1,347 @@
+#include "PhysicsCore/PhysRecording.hpp"
+#include "PhysicsCore/PhysJobSystem.hpp"
+#include "PhysicsCore/PhysLayers.hpp"
+#include "PhysicsCore/PhysRollback.hpp"
+#include <Jolt/Core/HashCombine.h>
+#include <Jolt/Core/TempAllocator.h>
+#include <Jolt/Physics/Body/BodyLock.h>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+#ifdef TRACY_ENABLE
+#include <tracy/Tracy.hpp>
+#endif
+
+namespace
+{
+constexpr uint32_t kRecordingMagic = 0x43455248; // "HREC"
+constexpr uint32_t kRecordingVersion = 1;
+
+enum class RecordType : uint8_t
+{
+	End,
+	AddBodies,
+	OptimizeBroadPhase,
+	Tick,
+	Rollback
+};
+
+uint64_t hashBodyStates(const JPH::PhysicsSystem& physicsSystem, JPH::BodyIDVector& bodies)
+{
+	physicsSystem.GetBodies(bodies);
+	const JPH::BodyLockInterfaceNoLock& locks = physicsSystem.GetBodyLockInterfaceNoLock();
+
+	uint64_t hash = JPH::HashBytes(nullptr, 0);
+	for (const JPH::BodyID& id : bodies)
+	{
+		const JPH::Body* body = locks.TryGetBody(id);
+		if (!body) continue;
+
+		const JPH::RVec3 position = body->GetPosition();
+		const JPH::Quat rotation = body->GetRotation();
+		const JPH::Vec3 linear = body->GetLinearVelocity();
+		const JPH::Vec3 angular = body->GetAngularVelocity();
+		const float state[] = {static_cast<float>(position.GetX()),
+		                       static_cast<float>(position.GetY()),
+		                       static_cast<float>(position.GetZ()),
+		                       rotation.GetX(),
+		                       rotation.GetY(),
+		                       rotation.GetZ(),
+		                       rotation.GetW(),
+		                       linear.GetX(),
+		                       linear.GetY(),
+		                       linear.GetZ(),
+		                       angular.GetX(),
+		                       angular.GetY(),
+		                       angular.GetZ()};
+		const JPH::uint32 idValue = id.GetIndexAndSequenceNumber();
+		hash = JPH::HashBytes(&idValue, sizeof(idValue), hash);
+		hash = JPH::HashBytes(state, sizeof(state), hash);
+	}
+	return hash;
+}
+
+void writeCommand(JPH::StreamOut& stream, const PhysCommand& command)
+{
+	stream.Write(static_cast<uint8_t>(command.type));
+	stream.Write(command.body.GetIndexAndSequenceNumber());
+	const float values[] = {command.value.x,    command.value.y,    command.value.z,   command.rotation.x,
+	                        command.rotation.y, command.rotation.z, command.rotation.w};
+	for (float value : values) stream.Write(value);
+}
+
+PhysCommand readCommand(JPH::StreamIn& stream)
+{
+	PhysCommand command;
+	uint8_t type = 0;
+	JPH::uint32 body = JPH::BodyID::cInvalidBodyID;
+	stream.Read(type);
+	stream.Read(body);
+	command.type = static_cast<PhysCommandType>(type);
+	command.body = JPH::BodyID(body);
+	stream.Read(command.value.x);
+	stream.Read(command.value.y);
+	stream.Read(command.value.z);
+	stream.Read(command.rotation.x);
+	stream.Read(command.rotation.y);
+	stream.Read(command.rotation.z);
+	stream.Read(command.rotation.w);
+	return command;
+}
+} // namespace
+
+PhysRecorder::PhysRecorder(const std::filesystem::path& path, const PhysSettingsComponent& settings)
+    : _file(path, std::ios::binary | std::ios::trunc), _stream(_file)
+{
+	if (!_file) throw std::runtime_error("Could not create physics recording " + path.string());
+
+	_stream.Write(kRecordingMagic);
+	_stream.Write(kRecordingVersion);
+	_stream.Write(settings.maxBodies);
+	_stream.Write(settings.numBodyMutexes);
+	_stream.Write(settings.maxBodyPairs);
+	_stream.Write(settings.maxContactConstraints);
+	_stream.Write(settings.tempAllocatorSize);
+	_stream.Write(settings.rollbackCapacity);
+	_stream.Write(settings.rollbackInterval);
+
+	const PhysLayerConfig& layers = settings.layers;
+	_stream.Write(static_cast<uint32_t>(layers.broadPhaseLayers.size()));
+	for (const char* name : layers.broadPhaseLayers) _stream.Write(std::string(name));
+	_stream.Write(static_cast<uint32_t>(layers.objectLayers.size()));
+	for (const PhysObjectLayerDesc& layer : layers.objectLayers)
+	{
+		_stream.Write(std::string(layer.name));
+		_stream.Write(layer.broadPhaseLayer);
+	}
+	_stream.Write(static_cast<uint32_t>(layers.collidingPairs.size()));
+	for (const auto& [a, b] : layers.collidingPairs)
+	{
+		_stream.Write(a);
+		_stream.Write(b);
+	}
+}
+
+PhysRecorder::~PhysRecorder()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_stream.Write(RecordType::End);
+	_file.flush();
+}
+
+void PhysRecorder::recordBodies(std::span<const JPH::BodyID> ids, std::span<const JPH::BodyCreationSettings> settings,
+                                JPH::EActivation activation)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_stream.Write(RecordType::AddBodies);
+	_stream.Write(static_cast<uint8_t>(activation));
+	_stream.Write(static_cast<uint32_t>(ids.size()));
+	for (size_t i = 0; i < ids.size(); ++i)
+	{
+		_stream.Write(ids[i].GetIndexAndSequenceNumber());
+		settings[i].SaveWithChildren(_stream, &_shapeIDs, &_materialIDs, &_groupFilterIDs);
+	}
+}
+
+void PhysRecorder::recordOptimizeBroadPhase()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_stream.Write(RecordType::OptimizeBroadPhase);
+}
+
+void PhysRecorder::recordRollback(uint64_t tick)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_stream.Write(RecordType::Rollback);
+	_stream.Write(tick);
+}
+
+void PhysRecorder::recordTick(float deltaTime, int collisionSteps, std::span<const PhysCommand> commands,
+                              const JPH::PhysicsSystem& physicsSystem)
+{
+#ifdef TRACY_ENABLE
+	ZoneScopedN("PhysRecorder::recordTick");
+#endif
+	std::lock_guard<std::mutex> lock(_mutex);
+	_stream.Write(RecordType::Tick);
+	_stream.Write(deltaTime);
+	_stream.Write(static_cast<uint32_t>(collisionSteps));
+	_stream.Write(static_cast<uint32_t>(commands.size()));
+	for (const PhysCommand& command : commands) writeCommand(_stream, command);
+	_stream.Write(hashBodyStates(physicsSystem, _bodies));
+}
+
+PhysReplayResult replayPhysRecording(const std::filesystem::path& path, TaskScheduler& scheduler)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file) throw std::runtime_error("Could not open physics recording " + path.string());
+	JPH::StreamInWrapper stream(file);
+	auto requireRead = [&]()
+	{
+		if (stream.IsEOF() || stream.IsFailed())
+			throw std::runtime_error("Physics recording " + path.string() + " is damaged");
+	};
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	stream.Read(magic);
+	stream.Read(version);
+	requireRead();
+	if (magic != kRecordingMagic || version != kRecordingVersion)
+		throw std::runtime_error(path.string() + " is not a physics recording of version " +
+		                         std::to_string(kRecordingVersion));
+
+	PhysSettingsComponent settings;
+	stream.Read(settings.maxBodies);
+	stream.Read(settings.numBodyMutexes);
+	stream.Read(settings.maxBodyPairs);
+	stream.Read(settings.maxContactConstraints);
+	stream.Read(settings.tempAllocatorSize);
+	stream.Read(settings.rollbackCapacity);
+	stream.Read(settings.rollbackInterval);
+
+	// The layer config holds names by pointer, so they are all read before it is filled in
+	uint32_t count = 0;
+	std::vector<std::string> broadPhaseNames;
+	stream.Read(count);
+	requireRead();
+	broadPhaseNames.resize(count);
+	for (std::string& name : broadPhaseNames) stream.Read(name);
+	std::vector<std::string> objectNames;
+	std::vector<uint8_t> objectBroadPhases;
+	stream.Read(count);
+	requireRead();
+	objectNames.resize(count);
+	objectBroadPhases.resize(count);
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		stream.Read(objectNames[i]);
+		stream.Read(objectBroadPhases[i]);
+	}
+	stream.Read(count);
+	requireRead();
+	settings.layers.collidingPairs.resize(count);
+	for (auto& [a, b] : settings.layers.collidingPairs)
+	{
+		stream.Read(a);
+		stream.Read(b);
+	}
+	requireRead();
+
+	settings.layers.broadPhaseLayers.clear();
+	for (const std::string& name : broadPhaseNames) settings.layers.broadPhaseLayers.push_back(name.c_str());
+	settings.layers.objectLayers.clear();
+	for (size_t i = 0; i < objectNames.size(); ++i)
+		settings.layers.objectLayers.push_back({objectNames[i].c_str(), objectBroadPhases[i]});
+
+	PhysLayerTable layerTable;
+	layerTable.build(settings.layers);
+	JPH::TempAllocatorImpl tempAllocator(settings.tempAllocatorSize);
+	PhysJobSystem jobSystem(scheduler, JPH::cMaxPhysicsJobs, JPH::cMaxPhysicsBarriers);
+	JPH::PhysicsSystem physicsSystem;
+	physicsSystem.Init(settings.maxBodies, settings.numBodyMutexes, settings.maxBodyPairs,
+	                   settings.maxContactConstraints, layerTable, layerTable, layerTable);
+	JPH::BodyInterface& bodyInterface = physicsSystem.GetBodyInterface();
+	// Kept like the recorded session kept it, so its rollbacks find the same states
+	PhysRollbackBuffer rollback(settings.rollbackCapacity);
+	const uint32_t rollbackInterval = std::max(1u, settings.rollbackInterval);
+	uint64_t tick = 0;
+
+	JPH::BodyCreationSettings::IDToShapeMap shapes;
+	JPH::BodyCreationSettings::IDToMaterialMap materials;
+	JPH::BodyCreationSettings::IDToGroupFilterMap groupFilters;
+	JPH::BodyIDVector bodies;
+	std::vector<JPH::BodyID> batch;
+	std::vector<PhysCommand> commands;
+
+	PhysReplayResult result;
+	using clock = std::chrono::steady_clock;
+	const auto replayStart = clock::now();
+	for (;;)
+	{
+		RecordType type = RecordType::End;
+		stream.Read(type);
+		if (stream.IsEOF() || stream.IsFailed())
+		{
+			result.truncated = true;
+			break;
+		}
+		if (type == RecordType::End) break;
+
+		switch (type)
+		{
+		case RecordType::AddBodies:
+		{
+			uint8_t activation = 0;
+			stream.Read(activation);
+			stream.Read(count);
+			requireRead();
+			batch.clear();
+			for (uint32_t i = 0; i < count; ++i)
+			{
+				JPH::uint32 id = JPH::BodyID::cInvalidBodyID;
+				stream.Read(id);
+				JPH::BodyCreationSettings::BCSResult restored =
+				    JPH::BodyCreationSettings::sRestoreWithChildren(stream, shapes, materials, groupFilters);
+				if (restored.HasError())
+					throw std::runtime_error("Physics recording body: " + std::string(restored.GetError().c_str()));
+				JPH::Body* body = bodyInterface.CreateBodyWithID(JPH::BodyID(id), restored.Get());
+				if (!body) throw std::runtime_error("Physics recording reuses body id " + std::to_string(id));
+				batch.push_back(body->GetID());
+			}
+			const int batchSize = static_cast<int>(batch.size());
+			JPH::BodyInterface::AddState state = bodyInterface.AddBodiesPrepare(batch.data(), batchSize);
+			bodyInterface.AddBodiesFinalize(batch.data(), batchSize, state, static_cast<JPH::EActivation>(activation));
+			result.peakBodies = std::max(result.peakBodies, physicsSystem.GetNumBodies());
+			break;
+		}
+		case RecordType::OptimizeBroadPhase:
+			physicsSystem.OptimizeBroadPhase();
+			break;
+		case RecordType::Tick:
+		{
+			float deltaTime = 0.0f;
+			uint32_t collisionSteps = 1;
+			stream.Read(deltaTime);
+			stream.Read(collisionSteps);
+			stream.Read(count);
+			requireRead();
+			commands.clear();
+			for (uint32_t i = 0; i < count; ++i) commands.push_back(readCommand(stream));
+			uint64_t recordedHash = 0;
+			stream.Read(recordedHash);
+			requireRead();
+
+			applyPhysCommands(bodyInterface, commands);
+			const auto stepStart = clock::now();
+			physicsSystem.Update(deltaTime, static_cast<int>(collisionSteps), &tempAllocator, &jobSystem);
+			result.stepMilliseconds.push_back(
+			    std::chrono::duration<double, std::milli>(clock::now() - stepStart).count());
+
+			++tick;
+			if (rollback.capacity() > 0 && tick % rollbackInterval == 0) rollback.save(tick, physicsSystem);
+
+			if (result.firstDivergentTick < 0 && hashBodyStates(physicsSystem, bodies) != recordedHash)
+				result.firstDivergentTick = static_cast<int64_t>(result.stepMilliseconds.size()) - 1;
+			break;
+		}
+		case RecordType::Rollback:
+		{
+			uint64_t target = 0;
+			stream.Read(target);
+			requireRead();
+			if (!rollback.restore(target, physicsSystem))
+				throw std::runtime_error("Physics recording rolls back to tick " + std::to_string(target) +
+				                         ", which the replay does not hold");
+			tick = target;
+			break;
+		}
+		default:
+			throw std::runtime_error("Physics recording " + path.string() + " has an unknown record");
+		}
+	}
+	result.wallSeconds = std::chrono::duration<double>(clock::now() - replayStart).count();
+	return result;
+}
@@ -0,0 +1,54 @@
+#include "PhysicsCore/PhysRollback.hpp"
+
+#ifdef TRACY_ENABLE
+#include <tracy/Tracy.hpp>
+#endif
+
+PhysRollbackBuffer::PhysRollbackBuffer(uint32_t capacity) : _entries(capacity)
+{
+}
+
+void PhysRollbackBuffer::save(uint64_t tick, const JPH::PhysicsSystem& physicsSystem)
+{
+	if (_entries.empty()) return;
+#ifdef TRACY_ENABLE
+	ZoneScopedN("PhysRollbackBuffer::save");
+#endif
+	Entry& entry = _entries[_next];
+	_next = (_next + 1) % capacity();
+
+	entry.state.Clear();
+	physicsSystem.SaveState(entry.state);
+	entry.tick = tick;
+	entry.valid = true;
+}
+
+bool PhysRollbackBuffer::restore(uint64_t tick, JPH::PhysicsSystem& physicsSystem)
+{
+#ifdef TRACY_ENABLE
+	ZoneScopedN("PhysRollbackBuffer::restore");
+#endif
+	for (Entry& entry : _entries)
+	{
+		if (!entry.valid || entry.tick != tick) continue;
+
+		entry.state.Rewind();
+		if (!physicsSystem.RestoreState(entry.state)) return false;
+
+		for (Entry& later : _entries)
+		{
+			if (later.valid && later.tick > tick) later.valid = false;
+		}
+		return true;
+	}
+	return false;
+}
+
+bool PhysRollbackBuffer::holds(uint64_t tick) const
+{
+	for (const Entry& entry : _entries)
+	{
+		if (entry.valid && entry.tick == tick) return true;
+	}
+	return false;
+}
@@ -0,0 +1,63 @@
+#include "PhysicsCore/PhysTickGovernor.hpp"
+#include <algorithm>
+
+namespace
+{
+constexpr float kLoadSmoothing = 0.1f;
+// Ticks keep their collision steps, so one takes about as long at any rate and the load, a fraction of the
+// interval, halves with the rate. Climbing back doubles it, so kIdle stays well under half of kOverloaded: the
+// margin absorbs the per-tick overhead that does not shrink with the rate and keeps it from bouncing.
+constexpr float kOverloaded = 0.9f;
+constexpr float kIdle = 0.35f;
+// How long the load has to stay past a threshold before the rate changes, in seconds of ticks
+constexpr double kDegradeAfter = 0.25;
+constexpr double kRecoverAfter = 2.0;
+// Ticks running a whole interval late: slow down before MainLoop gives up on the schedule
+// (PhysTickRateComponent::maxConsecutiveMissedSteps) and drops simulated time
+constexpr uint32_t kLateTicksBeforeDegrade = 2;
+} // namespace
+
+void PhysTickGovernor::onTick(const PhysTickRateComponent& config, double workSeconds, bool late)
+{
+	if (!config.adaptive)
+	{
+		_divisor = 1;
+		_load = 0.0f;
+		_overloadedTicks = _idleTicks = 0;
+		return;
+	}
+
+	// minRate raised, or rate lowered, since the last change
+	while (_divisor > 1 && config.rate / static_cast<float>(_divisor) < config.minRate) _divisor /= 2;
+
+	const double tickInterval = interval(config);
+	_load += (static_cast<float>(workSeconds / tickInterval) - _load) * kLoadSmoothing;
+	const double ticksPerSecond = 1.0 / tickInterval;
+
+	if (late || _load > kOverloaded)
+	{
+		_idleTicks = 0;
+		const double degradeAfter = late ? kLateTicksBeforeDegrade : std::max(1.0, kDegradeAfter * ticksPerSecond);
+		if (++_overloadedTicks >= degradeAfter &&
+		    config.rate / static_cast<float>(_divisor * 2) >= config.minRate)
+		{
+			_divisor *= 2;
+			_load *= 0.5f;
+			_overloadedTicks = 0;
+		}
+	}
+	else if (_load < kIdle && _divisor > 1)
+	{
+		_overloadedTicks = 0;
+		if (++_idleTicks >= kRecoverAfter * ticksPerSecond)
+		{
+			_divisor /= 2;
+			_load *= 2.0f;
+			_idleTicks = 0;
+		}
+	}
+	else
+	{
+		_overloadedTicks = _idleTicks = 0;
+	}
+}
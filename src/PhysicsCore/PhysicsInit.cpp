@@ -20,20 +20,21 @@
 #include "PhysicsCore/PhysContexts.hpp"
 #include "PhysicsCore/Systems/PhysUpdateSystem.hpp"
 #include "PhysicsCore/Systems/PhysSnapshotSystem.hpp"
+#include "PhysicsCore/Systems/PhysQuerySystem.hpp"
 #include "PhysicsCore/PhysLayers.hpp"
 
 #include "DeletionQueueComponent.hpp"
 #include "DeletionQueueContext.hpp"
 
 #pragma region Run
-void PhysicsInit::Run(Orhescyon::GeneralManager& gm)
+void PhysicsInit::Run(Orhescyon::GeneralManager& gm, const PhysSettingsComponent& settings)
 {
 #ifdef _DEBUG
 	std::cout << "PHYSICSINIT::RUN::Start init" << std::endl;
 #endif //_DEBUG
 
 	coreInit(gm);
-	initPhysics(gm);
+	initPhysics(gm, settings);
 
 #ifdef _DEBUG
 	std::cout << "PHYSICSINIT::RUN::Succes!" << std::endl;
@@ -51,11 +52,12 @@ void PhysicsInit::coreInit(Orhescyon::GeneralManager& gm)
 	    .after<PhysUpdateSystem>()
 	    .reads<PhysBodyComponent>()
 	    .writes<PhysTransformSnapshotComponent>();
+	gm.registerSystem<PhysQuerySystem>().after<PhysSnapshotSystem>();
 }
 #pragma endregion
 
 #pragma region initPhysics
-void PhysicsInit::initPhysics(Orhescyon::GeneralManager& gm)
+void PhysicsInit::initPhysics(Orhescyon::GeneralManager& gm, const PhysSettingsComponent& settings)
 {
 	DeletionQueue* dq = gm.getContextComponent<DeletionQueueContext, DeletionQueueComponent>()->queue;
 
@@ -75,6 +77,11 @@ void PhysicsInit::initPhysics(Orhescyon::GeneralManager& gm)
 	    });
 
 	JPH::RegisterTypes();
+
+	Orhescyon::Entity settingsEntity = gm.createEntity();
+	gm.addComponent<PhysSettingsComponent>(settingsEntity, settings);
+	gm.registerContext<PhysSettingsContext>(settingsEntity);
+
 	Orhescyon::Entity physManagerEntity = gm.createEntity();
 	PhysManager* physManager = new PhysManager(gm);
 	gm.addComponent<PhysManagerComponent>(physManagerEntity, physManager);
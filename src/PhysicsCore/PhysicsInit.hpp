@@ -1,11 +1,12 @@
 #pragma once
 #include <Orhescyon/GeneralManager.hpp>
+#include "PhysicsCore/Components/PhysSettingsComponent.hpp"
 
 class PhysicsInit
 {
 public:
-	static void Run(Orhescyon::GeneralManager& gm);
+	static void Run(Orhescyon::GeneralManager& gm, const PhysSettingsComponent& settings);
 private:
 	static void coreInit(Orhescyon::GeneralManager& gm);
-	static void initPhysics(Orhescyon::GeneralManager& gm);
+	static void initPhysics(Orhescyon::GeneralManager& gm, const PhysSettingsComponent& settings);
 };
@@ -0,0 +1,37 @@
+#include "PhysicsCore/Systems/PhysQuerySystem.hpp"
+#include "PhysicsCore/PhysContexts.hpp"
+#include "PhysicsCore/Components/PhysManagerComponent.hpp"
+#include "PhysicsCore/Managers/PhysManager.hpp"
+#include "TaskSchedulerComponent.hpp"
+#include "TaskSchedulerContext.hpp"
+#include "FrameProfiler.hpp"
+
+#ifdef TRACY_ENABLE
+#include <tracy/Tracy.hpp>
+#endif
+
+void PhysQuerySystem::onRegistered(GeneralManager& gm)
+{
+	std::cout << "PhysQuerySystem registered!" << std::endl;
+}
+
+void PhysQuerySystem::onShutdown(GeneralManager& gm)
+{
+	std::cout << "PhysQuerySystem shutdown!" << std::endl;
+}
+
+void PhysQuerySystem::update(GeneralManager& gm)
+{
+#ifdef TRACY_ENABLE
+	ZoneScopedN("PhysQuerySystem");
+#endif
+	CpuProfileScope profileScope(gm, "PhysQuerySystem");
+
+	PhysManager& physManager = *gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager;
+	TaskScheduler& scheduler = *gm.getContextComponent<TaskSchedulerContext, TaskSchedulerComponent>()->scheduler;
+
+	// Published by PhysSnapshotSystem on this thread, so the relaxed load already sees it
+	const SnapshotIndices indices = physManager.physSnapshot.load(std::memory_order_relaxed);
+	physManager.queries.execute(*physManager.physicsSystem, physManager.layerTable, scheduler,
+	                            physManager.snapshots[indices.current]);
+}
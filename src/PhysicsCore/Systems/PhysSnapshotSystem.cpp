@@ -3,6 +3,8 @@
 #include "PhysicsCore/Components/PhysManagerComponent.hpp"
 #include "PhysicsCore/PhysContexts.hpp"
 #include "PhysicsCore/Managers/PhysManager.hpp"
+#include "FrameProfiler.hpp"
+#include <algorithm>
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
@@ -26,7 +28,7 @@ void PhysSnapshotSystem::onEntitySubscribed(Orhescyon::Entity entity, GeneralMan
 	if (transSnapshot && physBody)
 	{
 		std::lock_guard<std::mutex> lock(_pendingMutex);
-		_pendingAdd.push_back({entity, transSnapshot, physBody});
+		_pendingAdd.push_back({entity, physBody->bodyID});
 	}
 }
 
@@ -36,26 +38,61 @@ void PhysSnapshotSystem::onEntityUnsubscribed(Orhescyon::Entity entity, GeneralM
 	_pendingRemove.push_back(entity);
 }
 
-void PhysSnapshotSystem::applyPendingChanges()
+void PhysSnapshotSystem::applyPendingChanges(JPH::BodyInterface& bodyInterface, uint64_t oldestPinnedTick)
 {
 	std::lock_guard<std::mutex> lock(_pendingMutex);
 
-	if (!_pendingAdd.empty())
-	{
-		_agents.insert(_agents.end(), _pendingAdd.begin(), _pendingAdd.end());
-		_pendingAdd.clear();
-	}
-
 	if (!_pendingRemove.empty())
 	{
 		for (Orhescyon::Entity entity : _pendingRemove)
 		{
-			auto it = std::remove_if(_agents.begin(), _agents.end(),
-			                         [entity](const Agent& agent) { return agent.entity == entity; });
-			_agents.erase(it, _agents.end());
+			for (uint32_t slot = 0; slot < _slots.size(); ++slot)
+			{
+				if (_slots[slot].bodyID.IsInvalid() || _slots[slot].entity != entity) continue;
+				// No-op when the body is already gone
+				bodyInterface.SetUserData(_slots[slot].bodyID, 0);
+				_slots[slot] = {Orhescyon::Entity::invalid(), JPH::BodyID()};
+				_retiredSlots.emplace_back(slot, _tick);
+			}
 		}
 		_pendingRemove.clear();
 	}
+
+	// Snapshots published before tick t may still list a slot freed on it; once those have cycled out of the ring,
+	// and no reader still has one pinned, nothing names it any more
+	auto it = std::remove_if(_retiredSlots.begin(), _retiredSlots.end(),
+	                         [&](const std::pair<uint32_t, uint64_t>& retired)
+	                         {
+		                         if (_tick < retired.second + maxSnapshots || oldestPinnedTick < retired.second)
+			                         return false;
+		                         _freeSlots.push_back(retired.first);
+		                         return true;
+	                         });
+	_retiredSlots.erase(it, _retiredSlots.end());
+
+	if (!_pendingAdd.empty())
+	{
+		for (const Agent& agent : _pendingAdd)
+		{
+			uint32_t slot;
+			if (!_freeSlots.empty())
+			{
+				slot = _freeSlots.back();
+				_freeSlots.pop_back();
+			}
+			else
+			{
+				slot = static_cast<uint32_t>(_slots.size());
+				_slots.emplace_back();
+				_movedTick.push_back(0);
+			}
+			_slots[slot] = agent;
+			// Offset by one: 0 is the default user data of bodies that belong to no agent
+			bodyInterface.SetUserData(agent.bodyID, static_cast<JPH::uint64>(slot) + 1);
+			_spawned.push_back(slot);
+		}
+		_pendingAdd.clear();
+	}
 }
 
 void PhysSnapshotSystem::update(GeneralManager& gm)
@@ -63,26 +100,100 @@ void PhysSnapshotSystem::update(GeneralManager& gm)
 #ifdef TRACY_ENABLE
 	ZoneScopedN("PhysSnapshotSystem");
 #endif
-
-	applyPendingChanges();
+	CpuProfileScope profileScope(gm, "PhysSnapshotSystem");
 
 	PhysManager& physManager =
 	    *gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager;
-	JPH::BodyInterface& bi = physManager.physicsSystem->GetBodyInterface();
+	JPH::PhysicsSystem& physicsSystem = *physManager.physicsSystem;
+
+	++_tick;
+	applyPendingChanges(physicsSystem.GetBodyInterface(), physManager.oldestPinnedTick());
+	// A rollback moved bodies that may be asleep now, so every agent is republished and the renderer snaps to it
+	if (physManager.stateRestored)
+	{
+		for (uint32_t slot = 0; slot < _slots.size(); ++slot)
+		{
+			if (!_slots[slot].bodyID.IsInvalid()) _spawned.push_back(slot);
+		}
+		physManager.stateRestored = false;
+	}
 
 	SnapshotIndices indicies = physManager.physSnapshot.load(std::memory_order_relaxed);
+	const PhysSnapshot& latest = physManager.snapshots[indicies.current];
+	// Never one the renderer is reading: its vectors are reallocated below
+	const uint8_t writing = physManager.freeSnapshotSlot();
+	PhysSnapshot& out = physManager.snapshots[writing];
+
+	// Start from the newest snapshot so bodies that stayed still keep their transforms, then overwrite the rest
+	const size_t slotCount = _slots.size();
+	out.positions.assign(latest.positions.begin(), latest.positions.end());
+	out.positions.resize(slotCount, JPH::Vec3::sZero());
+	out.rotations.assign(latest.rotations.begin(), latest.rotations.end());
+	out.rotations.resize(slotCount, JPH::Quat::sIdentity());
+	out.entities.resize(slotCount);
+	for (size_t slot = 0; slot < slotCount; ++slot) out.entities[slot] = _slots[slot].entity;
+	out.moved.clear();
+
+	auto markMoved = [&](uint32_t slot, bool teleport)
+	{
+		if (_movedTick[slot] == _tick) return;
+		_movedTick[slot] = _tick;
+		out.moved.push_back({_slots[slot].entity, slot, teleport});
+	};
+
+	// The update has finished and bodies are only added or removed between ticks, so nothing writes the bodies
+	// while they are read here
+	const JPH::BodyLockInterfaceNoLock& lockInterface = physicsSystem.GetBodyLockInterfaceNoLock();
+	auto readBody = [&](uint32_t slot, const JPH::Body& body)
+	{
+		out.positions[slot] = body.GetCenterOfMassPosition();
+		out.rotations[slot] = body.GetRotation();
+	};
+
+	// Joined agents first, whether active or not: static and sleeping bodies still need one transform
+	for (uint32_t slot : _spawned)
+	{
+		if (_slots[slot].bodyID.IsInvalid()) continue;
+		if (const JPH::Body* body = lockInterface.TryGetBody(_slots[slot].bodyID))
+		{
+			readBody(slot, *body);
+			markMoved(slot, true);
+		}
+	}
+	_spawned.clear();
+
+	_activeSlots.clear();
+	physicsSystem.GetActiveBodies(JPH::EBodyType::RigidBody, _activeBodies);
+	for (const JPH::BodyID& id : _activeBodies)
+	{
+		const JPH::Body* body = lockInterface.TryGetBody(id);
+		if (!body || body->GetUserData() == 0) continue;
+		const uint32_t slot = static_cast<uint32_t>(body->GetUserData() - 1);
+		if (slot >= slotCount || _slots[slot].bodyID != id) continue;
+
+		readBody(slot, *body);
+		markMoved(slot, false);
+		_activeSlots.push_back(slot);
+	}
 
-	for (auto& agent : _agents)
+	// Bodies that fell asleep during this tick are no longer active but still moved in it
+	for (uint32_t slot : _previouslyActive)
 	{
-		JPH::BodyID body = agent.physBody->bodyID;
-		PhysTransformSnapshotComponent& snap = *agent.transSnapshot;
-		snap.positionSnap[indicies.writing] = bi.GetCenterOfMassPosition(body);
-		snap.rotationSnap[indicies.writing] = bi.GetRotation(body);
+		if (_movedTick[slot] == _tick || _slots[slot].bodyID.IsInvalid()) continue;
+		if (const JPH::Body* body = lockInterface.TryGetBody(_slots[slot].bodyID))
+		{
+			readBody(slot, *body);
+			markMoved(slot, false);
+		}
 	}
+	std::swap(_previouslyActive, _activeSlots);
+
+	out.movedTicks.assign(_movedTick.begin(), _movedTick.begin() + slotCount);
+	out.tick = _tick;
+	out.time = physManager.tickTime;
 
-	indicies.current = (indicies.current + 1) % maxSnapshots;
-	indicies.previous = (indicies.previous + 1) % maxSnapshots;
-	indicies.writing = (indicies.writing + 1) % maxSnapshots;
+	indicies.previous = indicies.current;
+	indicies.current = writing;
 
 	physManager.physSnapshot.store(indicies, std::memory_order_release);
 }
@@ -5,6 +5,7 @@
 #include <Jolt/Jolt.h>
 #include "GraphicsCore/Components/DeltaTimeComponent.hpp"
 #include "GraphicsCore/GraphicsContexts.hpp"
+#include "FrameProfiler.hpp"
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
@@ -25,14 +26,8 @@ void PhysUpdateSystem::update(GeneralManager& gm)
 #ifdef TRACY_ENABLE
 	ZoneScopedN("PhysUpdateSystem");
 #endif
+	CpuProfileScope profileScope(gm, "PhysUpdateSystem");
 
-	const float deltaTime =
-	    1.0f / gm.getContextComponent<PhysTickRateContext, PhysTickRateComponent>()->rate;
-	JPH::PhysicsSystem* physicsSystem =
-	    gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager->physicsSystem;
-	JPH::TempAllocatorImpl* tempAllocator =
-	    gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager->tempAllocator;
-	JPH::JobSystemThreadPool* jobSystem =
-	    gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager->jobSystem;
-	physicsSystem->Update(deltaTime, 1, tempAllocator, jobSystem);
+	PhysManager& physManager = *gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager;
+	physManager.step(physManager.tickDeltaTime, physManager.tickCollisionSteps);
 }
@@ -9,6 +9,7 @@
 #include "PlatformCore/Components/CursorPositionComponent.hpp"
 #include "PlatformCore/Components/ScrollDeltaComponent.hpp"
 #include "PlatformCore/Components/WindowSizeComponent.hpp"
+#include "PlatformCore/Components/InputTimingComponent.hpp"
 #include "GraphicsCore/Components/NameComponent.hpp"
 #include "GraphicsCore/Systems/DeltaTimeSystem.hpp"
 #include "GraphicsCore/Systems/FrameBeginSystem.hpp"
@@ -17,14 +18,14 @@
 #include "DeletionQueueContext.hpp"
 
 #pragma region Run
-void PlatformInit::Run(Orhescyon::GeneralManager& gm)
+void PlatformInit::Run(Orhescyon::GeneralManager& gm, const WindowDesc& windowDesc)
 {
 #ifdef _DEBUG
 	std::cout << "PLATFORMINIT::RUN::Start init" << std::endl;
 #endif //_DEBUG
 
 	coreInit(gm);
-	initPlatform(gm);
+	initPlatform(gm, windowDesc);
 
 #ifdef _DEBUG
 	std::cout << "PLATFORMINIT::RUN::Succes!" << std::endl;
@@ -39,29 +40,30 @@ void PlatformInit::coreInit(Orhescyon::GeneralManager& gm)
 	    .after<DeltaTimeSystem>()
 	    .before<FrameBeginSystem>()
 	    .writes<KeyboardStateComponent, MouseStateComponent, CursorPositionComponent, ScrollDeltaComponent,
-	            WindowSizeComponent>();
+	            WindowSizeComponent, InputTimingComponent>();
 }
 #pragma endregion
 
 #pragma region initPlatform
-void PlatformInit::initPlatform(Orhescyon::GeneralManager& gm)
+void PlatformInit::initPlatform(Orhescyon::GeneralManager& gm, const WindowDesc& windowDesc)
 {
 	DeletionQueue* dq = gm.getContextComponent<DeletionQueueContext, DeletionQueueComponent>()->queue;
 
 	Orhescyon::Entity windowAndInputEntity = gm.createEntity();
 	gm.registerContext<InputDataContext>(windowAndInputEntity);
 	gm.registerContext<MainWindowContext>(windowAndInputEntity);
-	Window* window = new Window("Halcyon");
+	Window* window = new Window(windowDesc);
 	gm.addComponent<WindowComponent>(windowAndInputEntity, window);
 	dq->push_function([window]() { delete window; });
 	gm.addComponent<KeyboardStateComponent>(windowAndInputEntity);
 	gm.addComponent<MouseStateComponent>(windowAndInputEntity);
 	gm.addComponent<CursorPositionComponent>(windowAndInputEntity);
 	gm.addComponent<NameComponent>(windowAndInputEntity, "SYSTEM::PLATFORM Window and Input");
-	unsigned int ScreenWidth = 1920;
-	unsigned int ScreenHeight = 1080;
+	unsigned int ScreenWidth = windowDesc.headless ? windowDesc.width : 1920;
+	unsigned int ScreenHeight = windowDesc.headless ? windowDesc.height : 1080;
 	gm.addComponent<WindowSizeComponent>(windowAndInputEntity, ScreenWidth, ScreenHeight);
 	gm.addComponent<ScrollDeltaComponent>(windowAndInputEntity);
+	gm.addComponent<InputTimingComponent>(windowAndInputEntity);
 	gm.subscribeEntity<InputSolverSystem>(windowAndInputEntity);
 }
 #pragma endregion
@@ -1,11 +1,12 @@
 #pragma once
 #include <Orhescyon/GeneralManager.hpp>
+#include "PlatformCore/WindowDesc.hpp"
 
 class PlatformInit
 {
 public:
-	static void Run(Orhescyon::GeneralManager& gm);
+	static void Run(Orhescyon::GeneralManager& gm, const WindowDesc& windowDesc = {});
 private:
 	static void coreInit(Orhescyon::GeneralManager& gm);
-	static void initPlatform(Orhescyon::GeneralManager& gm);
+	static void initPlatform(Orhescyon::GeneralManager& gm, const WindowDesc& windowDesc);
 };
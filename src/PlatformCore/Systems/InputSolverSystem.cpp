@@ -2,6 +2,7 @@
 
 #include <GLFW/glfw3.h>
 #include "PlatformCore/PlatformContexts.hpp"
+#include "FrameProfiler.hpp"
 
 #ifdef TRACY_ENABLE
 #include <tracy/Tracy.hpp>
@@ -12,50 +13,60 @@ void InputSolverSystem::update(GeneralManager& gm)
 #ifdef TRACY_ENABLE
 	ZoneScopedN("InputSolverSystem");
 #endif
+	CpuProfileScope profileScope(gm, "InputSolverSystem");
 
 	forEachSubscribedEntity(
 	    gm,
 	    [](Orhescyon::Entity, WindowComponent& window, CursorPositionComponent& cursorPosition,
 	       WindowSizeComponent& windowSize, KeyboardStateComponent& keyboardState, MouseStateComponent& mouseState,
-	       ScrollDeltaComponent& scrollDelta)
+	       ScrollDeltaComponent& scrollDelta, InputTimingComponent& timing)
 	    {
-		    Window* mainWindow = window.windowInstance;
-		    while (!mainWindow->inputQueue.empty())
-		    {
-			    const auto& e = mainWindow->inputQueue.front();
+		    drainInputQueue(*window.windowInstance, cursorPosition, windowSize, keyboardState, mouseState, scrollDelta,
+		                    timing);
+	    });
+}
 
-			    switch (e.Type)
-			    {
-			    case InputEvent::Type::Key:
-				    keyboardState.keys[e.key] = (e.action == GLFW_PRESS || e.action == GLFW_REPEAT);
-				    break;
+void InputSolverSystem::drainInputQueue(Window& window, CursorPositionComponent& cursorPosition,
+                                        WindowSizeComponent& windowSize, KeyboardStateComponent& keyboardState,
+                                        MouseStateComponent& mouseState, ScrollDeltaComponent& scrollDelta,
+                                        InputTimingComponent& timing)
+{
+	window.inputQueue.drain(
+	    [&](const InputEvent& e)
+	    {
+		    if (timing.oldestEventNs == 0) timing.oldestEventNs = e.timestampNs;
+		    timing.newestEventNs = e.timestampNs;
 
-			    case InputEvent::Type::MouseButton:
-				    mouseState.keys[e.key] = (e.action == GLFW_PRESS || e.action == GLFW_REPEAT);
-				    break;
+		    switch (e.Type)
+		    {
+		    case InputEvent::Type::Key:
+			    keyboardState.keys[e.key] = (e.action == GLFW_PRESS || e.action == GLFW_REPEAT);
+			    break;
 
-			    case InputEvent::Type::MouseMove:
-				    cursorPosition.mousePositionX = e.mousePositionX;
-				    cursorPosition.mousePositionY = e.mousePositionY;
-				    break;
+		    case InputEvent::Type::MouseButton:
+			    mouseState.keys[e.key] = (e.action == GLFW_PRESS || e.action == GLFW_REPEAT);
+			    break;
 
-			    case InputEvent::Type::MouseScroll:
-				    scrollDelta.deltaScrollX += e.deltaScrollX;
-				    scrollDelta.deltaScrollY += e.deltaScrollY;
-				    break;
+		    case InputEvent::Type::MouseMove:
+			    cursorPosition.mousePositionX = e.mousePositionX;
+			    cursorPosition.mousePositionY = e.mousePositionY;
+			    break;
 
-			    case InputEvent::Type::WindowResize:
-				    windowSize.windowWidth = e.windowWidth;
-				    windowSize.windowHeight = e.windowHeight;
-				    break;
+		    case InputEvent::Type::MouseScroll:
+			    scrollDelta.deltaScrollX += e.deltaScrollX;
+			    scrollDelta.deltaScrollY += e.deltaScrollY;
+			    break;
 
-			    default:
-				    break;
-			    }
+		    case InputEvent::Type::WindowResize:
+			    windowSize.windowWidth = e.windowWidth;
+			    windowSize.windowHeight = e.windowHeight;
+			    break;
 
-			    mainWindow->inputQueue.pop();
+		    default:
+			    break;
 		    }
 	    });
+	timing.droppedEvents = window.inputQueue.droppedCount();
 }
 
 void InputSolverSystem::onRegistered(GeneralManager& gm)
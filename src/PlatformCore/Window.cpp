@@ -2,16 +2,40 @@
 #include <stdexcept>
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
+#include <chrono>
 #include <iostream>
 
-Window::Window(const char* title)
+namespace
 {
+uint64_t eventTimestamp()
+{
+	return static_cast<uint64_t>(
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+	        .count());
+}
+} // namespace
+
+Window::Window(const char* title) : Window(WindowDesc{.title = title}) {}
+
+Window::Window(const WindowDesc& desc) : _GLFWwindow(nullptr), _headless(desc.headless)
+{
+#ifdef GLFW_PLATFORM_NULL
+	// GLFW is still initialised for its timer; the null platform needs no display server
+	if (_headless) glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+#endif
 	if (!glfwInit())
 	{
 		std::cerr << "Failed to initialize GLFW" << std::endl;
 		throw std::runtime_error("glfwInit failed");
 	}
 
+	if (_headless)
+	{
+		width = static_cast<int>(desc.width);
+		height = static_cast<int>(desc.height);
+		return;
+	}
+
 	glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
 	glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
 
@@ -20,7 +44,7 @@ Window::Window(const char* title)
 	int width = mode->width;
 	int height = mode->height;
 
-	_GLFWwindow = glfwCreateWindow(width, height, title, nullptr, nullptr);
+	_GLFWwindow = glfwCreateWindow(width, height, desc.title, nullptr, nullptr);
 	if (_GLFWwindow == nullptr)
 	{
 		std::cerr << "Failed to create GLFW window" << std::endl;
@@ -53,8 +77,14 @@ GLFWwindow* Window::getHandle() const
 	return _GLFWwindow;
 }
 
+bool Window::isHeadless() const
+{
+	return _headless;
+}
+
 bool Window::shouldClose() const
 {
+	if (_headless) return _headlessShouldClose;
 	return glfwWindowShouldClose(_GLFWwindow);
 }
 
@@ -62,13 +92,16 @@ void Window::setShouldClose(bool value)
 {
 	std::lock_guard<std::mutex> lock(_actionQueueMutex);
 	_deferredActions.push_back([this, value]() {
-		glfwSetWindowShouldClose(_GLFWwindow, value ? GLFW_TRUE : GLFW_FALSE);
+		if (_headless)
+			_headlessShouldClose = value;
+		else
+			glfwSetWindowShouldClose(_GLFWwindow, value ? GLFW_TRUE : GLFW_FALSE);
 	});
 }
 
 void Window::pollEvents() const
 {
-	glfwPollEvents();
+	if (!_headless) glfwPollEvents();
 
 	std::vector<std::function<void()>> actionsToExecute;
 	{
@@ -84,11 +117,12 @@ void Window::pollEvents() const
 
 void Window::swapBuffers() const
 {
-	glfwSwapBuffers(_GLFWwindow);
+	if (_GLFWwindow) glfwSwapBuffers(_GLFWwindow);
 }
 
 std::vector<const char*> Window::getRequiredExtensions() const
 {
+	if (_headless) return {};
 	uint32_t count = 0;
 	const char** extensions = glfwGetRequiredInstanceExtensions(&count);
 	return std::vector<const char*>(extensions, extensions + count);
@@ -96,6 +130,7 @@ std::vector<const char*> Window::getRequiredExtensions() const
 
 vk::SurfaceKHR Window::createSurface(vk::Instance instance) const
 {
+	if (_headless) throw std::runtime_error("Headless windows have no surface!");
 	VkSurfaceKHR c_surface;
 	VkResult result = static_cast<VkResult>(glfwCreateWindowSurface(instance, _GLFWwindow, nullptr, &c_surface));
 
@@ -108,7 +143,7 @@ vk::SurfaceKHR Window::createSurface(vk::Instance instance) const
 
 void Window::waitEvents() const
 {
-	glfwWaitEvents();
+	if (!_headless) glfwWaitEvents();
 }
 
 // ===== Platform utility methods =====
@@ -128,7 +163,7 @@ void Window::setTitle(const char* title)
 	std::string titleStr = title;
 	std::lock_guard<std::mutex> lock(_actionQueueMutex);
 	_deferredActions.push_back([this, titleStr]() {
-		glfwSetWindowTitle(_GLFWwindow, titleStr.c_str());
+		if (_GLFWwindow) glfwSetWindowTitle(_GLFWwindow, titleStr.c_str());
 	});
 }
 
@@ -136,63 +171,81 @@ void Window::setWindowSize(int w, int h)
 {
 	std::lock_guard<std::mutex> lock(_actionQueueMutex);
 	_deferredActions.push_back([this, w, h]() {
-		glfwSetWindowSize(_GLFWwindow, w, h);
+		if (_GLFWwindow) glfwSetWindowSize(_GLFWwindow, w, h);
 	});
 }
 
 void Window::getWindowSize(int* w, int* h) const
 {
+	if (_headless)
+	{
+		if (w) *w = width;
+		if (h) *h = height;
+		return;
+	}
 	glfwGetWindowSize(_GLFWwindow, w, h);
 }
 
 void Window::getFramebufferSize(int* w, int* h) const
 {
+	if (_headless)
+	{
+		if (w) *w = width;
+		if (h) *h = height;
+		return;
+	}
 	glfwGetFramebufferSize(_GLFWwindow, w, h);
 }
 
 bool Window::isFocused() const
 {
-	return glfwGetWindowAttrib(_GLFWwindow, GLFW_FOCUSED) == GLFW_TRUE;
+	return _GLFWwindow && glfwGetWindowAttrib(_GLFWwindow, GLFW_FOCUSED) == GLFW_TRUE;
 }
 
 bool Window::isMinimized() const
 {
-	return glfwGetWindowAttrib(_GLFWwindow, GLFW_ICONIFIED) == GLFW_TRUE;
+	return _GLFWwindow && glfwGetWindowAttrib(_GLFWwindow, GLFW_ICONIFIED) == GLFW_TRUE;
 }
 
 void Window::setCursorMode(int mode)
 {
 	std::lock_guard<std::mutex> lock(_actionQueueMutex);
 	_deferredActions.push_back([this, mode]() {
-		glfwSetInputMode(_GLFWwindow, GLFW_CURSOR, mode);
+		if (_GLFWwindow) glfwSetInputMode(_GLFWwindow, GLFW_CURSOR, mode);
 	});
 }
 
 int Window::getCursorMode() const
 {
-	return glfwGetInputMode(_GLFWwindow, GLFW_CURSOR);
+	return _GLFWwindow ? glfwGetInputMode(_GLFWwindow, GLFW_CURSOR) : GLFW_CURSOR_NORMAL;
 }
 
 bool Window::isKeyPressed(int key) const
 {
-	return glfwGetKey(_GLFWwindow, key) == GLFW_PRESS;
+	return _GLFWwindow && glfwGetKey(_GLFWwindow, key) == GLFW_PRESS;
 }
 
 bool Window::isMouseButtonPressed(int button) const
 {
-	return glfwGetMouseButton(_GLFWwindow, button) == GLFW_PRESS;
+	return _GLFWwindow && glfwGetMouseButton(_GLFWwindow, button) == GLFW_PRESS;
 }
 
 void Window::getCursorPos(double* x, double* y) const
 {
-	glfwGetCursorPos(_GLFWwindow, x, y);
+	if (_GLFWwindow)
+	{
+		glfwGetCursorPos(_GLFWwindow, x, y);
+		return;
+	}
+	if (x) *x = 0.0;
+	if (y) *y = 0.0;
 }
 
 void Window::setCursorPos(double x, double y)
 {
 	std::lock_guard<std::mutex> lock(_actionQueueMutex);
 	_deferredActions.push_back([this, x, y]() {
-		glfwSetCursorPos(_GLFWwindow, x, y);
+		if (_GLFWwindow) glfwSetCursorPos(_GLFWwindow, x, y);
 	});
 }
 
@@ -237,6 +290,7 @@ void Window::framebufferSizeCallback(GLFWwindow* window, int width, int height)
 void Window::handleKey(int key, int scancode, int action, int mods)
 {
 	InputEvent ev;
+	ev.timestampNs = eventTimestamp();
 	ev.Type = InputEvent::Type::Key;
 	ev.key = key;
 	ev.action = action;
@@ -246,6 +300,7 @@ void Window::handleKey(int key, int scancode, int action, int mods)
 void Window::handleMouseButton(int button, int action, int mods)
 {
 	InputEvent ev;
+	ev.timestampNs = eventTimestamp();
 	ev.Type = InputEvent::Type::MouseButton;
 	ev.key = button;
 	ev.action = action;
@@ -255,6 +310,7 @@ void Window::handleMouseButton(int button, int action, int mods)
 void Window::handleCursorPosition(double xpos, double ypos)
 {
 	InputEvent ev;
+	ev.timestampNs = eventTimestamp();
 	ev.Type = InputEvent::Type::MouseMove;
 	ev.mousePositionX = xpos;
 	ev.mousePositionY = ypos;
@@ -263,6 +319,7 @@ void Window::handleCursorPosition(double xpos, double ypos)
 void Window::handleScroll(double xoffset, double yoffset)
 {
 	InputEvent ev;
+	ev.timestampNs = eventTimestamp();
 	ev.Type = InputEvent::Type::MouseScroll;
 	ev.deltaScrollX = xoffset;
 	ev.deltaScrollY = yoffset;
@@ -271,6 +328,7 @@ void Window::handleScroll(double xoffset, double yoffset)
 void Window::handleFramebufferSize(int width, int height)
 {
 	InputEvent ev;
+	ev.timestampNs = eventTimestamp();
 	ev.Type = InputEvent::Type::WindowResize;
 	ev.windowWidth = width;
 	ev.windowHeight = height;
@@ -0,0 +1,30 @@
+#include "SmithCore/Audio.hpp"
+#include "AudioCore/AudioContexts.hpp"
+#include "AudioCore/Components/AudioManagerComponent.hpp"
+#include "AudioCore/Systems/AudioSpatialSystem.hpp"
+#include "GraphicsCore/Components/GlobalTransformComponent.hpp"
+
+SoundHandle Smith::Audio::loadSound(Orhescyon::GeneralManager& gm, const std::string& filepath, SoundLoadMode mode,
+                                    uint32_t maxVoices)
+{
+	AudioManager& audioManager = *gm.getContextComponent<AudioManagerContext, AudioManagerComponent>()->audioManager;
+	return audioManager.load(filepath, mode, maxVoices);
+}
+
+void Smith::Audio::forgeSource(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, AudioSourceComponent source)
+{
+	if (!gm.hasComponent<GlobalTransformComponent>(e))
+	{
+		gm.addComponent<GlobalTransformComponent>(e);
+	}
+
+	if (!gm.hasComponent<AudioSourceComponent>(e))
+	{
+		gm.addComponent<AudioSourceComponent>(e, source);
+	}
+
+	if (!gm.isSubscribedTo<AudioSpatialSystem>(e))
+	{
+		gm.subscribeEntity<AudioSpatialSystem>(e);
+	}
+}
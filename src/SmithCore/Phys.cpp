@@ -5,8 +5,18 @@
 #include "PhysicsCore/PhysContexts.hpp"
 #include "PhysicsCore/PhysShapes.hpp"
 #include "GraphicsCore/Components/LocalTransformComponent.hpp"
+#include "GraphicsCore/Components/ModelManagerComponent.hpp"
+#include "GraphicsCore/GraphicsContexts.hpp"
+#include <stdexcept>
+#include <string>
+#include <utility>
 
-static void internalForgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, Body b, Shape shape)
+static PhysShapeCache& shapeCache(Orhescyon::GeneralManager& gm)
+{
+	return gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager->shapeCache;
+}
+
+static void internalForgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, Body b, ShapeHandle shape)
 {
 	PhysManager& physManager = *gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager;
 
@@ -45,33 +55,66 @@ static void internalForgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e
 void Smith::Phys::forgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, Body b, Sphere sphere)
 {
 	Shape shape = sphere;
-	internalForgeBody(gm, e, b, shape);
+	internalForgeBody(gm, e, b, shapeCache(gm).get(shape));
 }
 
 void Smith::Phys::forgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, Body b, Box box)
 {
 	Shape shape = box;
-	internalForgeBody(gm, e, b, shape);
+	internalForgeBody(gm, e, b, shapeCache(gm).get(shape));
 }
 
 void Smith::Phys::forgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, Body b, Capsule capsule)
 {
 	Shape shape = capsule;
-	internalForgeBody(gm, e, b, shape);
+	internalForgeBody(gm, e, b, shapeCache(gm).get(shape));
 }
 
 void Smith::Phys::forgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, Body b, Cylinder cylinder)
 {
 	Shape shape = cylinder;
-	internalForgeBody(gm, e, b, shape);
+	internalForgeBody(gm, e, b, shapeCache(gm).get(shape));
 }
 
 void Smith::Phys::forgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, Body b, ConvexHull convexHull)
 {
 	Shape shape = convexHull;
+	internalForgeBody(gm, e, b, shapeCache(gm).get(shape));
+}
+
+void Smith::Phys::forgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, Body b, ShapeHandle shape)
+{
 	internalForgeBody(gm, e, b, shape);
 }
 
+ShapeHandle Smith::Phys::cookMeshCollider(Orhescyon::GeneralManager& gm, ModelHandle model, MeshColliderKind kind)
+{
+	ModelManager& modelManager = *gm.getContextComponent<ModelManagerContext, ModelManagerComponent>()->modelManager;
+	const std::string path = modelManager.getModelPath(model);
+	if (path.empty()) throw std::runtime_error("Mesh colliders are cooked from models loaded from a file");
+
+	return shapeCache(gm).requestMesh(path, kind,
+	                                  [&]()
+	                                  {
+		                                  MeshColliderGeometry geometry;
+		                                  modelManager.readbackGeometry(model, geometry.positions, geometry.indices,
+		                                                                geometry.primitiveIndexCounts);
+		                                  return geometry;
+	                                  });
+}
+
+PhysQueryTicket Smith::Phys::submitQueries(Orhescyon::GeneralManager& gm, PhysQueryBatch batch)
+{
+	PhysManager& physManager = *gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager;
+	return physManager.queries.submit(std::move(batch));
+}
+
+bool Smith::Phys::fetchQueryResults(Orhescyon::GeneralManager& gm, PhysQueryTicket ticket, PhysQueryResults& out)
+{
+	PhysManager& physManager = *gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager;
+	return physManager.queries.fetch(ticket, out);
+}
+
 void Smith::Phys::forgeBody(Orhescyon::GeneralManager& gm, Orhescyon::Entity e, JPH::BodyID bodyID)
 {
 	PhysManager& physManager = *gm.getContextComponent<PhysManagerContext, PhysManagerComponent>()->physManager;
@@ -0,0 +1,167 @@
+#include "TaskScheduler.hpp"
+#include <iostream>
+#include <string>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+#ifdef TRACY_ENABLE
+#include <tracy/Tracy.hpp>
+#endif
+
+namespace
+{
+// Which scheduler and worker the current thread belongs to, so submits from a task go to its own deque
+thread_local const TaskScheduler* t_scheduler = nullptr;
+thread_local uint32_t t_workerIndex = 0;
+
+void pinToCore(std::jthread& thread, uint32_t core)
+{
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(core, &set);
+	if (pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) != 0)
+		std::cout << "Warning: could not pin task worker to core " << core << std::endl;
+#elif defined(_WIN32)
+	if (core >= 64 || !SetThreadAffinityMask(thread.native_handle(), DWORD_PTR(1) << core))
+		std::cout << "Warning: could not pin task worker to core " << core << std::endl;
+#else
+	(void)thread;
+	(void)core;
+#endif
+}
+} // namespace
+
+TaskScheduler::TaskScheduler(const TaskSchedulerDesc& desc)
+{
+	uint32_t workerCount = desc.workerCount;
+	if (workerCount == 0)
+	{
+		const uint32_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+		workerCount = hardwareThreads > desc.reservedThreads ? hardwareThreads - desc.reservedThreads : 1;
+	}
+
+	_workers.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i) _workers.push_back(std::make_unique<Worker>());
+
+	_threads.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i)
+	{
+		_threads.emplace_back([this, i](std::stop_token stopToken) { workerLoop(i, stopToken); });
+		if (desc.pinWorkers) pinToCore(_threads.back(), desc.reservedThreads + i);
+	}
+}
+
+TaskScheduler::~TaskScheduler()
+{
+	for (std::jthread& thread : _threads) thread.request_stop();
+	_sleepCv.notify_all();
+	_threads.clear();
+}
+
+void TaskScheduler::submit(Task task, TaskPriority priority, TaskCounter* counter)
+{
+	if (counter) counter->_pending.fetch_add(1, std::memory_order_relaxed);
+
+	const uint32_t target = (t_scheduler == this)
+	                            ? t_workerIndex
+	                            : _nextQueue.fetch_add(1, std::memory_order_relaxed) % workerCount();
+	{
+		Worker& worker = *_workers[target];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		worker.queues[static_cast<size_t>(priority)].push_back({std::move(task), counter});
+	}
+	_queued.fetch_add(1, std::memory_order_release);
+
+	// Taking the lock orders this wake-up after a sleeping worker's last look at _queued
+	{
+		std::lock_guard<std::mutex> lock(_sleepMutex);
+	}
+	_sleepCv.notify_one();
+}
+
+void TaskScheduler::wait(TaskCounter& counter, TaskPriority helpUpTo)
+{
+	const uint32_t self = (t_scheduler == this) ? t_workerIndex : 0;
+	QueuedTask queued;
+	while (!counter.done())
+	{
+		if (tryPop(self, helpUpTo, queued))
+			run(queued);
+		else
+			std::this_thread::yield();
+	}
+}
+
+void TaskScheduler::workerLoop(uint32_t index, std::stop_token stopToken)
+{
+#ifdef TRACY_ENABLE
+	tracy::SetThreadName(("TaskWorker" + std::to_string(index)).c_str());
+#endif
+	t_scheduler = this;
+	t_workerIndex = index;
+
+	QueuedTask queued;
+	while (!stopToken.stop_requested())
+	{
+		if (tryPop(index, TaskPriority::Low, queued))
+		{
+			run(queued);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(_sleepMutex);
+		_sleepCv.wait(lock, stopToken, [this] { return _queued.load(std::memory_order_acquire) > 0; });
+	}
+}
+
+bool TaskScheduler::tryPop(uint32_t self, TaskPriority helpUpTo, QueuedTask& out)
+{
+	const uint32_t count = workerCount();
+	for (size_t priority = 0; priority <= static_cast<size_t>(helpUpTo); ++priority)
+	{
+		for (uint32_t offset = 0; offset < count; ++offset)
+		{
+			const uint32_t victim = (self + offset) % count;
+			Worker& worker = *_workers[victim];
+			std::lock_guard<std::mutex> lock(worker.mutex);
+			std::deque<QueuedTask>& queue = worker.queues[priority];
+			if (queue.empty()) continue;
+
+			if (victim == self)
+			{
+				out = std::move(queue.back());
+				queue.pop_back();
+			}
+			else
+			{
+				out = std::move(queue.front());
+				queue.pop_front();
+			}
+			_queued.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+void TaskScheduler::run(QueuedTask& queued)
+{
+	try
+	{
+		queued.task();
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << "ERROR::TASKSCHEDULER::Task threw: " << e.what() << std::endl;
+	}
+	queued.task = nullptr;
+	if (queued.counter) queued.counter->_pending.fetch_sub(1, std::memory_order_acq_rel);
+}